@@ -4,11 +4,38 @@
 
 #include "Engine/AssetManager.h"
 #include "Engine/StreamableManager.h"
+#include "HAL/IConsoleManager.h"
 #include "Stats/Stats.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogAsyncMixin, Log, All);
 
 TMap<FAsyncMixin*, TSharedRef<FAsyncMixin::FLoadingState>> FAsyncMixin::Loading;
+TArray<TSharedRef<FAsyncMixin::FLoadingState>> FAsyncMixin::LoadingStatePool;
+TArray<FAsyncMixin::FQueuedLoadingState> FAsyncMixin::QueuedStarts;
+TArray<FAsyncMixin::FQueuedLoadingState> FAsyncMixin::QueuedDestroys;
+FTSTicker::FDelegateHandle FAsyncMixin::QueueTickerHandle;
+uint32 FAsyncMixin::NextLoadingStateGeneration = 0;
+
+namespace AsyncMixin
+{
+	// Loading states beyond this are freed instead of pooled
+	static constexpr int32 MaxPooledLoadingStates = 256;
+
+	static void LogLoadingStateStats(const TCHAR* Context)
+	{
+		const FAsyncMixin::FLoadingStateStats Stats = FAsyncMixin::GetLoadingStateStats();
+		UE_LOG(LogAsyncMixin, Display, TEXT("%s: Live %d, Pooled %d, Queued Starts %d, Queued Destroys %d"),
+			Context, Stats.NumLive, Stats.NumPooled, Stats.NumQueuedStarts, Stats.NumQueuedDestroys);
+	}
+
+	static FAutoConsoleCommand CmdDumpStats(
+		TEXT("AsyncMixin.DumpStats"),
+		TEXT("Logs the number of live, pooled and queued async mix-in loading states."),
+		FConsoleCommandDelegate::CreateLambda([]()
+		{
+			LogLoadingStateStats(TEXT("AsyncMixin"));
+		}));
+}
 
 FAsyncMixin::FAsyncMixin()
 {
@@ -20,7 +47,100 @@ FAsyncMixin::~FAsyncMixin()
 
 	// Removing the loading state will cancel any pending loadings it was 
 	// monitoring, and shouldn't receive any future callbacks for completion.
-	Loading.Remove(this);
+	ReleaseLoadingState(this);
+}
+
+FAsyncMixin::FLoadingStateStats FAsyncMixin::GetLoadingStateStats()
+{
+	check(IsInGameThread());
+
+	FLoadingStateStats Stats;
+	Stats.NumLive = Loading.Num();
+	Stats.NumPooled = LoadingStatePool.Num();
+	Stats.NumQueuedStarts = QueuedStarts.Num();
+	Stats.NumQueuedDestroys = QueuedDestroys.Num();
+	return Stats;
+}
+
+void FAsyncMixin::ReleaseLoadingState(FAsyncMixin* InOwner)
+{
+	const TSharedRef<FLoadingState>* LoadingStatePtr = Loading.Find(InOwner);
+	if (!LoadingStatePtr)
+	{
+		return;
+	}
+
+	TSharedRef<FLoadingState> LoadingState = *LoadingStatePtr;
+	Loading.Remove(InOwner);
+
+	// If anything else still references the loading state, we're most likely inside one of its own callbacks.
+	// It can't be reused yet, it's just unbound and freed once the last reference goes away.
+	const bool bCanPool = LoadingState.IsUnique() && LoadingStatePool.Num() < AsyncMixin::MaxPooledLoadingStates;
+	LoadingState->Deactivate(/*bReleaseSteps*/LoadingState.IsUnique());
+
+	if (bCanPool)
+	{
+		LoadingStatePool.Add(MoveTemp(LoadingState));
+	}
+}
+
+void FAsyncMixin::QueueLoadingState(TArray<FQueuedLoadingState>& Queue, const FLoadingState& LoadingState)
+{
+	check(IsInGameThread());
+
+	Queue.Add({ LoadingState.GetOwner(), LoadingState.GetGeneration() });
+
+	if (!QueueTickerHandle.IsValid())
+	{
+		QueueTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&FAsyncMixin::TickQueuedLoadingStates));
+	}
+}
+
+bool FAsyncMixin::TickQueuedLoadingStates(float DeltaTime)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_FAsyncMixin_TickQueuedLoadingStates);
+
+	// Work queued while processing (e.g. a start callback scheduling more loads) runs next frame, like the
+	// individual tickers did before.
+	TArray<FQueuedLoadingState> Starts = MoveTemp(QueuedStarts);
+	TArray<FQueuedLoadingState> Destroys = MoveTemp(QueuedDestroys);
+	QueuedStarts.Reset();
+	QueuedDestroys.Reset();
+
+	for (const FQueuedLoadingState& Queued : Starts)
+	{
+		const TSharedRef<FLoadingState>* LoadingStatePtr = Loading.Find(Queued.Owner);
+		if (LoadingStatePtr && (*LoadingStatePtr)->GetGeneration() == Queued.Generation && (*LoadingStatePtr)->IsStartPending())
+		{
+			// Keep the loading state alive in case the owner goes away during its callbacks
+			TSharedRef<FLoadingState> LoadingState = *LoadingStatePtr;
+			LoadingState->Start();
+		}
+	}
+
+	for (const FQueuedLoadingState& Queued : Destroys)
+	{
+		const TSharedRef<FLoadingState>* LoadingStatePtr = Loading.Find(Queued.Owner);
+		if (LoadingStatePtr && (*LoadingStatePtr)->GetGeneration() == Queued.Generation && (*LoadingStatePtr)->IsPendingDestroy())
+		{
+			UE_LOG(LogAsyncMixin, Verbose, TEXT("[0x%X] Destroy LoadingState (Done)"), &LoadingStatePtr->Get());
+			ReleaseLoadingState(Queued.Owner);
+		}
+	}
+
+	if (QueuedStarts.Num() == 0 && QueuedDestroys.Num() == 0)
+	{
+		// Reclaim the queue memory for the next burst and stop ticking until then
+		QueuedStarts = MoveTemp(Starts);
+		QueuedDestroys = MoveTemp(Destroys);
+		QueuedStarts.Reset();
+		QueuedDestroys.Reset();
+
+		QueueTickerHandle.Reset();
+		return false;
+	}
+
+	return true;
 }
 
 const FAsyncMixin::FLoadingState& FAsyncMixin::GetLoadingStateConst() const
@@ -38,7 +158,10 @@ FAsyncMixin::FLoadingState& FAsyncMixin::GetLoadingState()
 		return (*LoadingState).Get();
 	}
 
-	return Loading.Add(this, MakeShared<FLoadingState>(*this)).Get();
+	TSharedRef<FLoadingState> LoadingState = LoadingStatePool.Num() > 0 ? LoadingStatePool.Pop(EAllowShrinking::No) : MakeShared<FLoadingState>();
+	LoadingState->Activate(*this, ++NextLoadingStateGeneration);
+
+	return Loading.Add(this, MoveTemp(LoadingState)).Get();
 }
 
 bool FAsyncMixin::HasLoadingState() const
@@ -122,22 +245,47 @@ void FAsyncMixin::StartAsyncLoading()
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
 
-FAsyncMixin::FLoadingState::FLoadingState(FAsyncMixin& InOwner)
-	: OwnerRef(InOwner)
+FAsyncMixin::FLoadingState::FLoadingState()
 {
 }
 
 FAsyncMixin::FLoadingState::~FLoadingState()
 {
-	QUICK_SCOPE_CYCLE_COUNTER(STAT_FAsyncMixin_FLoadingState_DestroyThisMemoryDelegate);
-	UE_LOG(LogAsyncMixin, Verbose, TEXT("[0x%X] Destroy LoadingState (Done)"), this);
-
 	// If we get destroyed, need to cancel whatever we're doing and cancel any
 	// pending destruction - as we're already on the way out.
 	CancelOnly(/*bDestroying*/true);
 	CancelDestroyThisMemory(/*bDestroying*/true);
 }
 
+void FAsyncMixin::FLoadingState::Activate(FAsyncMixin& InOwner, uint32 InGeneration)
+{
+	check(Owner == nullptr);
+
+	Owner = &InOwner;
+	Generation = InGeneration;
+
+	// Keeps the array memory of the previous owner around for reuse
+	AsyncStepsPendingDestruction.Reset();
+}
+
+void FAsyncMixin::FLoadingState::Deactivate(bool bReleaseSteps)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_FAsyncMixin_FLoadingState_Deactivate);
+
+	// Cancel whatever we're doing and any pending destruction - as we're already on the way out.
+	CancelOnly(/*bDestroying*/true);
+	CancelDestroyThisMemory(/*bDestroying*/true);
+
+	// Steps can only be destroyed if we're not inside one of their callbacks
+	if (bReleaseSteps)
+	{
+		AsyncStepsPendingDestruction.Reset();
+	}
+
+	Owner = nullptr;
+	Generation = 0;
+}
+
 void FAsyncMixin::FLoadingState::CancelOnly(bool bDestroying)
 {
 	if (!bDestroying)
@@ -177,8 +325,8 @@ void FAsyncMixin::FLoadingState::CancelDestroyThisMemory(bool bDestroying)
 			UE_LOG(LogAsyncMixin, Verbose, TEXT("[0x%X] Destroy LoadingState (Canceled)"), this);
 		}
 
-		FTSTicker::GetCoreTicker().RemoveTicker(DestroyMemoryDelegate);
-		DestroyMemoryDelegate.Reset();
+		// The queued destroy is skipped by the ticker once the flag is cleared
+		bDestroyPending = false;
 	}
 }
 
@@ -189,21 +337,16 @@ void FAsyncMixin::FLoadingState::RequestDestroyThisMemory()
 	{
 		UE_LOG(LogAsyncMixin, Verbose, TEXT("[0x%X] Destroy LoadingState (Requested)"), this);
 
-		DestroyMemoryDelegate = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([this](float DeltaTime) {
-			// Remove any memory we were using.
-			FAsyncMixin::Loading.Remove(&OwnerRef);
-			return false;
-		}));
+		// Remove any memory we were using next frame.
+		bDestroyPending = true;
+		FAsyncMixin::QueueLoadingState(FAsyncMixin::QueuedDestroys, *this);
 	}
 }
 
 void FAsyncMixin::FLoadingState::CancelStartTimer()
 {
-	if (StartTimerDelegate.IsValid())
-	{
-		FTSTicker::GetCoreTicker().RemoveTicker(StartTimerDelegate);
-		StartTimerDelegate.Reset();
-	}
+	// The queued start is skipped by the ticker once the flag is cleared
+	bStartPending = false;
 }
 
 void FAsyncMixin::FLoadingState::Start()
@@ -218,7 +361,7 @@ void FAsyncMixin::FLoadingState::Start()
 	if (!bHasStarted)
 	{
 		bHasStarted = true;
-		OwnerRef.OnStartedLoading();
+		Owner->OnStartedLoading();
 	}
 	
 	TryCompleteAsyncLoading();
@@ -301,13 +444,10 @@ void FAsyncMixin::FLoadingState::TryScheduleStart()
 	CancelDestroyThisMemory(/*bDestroying*/false);
 
 	// In the event the user forgets to start async loading, we'll begin doing it next frame.
-	if (!StartTimerDelegate.IsValid())
+	if (!bStartPending)
 	{
-		StartTimerDelegate = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([this](float DeltaTime) {
-			QUICK_SCOPE_CYCLE_COUNTER(STAT_FAsyncMixin_FLoadingState_TryScheduleStartDelegate);
-			Start();
-			return false;
-		}));
+		bStartPending = true;
+		FAsyncMixin::QueueLoadingState(FAsyncMixin::QueuedStarts, *this);
 	}
 }
 
@@ -333,12 +473,12 @@ bool FAsyncMixin::FLoadingState::IsLoadingInProgress() const
 
 bool FAsyncMixin::FLoadingState::IsLoadingInProgressOrPending() const
 {
-	return StartTimerDelegate.IsValid() || IsLoadingInProgress();
+	return bStartPending || IsLoadingInProgress();
 }
 
 bool FAsyncMixin::FLoadingState::IsPendingDestroy() const
 {
-	return DestroyMemoryDelegate.IsValid();
+	return bDestroyPending;
 }
 
 void FAsyncMixin::FLoadingState::TryCompleteAsyncLoading()
@@ -361,7 +501,7 @@ void FAsyncMixin::FLoadingState::TryCompleteAsyncLoading()
 			if (!Step->IsCompleteDelegateBound())
 			{
 				UE_LOG(LogAsyncMixin, Verbose, TEXT("[0x%X] Step %d - Still Loading (Listening)"), this, CurrentAsyncStep + 1);
-				const bool bBound = Step->BindCompleteDelegate(FSimpleDelegate::CreateSP(this, &FLoadingState::TryCompleteAsyncLoading));
+				const bool bBound = Step->BindCompleteDelegate(FSimpleDelegate::CreateSP(this, &FLoadingState::HandleStepCompleted, Generation));
 				ensureMsgf(bBound, TEXT("This is not intended to return false.  We're checking if it's loaded above, this should definitely return true."));
 			}
 			else
@@ -394,6 +534,15 @@ void FAsyncMixin::FLoadingState::TryCompleteAsyncLoading()
 	}
 }
 
+void FAsyncMixin::FLoadingState::HandleStepCompleted(uint32 BoundGeneration)
+{
+	// A pooled loading state may be serving a different owner by now
+	if (BoundGeneration == Generation && Owner)
+	{
+		TryCompleteAsyncLoading();
+	}
+}
+
 void FAsyncMixin::FLoadingState::CompleteAsyncLoading()
 {
 	UE_LOG(LogAsyncMixin, Verbose, TEXT("[0x%X] CompleteAsyncLoading"), this);
@@ -402,7 +551,7 @@ void FAsyncMixin::FLoadingState::CompleteAsyncLoading()
 	if (bHasStarted)
 	{
 		bHasStarted = false;
-		OwnerRef.OnFinishedLoading();
+		Owner->OnFinishedLoading();
 	}
 
 	// It's unlikely but possible they started loading more stuff in the OnFinishedLoading callback,
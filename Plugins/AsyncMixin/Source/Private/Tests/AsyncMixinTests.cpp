@@ -0,0 +1,113 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AsyncMixin.h"
+
+#include "Containers/Ticker.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAsyncMixinStressTest, "AsyncMixin.LoadingStates.StressTest", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FAsyncMixinStressTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumScopes = 5000;
+
+	// Queued work is processed by the shared ticker, a callback starting more work is picked up on the next tick
+	auto ProcessQueuedWork = []()
+	{
+		for (int32 Tick = 0; Tick < 8; ++Tick)
+		{
+			const FAsyncMixin::FLoadingStateStats Stats = FAsyncMixin::GetLoadingStateStats();
+			if ((Stats.NumQueuedStarts == 0) && (Stats.NumQueuedDestroys == 0))
+			{
+				break;
+			}
+
+			FTSTicker::GetCoreTicker().Tick(0.f);
+		}
+	};
+
+	// Other mix-ins of the editor may be loading as well, only the states of this test are compared
+	const int32 NumLiveBefore = FAsyncMixin::GetLoadingStateStats().NumLive;
+
+	// Mix of explicit starts, starts left to the ticker, cancels and re-queues
+	{
+		TArray<TUniquePtr<FAsyncScope>> Scopes;
+		TArray<int32> NumCallbacks;
+		Scopes.Reserve(NumScopes);
+		NumCallbacks.SetNumZeroed(NumScopes);
+
+		for (int32 Index = 0; Index < NumScopes; ++Index)
+		{
+			FAsyncScope& Scope = *Scopes.Add_GetRef(MakeUnique<FAsyncScope>());
+			const FSimpleDelegate Callback = FSimpleDelegate::CreateLambda([&NumCallbacks, Index]() { NumCallbacks[Index]++; });
+			Scope.AsyncEvent(Callback);
+
+			switch (Index % 4)
+			{
+			case 0: Scope.StartAsyncLoading(); break;
+			case 1: Scope.CancelAsyncLoading(); break;
+			case 2: Scope.CancelAsyncLoading(); Scope.AsyncEvent(Callback); break;
+			default: break;
+			}
+		}
+
+		TestEqual(TEXT("Live loading states while queued"), FAsyncMixin::GetLoadingStateStats().NumLive, NumLiveBefore + NumScopes);
+
+		ProcessQueuedWork();
+
+		const FAsyncMixin::FLoadingStateStats Stats = FAsyncMixin::GetLoadingStateStats();
+		TestEqual(TEXT("Queued starts after processing"), Stats.NumQueuedStarts, 0);
+		TestEqual(TEXT("Queued destroys after processing"), Stats.NumQueuedDestroys, 0);
+
+		for (int32 Index = 0; Index < NumScopes; ++Index)
+		{
+			// Only the canceled scope without a new event never calls back
+			const int32 ExpectedCallbacks = (Index % 4 == 1) ? 0 : 1;
+			if (NumCallbacks[Index] != ExpectedCallbacks)
+			{
+				AddError(FString::Printf(TEXT("Scope %d (case %d) called back %d times, expected %d."), Index, Index % 4, NumCallbacks[Index], ExpectedCallbacks));
+				return false;
+			}
+
+			const FAsyncMixin& Scope = *Scopes[Index];
+			if (Scope.HasLoadingState() || Scope.IsLoadingInProgressOrPending())
+			{
+				AddError(FString::Printf(TEXT("Scope %d (case %d) still has a loading state after its work completed."), Index, Index % 4));
+				return false;
+			}
+		}
+	}
+
+	// Owners destroyed with their work still queued release everything, the queued work is skipped
+	{
+		TArray<TUniquePtr<FAsyncScope>> Scopes;
+		int32 NumCallbacks = 0;
+		Scopes.Reserve(NumScopes);
+
+		for (int32 Index = 0; Index < NumScopes; ++Index)
+		{
+			FAsyncScope& Scope = *Scopes.Add_GetRef(MakeUnique<FAsyncScope>());
+			Scope.AsyncEvent(FSimpleDelegate::CreateLambda([&NumCallbacks]() { NumCallbacks++; }));
+		}
+
+		Scopes.Reset();
+
+		TestEqual(TEXT("Live loading states after destroy"), FAsyncMixin::GetLoadingStateStats().NumLive, NumLiveBefore);
+
+		ProcessQueuedWork();
+
+		const FAsyncMixin::FLoadingStateStats Stats = FAsyncMixin::GetLoadingStateStats();
+		TestEqual(TEXT("Callbacks of destroyed scopes"), NumCallbacks, 0);
+		TestEqual(TEXT("Queued starts after destroy"), Stats.NumQueuedStarts, 0);
+		TestEqual(TEXT("Queued destroys after destroy"), Stats.NumQueuedDestroys, 0);
+
+		// See AsyncMixin::MaxPooledLoadingStates
+		TestTrue(TEXT("Pooled loading states are bounded"), Stats.NumPooled <= 256);
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -69,12 +69,32 @@ DECLARE_DELEGATE_OneParam(FStreamableHandleDelegate, TSharedPtr<FStreamableHandl
  */
 class ASYNCMIXIN_API FAsyncMixin : public FNoncopyable
 {
+#if WITH_DEV_AUTOMATION_TESTS
+	friend class FAsyncMixinStressTest;
+#endif
+
 protected:
 	FAsyncMixin();
 
 public:
 	virtual ~FAsyncMixin();
 
+	/** Counters of the loading states shared by all mix-ins, for profiling. */
+	struct FLoadingStateStats
+	{
+		/** Loading states currently owned by a mix-in. */
+		int32 NumLive = 0;
+
+		/** Loading states waiting in the pool for reuse. */
+		int32 NumPooled = 0;
+
+		/** Starts and destroys queued for the shared ticker, including ones that were canceled since. */
+		int32 NumQueuedStarts = 0;
+		int32 NumQueuedDestroys = 0;
+	};
+
+	static FLoadingStateStats GetLoadingStateStats();
+
 protected:
 	/** Called when loading starts. */
 	virtual void OnStartedLoading() { }
@@ -198,14 +218,23 @@ protected:
 private:
 	/**
 	 * The FLoadingState is what actually is allocated for the FAsyncMixin in a big map so that the FAsyncMixin itself holds no
-	 * no memory, and we dynamically create the FLoadingState only if needed, and destroy it when it's unneeded.
+	 * no memory, and we dynamically create the FLoadingState only if needed, and return it to a pool when it's unneeded.
 	 */
 	class FLoadingState : public TSharedFromThis<FLoadingState>
 	{
 	public:
-		FLoadingState(FAsyncMixin& InOwner);
+		FLoadingState();
 		virtual ~FLoadingState();
 
+		/** Binds a fresh or pooled loading state to its owner. */
+		void Activate(FAsyncMixin& InOwner, uint32 InGeneration);
+
+		/** Cancels everything and unbinds the loading state from its owner, so it can go back to the pool. */
+		void Deactivate(bool bReleaseSteps);
+
+		FAsyncMixin* GetOwner() const { return Owner; }
+		uint32 GetGeneration() const { return Generation; }
+
 		/** Starts the async sequence. */
 		void Start();
 
@@ -222,6 +251,7 @@ private:
 		bool IsLoadingInProgress() const;
 		bool IsLoadingInProgressOrPending() const;
 		bool IsPendingDestroy() const;
+		bool IsStartPending() const { return bStartPending; }
 
 	private:
 		void CancelOnly(bool bDestroying);
@@ -230,12 +260,18 @@ private:
 		void TryCompleteAsyncLoading();
 		void CompleteAsyncLoading();
 
+		/** Step completion callback, ignored if the loading state was recycled since it was bound. */
+		void HandleStepCompleted(uint32 BoundGeneration);
+
 	private:
 		void RequestDestroyThisMemory();
 		void CancelDestroyThisMemory(bool bDestroying);
 
 		/** Who owns the loading state?  We need this to call back into the owning mix-in object. */
-		FAsyncMixin& OwnerRef;
+		FAsyncMixin* Owner = nullptr;
+
+		/** Changes every time the loading state is handed to an owner, used to discard stale queue entries and callbacks. */
+		uint32 Generation = 0;
 
 		/**
 		 * Did we need to pre-load bundles?  If we didn't pre-load bundles (which require you keep the streaming handle 
@@ -280,8 +316,16 @@ private:
 		TArray<TUniquePtr<FAsyncStep>> AsyncSteps;
 		TArray<TUniquePtr<FAsyncStep>> AsyncStepsPendingDestruction;
 
-		FTSTicker::FDelegateHandle StartTimerDelegate;
-		FTSTicker::FDelegateHandle DestroyMemoryDelegate;
+		/** Whether a start or destroy is queued on the shared ticker. */
+		bool bStartPending = false;
+		bool bDestroyPending = false;
+	};
+
+	/** A queued start or destroy, only valid while the owner's loading state still has the same generation. */
+	struct FQueuedLoadingState
+	{
+		FAsyncMixin* Owner = nullptr;
+		uint32 Generation = 0;
 	};
 
 	const FLoadingState& GetLoadingStateConst() const;
@@ -292,8 +336,25 @@ private:
 
 	bool IsLoadingInProgressOrPending() const;
 
+	/** Removes the loading state of the given owner and returns it to the pool. */
+	static void ReleaseLoadingState(FAsyncMixin* InOwner);
+
+	static void QueueLoadingState(TArray<FQueuedLoadingState>& Queue, const FLoadingState& LoadingState);
+
+	/** Single ticker processing the queued starts and destroys of all loading states. */
+	static bool TickQueuedLoadingStates(float DeltaTime);
+
 private:
+	/**
+	 * All loading state bookkeeping is game thread only. The ticker looks states up by owner and generation,
+	 * so a mix-in destroyed or canceled after queuing work is simply skipped.
+	 */
 	static TMap<FAsyncMixin*, TSharedRef<FLoadingState>> Loading;
+	static TArray<TSharedRef<FLoadingState>> LoadingStatePool;
+	static TArray<FQueuedLoadingState> QueuedStarts;
+	static TArray<FQueuedLoadingState> QueuedDestroys;
+	static FTSTicker::FDelegateHandle QueueTickerHandle;
+	static uint32 NextLoadingStateGeneration;
 };
 
 /**
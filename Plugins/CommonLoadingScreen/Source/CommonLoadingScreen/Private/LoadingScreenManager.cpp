@@ -64,6 +64,18 @@ bool ILoadingProcessInterface::ShouldShowLoadingScreen(UObject* TestObject, FStr
 	return false;
 }
 
+void ILoadingProcessInterface::NotifyLoadingStateChanged(UObject* Processor)
+{
+	const UWorld* World = Processor ? Processor->GetWorld() : nullptr;
+	const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+
+	// There is no loading screen manager on dedicated servers
+	if (ULoadingScreenManager* LoadingScreenManager = GameInstance ? GameInstance->GetSubsystem<ULoadingScreenManager>() : nullptr)
+	{
+		LoadingScreenManager->NotifyLoadingProcessorStateChanged(Processor);
+	}
+}
+
 //////////////////////////////////////////////////////////////////////
 
 namespace LoadingScreenCVars
@@ -89,6 +101,18 @@ namespace LoadingScreenCVars
 		ForceLoadingScreenVisible,
 		TEXT("Force the loading screen to show."),
 		ECVF_Default);
+
+	static FAutoConsoleCommandWithWorld CmdDumpLoadingProcessors(
+		TEXT("CommonLoadingScreen.DumpLoadingProcessors"),
+		TEXT("Logs which loading processors are currently holding the loading screen, and for how long."),
+		FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+		{
+			const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+			if (const ULoadingScreenManager* LoadingScreenManager = GameInstance ? GameInstance->GetSubsystem<ULoadingScreenManager>() : nullptr)
+			{
+				UE_LOG(LogLoadingScreen, Display, TEXT("%s"), *LoadingScreenManager->GetLoadingProcessorDebugReport());
+			}
+		}));
 }
 
 //////////////////////////////////////////////////////////////////////
@@ -182,11 +206,61 @@ UWorld* ULoadingScreenManager::GetTickableGameObjectWorld() const
 void ULoadingScreenManager::RegisterLoadingProcessor(TScriptInterface<ILoadingProcessInterface> Interface)
 {
 	ExternalLoadingProcessors.Add(Interface.GetObject());
+	bLoadingProcessorsDirty = true;
 }
 
 void ULoadingScreenManager::UnregisterLoadingProcessor(TScriptInterface<ILoadingProcessInterface> Interface)
 {
 	ExternalLoadingProcessors.Remove(Interface.GetObject());
+	bLoadingProcessorsDirty = true;
+}
+
+void ULoadingScreenManager::NotifyLoadingProcessorStateChanged(TScriptInterface<ILoadingProcessInterface> Interface)
+{
+	UObject* Processor = Interface.GetObject();
+	if (Processor == nullptr)
+	{
+		return;
+	}
+
+	const bool bIsDiscovered = DiscoveredLoadingProcessors.ContainsByPredicate([Processor](const FDiscoveredLoadingProcessor& Discovered)
+	{
+		return Discovered.Object.Get() == Processor;
+	});
+
+	// Processors we don't know yet are asked when they get discovered
+	if (bIsDiscovered)
+	{
+		UpdateLoadingProcessorHold(Processor);
+	}
+	else
+	{
+		bLoadingProcessorsDirty = true;
+	}
+}
+
+FString ULoadingScreenManager::GetLoadingProcessorDebugReport() const
+{
+	const double CurrentTime = FPlatformTime::Seconds();
+
+	FString Report = FString::Printf(TEXT("Loading screen showing: %d. Reason: %s\n"), bCurrentlyShowingLoadingScreen ? 1 : 0, *DebugReasonForShowingOrHidingLoadingScreen);
+	Report += FString::Printf(TEXT("%d loading processors (%d holding the loading screen):\n"), DiscoveredLoadingProcessors.Num(), LoadingProcessorHolds.Num());
+
+	for (const FDiscoveredLoadingProcessor& Discovered : DiscoveredLoadingProcessors)
+	{
+		const FLoadingProcessorHold* Hold = LoadingProcessorHolds.Find(FObjectKey(Discovered.Object.Get()));
+		if (Hold)
+		{
+			Report += FString::Printf(TEXT("  HOLDING %.2fs [%s] %s: %s\n"),
+				CurrentTime - Hold->HoldStartTime, Discovered.bEventDriven ? TEXT("event") : TEXT("polled"), *GetPathNameSafe(Discovered.Object.Get()), *Hold->Reason);
+		}
+		else
+		{
+			Report += FString::Printf(TEXT("  ready [%s] %s\n"), Discovered.bEventDriven ? TEXT("event") : TEXT("polled"), *GetPathNameSafe(Discovered.Object.Get()));
+		}
+	}
+
+	return Report;
 }
 
 void ULoadingScreenManager::HandlePreLoadMap(const FWorldContext& WorldContext, const FString& MapName)
@@ -194,6 +268,7 @@ void ULoadingScreenManager::HandlePreLoadMap(const FWorldContext& WorldContext,
 	if (WorldContext.OwningGameInstance == GetGameInstance())
 	{
 		bCurrentlyInLoadMap = true;
+		bLoadingProcessorsDirty = true;
 
 		// Update the loading screen immediately if the engine is initialized
 		if (GEngine->IsInitialized())
@@ -208,6 +283,7 @@ void ULoadingScreenManager::HandlePostLoadMap(UWorld* World)
 	if ((World != nullptr) && (World->GetGameInstance() == GetGameInstance()))
 	{
 		bCurrentlyInLoadMap = false;
+		bLoadingProcessorsDirty = true;
 	}
 }
 
@@ -228,6 +304,8 @@ void ULoadingScreenManager::UpdateLoadingScreen()
  		{
 			bLogLoadingScreenStatus = true;
  			TimeUntilNextLogHeartbeatSeconds = Settings->LogLoadingScreenHeartbeatInterval;
+
+			UE_LOG(LogLoadingScreen, Log, TEXT("%s"), *GetLoadingProcessorDebugReport());
  		}
 	}
 	else
@@ -313,32 +391,12 @@ bool ULoadingScreenManager::CheckForAnyNeedToShowLoadingScreen()
 		return true;
 	}
 
-	// Ask the game state if it needs a loading screen	
-	if (ILoadingProcessInterface::ShouldShowLoadingScreen(GameState, /*out*/ DebugReasonForShowingOrHidingLoadingScreen))
+	// Ask the game state, its components, the local player controllers, their components and any external loading processors
+	if (CheckLoadingProcessors(GameState))
 	{
 		return true;
 	}
 
-	// Ask any game state components if they need a loading screen
-	for (UActorComponent* TestComponent : GameState->GetComponents())
-	{
-		if (ILoadingProcessInterface::ShouldShowLoadingScreen(TestComponent, /*out*/ DebugReasonForShowingOrHidingLoadingScreen))
-		{
-			return true;
-		}
-	}
-
-	// Ask any of the external loading processors that may have been registered.  These might be actors or components
-	// that were registered by game code to tell us to keep the loading screen up while perhaps something finishes
-	// streaming in.
-	for (const TWeakInterfacePtr<ILoadingProcessInterface>& Processor : ExternalLoadingProcessors)
-	{
-		if (ILoadingProcessInterface::ShouldShowLoadingScreen(Processor.GetObject(), /*out*/ DebugReasonForShowingOrHidingLoadingScreen))
-		{
-			return true;
-		}
-	}
-
 	// Check each local player
 	bool bFoundAnyLocalPC = false;
 	bool bMissingAnyLocalPC = false;
@@ -350,21 +408,6 @@ bool ULoadingScreenManager::CheckForAnyNeedToShowLoadingScreen()
 			if (APlayerController* PC = LP->PlayerController)
 			{
 				bFoundAnyLocalPC = true;
-
-				// Ask the PC itself if it needs a loading screen
-				if (ILoadingProcessInterface::ShouldShowLoadingScreen(PC, /*out*/ DebugReasonForShowingOrHidingLoadingScreen))
-				{
-					return true;
-				}
-
-				// Ask any PC components if they need a loading screen
-				for (UActorComponent* TestComponent : PC->GetComponents())
-				{
-					if (ILoadingProcessInterface::ShouldShowLoadingScreen(TestComponent, /*out*/ DebugReasonForShowingOrHidingLoadingScreen))
-					{
-						return true;
-					}
-				}
 			}
 			else
 			{
@@ -395,6 +438,156 @@ bool ULoadingScreenManager::CheckForAnyNeedToShowLoadingScreen()
 	return false;
 }
 
+bool ULoadingScreenManager::CheckLoadingProcessors(AGameStateBase* GameState)
+{
+	RefreshLoadingProcessors(GameState);
+
+	bool bAnyProcessorWantsLoadingScreen = false;
+
+	// Ask in discovery order, so the reason comes from the same processor as before.
+	// Event driven processors are answered from their hold, the others are polled.
+	for (const FDiscoveredLoadingProcessor& Discovered : DiscoveredLoadingProcessors)
+	{
+		UObject* Processor = Discovered.Object.Get();
+		if (Processor == nullptr)
+		{
+			// Drop its hold on the next refresh
+			bLoadingProcessorsDirty = true;
+			continue;
+		}
+
+		bool bWantsLoadingScreen;
+		if (Discovered.bEventDriven)
+		{
+			bWantsLoadingScreen = LoadingProcessorHolds.Contains(FObjectKey(Processor));
+		}
+		else
+		{
+			bWantsLoadingScreen = UpdateLoadingProcessorHold(Processor);
+		}
+
+		if (bWantsLoadingScreen && !bAnyProcessorWantsLoadingScreen)
+		{
+			bAnyProcessorWantsLoadingScreen = true;
+			DebugReasonForShowingOrHidingLoadingScreen = LoadingProcessorHolds.FindChecked(FObjectKey(Processor)).Reason;
+		}
+	}
+
+	return bAnyProcessorWantsLoadingScreen;
+}
+
+void ULoadingScreenManager::RefreshLoadingProcessors(AGameStateBase* GameState)
+{
+	const UGameInstance* LocalGameInstance = GetGameInstance();
+
+	// Components can be added at any time (e.g. by game features), so the hash includes the component counts
+	uint32 DiscoveryHash = HashCombine(GetTypeHash(GameState), GameState->GetComponents().Num());
+	for (const ULocalPlayer* LP : LocalGameInstance->GetLocalPlayers())
+	{
+		if (const APlayerController* PC = LP ? LP->PlayerController : nullptr)
+		{
+			DiscoveryHash = HashCombine(DiscoveryHash, HashCombine(GetTypeHash(PC), PC->GetComponents().Num()));
+		}
+	}
+	DiscoveryHash = HashCombine(DiscoveryHash, ExternalLoadingProcessors.Num());
+
+	if (!bLoadingProcessorsDirty && (DiscoveryHash == LoadingProcessorDiscoveryHash))
+	{
+		return;
+	}
+
+	bLoadingProcessorsDirty = false;
+	LoadingProcessorDiscoveryHash = DiscoveryHash;
+	DiscoveredLoadingProcessors.Reset();
+
+	auto AddIfLoadingProcessor = [this](UObject* TestObject)
+	{
+		if (const ILoadingProcessInterface* LoadingProcessor = Cast<ILoadingProcessInterface>(TestObject))
+		{
+			FDiscoveredLoadingProcessor& Discovered = DiscoveredLoadingProcessors.AddDefaulted_GetRef();
+			Discovered.Object = TestObject;
+			Discovered.bEventDriven = LoadingProcessor->IsLoadingStateEventDriven();
+		}
+	};
+
+	AddIfLoadingProcessor(GameState);
+	for (UActorComponent* TestComponent : GameState->GetComponents())
+	{
+		AddIfLoadingProcessor(TestComponent);
+	}
+
+	// These might be actors or components that were registered by game code to tell us to keep the loading screen up
+	// while perhaps something finishes streaming in.
+	for (const TWeakInterfacePtr<ILoadingProcessInterface>& Processor : ExternalLoadingProcessors)
+	{
+		AddIfLoadingProcessor(Processor.GetObject());
+	}
+
+	for (ULocalPlayer* LP : LocalGameInstance->GetLocalPlayers())
+	{
+		if (APlayerController* PC = LP ? LP->PlayerController : nullptr)
+		{
+			AddIfLoadingProcessor(PC);
+			for (UActorComponent* TestComponent : PC->GetComponents())
+			{
+				AddIfLoadingProcessor(TestComponent);
+			}
+		}
+	}
+
+	// Forget holds of processors that went away
+	for (auto It = LoadingProcessorHolds.CreateIterator(); It; ++It)
+	{
+		const UObject* HoldingObject = It.Value().Object.Get();
+		const bool bStillDiscovered = HoldingObject && DiscoveredLoadingProcessors.ContainsByPredicate([HoldingObject](const FDiscoveredLoadingProcessor& Discovered)
+		{
+			return Discovered.Object.Get() == HoldingObject;
+		});
+
+		if (!bStillDiscovered)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	// Event driven processors are asked once now, afterwards they notify us
+	for (const FDiscoveredLoadingProcessor& Discovered : DiscoveredLoadingProcessors)
+	{
+		if (Discovered.bEventDriven)
+		{
+			UpdateLoadingProcessorHold(Discovered.Object.Get());
+		}
+	}
+}
+
+bool ULoadingScreenManager::UpdateLoadingProcessorHold(UObject* Processor)
+{
+	const FObjectKey ProcessorKey(Processor);
+
+	FString Reason = TEXT("Reason for Showing/Hiding LoadingScreen is unknown!");
+	if (ILoadingProcessInterface::ShouldShowLoadingScreen(Processor, /*out*/ Reason))
+	{
+		FLoadingProcessorHold* Hold = LoadingProcessorHolds.Find(ProcessorKey);
+		if (Hold == nullptr)
+		{
+			Hold = &LoadingProcessorHolds.Add(ProcessorKey);
+			Hold->Object = Processor;
+			Hold->HoldStartTime = FPlatformTime::Seconds();
+		}
+
+		Hold->Reason = MoveTemp(Reason);
+		return true;
+	}
+
+	if (const FLoadingProcessorHold* Hold = LoadingProcessorHolds.Find(ProcessorKey))
+	{
+		UE_LOG(LogLoadingScreen, Verbose, TEXT("%s stopped holding the loading screen after %.2fs"), *GetPathNameSafe(Processor), FPlatformTime::Seconds() - Hold->HoldStartTime);
+		LoadingProcessorHolds.Remove(ProcessorKey);
+	}
+
+	return false;
+}
+
 bool ULoadingScreenManager::ShouldShowLoadingScreen()
 {
 	const UCommonLoadingScreenSettings* Settings = GetDefault<UCommonLoadingScreenSettings>();
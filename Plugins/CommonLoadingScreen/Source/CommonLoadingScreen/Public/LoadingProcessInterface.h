@@ -27,4 +27,14 @@ public:
 	{
 		return false;
 	}
+
+	// Return true if this object calls NotifyLoadingStateChanged whenever the result of ShouldShowLoadingScreen changes.
+	// Event driven processors are only asked when they are discovered or notify, everything else is polled every frame.
+	virtual bool IsLoadingStateEventDriven() const
+	{
+		return false;
+	}
+
+	// Tells the loading screen manager of the object's game instance that it needs to ask the object again
+	static void NotifyLoadingStateChanged(UObject* Processor);
 };
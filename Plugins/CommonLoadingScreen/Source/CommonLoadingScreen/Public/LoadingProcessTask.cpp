@@ -38,6 +38,11 @@ void ULoadingProcessTask::Unregister()
 void ULoadingProcessTask::SetShowLoadingScreenReason(const FString& InReason)
 {
 	Reason = InReason;
+
+	if (ULoadingScreenManager* LoadingScreenManager = Cast<ULoadingScreenManager>(GetOuter()))
+	{
+		LoadingScreenManager->NotifyLoadingProcessorStateChanged(this);
+	}
 }
 
 bool ULoadingProcessTask::ShouldShowLoadingScreen(FString& OutReason) const
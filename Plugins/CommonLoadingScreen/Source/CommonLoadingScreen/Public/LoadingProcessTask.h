@@ -28,6 +28,7 @@ public:
 	void SetShowLoadingScreenReason(const FString& InReason);
 
 	virtual bool ShouldShowLoadingScreen(FString& OutReason) const override;
+	virtual bool IsLoadingStateEventDriven() const override { return true; }
 	
 	FString Reason;
 };
@@ -10,6 +10,7 @@
 
 template <typename InterfaceType> class TScriptInterface;
 
+class AGameStateBase;
 class FSubsystemCollectionBase;
 class IInputProcessor;
 class ILoadingProcessInterface;
@@ -60,8 +61,30 @@ public:
 
 	void RegisterLoadingProcessor(TScriptInterface<ILoadingProcessInterface> Interface);
 	void UnregisterLoadingProcessor(TScriptInterface<ILoadingProcessInterface> Interface);
+
+	/** Called by event driven loading processors when the result of their ShouldShowLoadingScreen changed */
+	void NotifyLoadingProcessorStateChanged(TScriptInterface<ILoadingProcessInterface> Interface);
+
+	/** Returns which loading processors are currently holding the loading screen, and for how long */
+	UFUNCTION(BlueprintCallable, Category=LoadingScreen)
+	FString GetLoadingProcessorDebugReport() const;
 	
 private:
+	/** A loading processor found on the game state, a local player controller or registered externally */
+	struct FDiscoveredLoadingProcessor
+	{
+		TWeakObjectPtr<UObject> Object;
+		bool bEventDriven = false;
+	};
+
+	/** A loading processor that currently wants the loading screen to be shown */
+	struct FLoadingProcessorHold
+	{
+		TWeakObjectPtr<UObject> Object;
+		FString Reason;
+		double HoldStartTime = 0.0;
+	};
+
 	void HandlePreLoadMap(const FWorldContext& WorldContext, const FString& MapName);
 	void HandlePostLoadMap(UWorld* World);
 
@@ -71,6 +94,15 @@ private:
 	/** Returns true if we need to be showing the loading screen. */
 	bool CheckForAnyNeedToShowLoadingScreen();
 
+	/** Returns true if any loading processor wants the loading screen. Event driven ones are answered from their last notification. */
+	bool CheckLoadingProcessors(AGameStateBase* GameState);
+
+	/** Rebuilds the list of loading processors if the objects they are discovered from changed */
+	void RefreshLoadingProcessors(AGameStateBase* GameState);
+
+	/** Asks a single loading processor and updates its hold. Returns true if it wants the loading screen. */
+	bool UpdateLoadingProcessorHold(UObject* Processor);
+
 	/** Returns true if we want to be showing the loading screen (if we need to or are artificially forcing it on for other reasons). */
 	bool ShouldShowLoadingScreen();
 
@@ -107,6 +139,18 @@ private:
 	/** External loading processors, components maybe actors that delay the loading. */
 	TArray<TWeakInterfacePtr<ILoadingProcessInterface>> ExternalLoadingProcessors;
 
+	/** All loading processors, in the order they are asked */
+	TArray<FDiscoveredLoadingProcessor> DiscoveredLoadingProcessors;
+
+	/** Loading processors that currently want the loading screen */
+	TMap<FObjectKey, FLoadingProcessorHold> LoadingProcessorHolds;
+
+	/** Hash of the objects the loading processors were discovered from, used to detect when they need to be rediscovered */
+	uint32 LoadingProcessorDiscoveryHash = 0;
+
+	/** True when the loading processors have to be rediscovered */
+	bool bLoadingProcessorsDirty = true;
+
 	/** The reason why the loading screen is up (or not) */
 	FString DebugReasonForShowingOrHidingLoadingScreen;
 
@@ -6,10 +6,12 @@
 #include "Engine/AssetManager.h"
 #include "Engine/GameInstance.h"
 #include "Engine/LocalPlayer.h"
+#include "Engine/World.h"
 #include "GameFramework/PlayerController.h"
 #include "Interfaces/OnlineSessionDelegates.h"
 #include "Online/OnlineSessionNames.h"
 #include "OnlineSessionSettings.h"
+#include "TimerManager.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(CommonSessionSubsystem)
 
@@ -33,6 +35,51 @@ DEFINE_LOG_CATEGORY(LogCommonSession);
 
 #define LOCTEXT_NAMESPACE "CommonUser"
 
+namespace CommonSessionCVars
+{
+	static float QuickPlayMaxPingMs = 0.f;
+	static FAutoConsoleVariableRef CVarQuickPlayMaxPingMs(
+		TEXT("CommonSession.QuickPlay.MaxPingMs"),
+		QuickPlayMaxPingMs,
+		TEXT("Search results with a higher ping are never joined by quick play, 0 disables the limit."),
+		ECVF_Default);
+
+	static float QuickPlayPingWeight = 1.f;
+	static FAutoConsoleVariableRef CVarQuickPlayPingWeight(
+		TEXT("CommonSession.QuickPlay.PingWeight"),
+		QuickPlayPingWeight,
+		TEXT("Score subtracted per millisecond of ping when ranking quick play search results."),
+		ECVF_Default);
+
+	static float QuickPlayOpenSlotsWeight = 50.f;
+	static FAutoConsoleVariableRef CVarQuickPlayOpenSlotsWeight(
+		TEXT("CommonSession.QuickPlay.OpenSlotsWeight"),
+		QuickPlayOpenSlotsWeight,
+		TEXT("Score added for a completely empty session when ranking quick play search results, scaled by the fraction of open slots."),
+		ECVF_Default);
+
+	static float QuickPlayGameModeWeight = 200.f;
+	static FAutoConsoleVariableRef CVarQuickPlayGameModeWeight(
+		TEXT("CommonSession.QuickPlay.GameModeWeight"),
+		QuickPlayGameModeWeight,
+		TEXT("Score added when a quick play search result advertises the requested game mode."),
+		ECVF_Default);
+
+	static float QuickPlayMapWeight = 100.f;
+	static FAutoConsoleVariableRef CVarQuickPlayMapWeight(
+		TEXT("CommonSession.QuickPlay.MapWeight"),
+		QuickPlayMapWeight,
+		TEXT("Score added when a quick play search result advertises the requested map."),
+		ECVF_Default);
+
+	static float QuickPlayRegionWeight = 100.f;
+	static FAutoConsoleVariableRef CVarQuickPlayRegionWeight(
+		TEXT("CommonSession.QuickPlay.RegionWeight"),
+		QuickPlayRegionWeight,
+		TEXT("Score added when a quick play search result advertises the requested region."),
+		ECVF_Default);
+}
+
 //////////////////////////////////////////////////////////////////////
 //UCommonSession_SearchSessionRequest
 
@@ -531,6 +578,10 @@ void UCommonSessionSubsystem::CreateOnlineSessionInternalOSSv1(ULocalPlayer* Loc
 		HostSettings->bUseLobbiesIfAvailable = Request->bUseLobbies;
 		HostSettings->Set(SETTING_GAMEMODE, Request->ModeNameForAdvertisement, EOnlineDataAdvertisementType::ViaOnlineService);
 		HostSettings->Set(SETTING_MAPNAME, Request->GetMapName(), EOnlineDataAdvertisementType::ViaOnlineService);
+		if (!Request->RegionForAdvertisement.IsEmpty())
+		{
+			HostSettings->Set(SETTING_REGION, Request->RegionForAdvertisement, EOnlineDataAdvertisementType::ViaOnlineService);
+		}
 		//@TODO: HostSettings->Set(SETTING_MATCHING_HOPPER, FString("TeamDeathmatch"), EOnlineDataAdvertisementType::DontAdvertise);
 		HostSettings->Set(SETTING_MATCHING_TIMEOUT, 120.0f, EOnlineDataAdvertisementType::ViaOnlineService);
 		HostSettings->Set(SETTING_SESSION_TEMPLATE_NAME, FString(TEXT("GameSession")), EOnlineDataAdvertisementType::DontAdvertise);
@@ -584,6 +635,10 @@ void UCommonSessionSubsystem::CreateOnlineSessionInternalOSSv2(ULocalPlayer* Loc
 
 	CreateParams.Attributes.Emplace(SETTING_GAMEMODE, Request->ModeNameForAdvertisement);
 	CreateParams.Attributes.Emplace(SETTING_MAPNAME, Request->GetMapName());
+	if (!Request->RegionForAdvertisement.IsEmpty())
+	{
+		CreateParams.Attributes.Emplace(SETTING_REGION, Request->RegionForAdvertisement);
+	}
 	//@TODO: CreateParams.Attributes.Emplace(SETTING_MATCHING_HOPPER, FString("TeamDeathmatch"));
 	CreateParams.Attributes.Emplace(SETTING_MATCHING_TIMEOUT, 120.0f);
 	CreateParams.Attributes.Emplace(SETTING_SESSION_TEMPLATE_NAME, FString(TEXT("GameSession")));
@@ -828,6 +883,8 @@ void UCommonSessionSubsystem::QuickPlaySession(APlayerController* JoiningOrHosti
 		return;
 	}
 
+	ResetQuickPlay();
+
 	TStrongObjectPtr<UCommonSession_HostSessionRequest> HostRequestPtr = TStrongObjectPtr<UCommonSession_HostSessionRequest>(HostRequest);
 	TWeakObjectPtr<APlayerController> JoiningOrHostingPlayerPtr = TWeakObjectPtr<APlayerController>(JoiningOrHostingPlayer);
 
@@ -897,27 +954,360 @@ void UCommonSessionSubsystem::HandleQuickPlaySearchFinished(bool bSucceeded, con
 	//@TODO: We have to check if the error message is empty because some OSS layers report a failure just because there are no sessions.  Please fix with OSS 2.0.
 	if (bSucceeded || ErrorMessage.IsEmpty())
 	{
-		// Join the best search result.
-		if (ResultCount > 0)
+		// Join the best search result, or host if none of them is viable.
+		StartQuickPlayJoin(JoiningOrHostingPlayer.Get(), HostRequest.Get(), SearchSettings->SearchRequest->Results);
+	}
+	else
+	{
+		//@TODO: This sucks, need to tell someone.
+	}
+}
+
+bool UCommonSessionSubsystem::ScoreQuickPlayCandidate(const UCommonSession_SearchResult* SearchResult, const UCommonSession_HostSessionRequest* HostRequest, float& OutScore) const
+{
+	if (QuickPlayScoringOverride.IsBound())
+	{
+		return QuickPlayScoringOverride.Execute(SearchResult, HostRequest, OutScore);
+	}
+
+	const int32 NumOpenConnections = SearchResult->GetNumOpenPublicConnections();
+	if (NumOpenConnections <= 0)
+	{
+		return false;
+	}
+
+	const int32 PingInMs = SearchResult->GetPingInMs();
+#if COMMONUSER_OSSV1
+	if (PingInMs >= MAX_QUERY_PING)
+	{
+		return false;
+	}
+#endif // COMMONUSER_OSSV1
+	if (CommonSessionCVars::QuickPlayMaxPingMs > 0.f && PingInMs > CommonSessionCVars::QuickPlayMaxPingMs)
+	{
+		return false;
+	}
+
+	OutScore = -PingInMs * CommonSessionCVars::QuickPlayPingWeight;
+
+	const int32 MaxConnections = SearchResult->GetMaxPublicConnections();
+	if (MaxConnections > 0)
+	{
+		OutScore += CommonSessionCVars::QuickPlayOpenSlotsWeight * FMath::Min(NumOpenConnections, MaxConnections) / MaxConnections;
+	}
+
+	if (HostRequest == nullptr)
+	{
+		return true;
+	}
+
+	// Settings the request does not care about are not rated
+	auto MatchesSetting = [SearchResult](FName Key, const FString& Expected)
+	{
+		FString Value;
+		bool bFoundValue = false;
+		SearchResult->GetStringSetting(Key, Value, bFoundValue);
+		return bFoundValue && Value == Expected;
+	};
+
+	if (!HostRequest->ModeNameForAdvertisement.IsEmpty() && MatchesSetting(SETTING_GAMEMODE, HostRequest->ModeNameForAdvertisement))
+	{
+		OutScore += CommonSessionCVars::QuickPlayGameModeWeight;
+	}
+
+	const FString MapName = HostRequest->GetMapName();
+	if (!MapName.IsEmpty() && MatchesSetting(SETTING_MAPNAME, MapName))
+	{
+		OutScore += CommonSessionCVars::QuickPlayMapWeight;
+	}
+
+	if (!HostRequest->RegionForAdvertisement.IsEmpty() && MatchesSetting(SETTING_REGION, HostRequest->RegionForAdvertisement))
+	{
+		OutScore += CommonSessionCVars::QuickPlayRegionWeight;
+	}
+
+	return true;
+}
+
+void UCommonSessionSubsystem::StartQuickPlayJoin(APlayerController* JoiningOrHostingPlayer, UCommonSession_HostSessionRequest* HostRequest, const TArray<TObjectPtr<UCommonSession_SearchResult>>& Results)
+{
+	QuickPlayCandidates.Reset();
+	QuickPlayCandidateIndex = INDEX_NONE;
+	QuickPlayPlayer = JoiningOrHostingPlayer;
+	QuickPlayHostRequest = HostRequest;
+
+	TArray<TPair<float, UCommonSession_SearchResult*>> ScoredResults;
+	ScoredResults.Reserve(Results.Num());
+	for (UCommonSession_SearchResult* Result : Results)
+	{
+		float Score = 0.f;
+		if (Result && ScoreQuickPlayCandidate(Result, HostRequest, Score))
 		{
-			//@TODO: We should probably look at ping?  maybe some other factors to find the best.  Idk if they come pre-sorted or not.
-			for (UCommonSession_SearchResult* Result : SearchSettings->SearchRequest->Results)
-			{
-				JoinSession(JoiningOrHostingPlayer.Get(), Result);
-				return;
-			}
+			ScoredResults.Emplace(Score, Result);
 		}
 		else
 		{
-			HostSession(JoiningOrHostingPlayer.Get(), HostRequest.Get());
+			UE_LOG(LogCommonSession, Verbose, TEXT("\tIgnoring quick play result %s"), Result ? *Result->GetDescription() : TEXT("None"));
+		}
+	}
+
+	// Keep the order of the online system for equal scores
+	ScoredResults.StableSort([](const TPair<float, UCommonSession_SearchResult*>& A, const TPair<float, UCommonSession_SearchResult*>& B)
+	{
+		return A.Key > B.Key;
+	});
+
+	QuickPlayCandidates.Reserve(ScoredResults.Num());
+	for (const TPair<float, UCommonSession_SearchResult*>& ScoredResult : ScoredResults)
+	{
+		UE_LOG(LogCommonSession, Log, TEXT("\tQuickPlay candidate %d: %s (Score: %.1f, Ping: %d ms, NumOpenPubConns: %d)"),
+			QuickPlayCandidates.Num(),
+			*ScoredResult.Value->GetDescription(),
+			ScoredResult.Key,
+			ScoredResult.Value->GetPingInMs(),
+			ScoredResult.Value->GetNumOpenPublicConnections());
+
+		QuickPlayCandidates.Add(ScoredResult.Value);
+	}
+
+	if (JoinNextQuickPlayCandidate())
+	{
+		return;
+	}
+
+	UE_LOG(LogCommonSession, Log, TEXT("QuickPlay found no viable session out of %d results, hosting instead"), Results.Num());
+
+#if !UE_BUILD_SHIPPING
+	if (SimulatedQuickPlayJoinFailures != INDEX_NONE)
+	{
+		UE_LOG(LogCommonSession, Log, TEXT("Simulated quick play finished, would host %s"), HostRequest ? *HostRequest->GetMapName() : TEXT("None"));
+		ResetQuickPlay();
+		return;
+	}
+#endif
+
+	ResetQuickPlay();
+
+	HostSession(JoiningOrHostingPlayer, HostRequest);
+}
+
+bool UCommonSessionSubsystem::JoinNextQuickPlayCandidate()
+{
+	if (QuickPlayCandidateIndex + 1 >= QuickPlayCandidates.Num())
+	{
+		return false;
+	}
+
+	++QuickPlayCandidateIndex;
+	UCommonSession_SearchResult* Candidate = QuickPlayCandidates[QuickPlayCandidateIndex];
+	UE_LOG(LogCommonSession, Log, TEXT("QuickPlay joining candidate %d of %d (%s)"), QuickPlayCandidateIndex + 1, QuickPlayCandidates.Num(), *Candidate->GetDescription());
+
+#if !UE_BUILD_SHIPPING
+	if (SimulatedQuickPlayJoinFailures != INDEX_NONE)
+	{
+		SimulatedQuickPlayJoinAttempts.Add(Candidate);
+		bSimulatedQuickPlayJoinPending = true;
+
+		// Complete the simulated join on the next tick, like a real join would complete asynchronously
+		if (UGameInstance* GameInstance = GetGameInstance())
+		{
+			GameInstance->GetTimerManager().SetTimerForNextTick(FTimerDelegate::CreateWeakLambda(this, [this, Candidate]()
+			{
+				if (QuickPlayCandidates.IsValidIndex(QuickPlayCandidateIndex) && QuickPlayCandidates[QuickPlayCandidateIndex] == Candidate)
+				{
+					CompleteSimulatedQuickPlayJoin();
+				}
+			}));
+		}
+		return true;
+	}
+#endif
+
+	APlayerController* JoiningPlayer = QuickPlayPlayer.Get();
+	ULocalPlayer* LocalPlayer = (JoiningPlayer != nullptr) ? JoiningPlayer->GetLocalPlayer() : nullptr;
+	if (LocalPlayer == nullptr)
+	{
+		UE_LOG(LogCommonSession, Error, TEXT("JoiningPlayer is invalid"));
+		return false;
+	}
+
+	JoinSessionInternal(LocalPlayer, Candidate);
+	return true;
+}
+
+bool UCommonSessionSubsystem::RetryQuickPlayJoin(const FText& FailureReason)
+{
+	if (!QuickPlayCandidates.IsValidIndex(QuickPlayCandidateIndex))
+	{
+		return false;
+	}
+
+	UE_LOG(LogCommonSession, Warning, TEXT("QuickPlay failed to join candidate %d of %d (%s)"), QuickPlayCandidateIndex + 1, QuickPlayCandidates.Num(), *FailureReason.ToString());
+
+	// Try the next best result of the same search instead of searching again
+	if (JoinNextQuickPlayCandidate())
+	{
+		return true;
+	}
+
+	ResetQuickPlay();
+	return false;
+}
+
+void UCommonSessionSubsystem::ResetQuickPlay()
+{
+	QuickPlayCandidates.Reset();
+	QuickPlayCandidateIndex = INDEX_NONE;
+	QuickPlayPlayer.Reset();
+	QuickPlayHostRequest = nullptr;
+
+#if !UE_BUILD_SHIPPING
+	SimulatedQuickPlayJoinFailures = INDEX_NONE;
+	bSimulatedQuickPlayJoinPending = false;
+#endif
+}
+
+#if !UE_BUILD_SHIPPING
+void UCommonSessionSubsystem::SimulateQuickPlay(UCommonSession_HostSessionRequest* HostRequest, int32 NumResults, int32 NumJoinFailures)
+{
+	if (HostRequest == nullptr)
+	{
+		UE_LOG(LogCommonSession, Error, TEXT("SimulateQuickPlay passed a null request"));
+		return;
+	}
+
+	static const TCHAR* Regions[] = { TEXT("NA"), TEXT("EU"), TEXT("ASIA") };
+	const FString OtherMode(TEXT("SimulatedOtherMode"));
+
+	// Seeded so the same arguments always produce the same result set
+	FRandomStream Random(NumResults);
+	TArray<TObjectPtr<UCommonSession_SearchResult>> Results;
+	Results.Reserve(NumResults);
+
+	for (int32 ResultIdx = 0; ResultIdx < NumResults; ResultIdx++)
+	{
+		const int32 MaxPlayers = HostRequest->GetMaxPlayers();
+		const int32 NumOpenConnections = Random.RandRange(0, MaxPlayers);
+		const FString& GameMode = Random.FRand() < 0.5f ? HostRequest->ModeNameForAdvertisement : OtherMode;
+		const FString MapName = Random.FRand() < 0.5f ? HostRequest->GetMapName() : FString();
+		const FString Region = Regions[Random.RandHelper((int32)UE_ARRAY_COUNT(Regions))];
+#if COMMONUSER_OSSV1
+		const int32 PingInMs = Random.FRand() < 0.1f ? MAX_QUERY_PING : Random.RandRange(10, 300);
+#else
+		const int32 PingInMs = 0;
+#endif // COMMONUSER_OSSV1
+
+		Results.Add(CreateSimulatedSearchResult(this, FString::Printf(TEXT("Simulated User %d"), ResultIdx), PingInMs, NumOpenConnections, MaxPlayers, GameMode, MapName, Region));
+	}
+
+	SimulateQuickPlayWithResults(HostRequest, Results, NumJoinFailures);
+}
+
+void UCommonSessionSubsystem::SimulateQuickPlayWithResults(UCommonSession_HostSessionRequest* HostRequest, const TArray<TObjectPtr<UCommonSession_SearchResult>>& Results, int32 NumJoinFailures)
+{
+	if (HostRequest == nullptr)
+	{
+		UE_LOG(LogCommonSession, Error, TEXT("SimulateQuickPlayWithResults passed a null request"));
+		return;
+	}
+
+	ResetQuickPlay();
+	SimulatedQuickPlayJoinAttempts.Reset();
+	SimulatedQuickPlayJoinFailures = FMath::Max(NumJoinFailures, 0);
+
+	UE_LOG(LogCommonSession, Log, TEXT("Simulating quick play with %d results and %d join failures"), Results.Num(), SimulatedQuickPlayJoinFailures);
+
+	const UGameInstance* GameInstance = GetGameInstance();
+	StartQuickPlayJoin(GameInstance ? GameInstance->GetFirstLocalPlayerController() : nullptr, HostRequest, Results);
+}
+
+bool UCommonSessionSubsystem::CompleteSimulatedQuickPlayJoin()
+{
+	if (!bSimulatedQuickPlayJoinPending || !QuickPlayCandidates.IsValidIndex(QuickPlayCandidateIndex))
+	{
+		return false;
+	}
+
+	bSimulatedQuickPlayJoinPending = false;
+
+	if (SimulatedQuickPlayJoinFailures > 0)
+	{
+		--SimulatedQuickPlayJoinFailures;
+
+		const FText FailureReason = LOCTEXT("Error_SimulatedJoinFailure", "Simulated join failure");
+		if (!RetryQuickPlayJoin(FailureReason))
+		{
+			UE_LOG(LogCommonSession, Log, TEXT("Simulated quick play finished, every candidate failed to join"));
+
+			FOnlineResultInformation JoinSessionResult;
+			JoinSessionResult.bWasSuccessful = false;
+			JoinSessionResult.ErrorId = TEXT("SimulatedJoinFailure");
+			JoinSessionResult.ErrorText = FailureReason;
+			NotifyJoinSessionComplete(JoinSessionResult);
 		}
 	}
 	else
 	{
-		//@TODO: This sucks, need to tell someone.
+		UE_LOG(LogCommonSession, Log, TEXT("Simulated quick play finished, joined candidate %d (%s)"), QuickPlayCandidateIndex + 1, *QuickPlayCandidates[QuickPlayCandidateIndex]->GetDescription());
+		ResetQuickPlay();
+
+		FOnlineResultInformation JoinSessionResult;
+		JoinSessionResult.bWasSuccessful = true;
+		NotifyJoinSessionComplete(JoinSessionResult);
 	}
+
+	return true;
 }
 
+UCommonSession_SearchResult* UCommonSessionSubsystem::CreateSimulatedSearchResult(UObject* Outer, const FString& OwnerName, int32 PingInMs, int32 NumOpenConnections, int32 MaxConnections, const FString& GameMode, const FString& MapName, const FString& Region)
+{
+	UCommonSession_SearchResult* Entry = NewObject<UCommonSession_SearchResult>(Outer);
+#if COMMONUSER_OSSV1
+	FOnlineSessionSearchResult& FakeResult = Entry->Result;
+	FakeResult.Session.OwningUserName = OwnerName;
+	FakeResult.Session.NumOpenPublicConnections = NumOpenConnections;
+	FakeResult.Session.SessionSettings.NumPublicConnections = MaxConnections;
+	FakeResult.Session.SessionSettings.bShouldAdvertise = true;
+	FakeResult.Session.SessionSettings.bAllowJoinInProgress = true;
+	FakeResult.Session.SessionSettings.Set(SETTING_GAMEMODE, GameMode, EOnlineDataAdvertisementType::ViaOnlineService);
+	FakeResult.Session.SessionSettings.Set(SETTING_MAPNAME, MapName, EOnlineDataAdvertisementType::ViaOnlineService);
+	FakeResult.Session.SessionSettings.Set(SETTING_REGION, Region, EOnlineDataAdvertisementType::ViaOnlineService);
+	FakeResult.PingInMs = PingInMs;
+#else
+	TSharedRef<FLobby> FakeLobby = MakeShared<FLobby>();
+	FakeLobby->MaxMembers = NumOpenConnections;
+	FakeLobby->Attributes.Emplace(SETTING_GAMEMODE, GameMode);
+	FakeLobby->Attributes.Emplace(SETTING_MAPNAME, MapName);
+	FakeLobby->Attributes.Emplace(SETTING_REGION, Region);
+	Entry->Lobby = FakeLobby;
+#endif // COMMONUSER_OSSV1
+
+	return Entry;
+}
+
+static FAutoConsoleCommandWithWorldAndArgs SimulateQuickPlayCommand(
+	TEXT("CommonSession.QuickPlay.Simulate"),
+	TEXT("Runs quick play against fabricated search results without using the online subsystem. Usage: CommonSession.QuickPlay.Simulate [NumResults=8] [NumJoinFailures=2] [Mode] [Region]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+		UCommonSessionSubsystem* SessionSubsystem = GameInstance ? GameInstance->GetSubsystem<UCommonSessionSubsystem>() : nullptr;
+		if (SessionSubsystem == nullptr)
+		{
+			UE_LOG(LogCommonSession, Error, TEXT("CommonSession.QuickPlay.Simulate requires a game instance with a session subsystem"));
+			return;
+		}
+
+		UCommonSession_HostSessionRequest* HostRequest = SessionSubsystem->CreateOnlineHostSessionRequest();
+		HostRequest->ModeNameForAdvertisement = Args.IsValidIndex(2) ? Args[2] : TEXT("SimulatedMode");
+		HostRequest->RegionForAdvertisement = Args.IsValidIndex(3) ? Args[3] : TEXT("EU");
+
+		const int32 NumResults = Args.IsValidIndex(0) ? FCString::Atoi(*Args[0]) : 8;
+		const int32 NumJoinFailures = Args.IsValidIndex(1) ? FCString::Atoi(*Args[1]) : 2;
+		SessionSubsystem->SimulateQuickPlay(HostRequest, NumResults, NumJoinFailures);
+	}));
+#endif // !UE_BUILD_SHIPPING
+
 void UCommonSessionSubsystem::CleanUpSessions()
 {
 	bWantToDestroyPendingSession = true;
@@ -1065,6 +1455,9 @@ void UCommonSessionSubsystem::JoinSession(APlayerController* JoiningPlayer, UCom
 		return;
 	}
 
+	// An explicit join replaces any quick play that is still trying candidates
+	ResetQuickPlay();
+
 	ULocalPlayer* LocalPlayer = (JoiningPlayer != nullptr) ? JoiningPlayer->GetLocalPlayer() : nullptr;
 	if (LocalPlayer == nullptr)
 	{
@@ -1123,6 +1516,8 @@ void UCommonSessionSubsystem::FinishJoinSession(EOnJoinSessionCompleteResult::Ty
 {
 	if (Result == EOnJoinSessionCompleteResult::Success)
 	{
+		ResetQuickPlay();
+
 		//@TODO Synchronize timing of this with create callbacks, modify both places and the comments if plan changes
 		FOnlineResultInformation JoinSessionResult;
 		JoinSessionResult.bWasSuccessful = true;
@@ -1146,6 +1541,12 @@ void UCommonSessionSubsystem::FinishJoinSession(EOnJoinSessionCompleteResult::Ty
 			break;
 		}
 
+		// Quick play tries the next best session before reporting a failure
+		if (Result != EOnJoinSessionCompleteResult::AlreadyInSession && RetryQuickPlayJoin(ReturnReason))
+		{
+			return;
+		}
+
 		//@TODO: Error handling
 		UE_LOG(LogCommonSession, Error, TEXT("FinishJoinSession(Failed with Result: %s)"), *ReturnReason.ToString());
 
@@ -1180,10 +1581,17 @@ void UCommonSessionSubsystem::JoinSessionInternalOSSv2(ULocalPlayer* LocalPlayer
 	{
 		if (JoinResult.IsOk())
 		{
+			ResetQuickPlay();
 			InternalTravelToSession(SessionName);
 		}
 		else
 		{
+			// Quick play tries the next best lobby before giving up
+			if (RetryQuickPlayJoin(JoinResult.GetErrorValue().GetText()))
+			{
+				return;
+			}
+
 			//@TODO: Error handling
 			UE_LOG(LogCommonSession, Error, TEXT("JoinLobby Failed with Result: %s"), *ToLogString(JoinResult.GetErrorValue()));
 		}
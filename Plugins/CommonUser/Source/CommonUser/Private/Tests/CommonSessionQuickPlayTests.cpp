@@ -0,0 +1,125 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CommonSessionSubsystem.h"
+#include "CommonUserTypes.h"
+#include "Engine/GameInstance.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && !UE_BUILD_SHIPPING
+
+namespace CommonSessionQuickPlayTests
+{
+	/** Runs simulated quick play against a fixed result set and records the joins and the completion events */
+	struct FQuickPlayFixture
+	{
+		FQuickPlayFixture()
+			: GameInstance(NewObject<UGameInstance>(GetTransientPackage()))
+			, Subsystem(NewObject<UCommonSessionSubsystem>(GameInstance.Get()))
+			, HostRequest(NewObject<UCommonSession_HostSessionRequest>(GetTransientPackage()))
+		{
+			HostRequest->ModeNameForAdvertisement = TEXT("TestMode");
+			HostRequest->RegionForAdvertisement = TEXT("EU");
+
+			UCommonSessionSubsystem* Outer = Subsystem.Get();
+			Full = UCommonSessionSubsystem::CreateSimulatedSearchResult(Outer, TEXT("Full"), 1, 0, 8, TEXT("TestMode"), FString(), TEXT("EU"));
+			ModeAndRegion = UCommonSessionSubsystem::CreateSimulatedSearchResult(Outer, TEXT("ModeAndRegion"), 120, 4, 8, TEXT("TestMode"), FString(), TEXT("EU"));
+			ModeOnly = UCommonSessionSubsystem::CreateSimulatedSearchResult(Outer, TEXT("ModeOnly"), 30, 4, 8, TEXT("TestMode"), FString(), TEXT("NA"));
+			RegionOnly = UCommonSessionSubsystem::CreateSimulatedSearchResult(Outer, TEXT("RegionOnly"), 10, 4, 8, TEXT("OtherMode"), FString(), TEXT("EU"));
+			Nothing = UCommonSessionSubsystem::CreateSimulatedSearchResult(Outer, TEXT("Nothing"), 5, 4, 8, TEXT("OtherMode"), FString(), TEXT("NA"));
+
+			// Listed worst first, so the ranking has to reorder them
+			Results = { Nothing, Full, RegionOnly, ModeOnly, ModeAndRegion };
+			ExpectedOrder = { ModeAndRegion, ModeOnly, RegionOnly, Nothing };
+
+#if COMMONUSER_OSSV1
+			Results.Insert(UCommonSessionSubsystem::CreateSimulatedSearchResult(Outer, TEXT("Unreachable"), MAX_QUERY_PING, 8, 8, TEXT("TestMode"), FString(), TEXT("EU")), 0);
+#endif // COMMONUSER_OSSV1
+
+			Subsystem->OnJoinSessionCompleteEvent.AddLambda([this](const FOnlineResultInformation& Result)
+			{
+				JoinResults.Add(Result);
+			});
+		}
+
+		/** Runs quick play until no simulated join is pending, completing every join right away */
+		void Run(int32 NumJoinFailures)
+		{
+			JoinResults.Reset();
+			Subsystem->SimulateQuickPlayWithResults(HostRequest.Get(), Results, NumJoinFailures);
+			while (Subsystem->CompleteSimulatedQuickPlayJoin())
+			{
+			}
+		}
+
+		TStrongObjectPtr<UGameInstance> GameInstance;
+		TStrongObjectPtr<UCommonSessionSubsystem> Subsystem;
+		TStrongObjectPtr<UCommonSession_HostSessionRequest> HostRequest;
+
+		UCommonSession_SearchResult* Full = nullptr;
+		UCommonSession_SearchResult* ModeAndRegion = nullptr;
+		UCommonSession_SearchResult* ModeOnly = nullptr;
+		UCommonSession_SearchResult* RegionOnly = nullptr;
+		UCommonSession_SearchResult* Nothing = nullptr;
+
+		TArray<TObjectPtr<UCommonSession_SearchResult>> Results;
+		TArray<UCommonSession_SearchResult*> ExpectedOrder;
+		TArray<FOnlineResultInformation> JoinResults;
+	};
+
+	/** Compares the joined candidates against the first NumExpected entries of the expected order */
+	bool TestJoinAttempts(FAutomationTestBase& Test, const FQuickPlayFixture& Fixture, int32 NumExpected)
+	{
+		const TArray<TWeakObjectPtr<UCommonSession_SearchResult>>& Attempts = Fixture.Subsystem->GetSimulatedQuickPlayJoinAttempts();
+		if (!Test.TestEqual(TEXT("Number of join attempts"), Attempts.Num(), NumExpected))
+		{
+			return false;
+		}
+
+		for (int32 AttemptIdx = 0; AttemptIdx < NumExpected; AttemptIdx++)
+		{
+			const UCommonSession_SearchResult* Attempt = Attempts[AttemptIdx].Get();
+			const UCommonSession_SearchResult* Expected = Fixture.ExpectedOrder[AttemptIdx];
+			if (Attempt != Expected)
+			{
+				Test.AddError(FString::Printf(TEXT("Join attempt %d went to %s instead of %s."), AttemptIdx + 1, Attempt ? *Attempt->GetDescription() : TEXT("None"), *Expected->GetDescription()));
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCommonSessionQuickPlayRetryTest, "CommonUser.Session.QuickPlay.RankingAndRetry", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FCommonSessionQuickPlayRetryTest::RunTest(const FString& Parameters)
+{
+	using namespace CommonSessionQuickPlayTests;
+
+	// Relies on the default scoring weights, a match on mode outweighs a match on region and both outweigh the ping
+	FQuickPlayFixture Fixture;
+
+	// Fails the two best candidates, then joins the third
+	Fixture.Run(2);
+	TestJoinAttempts(*this, Fixture, 3);
+	if (TestEqual(TEXT("Join completions after two failures"), Fixture.JoinResults.Num(), 1))
+	{
+		TestTrue(TEXT("Third candidate joined"), Fixture.JoinResults[0].bWasSuccessful);
+	}
+
+	// Fails every viable candidate, full and unreachable results are never tried
+	Fixture.Run(10);
+	TestJoinAttempts(*this, Fixture, Fixture.ExpectedOrder.Num());
+	if (TestEqual(TEXT("Join completions after every candidate failed"), Fixture.JoinResults.Num(), 1))
+	{
+		TestFalse(TEXT("Quick play reported the failure"), Fixture.JoinResults[0].bWasSuccessful);
+	}
+
+	TestFalse(TEXT("No join pending after quick play finished"), Fixture.Subsystem->CompleteSimulatedQuickPlayJoin());
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS && !UE_BUILD_SHIPPING
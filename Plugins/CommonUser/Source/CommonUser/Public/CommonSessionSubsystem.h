@@ -67,6 +67,10 @@ public:
 	UPROPERTY(BlueprintReadWrite, Category=Session)
 	FString ModeNameForAdvertisement;
 
+	/** Region advertised when hosting and preferred by quick play when ranking search results, ignored if empty */
+	UPROPERTY(BlueprintReadWrite, Category=Session)
+	FString RegionForAdvertisement;
+
 	/** The map that will be loaded at the start of gameplay, this needs to be a valid Primary Asset top-level map */
 	UPROPERTY(BlueprintReadWrite, Category=Session, meta=(AllowedTypes="World"))
 	FPrimaryAssetId MapID;
@@ -217,6 +221,15 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FCommonSessionOnCreateSessionComplet
  */
 DECLARE_MULTICAST_DELEGATE_OneParam(FCommonSessionOnPreClientTravel, FString& /*URL*/);
 
+/**
+ * Delegate used to score a quick play search result, replacing the default scoring when bound.
+ * @param SearchResult the search result to score
+ * @param HostRequest the quick play request the search was started with
+ * @param OutScore the score of the result, higher scores are joined first
+ * @return false if the result should not be joined at all
+ */
+DECLARE_DELEGATE_RetVal_ThreeParams(bool, FCommonSessionScoreQuickPlayCandidate, const UCommonSession_SearchResult* /*SearchResult*/, const UCommonSession_HostSessionRequest* /*HostRequest*/, float& /*OutScore*/);
+
 //////////////////////////////////////////////////////////////////////
 // UCommonSessionSubsystem
 
@@ -289,6 +302,32 @@ public:
 	/** Native Delegate for modifying the connect URL prior to a client travel */
 	FCommonSessionOnPreClientTravel OnPreClientTravelEvent;
 
+	/** Native Delegate that replaces the default quick play scoring when bound */
+	FCommonSessionScoreQuickPlayCandidate QuickPlayScoringOverride;
+
+#if !UE_BUILD_SHIPPING
+	/**
+	 * Runs quick play against a fabricated set of search results instead of the online subsystem.
+	 * Joins are not sent to the online subsystem either, the first NumJoinFailures attempts fail and the next one succeeds.
+	 */
+	void SimulateQuickPlay(UCommonSession_HostSessionRequest* HostRequest, int32 NumResults, int32 NumJoinFailures);
+
+	/** Runs quick play against the given search results, see SimulateQuickPlay */
+	void SimulateQuickPlayWithResults(UCommonSession_HostSessionRequest* HostRequest, const TArray<TObjectPtr<UCommonSession_SearchResult>>& Results, int32 NumJoinFailures);
+
+	/** Completes the pending simulated join right away instead of on the next tick, returns false if no simulated join is pending */
+	bool CompleteSimulatedQuickPlayJoin();
+
+	/** Returns the candidates the last simulated quick play tried to join, in order */
+	const TArray<TWeakObjectPtr<UCommonSession_SearchResult>>& GetSimulatedQuickPlayJoinAttempts() const { return SimulatedQuickPlayJoinAttempts; }
+
+	/**
+	 * Fabricates a search result for simulated quick play.
+	 * Lobbies have no ping and their members can not be fabricated, so without OSSv1 the ping is ignored and every lobby with open slots rates as empty.
+	 */
+	static UCommonSession_SearchResult* CreateSimulatedSearchResult(UObject* Outer, const FString& OwnerName, int32 PingInMs, int32 NumOpenConnections, int32 MaxConnections, const FString& GameMode, const FString& MapName, const FString& Region);
+#endif
+
 protected:
 	// Functions called during the process of creating or joining a session, these can be overidden for game-specific behavior
 
@@ -298,6 +337,13 @@ protected:
 	/** Called when a quick play search finishes, can be overridden for game-specific behavior */
 	virtual void HandleQuickPlaySearchFinished(bool bSucceeded, const FText& ErrorMessage, TWeakObjectPtr<APlayerController> JoiningOrHostingPlayer, TStrongObjectPtr<UCommonSession_HostSessionRequest> HostRequest);
 
+	/**
+	 * Called to score a quick play search result, higher scores are joined first.
+	 * By default this uses QuickPlayScoringOverride if bound, otherwise it rates ping, open slots, game mode, map and region.
+	 * @return false if the result should not be joined at all
+	 */
+	virtual bool ScoreQuickPlayCandidate(const UCommonSession_SearchResult* SearchResult, const UCommonSession_HostSessionRequest* HostRequest, float& OutScore) const;
+
 	/** Called when traveling to a session fails */
 	virtual void TravelLocalSessionFailure(UWorld* World, ETravelFailure::Type FailureType, const FString& ReasonString);
 
@@ -323,6 +369,18 @@ protected:
 	void NotifyCreateSessionComplete(const FOnlineResultInformation& Result);
 	void SetCreateSessionError(const FText& ErrorText);
 
+	/** Ranks the search results into the quick play candidates and joins the best one, hosts if none is viable */
+	void StartQuickPlayJoin(APlayerController* JoiningOrHostingPlayer, UCommonSession_HostSessionRequest* HostRequest, const TArray<TObjectPtr<UCommonSession_SearchResult>>& Results);
+
+	/** Tries to join the next quick play candidate, returns false if there are none left */
+	bool JoinNextQuickPlayCandidate();
+
+	/** Called when a join failed, returns true if the next quick play candidate is being joined instead */
+	bool RetryQuickPlayJoin(const FText& FailureReason);
+
+	/** Forgets the quick play candidates, called once quick play completed or a different join was requested */
+	void ResetQuickPlay();
+
 #if COMMONUSER_OSSV1
 	void BindOnlineDelegatesOSSv1();
 	void CreateOnlineSessionInternalOSSv1(ULocalPlayer* LocalPlayer, UCommonSession_HostSessionRequest* Request);
@@ -380,4 +438,28 @@ protected:
 
 	/** Settings for the current host request */
 	TSharedPtr<FCommonSession_OnlineSessionSettings> HostSettings;
+
+	/** Remaining quick play search results ordered by score, the next one is joined if the current join fails */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UCommonSession_SearchResult>> QuickPlayCandidates;
+
+	/** Index of the quick play candidate that is currently being joined */
+	int32 QuickPlayCandidateIndex = INDEX_NONE;
+
+	/** Player and request of the running quick play, used when joining further candidates */
+	TWeakObjectPtr<APlayerController> QuickPlayPlayer;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UCommonSession_HostSessionRequest> QuickPlayHostRequest;
+
+#if !UE_BUILD_SHIPPING
+	/** Number of simulated join failures left, INDEX_NONE if quick play is not simulated */
+	int32 SimulatedQuickPlayJoinFailures = INDEX_NONE;
+
+	/** True while a simulated join waits to be completed */
+	bool bSimulatedQuickPlayJoinPending = false;
+
+	/** Candidates the last simulated quick play tried to join, in order */
+	TArray<TWeakObjectPtr<UCommonSession_SearchResult>> SimulatedQuickPlayJoinAttempts;
+#endif
 };
@@ -0,0 +1,121 @@
+/* Copyright (C) 2024 Hugo ATTAL - All Rights Reserved
+* This plugin is downloadable from the Unreal Engine Marketplace
+*/
+
+#include "ElectronicNodes.h"
+#include "ENConnectionDrawingPolicy.h"
+#include "ENPathDrawer.h"
+#include "EdGraphSchema_K2.h"
+#include "HAL/IConsoleManager.h"
+#include "../Public/ElectronicNodesSettings.h"
+
+// Manual profiling tool, the timings are read from the log and nothing is asserted.
+namespace ENBenchmark
+{
+	struct FWire
+	{
+		FVector2D Start;
+		FVector2D End;
+	};
+
+	/** Lays out a graph of columns of nodes, each wire links an output pin to an input pin one to three columns further */
+	static void BuildWires(int32 NumWires, TArray<FWire>& OutWires)
+	{
+		constexpr float ColumnWidth = 400.0f;
+		constexpr float NodeWidth = 220.0f;
+		constexpr float PinSpacing = 24.0f;
+		constexpr int32 NumColumns = 40;
+		constexpr int32 NumRows = 200;
+
+		FRandomStream RandomStream(1337);
+
+		OutWires.Reset(NumWires);
+		for (int32 i = 0; i < NumWires; i++)
+		{
+			const int32 Column = RandomStream.RandRange(0, NumColumns - 4);
+			const int32 TargetColumn = Column + RandomStream.RandRange(1, 3);
+
+			FWire& Wire = OutWires.AddDefaulted_GetRef();
+			Wire.Start = FVector2D(Column * ColumnWidth + NodeWidth, RandomStream.RandRange(0, NumRows) * PinSpacing);
+			Wire.End = FVector2D(TargetColumn * ColumnWidth, RandomStream.RandRange(0, NumRows) * PinSpacing);
+
+			// Some wires loop back to an earlier column
+			if (RandomStream.FRand() < 0.1f)
+			{
+				Swap(Wire.Start.X, Wire.End.X);
+			}
+		}
+	}
+
+	/** Draws every wire with a new drawing policy, as a graph panel repaint does, and returns the time it took in milliseconds */
+	static double DrawWires(UEdGraph* Graph, const TArray<FWire>& Wires, const FVector2D& PanOffset, float ZoomFactor, int32& OutNumRibbons)
+	{
+		FSlateWindowElementList DrawElements(nullptr);
+		const FSlateRect ClippingRect(-100000.0f, -100000.0f, 100000.0f, 100000.0f);
+
+		FENConnectionDrawingPolicy ConnectionDrawingPolicy(0, 1, ZoomFactor, ClippingRect, DrawElements, Graph);
+
+		FConnectionParams Params;
+		Params.WireColor = FLinearColor::White;
+		Params.WireThickness = 1.5f;
+		Params.StartDirection = EGPD_Output;
+		Params.EndDirection = EGPD_Input;
+
+		const double StartTime = FPlatformTime::Seconds();
+
+		for (const FWire& Wire : Wires)
+		{
+			ConnectionDrawingPolicy.DrawConnection(0, (Wire.Start + PanOffset) * ZoomFactor, (Wire.End + PanOffset) * ZoomFactor, Params);
+		}
+
+		const double Time = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+		OutNumRibbons = ConnectionDrawingPolicy.GetNumRibbonConnections();
+		return Time;
+	}
+
+	static void Run(const TArray<FString>& Args)
+	{
+		const int32 NumWires = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 5000;
+		const EWireStyle WireStyle = (Args.Num() > 1 && Args[1] == TEXT("Subway")) ? EWireStyle::Subway : EWireStyle::Manhattan;
+
+		UElectronicNodesSettings* ElectronicNodesSettings = GetMutableDefault<UElectronicNodesSettings>();
+		const EWireStyle PreviousWireStyle = ElectronicNodesSettings->WireStyle;
+		const bool PreviousActivateRibbon = ElectronicNodesSettings->ActivateRibbon;
+		const bool PreviousDebug = ElectronicNodesSettings->Debug;
+		ElectronicNodesSettings->WireStyle = WireStyle;
+		ElectronicNodesSettings->ActivateRibbon = true;
+		ElectronicNodesSettings->Debug = false;
+
+		UEdGraph* Graph = NewObject<UEdGraph>(GetTransientPackage());
+		Graph->Schema = UEdGraphSchema_K2::StaticClass();
+
+		TArray<FWire> Wires;
+		BuildWires(NumWires, Wires);
+
+		FENPathDrawer::ResetPathCache();
+
+		int32 NumRibbons = 0;
+		const double ColdTime = DrawWires(Graph, Wires, FVector2D::ZeroVector, 1.0f, NumRibbons);
+		const int32 NumCachedPaths = FENPathDrawer::GetPathCacheNum();
+		const double WarmTime = DrawWires(Graph, Wires, FVector2D::ZeroVector, 1.0f, NumRibbons);
+		const double PannedTime = DrawWires(Graph, Wires, FVector2D(137.5f, -71.25f), 1.0f, NumRibbons);
+		const double ZoomedTime = DrawWires(Graph, Wires, FVector2D::ZeroVector, 0.75f, NumRibbons);
+
+		UE_LOG(LogElectronicNodes, Log, TEXT("[EN] Benchmark: %d %s wires, %d ribbons, %d cached paths"),
+		       NumWires, WireStyle == EWireStyle::Subway ? TEXT("Subway") : TEXT("Manhattan"), NumRibbons, NumCachedPaths);
+		UE_LOG(LogElectronicNodes, Log, TEXT("[EN] Benchmark: cold %.2f ms, warm %.2f ms, panned %.2f ms, new zoom %.2f ms"),
+		       ColdTime, WarmTime, PannedTime, ZoomedTime);
+
+		ElectronicNodesSettings->WireStyle = PreviousWireStyle;
+		ElectronicNodesSettings->ActivateRibbon = PreviousActivateRibbon;
+		ElectronicNodesSettings->Debug = PreviousDebug;
+
+		Graph->MarkAsGarbage();
+	}
+
+	static FAutoConsoleCommand BenchmarkCommand(
+		TEXT("ElectronicNodes.Benchmark"),
+		TEXT("Draws a synthetic graph without a window and logs the wire layout time. Usage: ElectronicNodes.Benchmark [NumWires=5000] [Manhattan|Subway]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&Run));
+}
@@ -249,10 +249,8 @@ void FENConnectionDrawingPolicy::ENDrawMainWire(FENPathDrawer* PathDrawer, EWire
 	switch (WireStyle)
 	{
 	case EWireStyle::Manhattan:
-		PathDrawer->DrawManhattanWire(Start, StartDirection, End, EndDirection);
-		break;
 	case EWireStyle::Subway:
-		PathDrawer->DrawSubwayWire(Start, StartDirection, End, EndDirection);
+		PathDrawer->DrawCachedWire(WireStyle, Start, StartDirection, End, EndDirection);
 		break;
 	default:
 		PathDrawer->DrawDefaultWire(Start, StartDirection, End, EndDirection);
@@ -279,8 +277,15 @@ void FENConnectionDrawingPolicy::ENProcessRibbon(int32 LayerId, FVector2D& Start
 
 	if (ElectronicNodesSettings.ActivateRibbon && !IsTree)
 	{
-		for (ENRibbonConnection RibbonConnection : RibbonConnections)
+		TArray<int32, TInlineAllocator<16>> RibbonIndices;
+
+		// The depth depends on the order the connections were drawn in, visit the candidates in that order
+		HorizontalRibbons.Query(Start.Y, FMath::Min(Start.X, End.X), FMath::Max(Start.X, End.X), RibbonIndices);
+		RibbonIndices.Sort();
+
+		for (const int32 RibbonIndex : RibbonIndices)
 		{
+			const ENRibbonConnection& RibbonConnection = RibbonConnections[RibbonIndex];
 			if (RibbonConnection.Horizontal)
 			{
 				if (FMath::Abs(Start.Y - RibbonConnection.Main) < ElectronicNodesSettings.RibbonOffset)
@@ -312,8 +317,14 @@ void FENConnectionDrawingPolicy::ENProcessRibbon(int32 LayerId, FVector2D& Start
 				}
 			}
 		}
-		for (ENRibbonConnection RibbonConnection : RibbonConnections)
+
+		RibbonIndices.Reset();
+		VerticalRibbons.Query(End.X, FMath::Min(Start.Y, End.Y), FMath::Max(Start.Y, End.Y), RibbonIndices);
+		RibbonIndices.Sort();
+
+		for (const int32 RibbonIndex : RibbonIndices)
 		{
+			const ENRibbonConnection& RibbonConnection = RibbonConnections[RibbonIndex];
 			if (!RibbonConnection.Horizontal)
 			{
 				if (FMath::Abs(End.X - RibbonConnection.Main) < ElectronicNodesSettings.RibbonOffset)
@@ -351,8 +362,8 @@ void FENConnectionDrawingPolicy::ENProcessRibbon(int32 LayerId, FVector2D& Start
 			}
 		}
 
-		RibbonConnections.Add(ENRibbonConnection(Start.Y, End.Y, true, Start.X, End.X, DepthOffsetY));
-		RibbonConnections.Add(ENRibbonConnection(End.X, Start.X, false, Start.Y, End.Y, DepthOffsetX));
+		HorizontalRibbons.Add(RibbonConnections.Add(ENRibbonConnection(Start.Y, End.Y, true, Start.X, End.X, DepthOffsetY)), Start.Y, FMath::Min(Start.X, End.X), FMath::Max(Start.X, End.X));
+		VerticalRibbons.Add(RibbonConnections.Add(ENRibbonConnection(End.X, Start.X, false, Start.Y, End.Y, DepthOffsetX)), End.X, FMath::Min(Start.Y, End.Y), FMath::Max(Start.Y, End.Y));
 
 		FVector2D StartKey(FMath::FloorToInt(Start.X), FMath::FloorToInt(Start.Y));
 		FVector2D EndKey(FMath::FloorToInt(End.X), FMath::FloorToInt(End.Y));
@@ -665,3 +676,140 @@ void FENConnectionDrawingPolicy::ENComputeClosestPointDefault(const FVector2D& S
 		}
 	}
 }
+
+void FENRibbonIndex::Add(int32 ConnectionIndex, float Main, float SpanMin, float SpanMax)
+{
+	if (LaneSize <= 0.0f)
+	{
+		return;
+	}
+
+	const int32 NodeIndex = Nodes.AddUninitialized();
+	FNode& Node = Nodes[NodeIndex];
+	Node.Main = Main;
+	Node.SpanMin = SpanMin;
+	Node.SpanMax = SpanMax;
+	Node.SubtreeSpanMax = SpanMax;
+	Node.ConnectionIndex = ConnectionIndex;
+	Node.Priority = FCrc::MemCrc32(&NodeIndex, sizeof(NodeIndex));
+	Node.Left = INDEX_NONE;
+	Node.Right = INDEX_NONE;
+
+	int32& Root = LaneRoots.FindOrAdd(FMath::FloorToInt(Main / LaneSize), INDEX_NONE);
+	Root = Insert(Root, NodeIndex);
+}
+
+void FENRibbonIndex::Query(float Main, float SpanMin, float SpanMax, TArray<int32, TInlineAllocator<16>>& OutConnectionIndices) const
+{
+	if (LaneSize <= 0.0f)
+	{
+		return;
+	}
+
+	// Connections closer than a lane are at most one lane away, spans touching within a unit count as overlapping
+	const int32 Lane = FMath::FloorToInt(Main / LaneSize);
+	for (int32 LaneOffset = -1; LaneOffset <= 1; LaneOffset++)
+	{
+		if (const int32* Root = LaneRoots.Find(Lane + LaneOffset))
+		{
+			QueryNode(*Root, Main, SpanMin - 1.0f, SpanMax + 1.0f, OutConnectionIndices);
+		}
+	}
+}
+
+int32 FENRibbonIndex::Insert(int32 Root, int32 NodeIndex)
+{
+	if (Root == INDEX_NONE)
+	{
+		return NodeIndex;
+	}
+
+	FNode& RootNode = Nodes[Root];
+	RootNode.SubtreeSpanMax = FMath::Max(RootNode.SubtreeSpanMax, Nodes[NodeIndex].SpanMax);
+
+	if (Nodes[NodeIndex].SpanMin < RootNode.SpanMin)
+	{
+		RootNode.Left = Insert(RootNode.Left, NodeIndex);
+		if (Nodes[RootNode.Left].Priority > RootNode.Priority)
+		{
+			return RotateRight(Root);
+		}
+	}
+	else
+	{
+		RootNode.Right = Insert(RootNode.Right, NodeIndex);
+		if (Nodes[RootNode.Right].Priority > RootNode.Priority)
+		{
+			return RotateLeft(Root);
+		}
+	}
+
+	return Root;
+}
+
+int32 FENRibbonIndex::RotateLeft(int32 Root)
+{
+	const int32 NewRoot = Nodes[Root].Right;
+	Nodes[Root].Right = Nodes[NewRoot].Left;
+	Nodes[NewRoot].Left = Root;
+
+	UpdateSubtreeSpanMax(Root);
+	UpdateSubtreeSpanMax(NewRoot);
+	return NewRoot;
+}
+
+int32 FENRibbonIndex::RotateRight(int32 Root)
+{
+	const int32 NewRoot = Nodes[Root].Left;
+	Nodes[Root].Left = Nodes[NewRoot].Right;
+	Nodes[NewRoot].Right = Root;
+
+	UpdateSubtreeSpanMax(Root);
+	UpdateSubtreeSpanMax(NewRoot);
+	return NewRoot;
+}
+
+void FENRibbonIndex::UpdateSubtreeSpanMax(int32 NodeIndex)
+{
+	FNode& Node = Nodes[NodeIndex];
+	Node.SubtreeSpanMax = Node.SpanMax;
+
+	if (Node.Left != INDEX_NONE)
+	{
+		Node.SubtreeSpanMax = FMath::Max(Node.SubtreeSpanMax, Nodes[Node.Left].SubtreeSpanMax);
+	}
+	if (Node.Right != INDEX_NONE)
+	{
+		Node.SubtreeSpanMax = FMath::Max(Node.SubtreeSpanMax, Nodes[Node.Right].SubtreeSpanMax);
+	}
+}
+
+void FENRibbonIndex::QueryNode(int32 NodeIndex, float Main, float SpanMin, float SpanMax, TArray<int32, TInlineAllocator<16>>& OutConnectionIndices) const
+{
+	if (NodeIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	// No span in this subtree reaches the queried one
+	const FNode& Node = Nodes[NodeIndex];
+	if (Node.SubtreeSpanMax < SpanMin)
+	{
+		return;
+	}
+
+	QueryNode(Node.Left, Main, SpanMin, SpanMax, OutConnectionIndices);
+
+	// Every span on the right starts after this one
+	if (Node.SpanMin > SpanMax)
+	{
+		return;
+	}
+
+	if ((Node.SpanMax >= SpanMin) && (FMath::Abs(Node.Main - Main) <= LaneSize))
+	{
+		OutConnectionIndices.Add(Node.ConnectionIndex);
+	}
+
+	QueryNode(Node.Right, Main, SpanMin, SpanMax, OutConnectionIndices);
+}
@@ -33,6 +33,51 @@ struct ENRibbonConnection
 	}
 };
 
+/**
+ * Spatial index over the ribbon connections drawn so far.
+ * Connections are bucketed in lanes of RibbonOffset size along their main axis, each lane is an interval tree (a treap
+ * ordered by span start, augmented with the largest span end of each subtree) so a wire only visits the connections
+ * running alongside it instead of every connection of the graph.
+ */
+class FENRibbonIndex
+{
+public:
+	explicit FENRibbonIndex(float InLaneSize)
+		: LaneSize(InLaneSize)
+	{
+	}
+
+	void Add(int32 ConnectionIndex, float Main, float SpanMin, float SpanMax);
+
+	/** Gathers the connections closer than a lane to Main whose span overlaps the given one, in no particular order */
+	void Query(float Main, float SpanMin, float SpanMax, TArray<int32, TInlineAllocator<16>>& OutConnectionIndices) const;
+
+	int32 Num() const { return Nodes.Num(); }
+
+private:
+	struct FNode
+	{
+		float Main;
+		float SpanMin;
+		float SpanMax;
+		float SubtreeSpanMax;
+		int32 ConnectionIndex;
+		uint32 Priority;
+		int32 Left = INDEX_NONE;
+		int32 Right = INDEX_NONE;
+	};
+
+	int32 Insert(int32 Root, int32 NodeIndex);
+	int32 RotateLeft(int32 Root);
+	int32 RotateRight(int32 Root);
+	void UpdateSubtreeSpanMax(int32 NodeIndex);
+	void QueryNode(int32 NodeIndex, float Main, float SpanMin, float SpanMax, TArray<int32, TInlineAllocator<16>>& OutConnectionIndices) const;
+
+	float LaneSize;
+	TArray<FNode> Nodes;
+	TMap<int32, int32> LaneRoots;
+};
+
 struct FENConnectionDrawingPolicyFactory : public FGraphPanelPinConnectionFactory
 {
 	virtual ~FENConnectionDrawingPolicyFactory()
@@ -59,6 +104,8 @@ public:
 
 	void DrawDebugPoint(const FVector2D& Position, FLinearColor Color);
 
+	int32 GetNumRibbonConnections() const { return RibbonConnections.Num(); }
+
 private:
 	const UElectronicNodesSettings& ElectronicNodesSettings = *GetDefault<UElectronicNodesSettings>();
 	bool ReversePins;
@@ -66,6 +113,8 @@ private:
 	float ClosestDistanceSquared;
 	FVector2D ClosestPoint;
 	TArray<ENRibbonConnection> RibbonConnections;
+	FENRibbonIndex HorizontalRibbons = FENRibbonIndex(ElectronicNodesSettings.RibbonOffset);
+	FENRibbonIndex VerticalRibbons = FENRibbonIndex(ElectronicNodesSettings.RibbonOffset);
 	TMap<FVector2D, int> PinsOffset;
 
 	bool IsTree = false;
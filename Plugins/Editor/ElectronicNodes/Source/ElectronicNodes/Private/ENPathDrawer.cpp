@@ -4,6 +4,60 @@
 
 #include "ENPathDrawer.h"
 
+#include "CoreGlobals.h"
+
+namespace ENPathCache
+{
+	/** Paths are shared by every graph, the least recently drawn ones are dropped beyond this count */
+	constexpr int32 MaxCachedPaths = 32768;
+
+	/** Pin offsets are snapped to this fraction of a unit so panning the graph keeps hitting the same paths */
+	constexpr float OffsetPrecision = 64.0f;
+
+	struct FKey
+	{
+		EWireStyle WireStyle;
+		bool RightPriority;
+		FIntPoint Offset;
+		FVector2D StartDirection;
+		FVector2D EndDirection;
+		float ZoomFactor;
+		float RoundRadius;
+
+		bool operator==(const FKey& Other) const
+		{
+			return WireStyle == Other.WireStyle
+				&& RightPriority == Other.RightPriority
+				&& Offset == Other.Offset
+				&& StartDirection == Other.StartDirection
+				&& EndDirection == Other.EndDirection
+				&& ZoomFactor == Other.ZoomFactor
+				&& RoundRadius == Other.RoundRadius;
+		}
+
+		friend uint32 GetTypeHash(const FKey& Key)
+		{
+			uint32 Hash = HashCombine(GetTypeHash(Key.Offset), GetTypeHash(Key.StartDirection));
+			Hash = HashCombine(Hash, GetTypeHash(Key.EndDirection));
+			Hash = HashCombine(Hash, GetTypeHash(Key.ZoomFactor));
+			Hash = HashCombine(Hash, GetTypeHash(Key.RoundRadius));
+			return HashCombine(Hash, (static_cast<uint32>(Key.WireStyle) << 1) | (Key.RightPriority ? 1 : 0));
+		}
+	};
+
+	struct FPath
+	{
+		TArray<FENPathSegment> Segments;
+		uint64 LastDrawnFrame = 0;
+	};
+
+	static TMap<FKey, FPath>& Get()
+	{
+		static TMap<FKey, FPath> Paths;
+		return Paths;
+	}
+}
+
 FENPathDrawer::FENPathDrawer(int32& LayerId, float& ZoomFactor, bool RightPriority, const FConnectionParams* Params, FSlateWindowElementList* DrawElementsList, FENConnectionDrawingPolicy* ConnectionDrawingPolicy)
 {
 	this->LayerId = LayerId;
@@ -249,6 +303,110 @@ void FENPathDrawer::DrawSubwayWire(const FVector2D& Start, const FVector2D& Star
 	DrawSubwayWire(NewStart, NewStartDirection, NewEnd, NewEndDirection);
 }
 
+void FENPathDrawer::DrawCachedWire(EWireStyle WireStyle, const FVector2D& Start, const FVector2D& StartDirection, const FVector2D& End, const FVector2D& EndDirection)
+{
+	// Debug colors are applied while laying out the path, draw those wires directly
+	if (ElectronicNodesSettings.Debug || RecordedSegments != nullptr)
+	{
+		if (WireStyle == EWireStyle::Subway)
+		{
+			DrawSubwayWire(Start, StartDirection, End, EndDirection);
+		}
+		else
+		{
+			DrawManhattanWire(Start, StartDirection, End, EndDirection);
+		}
+		return;
+	}
+
+	const FVector2D Offset = End - Start;
+
+	ENPathCache::FKey Key;
+	Key.WireStyle = WireStyle;
+	Key.RightPriority = RightPriority;
+	Key.Offset = FIntPoint(FMath::RoundToInt(Offset.X * ENPathCache::OffsetPrecision), FMath::RoundToInt(Offset.Y * ENPathCache::OffsetPrecision));
+	Key.StartDirection = StartDirection;
+	Key.EndDirection = EndDirection;
+	Key.ZoomFactor = ZoomFactor;
+	Key.RoundRadius = ElectronicNodesSettings.RoundRadius;
+
+	TMap<ENPathCache::FKey, ENPathCache::FPath>& Paths = ENPathCache::Get();
+	if (ENPathCache::FPath* Path = Paths.Find(Key))
+	{
+		Path->LastDrawnFrame = GFrameCounter;
+
+		for (const FENPathSegment& Segment : Path->Segments)
+		{
+			switch (Segment.Type)
+			{
+			case FENPathSegment::EType::Line:
+				DrawLine(Start + Segment.Start, Start + Segment.End);
+				break;
+			case FENPathSegment::EType::Radius:
+				DrawRadius(Start + Segment.Start, Segment.StartDirection, Start + Segment.End, Segment.EndDirection, Segment.AngleDeg);
+				break;
+			case FENPathSegment::EType::Spline:
+				DrawSpline(Start + Segment.Start, Segment.StartDirection, Start + Segment.End, Segment.EndDirection);
+				break;
+			}
+		}
+		return;
+	}
+
+	if (Paths.Num() >= ENPathCache::MaxCachedPaths)
+	{
+		for (auto It = Paths.CreateIterator(); It; ++It)
+		{
+			if (It.Value().LastDrawnFrame + 1 < GFrameCounter)
+			{
+				It.RemoveCurrent();
+			}
+		}
+
+		if (Paths.Num() >= ENPathCache::MaxCachedPaths)
+		{
+			Paths.Reset();
+		}
+	}
+
+	ENPathCache::FPath NewPath;
+	NewPath.LastDrawnFrame = GFrameCounter;
+
+	RecordedSegments = &NewPath.Segments;
+	RecordOrigin = Start;
+
+	if (WireStyle == EWireStyle::Subway)
+	{
+		DrawSubwayWire(Start, StartDirection, End, EndDirection);
+	}
+	else
+	{
+		DrawManhattanWire(Start, StartDirection, End, EndDirection);
+	}
+
+	RecordedSegments = nullptr;
+
+	Paths.Add(Key, MoveTemp(NewPath));
+}
+
+int32 FENPathDrawer::GetPathCacheNum()
+{
+	return ENPathCache::Get().Num();
+}
+
+void FENPathDrawer::ResetPathCache()
+{
+	ENPathCache::Get().Reset();
+}
+
+void FENPathDrawer::RecordSegment(FENPathSegment::EType Type, const FVector2D& Start, const FVector2D& StartDirection, const FVector2D& End, const FVector2D& EndDirection, int32 AngleDeg)
+{
+	if (RecordedSegments != nullptr)
+	{
+		RecordedSegments->Add({Type, Start - RecordOrigin, StartDirection, End - RecordOrigin, EndDirection, AngleDeg});
+	}
+}
+
 void FENPathDrawer::DrawDefaultWire(const FVector2D& Start, const FVector2D& StartDirection, const FVector2D& End, const FVector2D& EndDirection)
 {
 	const float Tangent = (End - Start).Size();
@@ -504,6 +662,8 @@ void FENPathDrawer::DrawLine(const FVector2D& Start, const FVector2D& End)
 		return;
 	}
 
+	RecordSegment(FENPathSegment::EType::Line, Start, FVector2D::ZeroVector, End, FVector2D::ZeroVector);
+
 	FSlateDrawElement::MakeDrawSpaceSpline(*DrawElementsList, LayerId,
 	                                       Start, FVector2D::ZeroVector, End, FVector2D::ZeroVector,
 	                                       Params->WireThickness * ElectronicNodesSettings.WireThickness, ESlateDrawEffect::None, WireColor);
@@ -521,6 +681,8 @@ void FENPathDrawer::DrawRadius(const FVector2D& Start, const FVector2D& StartDir
 	const float Tangent = GetRadiusTangent(AngleDeg);
 	const float Offset = GetRadiusOffset(AngleDeg);
 
+	RecordSegment(FENPathSegment::EType::Radius, Start, StartDirection, End, EndDirection, AngleDeg);
+
 	FSlateDrawElement::MakeDrawSpaceSpline(*DrawElementsList, LayerId,
 	                                       Start, StartDirection * Tangent, End, EndDirection * Tangent,
 	                                       Params->WireThickness * ElectronicNodesSettings.WireThickness, ESlateDrawEffect::None, WireColor);
@@ -532,6 +694,8 @@ void FENPathDrawer::DrawSpline(const FVector2D& Start, const FVector2D& StartDir
 {
 	const float Tangent = GetRadiusTangent();
 
+	RecordSegment(FENPathSegment::EType::Spline, Start, StartDirection, End, EndDirection);
+
 	FSlateDrawElement::MakeDrawSpaceSpline(*DrawElementsList, LayerId,
 	                                       Start, StartDirection * Tangent, End, EndDirection * Tangent,
 	                                       Params->WireThickness * ElectronicNodesSettings.WireThickness, ESlateDrawEffect::None, WireColor);
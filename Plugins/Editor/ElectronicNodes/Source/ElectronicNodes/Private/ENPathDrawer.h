@@ -9,6 +9,24 @@
 #include "ENConnectionDrawingPolicy.h"
 #include "../Public/ElectronicNodesSettings.h"
 
+/** A drawn piece of a wire path, relative to the start of the wire */
+struct FENPathSegment
+{
+	enum class EType : uint8
+	{
+		Line,
+		Radius,
+		Spline
+	};
+
+	EType Type;
+	FVector2D Start;
+	FVector2D StartDirection;
+	FVector2D End;
+	FVector2D EndDirection;
+	int32 AngleDeg;
+};
+
 class FENPathDrawer
 {
 public:
@@ -18,6 +36,15 @@ public:
 	void DrawSubwayWire(const FVector2D& Start, const FVector2D& StartDirection, const FVector2D& End, const FVector2D& EndDirection);
 	void DrawDefaultWire(const FVector2D& Start, const FVector2D& StartDirection, const FVector2D& End, const FVector2D& EndDirection);
 
+	/**
+	 * Draws a Manhattan or Subway wire. The path only depends on the offset between the pins and the zoom, it is computed once
+	 * and replayed for every wire with the same offset, directions and zoom, so graphs that are not edited skip the path layout.
+	 */
+	void DrawCachedWire(EWireStyle WireStyle, const FVector2D& Start, const FVector2D& StartDirection, const FVector2D& End, const FVector2D& EndDirection);
+
+	static int32 GetPathCacheNum();
+	static void ResetPathCache();
+
 	void DrawIntersectionRadius(const FVector2D& Start, const FVector2D& StartDirection, const FVector2D& End, const FVector2D& EndDirection);
 	void DrawIntersectionDiagRadius(const FVector2D& Start, const FVector2D& StartDirection, const FVector2D& End, const FVector2D& EndDirection);
 
@@ -49,4 +76,10 @@ private:
 	FENConnectionDrawingPolicy* ConnectionDrawingPolicy;
 
 	int32 MaxDepthWire = 5;
+
+	/** Segments of the path being laid out for the cache, relative to RecordOrigin */
+	TArray<FENPathSegment>* RecordedSegments = nullptr;
+	FVector2D RecordOrigin;
+
+	void RecordSegment(FENPathSegment::EType Type, const FVector2D& Start, const FVector2D& StartDirection, const FVector2D& End, const FVector2D& EndDirection, int32 AngleDeg = 0);
 };
@@ -14,6 +14,8 @@
 
 #define LOCTEXT_NAMESPACE "FElectronicNodesModule"
 
+DEFINE_LOG_CATEGORY(LogElectronicNodes);
+
 void FElectronicNodesModule::StartupModule()
 {
 	const TSharedPtr<FENConnectionDrawingPolicyFactory> ENConnectionFactory = MakeShareable(
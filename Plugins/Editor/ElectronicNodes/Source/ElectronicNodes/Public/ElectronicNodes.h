@@ -9,6 +9,8 @@
 #include "ElectronicNodesSettings.h"
 #include "Modules/ModuleInterface.h"
 
+DECLARE_LOG_CATEGORY_EXTERN(LogElectronicNodes, Log, All);
+
 class FElectronicNodesModule : public IModuleInterface
 {
 public:
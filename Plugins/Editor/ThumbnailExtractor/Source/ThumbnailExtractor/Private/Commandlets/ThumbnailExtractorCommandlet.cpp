@@ -0,0 +1,99 @@
+// Copyright © 2024 MajorT. All rights reserved.
+
+#include "ThumbnailExtractorCommandlet.h"
+
+#include "Playset.h"
+#include "ThumbnailExtraction.h"
+#include "ThumbnailExtractor.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/StaticMesh.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(ThumbnailExtractorCommandlet)
+
+UThumbnailExtractorCommandlet::UThumbnailExtractorCommandlet(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UThumbnailExtractorCommandlet::Main(const FString& Params)
+{
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamVals;
+	ParseCommandLine(*Params, Tokens, Switches, ParamVals);
+
+	FThumbnailExtractionParams ExtractionParams;
+	ExtractionParams.bSkipUnchanged = !Switches.Contains(TEXT("Force"));
+
+	if (const FString* OutputPath = ParamVals.Find(TEXT("OutputPath")))
+	{
+		ExtractionParams.OutputPath = *OutputPath;
+	}
+
+	if (const FString* BatchSize = ParamVals.Find(TEXT("BatchSize")))
+	{
+		ExtractionParams.BatchSize = FMath::Max(1, FCString::Atoi(**BatchSize));
+	}
+
+	FARFilter Filter;
+	Filter.bRecursivePaths = true;
+	Filter.bRecursiveClasses = true;
+
+	TArray<FString> Paths;
+	if (const FString* PathsParam = ParamVals.Find(TEXT("Paths")))
+	{
+		PathsParam->ParseIntoArray(Paths, TEXT("+"));
+	}
+	else
+	{
+		Paths.Add(TEXT("/Game"));
+	}
+
+	for (const FString& Path : Paths)
+	{
+		Filter.PackagePaths.Add(*Path);
+	}
+
+	if (const FString* ClassesParam = ParamVals.Find(TEXT("Classes")))
+	{
+		TArray<FString> ClassNames;
+		ClassesParam->ParseIntoArray(ClassNames, TEXT("+"));
+
+		for (const FString& ClassName : ClassNames)
+		{
+			const FTopLevelAssetPath ClassPath = UClass::TryConvertShortTypeNameToPathName<UClass>(ClassName, ELogVerbosity::Warning);
+			if (ClassPath.IsNull())
+			{
+				UE_LOG(LogThumbnailExtractor, Error, TEXT("Unknown class %s."), *ClassName);
+				return 1;
+			}
+
+			Filter.ClassPaths.Add(ClassPath);
+		}
+	}
+	else
+	{
+		Filter.ClassPaths.Add(UStaticMesh::StaticClass()->GetClassPathName());
+		Filter.ClassPaths.Add(UPlayset::StaticClass()->GetClassPathName());
+	}
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssets(Filter, Assets);
+
+	UE_LOG(LogThumbnailExtractor, Display, TEXT("Extracting the thumbnails of %d assets."), Assets.Num());
+
+	const double StartTime = FPlatformTime::Seconds();
+	const FThumbnailExtractionResult Result = FThumbnailExtraction::ExtractThumbnails(Assets, ExtractionParams);
+
+	UE_LOG(LogThumbnailExtractor, Display, TEXT("Extracted %d, skipped %d unchanged, %d without thumbnail and failed %d thumbnails in %.2f s."),
+		Result.NumExtracted, Result.NumSkipped, Result.NumMissing, Result.NumFailed, FPlatformTime::Seconds() - StartTime);
+
+	return Result.NumFailed > 0 ? 1 : 0;
+}
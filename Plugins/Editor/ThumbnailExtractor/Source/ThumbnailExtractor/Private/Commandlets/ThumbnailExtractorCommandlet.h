@@ -0,0 +1,24 @@
+// Copyright © 2024 MajorT. All rights reserved.
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "ThumbnailExtractorCommandlet.generated.h"
+
+/**
+ * UThumbnailExtractorCommandlet
+ *
+ * Extracts the saved thumbnails of every matching asset into texture assets, skipping assets whose thumbnail did not
+ * change since the last run. Does not need a renderer, so it can run on a build machine with -nullrhi.
+ *
+ * Usage: -run=ThumbnailExtractor [-Paths=/Game+/Plugin] [-Classes=StaticMesh+Playset] [-OutputPath=/Game/Thumbnails] [-BatchSize=64] [-Force]
+ */
+UCLASS()
+class UThumbnailExtractorCommandlet : public UCommandlet
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+	//~ Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet Interface
+};
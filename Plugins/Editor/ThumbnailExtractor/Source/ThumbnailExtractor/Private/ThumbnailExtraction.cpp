@@ -0,0 +1,311 @@
+// Copyright © 2024 MajorT. All rights reserved.
+
+#include "ThumbnailExtraction.h"
+
+#include "IImageWrapperModule.h"
+#include "ObjectTools.h"
+#include "ThumbnailExtractor.h"
+#include "Async/ParallelFor.h"
+#include "AssetRegistry/AssetData.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/Texture2D.h"
+#include "Hash/xxhash.h"
+#include "Misc/FileHelper.h"
+#include "Misc/ObjectThumbnail.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+
+namespace ThumbnailExtraction
+{
+	/** Thumbnail hash per texture package name, written by the last extractions */
+	static FString GetHashManifestFilename()
+	{
+		return FPaths::ProjectSavedDir() / TEXT("ThumbnailExtractor") / TEXT("ThumbnailHashes.txt");
+	}
+
+	static void LoadHashManifest(TMap<FString, uint64>& OutHashes)
+	{
+		TArray<FString> Lines;
+		FFileHelper::LoadFileToStringArray(Lines, *GetHashManifestFilename());
+
+		for (const FString& Line : Lines)
+		{
+			FString PackageName;
+			FString Hash;
+			if (Line.Split(TEXT("="), &PackageName, &Hash))
+			{
+				OutHashes.Add(PackageName, FCString::Strtoui64(*Hash, nullptr, 16));
+			}
+		}
+	}
+
+	static void SaveHashManifest(const TMap<FString, uint64>& Hashes)
+	{
+		TArray<FString> Lines;
+		Lines.Reserve(Hashes.Num());
+
+		for (const TPair<FString, uint64>& Pair : Hashes)
+		{
+			Lines.Add(FString::Printf(TEXT("%s=%016llx"), *Pair.Key, Pair.Value));
+		}
+
+		FFileHelper::SaveStringArrayToFile(Lines, *GetHashManifestFilename());
+	}
+
+	struct FExtractedThumbnail
+	{
+		FString PackageFilename;
+		FString TexturePackageName;
+		FObjectThumbnail Thumbnail;
+		int32 Width = 0;
+		int32 Height = 0;
+		TArray<uint8> Pixels;
+		uint64 Hash = 0;
+		bool bLoaded = false;
+		bool bChanged = false;
+		bool bDecompressed = false;
+	};
+}
+
+FThumbnailExtractionResult FThumbnailExtraction::ExtractThumbnails(const TArray<FAssetData>& Assets, const FThumbnailExtractionParams& Params)
+{
+	FThumbnailExtractionResult Result;
+
+	// Thumbnails are decompressed on worker threads, which may only use modules that are already loaded
+	FModuleManager::LoadModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
+
+	TMap<FString, uint64> Hashes;
+	ThumbnailExtraction::LoadHashManifest(Hashes);
+
+	const int32 BatchSize = FMath::Max(1, Params.BatchSize);
+	TArray<ThumbnailExtraction::FExtractedThumbnail> Batch;
+
+	for (int32 BatchStart = 0; BatchStart < Assets.Num(); BatchStart += BatchSize)
+	{
+		const int32 NumInBatch = FMath::Min(BatchSize, Assets.Num() - BatchStart);
+
+		Batch.Reset();
+		Batch.SetNum(NumInBatch);
+
+		// Package files are resolved through the package resolver, which is not thread safe
+		for (int32 Idx = 0; Idx < NumInBatch; Idx++)
+		{
+			const FAssetData& AssetData = Assets[BatchStart + Idx];
+			ThumbnailExtraction::FExtractedThumbnail& Thumbnail = Batch[Idx];
+
+			if (!FPackageName::DoesPackageExist(AssetData.PackageName.ToString(), &Thumbnail.PackageFilename))
+			{
+				Thumbnail.PackageFilename.Reset();
+			}
+			Thumbnail.TexturePackageName = GetThumbnailPackageName(AssetData, Params.OutputPath);
+		}
+
+		// The unchanged check only needs the compressed bytes as they are stored in the package
+		ParallelFor(NumInBatch, [&Assets, &Batch, BatchStart](int32 Idx)
+		{
+			ThumbnailExtraction::FExtractedThumbnail& Thumbnail = Batch[Idx];
+			if (Thumbnail.PackageFilename.IsEmpty())
+			{
+				return;
+			}
+
+			Thumbnail.bLoaded = LoadCompressedThumbnail(Assets[BatchStart + Idx], Thumbnail.PackageFilename, Thumbnail.Thumbnail);
+			if (Thumbnail.bLoaded)
+			{
+				const TArray<uint8>& CompressedData = Thumbnail.Thumbnail.AccessCompressedImageData();
+				Thumbnail.Hash = FXxHash64::HashBuffer(CompressedData.GetData(), CompressedData.Num()).Hash;
+			}
+		});
+
+		int32 NumChanged = 0;
+		for (int32 Idx = 0; Idx < NumInBatch; Idx++)
+		{
+			ThumbnailExtraction::FExtractedThumbnail& Thumbnail = Batch[Idx];
+			if (!Thumbnail.bLoaded)
+			{
+				UE_LOG(LogThumbnailExtractor, Verbose, TEXT("No thumbnail saved for %s"), *Assets[BatchStart + Idx].GetObjectPathString());
+				Result.NumMissing++;
+				continue;
+			}
+
+			if (Params.bSkipUnchanged)
+			{
+				const uint64* PreviousHash = Hashes.Find(Thumbnail.TexturePackageName);
+				if (PreviousHash && *PreviousHash == Thumbnail.Hash && FPackageName::DoesPackageExist(Thumbnail.TexturePackageName))
+				{
+					Result.NumSkipped++;
+					continue;
+				}
+			}
+
+			Thumbnail.bChanged = true;
+			NumChanged++;
+		}
+
+		// Only the changed thumbnails are decompressed
+		if (NumChanged > 0)
+		{
+			ParallelFor(NumInBatch, [&Batch](int32 Idx)
+			{
+				ThumbnailExtraction::FExtractedThumbnail& Thumbnail = Batch[Idx];
+				if (Thumbnail.bChanged)
+				{
+					Thumbnail.bDecompressed = DecompressThumbnail(Thumbnail.Thumbnail, Thumbnail.Width, Thumbnail.Height, Thumbnail.Pixels);
+				}
+			});
+		}
+
+		TArray<UTexture2D*> SavedTextures;
+		for (int32 Idx = 0; Idx < NumInBatch; Idx++)
+		{
+			ThumbnailExtraction::FExtractedThumbnail& Thumbnail = Batch[Idx];
+			if (!Thumbnail.bChanged)
+			{
+				continue;
+			}
+
+			if (!Thumbnail.bDecompressed)
+			{
+				UE_LOG(LogThumbnailExtractor, Warning, TEXT("Failed to decompress the thumbnail of %s"), *Assets[BatchStart + Idx].GetObjectPathString());
+				Result.NumFailed++;
+				continue;
+			}
+
+			UTexture2D* Texture = CreateThumbnailTexture(Thumbnail.TexturePackageName, Thumbnail.Width, Thumbnail.Height, Thumbnail.Pixels);
+			if (Texture == nullptr || !SaveThumbnailTexture(Texture))
+			{
+				UE_LOG(LogThumbnailExtractor, Warning, TEXT("Failed to save thumbnail texture %s"), *Thumbnail.TexturePackageName);
+				Result.NumFailed++;
+				continue;
+			}
+
+			SavedTextures.Add(Texture);
+			Hashes.Add(Thumbnail.TexturePackageName, Thumbnail.Hash);
+			Result.NumExtracted++;
+		}
+
+		FlushSaves();
+
+		// The written textures are only needed again if something loads them, so their packages are released every batch
+		for (UTexture2D* Texture : SavedTextures)
+		{
+			Texture->ClearFlags(RF_Standalone);
+		}
+
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+		UE_LOG(LogThumbnailExtractor, Display, TEXT("Processed %d/%d assets"), BatchStart + NumInBatch, Assets.Num());
+	}
+
+	ThumbnailExtraction::SaveHashManifest(Hashes);
+
+	return Result;
+}
+
+bool FThumbnailExtraction::LoadThumbnail(const FAssetData& AssetData, const FString& PackageFilename, int32& OutWidth, int32& OutHeight, TArray<uint8>& OutPixels)
+{
+	FObjectThumbnail Thumbnail;
+	return LoadCompressedThumbnail(AssetData, PackageFilename, Thumbnail) && DecompressThumbnail(Thumbnail, OutWidth, OutHeight, OutPixels);
+}
+
+bool FThumbnailExtraction::LoadCompressedThumbnail(const FAssetData& AssetData, const FString& PackageFilename, FObjectThumbnail& OutThumbnail)
+{
+	const FName ObjectFullName = FName(*AssetData.GetFullName());
+	TSet<FName> ObjectFullNames;
+	ObjectFullNames.Add(ObjectFullName);
+
+	FThumbnailMap ThumbnailMap;
+	if (!ThumbnailTools::LoadThumbnailsFromPackage(PackageFilename, ObjectFullNames, ThumbnailMap))
+	{
+		return false;
+	}
+
+	FObjectThumbnail* Thumbnail = ThumbnailMap.Find(ObjectFullName);
+	if (Thumbnail == nullptr || Thumbnail->IsEmpty())
+	{
+		return false;
+	}
+
+	OutThumbnail = MoveTemp(*Thumbnail);
+	return true;
+}
+
+bool FThumbnailExtraction::DecompressThumbnail(FObjectThumbnail& Thumbnail, int32& OutWidth, int32& OutHeight, TArray<uint8>& OutPixels)
+{
+	// Thumbnails decompress to BGRA8, which is what the texture source is initialized from
+	Thumbnail.GetUncompressedImageData();
+
+	OutWidth = Thumbnail.GetImageWidth();
+	OutHeight = Thumbnail.GetImageHeight();
+	OutPixels = MoveTemp(Thumbnail.AccessImageData());
+
+	return OutPixels.Num() == OutWidth * OutHeight * 4;
+}
+
+UTexture2D* FThumbnailExtraction::CreateThumbnailTexture(const FString& PackageName, int32 Width, int32 Height, const TArray<uint8>& Pixels)
+{
+	UPackage* Package = CreatePackage(*PackageName);
+	if (!ensure(Package))
+	{
+		return nullptr;
+	}
+
+	Package->FullyLoad();
+
+	const FString TextureName = FPackageName::GetShortName(PackageName);
+	UTexture2D* Texture = FindObject<UTexture2D>(Package, *TextureName);
+	if (Texture)
+	{
+		Texture->Modify();
+	}
+	else
+	{
+		Texture = NewObject<UTexture2D>(Package, *TextureName, RF_Public | RF_Standalone);
+		FAssetRegistryModule::AssetCreated(Texture);
+	}
+
+	Texture->Source.Init(Width, Height, 1, 1, TSF_BGRA8, Pixels.GetData());
+
+	// Building the platform data is left to the first load when running headless
+	if (!IsRunningCommandlet())
+	{
+		Texture->PostEditChange();
+	}
+
+	Package->MarkPackageDirty();
+
+	return Texture;
+}
+
+bool FThumbnailExtraction::SaveThumbnailTexture(UTexture2D* Texture)
+{
+	UPackage* Package = Texture->GetPackage();
+	const FString PackageFilename = FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension());
+
+	FSavePackageArgs SaveArgs;
+	SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+	SaveArgs.SaveFlags = SAVE_Async;
+	SaveArgs.Error = GWarn;
+
+	return UPackage::SavePackage(Package, Texture, *PackageFilename, SaveArgs);
+}
+
+void FThumbnailExtraction::FlushSaves()
+{
+	UPackage::WaitForAsyncFileWrites();
+}
+
+FString FThumbnailExtraction::GetThumbnailPackageName(const FAssetData& AssetData, const FString& OutputPath)
+{
+	const FString AssetName = AssetData.AssetName.ToString();
+	const FString TextureName = FString::Printf(TEXT("%s_Thumbnail"), *AssetName);
+
+	if (!OutputPath.IsEmpty())
+	{
+		return FPaths::Combine(OutputPath, TextureName);
+	}
+
+	const FString AssetPath = FPackageName::GetLongPackagePath(AssetData.PackageName.ToString());
+	return FPaths::Combine(AssetPath, AssetName, TextureName);
+}
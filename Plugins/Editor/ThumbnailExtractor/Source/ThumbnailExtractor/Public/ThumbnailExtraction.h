@@ -0,0 +1,85 @@
+// Copyright © 2024 MajorT. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FObjectThumbnail;
+class UTexture2D;
+struct FAssetData;
+
+/**
+ * FThumbnailExtractionParams
+ *
+ * Parameters of a batch thumbnail extraction.
+ */
+struct FThumbnailExtractionParams
+{
+	/** Long package path the textures are saved to, next to each asset in a folder named after it if empty. */
+	FString OutputPath;
+
+	/** Whether assets whose thumbnail has not changed since the last extraction should be skipped. */
+	bool bSkipUnchanged = true;
+
+	/** Number of assets whose thumbnails are loaded in parallel and whose texture packages are written together. */
+	int32 BatchSize = 64;
+};
+
+/**
+ * FThumbnailExtractionResult
+ *
+ * Outcome of a batch thumbnail extraction.
+ */
+struct FThumbnailExtractionResult
+{
+	int32 NumExtracted = 0;
+	int32 NumSkipped = 0;
+
+	/** Assets that have no thumbnail saved in their package */
+	int32 NumMissing = 0;
+
+	int32 NumFailed = 0;
+};
+
+/**
+ * FThumbnailExtraction
+ *
+ * Extracts the saved editor thumbnails of assets into texture assets.
+ * Thumbnails are read from the asset packages on worker threads and copied into the textures as raw BGRA pixels,
+ * so this works without a renderer, e.g. in a commandlet running with -nullrhi.
+ */
+class THUMBNAILEXTRACTOR_API FThumbnailExtraction
+{
+public:
+	/** Extracts the thumbnails of the given assets and saves them as textures. */
+	static FThumbnailExtractionResult ExtractThumbnails(const TArray<FAssetData>& Assets, const FThumbnailExtractionParams& Params = FThumbnailExtractionParams());
+
+	/**
+	 * Loads the raw BGRA thumbnail saved in the package of the given asset.
+	 * Safe to call from any thread.
+	 * @returns Whether the asset has a saved thumbnail.
+	 */
+	static bool LoadThumbnail(const FAssetData& AssetData, const FString& PackageFilename, int32& OutWidth, int32& OutHeight, TArray<uint8>& OutPixels);
+
+	/**
+	 * Loads the compressed thumbnail saved in the package of the given asset, without decompressing it.
+	 * Safe to call from any thread.
+	 * @returns Whether the asset has a saved thumbnail.
+	 */
+	static bool LoadCompressedThumbnail(const FAssetData& AssetData, const FString& PackageFilename, FObjectThumbnail& OutThumbnail);
+
+	/** Decompresses a loaded thumbnail into raw BGRA pixels. Safe to call from any thread. */
+	static bool DecompressThumbnail(FObjectThumbnail& Thumbnail, int32& OutWidth, int32& OutHeight, TArray<uint8>& OutPixels);
+
+	/** Creates the texture with the given package name, or updates it if it already exists, from raw BGRA pixels. */
+	static UTexture2D* CreateThumbnailTexture(const FString& PackageName, int32 Width, int32 Height, const TArray<uint8>& Pixels);
+
+	/** Saves the package of the given texture, the file is written asynchronously until FlushSaves is called. */
+	static bool SaveThumbnailTexture(UTexture2D* Texture);
+
+	/** Waits until every texture package saved so far has been written. */
+	static void FlushSaves();
+
+	/** Returns the package name of the thumbnail texture of the given asset. */
+	static FString GetThumbnailPackageName(const FAssetData& AssetData, const FString& OutputPath = FString());
+};
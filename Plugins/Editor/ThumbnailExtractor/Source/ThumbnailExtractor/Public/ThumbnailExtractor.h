@@ -5,6 +5,8 @@
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
 
+THUMBNAILEXTRACTOR_API DECLARE_LOG_CATEGORY_EXTERN(LogThumbnailExtractor, Log, All);
+
 class FThumbnailExtractorModule : public IModuleInterface
 {
 public:
@@ -18,6 +18,10 @@ void UEnhancedOnlineSessionsSubsystem::Initialize(FSubsystemCollectionBase& Coll
 
 void UEnhancedOnlineSessionsSubsystem::Deinitialize()
 {
+	StopSessionRefresh();
+	CachedSearchResults.Reset();
+	SearchResultRequests.Reset();
+
 	Super::Deinitialize();
 }
 
@@ -5,10 +5,63 @@
 #include "EnhancedOnlineRequests.h"
 #include "EnhancedOnlineSubsystem.h"
 #include "OnlineSessionSettings.h"
+#include "TimerManager.h"
+#include "Engine/GameInstance.h"
 #include "Interfaces/OnlineSessionInterface.h"
 #include "Kismet/GameplayStatics.h"
 #include "Online/OnlineSessionNames.h"
 
+namespace EnhancedSessionCache
+{
+	/** Returns the key a search result is cached with */
+	static FString GetSessionKey(const FOnlineSessionSearchResult& SearchResult)
+	{
+		if (SearchResult.IsSessionInfoValid())
+		{
+			return SearchResult.GetSessionIdStr();
+		}
+
+		// Results without session info can only be told apart by their owner
+		if (SearchResult.Session.OwningUserId.IsValid())
+		{
+			return SearchResult.Session.OwningUserId->ToString();
+		}
+
+		return SearchResult.Session.OwningUserName;
+	}
+
+	/** Returns the key of the search settings a request searches with, results of different searches are not cached together */
+	static FString GetSearchKey(const UEnhancedOnlineRequest_FindSessions* Request)
+	{
+		return FString::Printf(TEXT("%d|%d|%s"), static_cast<int32>(Request->OnlineMode), Request->bFindLobbies ? 1 : 0, *Request->SearchKeyword);
+	}
+
+	/** Returns whether anything a session browser displays differs between the two results */
+	static bool HasChanged(const FOnlineSessionSearchResult& Old, const FOnlineSessionSearchResult& New)
+	{
+		if (Old.PingInMs != New.PingInMs
+			|| Old.Session.NumOpenPublicConnections != New.Session.NumOpenPublicConnections
+			|| Old.Session.NumOpenPrivateConnections != New.Session.NumOpenPrivateConnections
+			|| Old.Session.SessionSettings.NumPublicConnections != New.Session.SessionSettings.NumPublicConnections
+			|| Old.Session.OwningUserName != New.Session.OwningUserName
+			|| Old.Session.SessionSettings.Settings.Num() != New.Session.SessionSettings.Settings.Num())
+		{
+			return true;
+		}
+
+		for (const auto& Setting : New.Session.SessionSettings.Settings)
+		{
+			const FOnlineSessionSetting* OldSetting = Old.Session.SessionSettings.Settings.Find(Setting.Key);
+			if (OldSetting == nullptr || !(OldSetting->Data == Setting.Value.Data))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+}
+
 void UEnhancedOnlineSessionsSubsystem::HostOnlineSession(UEnhancedOnlineRequest_Session* Request)
 {
 	if (Request == nullptr)
@@ -256,9 +309,311 @@ void UEnhancedOnlineSessionsSubsystem::FindOnlineSessions(UEnhancedOnlineRequest
 		return;
 	}
 
+	// A new browser replaces the one that is being refreshed
+	if (RefreshingSearchRequest && RefreshingSearchRequest != Request)
+	{
+		StopSessionRefresh();
+	}
+
+	if (PrepareSearchCache(Request))
+	{
+		// Show the cached sessions right away, the search only reports what changed
+		SearchResultRequests.AddUnique(Request);
+
+		const double Now = FPlatformTime::Seconds();
+		TArray<FString> ExpiredKeys;
+		for (const auto& CachedResult : CachedSearchResults)
+		{
+			if (Now - CachedResult.Value->LastSeenTime > Request->ResultLifetime)
+			{
+				ExpiredKeys.Add(CachedResult.Key);
+			}
+			else if (!Request->SearchResults.Contains(CachedResult.Value))
+			{
+				Request->SearchResults.Add(CachedResult.Value);
+				Request->OnSearchResultAdded.Broadcast(CachedResult.Value);
+			}
+		}
+
+		for (const FString& ExpiredKey : ExpiredKeys)
+		{
+			RemoveCachedSearchResult(ExpiredKey);
+		}
+	}
+
 	FindOnlineSessionsInternal(LocalPlayer, MakeShared<FEnhancedOnlineSearchSettings>(Request));
 }
 
+void UEnhancedOnlineSessionsSubsystem::StopSessionRefresh()
+{
+	if (UGameInstance* GameInstance = GetGameInstance())
+	{
+		GameInstance->GetTimerManager().ClearTimer(SessionRefreshTimerHandle);
+	}
+
+	if (UEnhancedOnlineRequest_FindSessions* Request = RefreshingSearchRequest)
+	{
+		RefreshingSearchRequest = nullptr;
+
+		// A search that is still running completes the request once it finishes
+		if (!SearchSettings.IsValid() || SearchSettings->Request != Request)
+		{
+			Request->CompleteRequest();
+		}
+	}
+}
+
+void UEnhancedOnlineSessionsSubsystem::HandleSessionRefreshTimer()
+{
+	if (IsValid(RefreshingSearchRequest))
+	{
+		FindOnlineSessions(RefreshingSearchRequest);
+	}
+	else
+	{
+		RefreshingSearchRequest = nullptr;
+	}
+}
+
+void UEnhancedOnlineSessionsSubsystem::ApplySearchResults(UEnhancedOnlineRequest_FindSessions* Request, const TArray<FOnlineSessionSearchResult>& Results)
+{
+	check(Request);
+
+	const double Now = FPlatformTime::Seconds();
+	TSet<FString> FoundKeys;
+	FoundKeys.Reserve(Results.Num());
+
+	TArray<UEnhancedSessionSearchResult*> AddedResults;
+	TArray<UEnhancedSessionSearchResult*> ChangedResults;
+
+	SearchResultRequests.AddUnique(Request);
+
+	for (const FOnlineSessionSearchResult& SearchResult : Results)
+	{
+		const FString SessionKey = EnhancedSessionCache::GetSessionKey(SearchResult);
+		bool bAlreadyFound = false;
+		FoundKeys.Add(SessionKey, &bAlreadyFound);
+		if (bAlreadyFound)
+		{
+			continue;
+		}
+
+		if (TObjectPtr<UEnhancedSessionSearchResult>* CachedResult = CachedSearchResults.Find(SessionKey))
+		{
+			UEnhancedSessionSearchResult* Result = *CachedResult;
+			const bool bChanged = EnhancedSessionCache::HasChanged(Result->StoredSearchResult, SearchResult);
+			Result->StoredSearchResult = SearchResult;
+			Result->LastSeenTime = Now;
+
+			if (!Request->SearchResults.Contains(Result))
+			{
+				Request->SearchResults.Add(Result);
+				AddedResults.Add(Result);
+			}
+
+			if (bChanged)
+			{
+				ChangedResults.Add(Result);
+			}
+		}
+		else
+		{
+			// Cached results outlive the request, so they are owned by the subsystem
+			UEnhancedSessionSearchResult* NewResult = NewObject<UEnhancedSessionSearchResult>(this);
+			NewResult->StoredSearchResult = SearchResult;
+			NewResult->LastSeenTime = Now;
+			CachedSearchResults.Add(SessionKey, NewResult);
+
+			Request->SearchResults.Add(NewResult);
+			AddedResults.Add(NewResult);
+
+			FString OwningUserId = TEXT("Uknown");
+			if (SearchResult.Session.OwningUserId.IsValid())
+			{
+				OwningUserId = SearchResult.Session.OwningUserId->ToString();
+			}
+
+			UE_LOG(LogEnhancedSubsystem, Log, TEXT("\tFound session (UserId: %s, UserName: %s, NumOpenPrivConns: %d, NumOpenPubConns: %d, Ping: %d ms"),
+			*OwningUserId,
+			*SearchResult.Session.OwningUserName,
+			SearchResult.Session.NumOpenPrivateConnections,
+			SearchResult.Session.NumOpenPublicConnections,
+			SearchResult.PingInMs);
+		}
+	}
+
+	for (UEnhancedSessionSearchResult* Result : AddedResults)
+	{
+		Request->OnSearchResultAdded.Broadcast(Result);
+	}
+
+	// The result objects are shared, every other request displaying a changed session has to refresh it as well
+	int32 NumUpdated = 0;
+	for (UEnhancedSessionSearchResult* Result : ChangedResults)
+	{
+		TArray<UEnhancedOnlineRequest_FindSessions*> Requests;
+		GetRequestsWithSearchResult(Result, Requests);
+		for (UEnhancedOnlineRequest_FindSessions* OtherRequest : Requests)
+		{
+			if (OtherRequest != Request || !AddedResults.Contains(Result))
+			{
+				OtherRequest->OnSearchResultUpdated.Broadcast(Result);
+				NumUpdated++;
+			}
+		}
+	}
+
+	// Sessions missing from a single search are kept until their lifetime expired, so they do not flicker
+	TArray<FString> ExpiredKeys;
+	for (const auto& CachedResult : CachedSearchResults)
+	{
+		if (!FoundKeys.Contains(CachedResult.Key) && Now - CachedResult.Value->LastSeenTime > Request->ResultLifetime)
+		{
+			ExpiredKeys.Add(CachedResult.Key);
+		}
+	}
+
+	for (const FString& ExpiredKey : ExpiredKeys)
+	{
+		RemoveCachedSearchResult(ExpiredKey);
+	}
+
+	UE_LOG(LogEnhancedSubsystem, Log, TEXT("Session cache updated (Added: %d, Updated: %d, Removed: %d, Cached: %d)."), AddedResults.Num(), NumUpdated, ExpiredKeys.Num(), CachedSearchResults.Num());
+
+	const TArray<UEnhancedSessionSearchResult*> KnownResults(Request->SearchResults);
+	Request->OnFindOnlineSessionsCompleted.Broadcast(KnownResults);
+}
+
+#if !UE_BUILD_SHIPPING
+void UEnhancedOnlineSessionsSubsystem::ApplyFakeSearchResults(int32 NumSessions, int32 Seed)
+{
+	UEnhancedOnlineRequest_FindSessions* Request = RefreshingSearchRequest;
+	if (Request == nullptr)
+	{
+		if (FakeSearchRequest == nullptr)
+		{
+			// Expire sessions right away so every fabricated search reports its removals
+			FakeSearchRequest = NewObject<UEnhancedOnlineRequest_FindSessions>(this);
+			FakeSearchRequest->ResultLifetime = 0.f;
+			FakeSearchRequest->OnSearchResultAdded.AddLambda([](UEnhancedSessionSearchResult* Result)
+			{
+				UE_LOG(LogEnhancedSubsystem, Log, TEXT("\tAdded %s (Ping: %d ms, Players: %d/%d)"), *Result->GetSessionFriendlyName(), Result->GetPingInMs(), Result->GetCurrentPlayers(), Result->GetMaxPlayers());
+			});
+			FakeSearchRequest->OnSearchResultUpdated.AddLambda([](UEnhancedSessionSearchResult* Result)
+			{
+				UE_LOG(LogEnhancedSubsystem, Log, TEXT("\tUpdated %s (Ping: %d ms, Players: %d/%d)"), *Result->GetSessionFriendlyName(), Result->GetPingInMs(), Result->GetCurrentPlayers(), Result->GetMaxPlayers());
+			});
+			FakeSearchRequest->OnSearchResultRemoved.AddLambda([](UEnhancedSessionSearchResult* Result)
+			{
+				UE_LOG(LogEnhancedSubsystem, Log, TEXT("\tRemoved %s"), *Result->GetSessionFriendlyName());
+			});
+		}
+
+		Request = FakeSearchRequest;
+	}
+
+	PrepareSearchCache(Request);
+
+	FRandomStream Random(Seed);
+	TArray<FOnlineSessionSearchResult> Results;
+	Results.Reserve(NumSessions);
+
+	for (int32 SessionIdx = 0; SessionIdx < NumSessions; SessionIdx++)
+	{
+		if (Seed != 0 && Random.FRand() < 0.2f)
+		{
+			continue;
+		}
+
+		const FString SessionName = FString::Printf(TEXT("Fake Session %d"), SessionIdx);
+
+		FOnlineSessionSearchResult& FakeResult = Results.AddDefaulted_GetRef();
+		FakeResult.Session.OwningUserName = SessionName;
+		FakeResult.Session.SessionSettings.NumPublicConnections = 16;
+		FakeResult.Session.SessionSettings.bShouldAdvertise = true;
+		FakeResult.Session.SessionSettings.Set(SETTING_FRIENDLYNAME, SessionName, EOnlineDataAdvertisementType::ViaOnlineService);
+		FakeResult.Session.NumOpenPublicConnections = Seed != 0 && Random.FRand() < 0.3f ? Random.RandRange(0, 16) : 8;
+		FakeResult.PingInMs = Seed != 0 && Random.FRand() < 0.3f ? Random.RandRange(10, 200) : 50;
+	}
+
+	UE_LOG(LogEnhancedSubsystem, Log, TEXT("Applying %d fake sessions (Seed: %d)."), Results.Num(), Seed);
+	ApplySearchResults(Request, Results);
+}
+
+static FAutoConsoleCommandWithWorldAndArgs FakeSessionSearchCommand(
+	TEXT("EnhancedSessions.FakeSearch"),
+	TEXT("Applies a fabricated session search to the session cache without an online service. Usage: EnhancedSessions.FakeSearch [NumSessions=10] [Seed=0]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+		UEnhancedOnlineSessionsSubsystem* SessionsSubsystem = GameInstance ? GameInstance->GetSubsystem<UEnhancedOnlineSessionsSubsystem>() : nullptr;
+		if (SessionsSubsystem == nullptr)
+		{
+			UE_LOG(LogEnhancedSubsystem, Error, TEXT("EnhancedSessions.FakeSearch requires a game instance with an enhanced sessions subsystem."));
+			return;
+		}
+
+		const int32 NumSessions = Args.IsValidIndex(0) ? FCString::Atoi(*Args[0]) : 10;
+		const int32 Seed = Args.IsValidIndex(1) ? FCString::Atoi(*Args[1]) : 0;
+		SessionsSubsystem->ApplyFakeSearchResults(NumSessions, Seed);
+	}));
+#endif
+
+bool UEnhancedOnlineSessionsSubsystem::PrepareSearchCache(const UEnhancedOnlineRequest_FindSessions* Request)
+{
+	check(Request);
+
+	const FString SearchKey = EnhancedSessionCache::GetSearchKey(Request);
+	if (SearchKey == CachedSearchKey)
+	{
+		return true;
+	}
+
+	CachedSearchKey = SearchKey;
+
+	TArray<FString> SessionKeys;
+	CachedSearchResults.GenerateKeyArray(SessionKeys);
+	for (const FString& SessionKey : SessionKeys)
+	{
+		RemoveCachedSearchResult(SessionKey);
+	}
+
+	return false;
+}
+
+void UEnhancedOnlineSessionsSubsystem::RemoveCachedSearchResult(const FString& SessionKey)
+{
+	TObjectPtr<UEnhancedSessionSearchResult> Result;
+	if (!CachedSearchResults.RemoveAndCopyValue(SessionKey, Result))
+	{
+		return;
+	}
+
+	TArray<UEnhancedOnlineRequest_FindSessions*> Requests;
+	GetRequestsWithSearchResult(Result, Requests);
+	for (UEnhancedOnlineRequest_FindSessions* Request : Requests)
+	{
+		Request->SearchResults.Remove(Result);
+		Request->OnSearchResultRemoved.Broadcast(Result);
+	}
+}
+
+void UEnhancedOnlineSessionsSubsystem::GetRequestsWithSearchResult(const UEnhancedSessionSearchResult* Result, TArray<UEnhancedOnlineRequest_FindSessions*>& OutRequests)
+{
+	SearchResultRequests.RemoveAll([](const TWeakObjectPtr<UEnhancedOnlineRequest_FindSessions>& Request)
+	{
+		return !Request.IsValid();
+	});
+
+	for (const TWeakObjectPtr<UEnhancedOnlineRequest_FindSessions>& Request : SearchResultRequests)
+	{
+		if (Request->SearchResults.Contains(Result))
+		{
+			OutRequests.Add(Request.Get());
+		}
+	}
+}
+
 void UEnhancedOnlineSessionsSubsystem::FindOnlineSessionsInternal(ULocalPlayer* LocalPlayer, const TSharedRef<FEnhancedOnlineSearchSettings>& InSearchSettings)
 {
 	if (SearchSettings.IsValid())
@@ -290,42 +645,32 @@ void UEnhancedOnlineSessionsSubsystem::HandleFindOnlineSessionsComplete(bool bWa
 
 		if (SearchSettings.IsValid())
 		{
-			TArray<UEnhancedSessionSearchResult*> Results;
-			for (auto& SearchResult : SearchSettings->SearchResults)
-			{
-				UEnhancedSessionSearchResult* NewResult = NewObject<UEnhancedSessionSearchResult>(SearchSettings->Request);
-				NewResult->StoredSearchResult = SearchResult;
-				Results.Add(NewResult);
-
-				FString OwningUserId = TEXT("Uknown");
-				if (SearchResult.Session.OwningUserId.IsValid())
-				{
-					OwningUserId = SearchResult.Session.OwningUserId->ToString();
-				}
-				
-				UE_LOG(LogEnhancedSubsystem, Log, TEXT("\tFound session (UserId: %s, UserName: %s, NumOpenPrivConns: %d, NumOpenPubConns: %d, Ping: %d ms"),
-				*OwningUserId,
-				*SearchResult.Session.OwningUserName,
-				SearchResult.Session.NumOpenPrivateConnections,
-				SearchResult.Session.NumOpenPublicConnections,
-				SearchResult.PingInMs);
-			}
-
-			SearchSettings->Request->OnFindOnlineSessionsCompleted.Broadcast(Results);
+			ApplySearchResults(SearchSettings->Request, SearchSettings->SearchResults);
 		}
 	}
 	else
 	{
+		// Cached sessions are kept, the next refresh may succeed again
 		UE_LOG(LogEnhancedSubsystem, Error, TEXT("Failed to find sessions. :("));
 	}
 
 	if (SearchSettings.IsValid())
 	{
-		SearchSettings->Request->Sessions->ClearOnFindSessionsCompleteDelegate_Handle(FindSessionsDelegateHandle);
+		UEnhancedOnlineRequest_FindSessions* Request = SearchSettings->Request;
+		Request->Sessions->ClearOnFindSessionsCompleteDelegate_Handle(FindSessionsDelegateHandle);
 		FindSessionsDelegateHandle.Reset();
-		
-		SearchSettings->Request->CompleteRequest();
 		SearchSettings = nullptr;
+
+		// Refreshing requests search again after their interval and complete once the refresh is stopped
+		if (IsValid(Request) && Request->RefreshInterval > 0.f && (RefreshingSearchRequest == nullptr || RefreshingSearchRequest == Request))
+		{
+			RefreshingSearchRequest = Request;
+			GetGameInstance()->GetTimerManager().SetTimer(SessionRefreshTimerHandle, this, &ThisClass::HandleSessionRefreshTimer, Request->RefreshInterval, false);
+		}
+		else
+		{
+			Request->CompleteRequest();
+		}
 	}
 	else
 	{
@@ -0,0 +1,182 @@
+// Copyright © 2024 MajorT. All rights reserved.
+
+#include "EnhancedOnlineRequests.h"
+#include "EnhancedOnlineSessionsSubsystem.h"
+#include "EnhancedOnlineTypes.h"
+#include "OnlineSessionSettings.h"
+#include "Engine/GameInstance.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace EnhancedSessionSearchCacheTests
+{
+	/** Records the session events a find sessions request received */
+	struct FSearchEvents
+	{
+		explicit FSearchEvents(UEnhancedOnlineRequest_FindSessions* Request)
+		{
+			Request->OnSearchResultAdded.AddLambda([this](UEnhancedSessionSearchResult* Result)
+			{
+				Added.Add(Result->GetSessionFriendlyName());
+			});
+			Request->OnSearchResultUpdated.AddLambda([this](UEnhancedSessionSearchResult* Result)
+			{
+				Updated.Add(Result->GetSessionFriendlyName());
+			});
+			Request->OnSearchResultRemoved.AddLambda([this](UEnhancedSessionSearchResult* Result)
+			{
+				Removed.Add(Result->GetSessionFriendlyName());
+			});
+			Request->OnFindOnlineSessionsCompleted.AddLambda([this](const TArray<UEnhancedSessionSearchResult*> Results)
+			{
+				LastCompletedNum = Results.Num();
+			});
+		}
+
+		void Reset()
+		{
+			Added.Reset();
+			Updated.Reset();
+			Removed.Reset();
+			LastCompletedNum = INDEX_NONE;
+		}
+
+		TArray<FString> Added;
+		TArray<FString> Updated;
+		TArray<FString> Removed;
+		int32 LastCompletedNum = INDEX_NONE;
+	};
+
+	FOnlineSessionSearchResult MakeSearchResult(const FString& Name, int32 PingInMs, int32 NumOpenConnections)
+	{
+		FOnlineSessionSearchResult Result;
+		Result.Session.OwningUserName = Name;
+		Result.Session.NumOpenPublicConnections = NumOpenConnections;
+		Result.Session.SessionSettings.NumPublicConnections = 16;
+		Result.Session.SessionSettings.Set(SETTING_FRIENDLYNAME, Name, EOnlineDataAdvertisementType::ViaOnlineService);
+		Result.PingInMs = PingInMs;
+		return Result;
+	}
+
+	UEnhancedSessionSearchResult* FindResult(const UEnhancedOnlineRequest_FindSessions* Request, const FString& Name)
+	{
+		for (UEnhancedSessionSearchResult* Result : Request->SearchResults)
+		{
+			if (Result->GetSessionFriendlyName() == Name)
+			{
+				return Result;
+			}
+		}
+
+		return nullptr;
+	}
+
+	/** Compares the events regardless of their order, the cache does not keep the order of the search */
+	void TestEvents(FAutomationTestBase& Test, const FString& What, TArray<FString> Actual, TArray<FString> Expected)
+	{
+		Actual.Sort();
+		Expected.Sort();
+		if (Actual != Expected)
+		{
+			Test.AddError(FString::Printf(TEXT("%s were [%s] instead of [%s]."), *What, *FString::Join(Actual, TEXT(", ")), *FString::Join(Expected, TEXT(", "))));
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEnhancedSessionSearchCacheTest, "EnhancedOnlineSubsystem.Sessions.SearchCache", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FEnhancedSessionSearchCacheTest::RunTest(const FString& Parameters)
+{
+	using namespace EnhancedSessionSearchCacheTests;
+
+	TStrongObjectPtr<UGameInstance> GameInstance(NewObject<UGameInstance>(GetTransientPackage()));
+	TStrongObjectPtr<UEnhancedOnlineSessionsSubsystem> Subsystem(NewObject<UEnhancedOnlineSessionsSubsystem>(GameInstance.Get()));
+	TStrongObjectPtr<UEnhancedOnlineRequest_FindSessions> Request(NewObject<UEnhancedOnlineRequest_FindSessions>(GetTransientPackage()));
+	Request->ResultLifetime = 30.f;
+	FSearchEvents Events(Request.Get());
+
+	// The first search starts a new cache
+	TestFalse(TEXT("Cache kept for the first search"), Subsystem->PrepareSearchCache(Request.Get()));
+
+	// Every session of the first search is new
+	Subsystem->ApplySearchResults(Request.Get(), { MakeSearchResult(TEXT("A"), 50, 8), MakeSearchResult(TEXT("B"), 50, 8), MakeSearchResult(TEXT("C"), 50, 8) });
+	TestEvents(*this, TEXT("Added sessions of the first search"), Events.Added, { TEXT("A"), TEXT("B"), TEXT("C") });
+	TestEvents(*this, TEXT("Updated sessions of the first search"), Events.Updated, {});
+	TestEvents(*this, TEXT("Removed sessions of the first search"), Events.Removed, {});
+	TestEqual(TEXT("Sessions known after the first search"), Events.LastCompletedNum, 3);
+
+	// Changed sessions are updated, a session missing from a single search is kept within its lifetime
+	Events.Reset();
+	UEnhancedSessionSearchResult* ResultA = FindResult(Request.Get(), TEXT("A"));
+	Subsystem->ApplySearchResults(Request.Get(), { MakeSearchResult(TEXT("A"), 50, 8), MakeSearchResult(TEXT("B"), 120, 3) });
+	TestEvents(*this, TEXT("Added sessions of the second search"), Events.Added, {});
+	TestEvents(*this, TEXT("Updated sessions of the second search"), Events.Updated, { TEXT("B") });
+	TestEvents(*this, TEXT("Removed sessions of the second search"), Events.Removed, {});
+	TestEqual(TEXT("Sessions known after the second search"), Events.LastCompletedNum, 3);
+	TestTrue(TEXT("Unchanged session keeps its result object"), ResultA != nullptr && FindResult(Request.Get(), TEXT("A")) == ResultA);
+
+	const UEnhancedSessionSearchResult* ResultB = FindResult(Request.Get(), TEXT("B"));
+	if (TestNotNull(TEXT("Updated session"), ResultB))
+	{
+		TestEqual(TEXT("Updated ping"), ResultB->GetPingInMs(), 120);
+		TestEqual(TEXT("Updated players"), ResultB->GetCurrentPlayers(), 13);
+	}
+
+	// Once its lifetime expired the missing session is removed, duplicates within one search are only added once
+	Events.Reset();
+	if (UEnhancedSessionSearchResult* ResultC = FindResult(Request.Get(), TEXT("C")))
+	{
+		ResultC->LastSeenTime -= Request->ResultLifetime * 2.f;
+	}
+
+	Subsystem->ApplySearchResults(Request.Get(), { MakeSearchResult(TEXT("A"), 50, 8), MakeSearchResult(TEXT("B"), 120, 3), MakeSearchResult(TEXT("D"), 30, 4), MakeSearchResult(TEXT("D"), 30, 4) });
+	TestEvents(*this, TEXT("Added sessions of the third search"), Events.Added, { TEXT("D") });
+	TestEvents(*this, TEXT("Updated sessions of the third search"), Events.Updated, {});
+	TestEvents(*this, TEXT("Removed sessions of the third search"), Events.Removed, { TEXT("C") });
+	TestEqual(TEXT("Sessions known after the third search"), Events.LastCompletedNum, 3);
+
+	// Another request is given the cached result objects instead of new ones
+	TStrongObjectPtr<UEnhancedOnlineRequest_FindSessions> OtherRequest(NewObject<UEnhancedOnlineRequest_FindSessions>(GetTransientPackage()));
+	FSearchEvents OtherEvents(OtherRequest.Get());
+	Subsystem->ApplySearchResults(OtherRequest.Get(), { MakeSearchResult(TEXT("A"), 50, 8) });
+	TestEvents(*this, TEXT("Added sessions of the other request"), OtherEvents.Added, { TEXT("A") });
+	TestTrue(TEXT("Cached session is shared between requests"), ResultA != nullptr && FindResult(OtherRequest.Get(), TEXT("A")) == ResultA);
+
+	// Both requests display the shared object, so both are told when it changes
+	Events.Reset();
+	OtherEvents.Reset();
+	Subsystem->ApplySearchResults(Request.Get(), { MakeSearchResult(TEXT("A"), 80, 8), MakeSearchResult(TEXT("B"), 120, 3), MakeSearchResult(TEXT("D"), 30, 4) });
+	TestEvents(*this, TEXT("Updated sessions of the request"), Events.Updated, { TEXT("A") });
+	TestEvents(*this, TEXT("Updated sessions of the other request"), OtherEvents.Updated, { TEXT("A") });
+	TestEvents(*this, TEXT("Added sessions of the other request after the update"), OtherEvents.Added, {});
+
+	// And both lose it once it expired
+	Events.Reset();
+	OtherEvents.Reset();
+	if (ResultA != nullptr)
+	{
+		ResultA->LastSeenTime -= Request->ResultLifetime * 2.f;
+	}
+
+	Subsystem->ApplySearchResults(Request.Get(), { MakeSearchResult(TEXT("B"), 120, 3), MakeSearchResult(TEXT("D"), 30, 4) });
+	TestEvents(*this, TEXT("Removed sessions of the request"), Events.Removed, { TEXT("A") });
+	TestEvents(*this, TEXT("Removed sessions of the other request"), OtherEvents.Removed, { TEXT("A") });
+	TestEqual(TEXT("Sessions the other request knows after the removal"), OtherRequest->SearchResults.Num(), 0);
+
+	// Searching with the same settings keeps the cache, other settings drop it and every request holding a session is told
+	TestTrue(TEXT("Cache kept for the same settings"), Subsystem->PrepareSearchCache(OtherRequest.Get()));
+
+	Events.Reset();
+	TStrongObjectPtr<UEnhancedOnlineRequest_FindSessions> KeywordRequest(NewObject<UEnhancedOnlineRequest_FindSessions>(GetTransientPackage()));
+	KeywordRequest->SearchKeyword = TEXT("Keyword");
+	TestFalse(TEXT("Cache kept for other settings"), Subsystem->PrepareSearchCache(KeywordRequest.Get()));
+	TestEvents(*this, TEXT("Removed sessions after the settings changed"), Events.Removed, { TEXT("B"), TEXT("D") });
+	TestEqual(TEXT("Sessions the request knows after the settings changed"), Request->SearchResults.Num(), 0);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
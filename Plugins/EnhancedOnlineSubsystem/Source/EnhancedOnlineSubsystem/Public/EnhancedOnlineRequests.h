@@ -471,6 +471,9 @@ public:
 public:
 	/** The search result which uniquely identifies the session */
 	FOnlineSessionSearchResult StoredSearchResult;
+
+	/** Time the session was last returned by a search, used to expire cached results */
+	double LastSeenTime = 0.0;
 };
 
 /**
@@ -479,6 +482,12 @@ public:
  */
 DECLARE_MULTICAST_DELEGATE_OneParam(FOnEnhancedFindOnlineSessionsCompleted, const TArray<UEnhancedSessionSearchResult*> /* Search Results */);
 
+/**
+ * Delegate for when a single search result of a find online sessions request was added, updated or removed
+ * @param SearchResult	The search result that changed
+ */
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnEnhancedSessionSearchResultChanged, UEnhancedSessionSearchResult* /* Search Result */);
+
 /**
  * Request class used to find online sessions
  */
@@ -504,13 +513,30 @@ public:
 	UPROPERTY(BlueprintReadWrite, Category = "Online|Request")
 	FString SearchKeyword;
 
+	/** Interval in seconds the search is repeated at until the refresh is stopped, 0 only searches once */
+	UPROPERTY(BlueprintReadWrite, Category = "Online|Request")
+	float RefreshInterval = 0.f;
+
+	/** Time in seconds a session is kept after a search last found it, before it is reported as removed */
+	UPROPERTY(BlueprintReadWrite, Category = "Online|Request")
+	float ResultLifetime = 30.f;
+
 	/** List of all the search results found online, will be valid after the request is completed */
 	UPROPERTY(BlueprintReadOnly, Category = "Online|Request")
 	TArray<TObjectPtr<UEnhancedSessionSearchResult>> SearchResults;
 
-	/** Native delegate for when the request is completed */
+	/** Native delegate for when the request is completed, called with every currently known search result */
 	FOnEnhancedFindOnlineSessionsCompleted OnFindOnlineSessionsCompleted;
 
+	/** Native delegate for when a session was found that was not part of the search results yet */
+	FOnEnhancedSessionSearchResultChanged OnSearchResultAdded;
+
+	/** Native delegate for when a known session changed, e.g. its ping or number of players */
+	FOnEnhancedSessionSearchResultChanged OnSearchResultUpdated;
+
+	/** Native delegate for when a known session was not found again within the result lifetime */
+	FOnEnhancedSessionSearchResultChanged OnSearchResultRemoved;
+
 public:
 	virtual void InvalidateRequest() override
 	{
@@ -521,6 +547,10 @@ public:
 			OnFindOnlineSessionsCompleted.RemoveAll(this);
 			OnFindOnlineSessionsCompleted.Clear();
 		}
+
+		OnSearchResultAdded.Clear();
+		OnSearchResultUpdated.Clear();
+		OnSearchResultRemoved.Clear();
 	}
 };
 
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Engine/TimerHandle.h"
 #include "Interfaces/OnlineSessionInterface.h"
 #include "Subsystems/GameInstanceSubsystem.h"
 #include "EnhancedOnlineSessionsSubsystem.generated.h"
@@ -80,6 +81,35 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Online|EnhancedSessions|Sessions")
 	virtual void FindOnlineSessions(UEnhancedOnlineRequest_FindSessions* Request);
 
+	/**
+	 * Stops repeating the search of the request that is currently refreshing, and completes it.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Online|EnhancedSessions|Sessions")
+	virtual void StopSessionRefresh();
+
+	/**
+	 * Merges the results of a finished search into the session cache and notifies the request about every added, updated and removed session.
+	 * Called once a search completes, can also be called with fabricated results to drive the cache without an online service.
+	 * @param Request	The request the search was made for.
+	 * @param Results	The sessions found by the search.
+	 */
+	void ApplySearchResults(UEnhancedOnlineRequest_FindSessions* Request, const TArray<FOnlineSessionSearchResult>& Results);
+
+	/**
+	 * Drops the cached sessions if the request searches with other settings than they were found with.
+	 * Every request still holding a dropped session is notified of its removal.
+	 * @return	True if the cached sessions were kept.
+	 */
+	bool PrepareSearchCache(const UEnhancedOnlineRequest_FindSessions* Request);
+
+#if !UE_BUILD_SHIPPING
+	/**
+	 * Applies a fabricated search to the refreshing request, or to an internal request that logs every change if none is refreshing.
+	 * The same seed always produces the same sessions, different seeds drop some sessions and change the ping and player count of others.
+	 */
+	void ApplyFakeSearchResults(int32 NumSessions, int32 Seed);
+#endif
+
 	/**
 	 * Joins an online session.
 	 * @param Request	The search result of the session to join.
@@ -111,6 +141,15 @@ protected:
 	virtual void HandleFindOnlineSessionsComplete(bool bWasSuccessful);
 	virtual void HandleJoinSessionCompleted(FName SessionName, EOnJoinSessionCompleteResult::Type Result);
 
+	/** Called when the refresh interval of the refreshing search request has passed */
+	void HandleSessionRefreshTimer();
+
+	/** Removes a cached session and notifies every request that knew about it */
+	void RemoveCachedSearchResult(const FString& SessionKey);
+
+	/** Gathers the requests whose search results contain the cached session */
+	void GetRequestsWithSearchResult(const UEnhancedSessionSearchResult* Result, TArray<UEnhancedOnlineRequest_FindSessions*>& OutRequests);
+
 	/** Online Identity */
 	virtual void LoginOnlineUserInternal(ULocalPlayer* LocalPlayer, UEnhancedOnlineRequest_LoginUser* Request, bool bAllowCommandLineAuth = true);
 	virtual void LogoutOnlineUserInternal(ULocalPlayer* LocalPlayer, UEnhancedOnlineRequest_LogoutUser* Request);
@@ -152,4 +191,24 @@ private:
 
 	/** Settings for the current search */
 	TSharedPtr<FEnhancedOnlineSearchSettings> SearchSettings;
+
+	/** Sessions found by previous searches, keyed by session id */
+	UPROPERTY(Transient)
+	TMap<FString, TObjectPtr<UEnhancedSessionSearchResult>> CachedSearchResults;
+
+	/** Identifies the search settings the cached sessions were found with */
+	FString CachedSearchKey;
+
+	/** Requests that were given cached sessions, they share the result objects and are notified of every change */
+	TArray<TWeakObjectPtr<UEnhancedOnlineRequest_FindSessions>> SearchResultRequests;
+
+	/** The request that is searched again once the refresh timer expires */
+	UPROPERTY()
+	TObjectPtr<UEnhancedOnlineRequest_FindSessions> RefreshingSearchRequest;
+
+	FTimerHandle SessionRefreshTimerHandle;
+
+	/** Request fabricated searches are applied to while no request is refreshing, only used outside of shipping builds */
+	UPROPERTY(Transient)
+	TObjectPtr<UEnhancedOnlineRequest_FindSessions> FakeSearchRequest;
 };
@@ -21,6 +21,8 @@ public class BioDevices : ModuleRules
             {
                 "CoreUObject",
                 "Engine",
+                "AIModule",
+                "GameplayAbilities",
             }
         );
     }
@@ -0,0 +1,417 @@
+// Copyright © 2024 Botanibots Team. All rights reserved.
+
+
+#include "BioCharacterSpawnSubsystem.h"
+
+#include "AbilitySystemComponent.h"
+#include "AbilitySystemGlobals.h"
+#include "AIController.h"
+#include "BioCharacterSpawnerComponent.h"
+#include "BotaniLogChannels.h"
+#include "BrainComponent.h"
+#include "AbilitySystem/Attributes/BotaniHealthSet.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/GameModeBase.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(BioCharacterSpawnSubsystem)
+
+namespace BioCharacterSpawnerCVars
+{
+	static int32 MaxSpawnsPerFrame = 2;
+	static FAutoConsoleVariableRef CVarMaxSpawnsPerFrame(
+		TEXT("Bio.Spawner.MaxSpawnsPerFrame"),
+		MaxSpawnsPerFrame,
+		TEXT("Maximum number of bots all character spawners of a world may spawn or reuse in a single frame."),
+		ECVF_Default);
+
+	static float SpawnBudgetMs = 4.f;
+	static FAutoConsoleVariableRef CVarSpawnBudgetMs(
+		TEXT("Bio.Spawner.SpawnBudgetMs"),
+		SpawnBudgetMs,
+		TEXT("Game thread time in milliseconds character spawners may use per frame. At least one bot is always processed."),
+		ECVF_Default);
+
+	static int32 MaxPooledBotsPerDefinition = 16;
+	static FAutoConsoleVariableRef CVarMaxPooledBotsPerDefinition(
+		TEXT("Bio.Spawner.MaxPooledBotsPerDefinition"),
+		MaxPooledBotsPerDefinition,
+		TEXT("Maximum number of despawned bots kept for reuse per bot definition. Set to 0 to disable pooling."),
+		ECVF_Default);
+
+	static FAutoConsoleCommandWithWorld CmdDumpSpawnStats(
+		TEXT("Bio.Spawner.DumpStats"),
+		TEXT("Logs the spawn statistics of all character spawners in the current world."),
+		FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+		{
+			if (const UBioCharacterSpawnSubsystem* Subsystem = World ? World->GetSubsystem<UBioCharacterSpawnSubsystem>() : nullptr)
+			{
+				UE_LOG(LogBotani, Display, TEXT("%s"), *Subsystem->GetSpawnStats().ToString());
+			}
+		}));
+}
+
+//////////////////////////////////////////////////////////////////////////
+// FBioCharacterSpawnStats
+
+FString FBioCharacterSpawnStats::ToString() const
+{
+	return FString::Printf(TEXT("Requested: %d, Spawned: %d, Reused: %d, Pooled: %d, Pending: %d, Latency avg/max: %.3fs/%.3fs, Cost spawn/reuse: %.2fms/%.2fms"),
+		NumRequested, NumSpawned, NumReused, NumPooled, NumPending, AverageLatency, MaxLatency, AverageSpawnCostMs, AverageReuseCostMs);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// UBioCharacterSpawnSubsystem
+
+UBioCharacterSpawnSubsystem::UBioCharacterSpawnSubsystem()
+{
+}
+
+bool UBioCharacterSpawnSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	if (!Super::ShouldCreateSubsystem(Outer))
+	{
+		return false;
+	}
+
+	// Bots are only ever spawned by the server
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld() && World->GetNetMode() != NM_Client;
+}
+
+void UBioCharacterSpawnSubsystem::Deinitialize()
+{
+	PendingRequests.Empty();
+	BotPool.Empty();
+
+	Super::Deinitialize();
+}
+
+void UBioCharacterSpawnSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const double StartTime = FPlatformTime::Seconds();
+	const double BudgetSeconds = BioCharacterSpawnerCVars::SpawnBudgetMs / 1000.0;
+	int32 NumProcessed = 0;
+
+	while (PendingRequests.Num() > 0 && NumProcessed < BioCharacterSpawnerCVars::MaxSpawnsPerFrame)
+	{
+		if (NumProcessed > 0 && (FPlatformTime::Seconds() - StartTime) >= BudgetSeconds)
+		{
+			break;
+		}
+
+		// Pop first, the spawner callback may add or cancel requests
+		const FSpawnRequest Request = PendingRequests[0];
+		PendingRequests.RemoveAt(0);
+
+		ProcessRequest(Request);
+		++NumProcessed;
+	}
+}
+
+bool UBioCharacterSpawnSubsystem::IsTickable() const
+{
+	return PendingRequests.Num() > 0;
+}
+
+TStatId UBioCharacterSpawnSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UBioCharacterSpawnSubsystem, STATGROUP_Tickables);
+}
+
+UBioCharacterSpawnSubsystem* UBioCharacterSpawnSubsystem::GetForActor(const AActor* Actor)
+{
+	if (Actor == nullptr)
+	{
+		return nullptr;
+	}
+
+	if (UWorld* World = Actor->GetWorld())
+	{
+		return World->GetSubsystem<UBioCharacterSpawnSubsystem>();
+	}
+
+	return nullptr;
+}
+
+void UBioCharacterSpawnSubsystem::RequestSpawn(UBioCharacterSpawnerComponent* Spawner, const FTransform& SpawnTransform)
+{
+	if (!ensure(Spawner))
+	{
+		return;
+	}
+
+	FSpawnRequest& Request = PendingRequests.AddDefaulted_GetRef();
+	Request.Spawner = Spawner;
+	Request.SpawnTransform = SpawnTransform;
+	Request.RequestTime = FPlatformTime::Seconds();
+
+	++SpawnStats.NumRequested;
+}
+
+void UBioCharacterSpawnSubsystem::CancelSpawnRequests(const UBioCharacterSpawnerComponent* Spawner)
+{
+	PendingRequests.RemoveAll([Spawner](const FSpawnRequest& Request)
+	{
+		return !Request.Spawner.IsValid() || Request.Spawner.Get() == Spawner;
+	});
+}
+
+int32 UBioCharacterSpawnSubsystem::GetNumPendingRequests(const UBioCharacterSpawnerComponent* Spawner) const
+{
+	int32 NumPending = 0;
+	for (const FSpawnRequest& Request : PendingRequests)
+	{
+		if (Request.Spawner.Get() == Spawner)
+		{
+			++NumPending;
+		}
+	}
+
+	return NumPending;
+}
+
+void UBioCharacterSpawnSubsystem::ReleaseBot(const UBotaniBotDefinition* BotDefinition, AAIController* Controller)
+{
+	if (Controller == nullptr)
+	{
+		return;
+	}
+
+	TArray<FPooledBot>& Pool = BotPool.FindOrAdd(FObjectKey(BotDefinition));
+
+	// Drop bots that got destroyed while sleeping
+	Pool.RemoveAll([](const FPooledBot& PooledBot)
+	{
+		return !PooledBot.Controller.IsValid();
+	});
+
+	if (Controller->GetPawn() == nullptr || Pool.Num() >= BioCharacterSpawnerCVars::MaxPooledBotsPerDefinition)
+	{
+		DestroyBot(Controller);
+		return;
+	}
+
+	SetBotDormant(Controller, true);
+
+	FPooledBot& PooledBot = Pool.AddDefaulted_GetRef();
+	PooledBot.Controller = Controller;
+	PooledBot.ControllerClass = Controller->GetClass();
+}
+
+FBioCharacterSpawnStats UBioCharacterSpawnSubsystem::GetSpawnStats() const
+{
+	FBioCharacterSpawnStats Stats = SpawnStats;
+	Stats.NumPending = PendingRequests.Num();
+
+	for (const TPair<FObjectKey, TArray<FPooledBot>>& Pair : BotPool)
+	{
+		Stats.NumPooled += Pair.Value.Num();
+	}
+
+	const int32 NumCompleted = Stats.NumSpawned + Stats.NumReused;
+	Stats.AverageLatency = NumCompleted > 0 ? static_cast<float>(TotalLatency / NumCompleted) : 0.f;
+	Stats.AverageSpawnCostMs = Stats.NumSpawned > 0 ? static_cast<float>(TotalSpawnCostMs / Stats.NumSpawned) : 0.f;
+	Stats.AverageReuseCostMs = Stats.NumReused > 0 ? static_cast<float>(TotalReuseCostMs / Stats.NumReused) : 0.f;
+
+	return Stats;
+}
+
+bool UBioCharacterSpawnSubsystem::ProcessRequest(const FSpawnRequest& Request)
+{
+	UBioCharacterSpawnerComponent* Spawner = Request.Spawner.Get();
+	if (Spawner == nullptr)
+	{
+		return false;
+	}
+
+	const UBotaniBotDefinition* BotDefinition = Spawner->BotDefinition;
+	const TSubclassOf<AAIController> ControllerClass = Spawner->BotControllerClass;
+	if (ControllerClass == nullptr)
+	{
+		UE_LOG(LogBotani, Error, TEXT("Spawner [%s] has no bot controller class set."), *GetPathNameSafe(Spawner));
+		return false;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	bool bReused = true;
+	AAIController* Controller = AcquirePooledBot(BotDefinition, ControllerClass, Request.SpawnTransform);
+	if (Controller == nullptr)
+	{
+		bReused = false;
+		Controller = SpawnNewBot(ControllerClass, Request.SpawnTransform);
+	}
+
+	if (Controller == nullptr)
+	{
+		UE_LOG(LogBotani, Warning, TEXT("Spawner [%s] failed to spawn a bot."), *GetPathNameSafe(Spawner));
+		return false;
+	}
+
+	Spawner->HandleBotSpawned(Controller);
+
+	const double CostMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	if (bReused)
+	{
+		++SpawnStats.NumReused;
+		TotalReuseCostMs += CostMs;
+	}
+	else
+	{
+		++SpawnStats.NumSpawned;
+		TotalSpawnCostMs += CostMs;
+	}
+
+	RecordLatency(Request.RequestTime);
+	return true;
+}
+
+AAIController* UBioCharacterSpawnSubsystem::AcquirePooledBot(const UBotaniBotDefinition* BotDefinition, TSubclassOf<AAIController> ControllerClass, const FTransform& SpawnTransform)
+{
+	TArray<FPooledBot>* Pool = BotPool.Find(FObjectKey(BotDefinition));
+	if (Pool == nullptr)
+	{
+		return nullptr;
+	}
+
+	for (int32 Index = Pool->Num() - 1; Index >= 0; --Index)
+	{
+		const FPooledBot& PooledBot = (*Pool)[Index];
+		AAIController* Controller = PooledBot.Controller.Get();
+		APawn* Pawn = Controller ? Controller->GetPawn() : nullptr;
+
+		if (Pawn == nullptr)
+		{
+			// Got destroyed while sleeping
+			if (Controller)
+			{
+				DestroyBot(Controller);
+			}
+
+			Pool->RemoveAtSwap(Index);
+			continue;
+		}
+
+		if (PooledBot.ControllerClass != ControllerClass)
+		{
+			continue;
+		}
+
+		Pool->RemoveAtSwap(Index);
+
+		Pawn->TeleportTo(SpawnTransform.GetLocation(), SpawnTransform.Rotator(), false, true);
+		Controller->SetControlRotation(SpawnTransform.Rotator());
+		SetBotDormant(Controller, false);
+
+		return Controller;
+	}
+
+	return nullptr;
+}
+
+AAIController* UBioCharacterSpawnSubsystem::SpawnNewBot(TSubclassOf<AAIController> ControllerClass, const FTransform& SpawnTransform)
+{
+	UWorld* World = GetWorld();
+	AGameModeBase* GameMode = World->GetAuthGameMode();
+	if (GameMode == nullptr)
+	{
+		return nullptr;
+	}
+
+	FActorSpawnParameters SpawnInfo;
+	SpawnInfo.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	SpawnInfo.OverrideLevel = World->PersistentLevel;
+	SpawnInfo.ObjectFlags |= RF_Transient;
+
+	AAIController* NewController = World->SpawnActor<AAIController>(ControllerClass, SpawnInfo);
+	if (NewController == nullptr)
+	{
+		return nullptr;
+	}
+
+	GameMode->GenericPlayerInitialization(NewController);
+	GameMode->RestartPlayerAtTransform(NewController, SpawnTransform);
+
+	if (NewController->GetPawn() == nullptr)
+	{
+		DestroyBot(NewController);
+		return nullptr;
+	}
+
+	return NewController;
+}
+
+void UBioCharacterSpawnSubsystem::SetBotDormant(AAIController* Controller, bool bDormant)
+{
+	APawn* Pawn = Controller->GetPawn();
+	check(Pawn);
+
+	Controller->StopMovement();
+
+	if (UBrainComponent* BrainComponent = Controller->GetBrainComponent())
+	{
+		if (bDormant)
+		{
+			BrainComponent->StopLogic(TEXT("Pooled"));
+		}
+		else
+		{
+			BrainComponent->RestartLogic();
+		}
+	}
+
+	Pawn->SetActorHiddenInGame(bDormant);
+	Pawn->SetActorEnableCollision(!bDormant);
+	Pawn->SetActorTickEnabled(!bDormant);
+
+	if (const ACharacter* Character = Cast<ACharacter>(Pawn))
+	{
+		UCharacterMovementComponent* MovementComponent = Character->GetCharacterMovement();
+		MovementComponent->StopMovementImmediately();
+
+		if (bDormant)
+		{
+			MovementComponent->DisableMovement();
+		}
+		else
+		{
+			MovementComponent->SetDefaultMovementMode();
+		}
+	}
+
+	// A reused bot starts with full health
+	if (!bDormant)
+	{
+		if (UAbilitySystemComponent* AbilitySystemComponent = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(Pawn))
+		{
+			if (AbilitySystemComponent->HasAttributeSetForAttribute(UBotaniHealthSet::GetHealthAttribute()))
+			{
+				const float MaxHealth = AbilitySystemComponent->GetNumericAttribute(UBotaniHealthSet::GetMaxHealthAttribute());
+				AbilitySystemComponent->SetNumericAttributeBase(UBotaniHealthSet::GetHealthAttribute(), MaxHealth);
+			}
+		}
+	}
+}
+
+void UBioCharacterSpawnSubsystem::DestroyBot(AAIController* Controller)
+{
+	if (APawn* Pawn = Controller->GetPawn())
+	{
+		Controller->UnPossess();
+		Pawn->Destroy();
+	}
+
+	Controller->Destroy();
+}
+
+void UBioCharacterSpawnSubsystem::RecordLatency(double RequestTime)
+{
+	const double Latency = FPlatformTime::Seconds() - RequestTime;
+
+	TotalLatency += Latency;
+	SpawnStats.MaxLatency = FMath::Max(SpawnStats.MaxLatency, static_cast<float>(Latency));
+}
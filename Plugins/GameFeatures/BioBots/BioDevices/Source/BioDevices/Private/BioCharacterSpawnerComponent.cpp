@@ -3,7 +3,12 @@
 
 #include "BioCharacterSpawnerComponent.h"
 
+#include "AIController.h"
+#include "BioCharacterSpawnSubsystem.h"
+#include "Bot/BotaniBotController.h"
+#include "Bot/BotaniBotDefinition.h"
 #include "Character/Components/BotaniHealthComponent.h"
+#include "GameFramework/Character.h"
 
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(BioCharacterSpawnerComponent)
@@ -13,6 +18,7 @@ UBioCharacterSpawnerComponent::UBioCharacterSpawnerComponent(const FObjectInitia
 {
 	SpawnCount = 1;
 	BotDefinition = nullptr;
+	BotControllerClass = ABotaniBotController::StaticClass();
 	bDespawnAIOnDisable = false;
 }
 
@@ -58,24 +64,36 @@ void UBioCharacterSpawnerComponent::StopSpawning()
 		SpawnTimerHandle.Invalidate();
 	}
 
+	UBioCharacterSpawnSubsystem* SpawnSubsystem = UBioCharacterSpawnSubsystem::GetForActor(GetOwner());
+	if (SpawnSubsystem)
+	{
+		SpawnSubsystem->CancelSpawnRequests(this);
+	}
+
 	if (bDespawnAIOnDisable)
 	{
-		for (auto& Key : SpawnedAIs)
+		PruneSpawnedAIs();
+
+		for (const TWeakObjectPtr<AAIController>& WeakController : SpawnedAIs)
 		{
-			UObject* Obj = Key.ResolveObjectPtr();
-			
-			if (Obj == nullptr)
+			AAIController* Controller = WeakController.Get();
+			if (Controller == nullptr)
 			{
 				continue;
 			}
 
-			if (UBotaniHealthComponent* HealthComponent = UBotaniHealthComponent::FindHealthComponent(Cast<AActor>(Obj)))
+			// Living AIs go back to the pool instead of being destroyed
+			if (SpawnSubsystem)
+			{
+				SpawnSubsystem->ReleaseBot(BotDefinition, Controller);
+			}
+			else if (UBotaniHealthComponent* HealthComponent = UBotaniHealthComponent::FindHealthComponent(Controller->GetPawn()))
 			{
 				HealthComponent->DamageSelfDestruct(true);
 			}
 			else
 			{
-				Obj->ConditionalBeginDestroy();
+				Controller->Destroy();
 			}
 		}
 
@@ -90,6 +108,11 @@ void UBioCharacterSpawnerComponent::InitializeComponent()
 
 void UBioCharacterSpawnerComponent::UninitializeComponent()
 {
+	if (UBioCharacterSpawnSubsystem* SpawnSubsystem = UBioCharacterSpawnSubsystem::GetForActor(GetOwner()))
+	{
+		SpawnSubsystem->CancelSpawnRequests(this);
+	}
+
 	Super::UninitializeComponent();
 }
 
@@ -105,6 +128,15 @@ FVector UBioCharacterSpawnerComponent::GetSpawnLocation() const
 
 void UBioCharacterSpawnerComponent::TimerCallSpawnAI()
 {
+	const UBioCharacterSpawnSubsystem* SpawnSubsystem = UBioCharacterSpawnSubsystem::GetForActor(GetOwner());
+	const int32 NumPending = SpawnSubsystem ? SpawnSubsystem->GetNumPendingRequests(this) : 0;
+
+	// Only top up to the configured number of active AIs
+	if (PruneSpawnedAIs() + NumPending >= SpawnCount)
+	{
+		return;
+	}
+
 	const FVector SpawnLocation = GetSpawnLocation();
 	const FRotator SpawnRotation = FRotator::ZeroRotator;
 
@@ -113,5 +145,39 @@ void UBioCharacterSpawnerComponent::TimerCallSpawnAI()
 
 void UBioCharacterSpawnerComponent::SpawnAI(const FVector& SpawnLocation, const FRotator& SpawnRotation)
 {
-	
+	if (UBioCharacterSpawnSubsystem* SpawnSubsystem = UBioCharacterSpawnSubsystem::GetForActor(GetOwner()))
+	{
+		SpawnSubsystem->RequestSpawn(this, FTransform(SpawnRotation, SpawnLocation));
+	}
+}
+
+void UBioCharacterSpawnerComponent::HandleBotSpawned(AAIController* Controller)
+{
+	check(Controller);
+
+	SpawnedAIs.Add(Controller);
+
+	// Modifiers are applied on every spawn, pooled AIs may have been modified by another spawner
+	if (BotDefinition)
+	{
+		BotDefinition->ApplyToCharacter(Cast<ACharacter>(Controller->GetPawn()));
+	}
+}
+
+int32 UBioCharacterSpawnerComponent::PruneSpawnedAIs()
+{
+	SpawnedAIs.RemoveAll([](const TWeakObjectPtr<AAIController>& WeakController)
+	{
+		const AAIController* Controller = WeakController.Get();
+		const APawn* Pawn = Controller ? Controller->GetPawn() : nullptr;
+		if (Pawn == nullptr)
+		{
+			return true;
+		}
+
+		const UBotaniHealthComponent* HealthComponent = UBotaniHealthComponent::FindHealthComponent(Pawn);
+		return HealthComponent && HealthComponent->IsDeadOrDying();
+	});
+
+	return SpawnedAIs.Num();
 }
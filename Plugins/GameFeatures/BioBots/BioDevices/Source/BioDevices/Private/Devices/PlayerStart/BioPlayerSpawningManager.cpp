@@ -3,14 +3,29 @@
 
 #include "Devices/PlayerStart/BioPlayerSpawningManager.h"
 
+#include "Algo/BinarySearch.h"
 #include "BotaniLogChannels.h"
-#include "EngineUtils.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/GameFrameworkComponentManager.h"
 #include "Devices/PlayerStart/Device_BioPlayerStart.h"
 #include "Game/BotaniGameModeBase.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/Pawn.h"
+#include "Teams/Subsystem/BotaniTeamSubsystem.h"
 
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(BioPlayerSpawningManager)
 
+namespace BioPlayerSpawningCVars
+{
+	static float OccupancyGridCellSize = 1000.f;
+	static FAutoConsoleVariableRef CVarOccupancyGridCellSize(
+		TEXT("Bio.PlayerStart.OccupancyGridCellSize"),
+		OccupancyGridCellSize,
+		TEXT("Cell size in cm of the grid the player spawning manager sorts pawns into when checking player start occupancy."),
+		ECVF_Default);
+}
+
 UBioPlayerSpawningManager::UBioPlayerSpawningManager(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
@@ -29,55 +44,134 @@ void UBioPlayerSpawningManager::InitializeComponent()
 {
 	Super::InitializeComponent();
 
-	FWorldDelegates::LevelAddedToWorld.AddUObject(this, &ThisClass::OnLevelAdded);
-
-
 	if (ABotaniGameModeBase* BotaniGameMode = GetWorld()->GetAuthGameMode<ABotaniGameModeBase>())
 	{
 		BotaniGameMode->DeterminePlayerStartSpot.BindUObject(this, &ThisClass::DeterminePlayerStartSpot);
 	}
 
-	UWorld* World = GetWorld();
-	World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &ThisClass::HandleOnActorSpawned));
-
-	for (TActorIterator<ADevice_BioPlayerStart> It(World); It; ++It)
+	// Player start devices are game framework component receivers, so we're told about every existing one right away
+	// and about every one that is added or removed afterward, including streamed levels.
+	if (UGameFrameworkComponentManager* ComponentManager = UGameFrameworkComponentManager::GetForActor(GetOwner()))
 	{
-		ADevice_BioPlayerStart* PlayerStart = *It;
-		if (PlayerStart == nullptr)
-		{
-			continue;
-		}
-
-		PlayerStartDevices.Add(PlayerStart);
+		PlayerStartExtensionHandle = ComponentManager->AddExtensionHandler(ADevice_BioPlayerStart::StaticClass(),
+			UGameFrameworkComponentManager::FExtensionHandlerDelegate::CreateUObject(this, &ThisClass::HandlePlayerStartExtension));
 	}
 }
 
+void UBioPlayerSpawningManager::UninitializeComponent()
+{
+	PlayerStartExtensionHandle.Reset();
+	PlayerStartBuckets.Reset();
+	CachedPawns.Reset();
+	PawnGrid.Reset();
+
+	Super::UninitializeComponent();
+}
+
 void UBioPlayerSpawningManager::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 }
 
-void UBioPlayerSpawningManager::OnLevelAdded(ULevel* InLevel, UWorld* InWorld)
+FIntPoint UBioPlayerSpawningManager::GetGridCell(const FVector& Location) const
 {
-	if (InWorld != GetWorld())
+	const float CellSize = FMath::Max(BioPlayerSpawningCVars::OccupancyGridCellSize, 100.f);
+	return FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+}
+
+template <typename FuncType>
+void UBioPlayerSpawningManager::ForEachCachedPawnInRadius(const FVector& Location, float Radius, FuncType&& Func) const
+{
+	if (CachedPawns.Num() == 0)
 	{
 		return;
 	}
 
-	for (AActor* Actor : InLevel->Actors)
+	const FIntPoint MinCell = GetGridCell(Location - FVector(Radius, Radius, 0.f));
+	const FIntPoint MaxCell = GetGridCell(Location + FVector(Radius, Radius, 0.f));
+	const float RadiusSquared = FMath::Square(Radius);
+
+	for (int32 CellX = MinCell.X; CellX <= MaxCell.X; ++CellX)
 	{
-		if (ADevice_BioPlayerStart* PlayerStart = Cast<ADevice_BioPlayerStart>(Actor))
+		for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; ++CellY)
 		{
-			PlayerStartDevices.Add(PlayerStart);
+			const TArray<int32>* PawnIndices = PawnGrid.Find(FIntPoint(CellX, CellY));
+			if (PawnIndices == nullptr)
+			{
+				continue;
+			}
+
+			for (const int32 PawnIndex : *PawnIndices)
+			{
+				const FCachedPawn& CachedPawn = CachedPawns[PawnIndex];
+				const float DistanceSquared2D = FVector::DistSquared2D(CachedPawn.Location, Location);
+				if (DistanceSquared2D <= RadiusSquared)
+				{
+					Func(CachedPawn, DistanceSquared2D);
+				}
+			}
 		}
 	}
 }
 
-void UBioPlayerSpawningManager::HandleOnActorSpawned(AActor* Actor)
+void UBioPlayerSpawningManager::HandlePlayerStartExtension(AActor* Actor, FName EventName)
 {
-	if (ADevice_BioPlayerStart* PlayerStart = Cast<ADevice_BioPlayerStart>(Actor))
+	ADevice_BioPlayerStart* PlayerStart = Cast<ADevice_BioPlayerStart>(Actor);
+	if (PlayerStart == nullptr)
+	{
+		return;
+	}
+
+	if ((EventName == UGameFrameworkComponentManager::NAME_ExtensionRemoved) || (EventName == UGameFrameworkComponentManager::NAME_ReceiverRemoved))
+	{
+		RemovePlayerStart(PlayerStart);
+	}
+	else if ((EventName == UGameFrameworkComponentManager::NAME_ExtensionAdded) || (EventName == UGameFrameworkComponentManager::NAME_GameActorReady))
 	{
-		PlayerStartDevices.Add(PlayerStart);
+		AddPlayerStart(PlayerStart);
+	}
+}
+
+void UBioPlayerSpawningManager::AddPlayerStart(ADevice_BioPlayerStart* PlayerStart)
+{
+	const int32 Priority = PlayerStart->GetPriority();
+
+	// Buckets are sorted by descending priority
+	const int32 BucketIndex = Algo::LowerBoundBy(PlayerStartBuckets, Priority, &FPlayerStartBucket::Priority, TGreater<>());
+	if (!PlayerStartBuckets.IsValidIndex(BucketIndex) || PlayerStartBuckets[BucketIndex].Priority != Priority)
+	{
+		PlayerStartBuckets.Insert(FPlayerStartBucket(), BucketIndex);
+		PlayerStartBuckets[BucketIndex].Priority = Priority;
+	}
+
+	TArray<FPlayerStartEntry>& Starts = PlayerStartBuckets[BucketIndex].Starts;
+	if (Starts.ContainsByPredicate([PlayerStart](const FPlayerStartEntry& Entry) { return Entry.PlayerStart == PlayerStart; }))
+	{
+		return;
+	}
+
+	FPlayerStartEntry& Entry = Starts.AddDefaulted_GetRef();
+	Entry.PlayerStart = PlayerStart;
+	Entry.Location = PlayerStart->GetActorLocation();
+	PlayerStart->GetCapsuleComponent()->GetScaledCapsuleSize(Entry.Radius, Entry.HalfHeight);
+
+	// Make sure the new start gets an occupancy before it's picked
+	LastOccupancyRefreshTime = -UE_BIG_NUMBER;
+}
+
+void UBioPlayerSpawningManager::RemovePlayerStart(ADevice_BioPlayerStart* PlayerStart)
+{
+	for (int32 BucketIndex = 0; BucketIndex < PlayerStartBuckets.Num(); ++BucketIndex)
+	{
+		TArray<FPlayerStartEntry>& Starts = PlayerStartBuckets[BucketIndex].Starts;
+		if (Starts.RemoveAllSwap([PlayerStart](const FPlayerStartEntry& Entry) { return Entry.PlayerStart == PlayerStart; }) > 0)
+		{
+			if (Starts.Num() == 0)
+			{
+				PlayerStartBuckets.RemoveAt(BucketIndex);
+			}
+			return;
+		}
 	}
 }
 
@@ -88,37 +182,187 @@ AActor* UBioPlayerSpawningManager::DeterminePlayerStartSpot(AController* Player)
 		return nullptr;
 	}
 
-	TArray<ADevice_BioPlayerStart*> ValidPlayerStarts;
-	for (auto StartIt = PlayerStartDevices.CreateIterator(); StartIt; ++StartIt)
+	RefreshOccupancyIfStale();
+
+	FPlayerStartEntry* ChosenEntry = (SelectionMode == EBioPlayerStartSelectionMode::Scored) ? ChooseByScore(Player) : ChooseByPriority(Player);
+	if (ChosenEntry == nullptr)
 	{
-		ADevice_BioPlayerStart* StartDevice = StartIt->Get();
-		if (StartDevice == nullptr)
+		BOTANI_GFP_LOG(Warning, TEXT("No free player start device found for %s"), *GetNameSafe(Player));
+		return nullptr;
+	}
+
+	// Keep the following respawns of this refresh window away from this start
+	ChosenEntry->Occupancy = EBotaniPlayerStartLocationOccupancy::Full;
+
+	return ChosenEntry->PlayerStart.Get();
+}
+
+UBioPlayerSpawningManager::FPlayerStartEntry* UBioPlayerSpawningManager::ChooseByPriority(AController* Player)
+{
+	// Prefer free starts of the highest priority, fall back to partially occupied ones
+	for (const EBotaniPlayerStartLocationOccupancy::Type AcceptedOccupancy : { EBotaniPlayerStartLocationOccupancy::Empty, EBotaniPlayerStartLocationOccupancy::Partial })
+	{
+		for (FPlayerStartBucket& Bucket : PlayerStartBuckets)
 		{
-			StartIt.RemoveCurrent();
-			continue;
+			FPlayerStartEntry* ChosenEntry = nullptr;
+			int32 NumCandidates = 0;
+
+			for (FPlayerStartEntry& Entry : Bucket.Starts)
+			{
+				const ADevice_BioPlayerStart* StartDevice = Entry.PlayerStart.Get();
+				if (StartDevice == nullptr || !StartDevice->IsDeviceEnabled() || Entry.Occupancy != AcceptedOccupancy)
+				{
+					continue;
+				}
+
+				// Reservoir sampling, uniformly random among the candidates of this priority
+				if (FMath::RandRange(0, NumCandidates++) == 0)
+				{
+					ChosenEntry = &Entry;
+				}
+			}
+
+			if (ChosenEntry)
+			{
+				return ChosenEntry;
+			}
 		}
+	}
+
+	return nullptr;
+}
+
+UBioPlayerSpawningManager::FPlayerStartEntry* UBioPlayerSpawningManager::ChooseByScore(AController* Player)
+{
+	const int32 TeamId = UBotaniTeamSubsystem::FindTeamFromObject(Player);
+
+	FPlayerStartEntry* ChosenEntry = nullptr;
+	float BestScore = -UE_BIG_NUMBER;
+
+	for (FPlayerStartBucket& Bucket : PlayerStartBuckets)
+	{
+		const float PriorityScore = Bucket.Priority * PriorityWeight;
+
+		for (FPlayerStartEntry& Entry : Bucket.Starts)
+		{
+			const ADevice_BioPlayerStart* StartDevice = Entry.PlayerStart.Get();
+			if (StartDevice == nullptr || !StartDevice->IsDeviceEnabled() || Entry.Occupancy == EBotaniPlayerStartLocationOccupancy::Full)
+			{
+				continue;
+			}
+
+			float Score = PriorityScore + GetProximityScore(Entry, TeamId);
+			if (Entry.Occupancy == EBotaniPlayerStartLocationOccupancy::Partial)
+			{
+				Score -= PartialOccupancyPenalty;
+			}
 
-		if (!StartDevice->IsDeviceEnabled())
+			if (Score > BestScore)
+			{
+				BestScore = Score;
+				ChosenEntry = &Entry;
+			}
+		}
+	}
+
+	return ChosenEntry;
+}
+
+void UBioPlayerSpawningManager::RefreshOccupancyIfStale()
+{
+	const UWorld* World = GetWorld();
+	const double Now = World->GetTimeSeconds();
+	if ((Now - LastOccupancyRefreshTime) < OccupancyRefreshInterval)
+	{
+		return;
+	}
+
+	LastOccupancyRefreshTime = Now;
+
+	// Sort every controlled pawn into the grid
+	CachedPawns.Reset();
+	PawnGrid.Reset();
+	MaxCachedPawnRadius = 0.f;
+
+	for (FConstControllerIterator It = World->GetControllerIterator(); It; ++It)
+	{
+		const AController* Controller = It->Get();
+		const APawn* Pawn = Controller ? Controller->GetPawn() : nullptr;
+		if (Pawn == nullptr)
 		{
-			StartIt.RemoveCurrent();
 			continue;
 		}
 
-		ValidPlayerStarts.Add(StartDevice);
+		FCachedPawn& CachedPawn = CachedPawns.AddDefaulted_GetRef();
+		CachedPawn.Location = Pawn->GetActorLocation();
+		CachedPawn.Radius = Pawn->GetSimpleCollisionRadius();
+		CachedPawn.TeamId = UBotaniTeamSubsystem::FindTeamFromObject(Controller);
+
+		MaxCachedPawnRadius = FMath::Max(MaxCachedPawnRadius, CachedPawn.Radius);
+		PawnGrid.FindOrAdd(GetGridCell(CachedPawn.Location)).Add(CachedPawns.Num() - 1);
 	}
 
-	BOTANI_GFP_LOG(Warning, TEXT("ValidPlayerStarts.Num() = %d"), ValidPlayerStarts.Num());
+	for (FPlayerStartBucket& Bucket : PlayerStartBuckets)
+	{
+		for (FPlayerStartEntry& Entry : Bucket.Starts)
+		{
+			Entry.Occupancy = ComputeOccupancy(Entry);
+			Entry.ProximityScores.Reset();
+		}
+	}
+}
 
-	auto SortByPriority = [](const ADevice_BioPlayerStart& A, const ADevice_BioPlayerStart& B)
+EBotaniPlayerStartLocationOccupancy::Type UBioPlayerSpawningManager::ComputeOccupancy(const FPlayerStartEntry& Entry) const
+{
+	const ADevice_BioPlayerStart* StartDevice = Entry.PlayerStart.Get();
+	if (StartDevice == nullptr || StartDevice->IsClaimed())
 	{
-		return A.GetPriority() > B.GetPriority();
-	};
+		return EBotaniPlayerStartLocationOccupancy::Full;
+	}
 
-	ValidPlayerStarts.Sort(SortByPriority);
-	if (ValidPlayerStarts.IsValidIndex(0))
+	// A pawn overlapping the start's capsule blocks it, one standing right next to it only partially
+	EBotaniPlayerStartLocationOccupancy::Type Occupancy = EBotaniPlayerStartLocationOccupancy::Empty;
+	ForEachCachedPawnInRadius(Entry.Location, (Entry.Radius + MaxCachedPawnRadius) * 2.f, [&](const FCachedPawn& CachedPawn, float DistanceSquared2D)
 	{
-		return ValidPlayerStarts[0];
+		if (FMath::Abs(CachedPawn.Location.Z - Entry.Location.Z) > Entry.HalfHeight * 2.f)
+		{
+			return;
+		}
+
+		const float BlockingDistance = Entry.Radius + CachedPawn.Radius;
+		if (DistanceSquared2D < FMath::Square(BlockingDistance))
+		{
+			Occupancy = EBotaniPlayerStartLocationOccupancy::Full;
+		}
+		else if (DistanceSquared2D < FMath::Square(BlockingDistance * 2.f) && Occupancy == EBotaniPlayerStartLocationOccupancy::Empty)
+		{
+			Occupancy = EBotaniPlayerStartLocationOccupancy::Partial;
+		}
+	});
+
+	return Occupancy;
+}
+
+float UBioPlayerSpawningManager::GetProximityScore(FPlayerStartEntry& Entry, int32 TeamId) const
+{
+	// Every player of a team shares the same score until the next refresh
+	for (const TPair<int32, float>& CachedScore : Entry.ProximityScores)
+	{
+		if (CachedScore.Key == TeamId)
+		{
+			return CachedScore.Value;
+		}
 	}
-	
-	return nullptr;
+
+	float Score = 0.f;
+	ForEachCachedPawnInRadius(Entry.Location, InfluenceRadius, [&](const FCachedPawn& CachedPawn, float DistanceSquared2D)
+	{
+		const float Falloff = 1.f - (FMath::Sqrt(DistanceSquared2D) / InfluenceRadius);
+		const bool bIsTeammate = (TeamId != INDEX_NONE) && (CachedPawn.TeamId == TeamId);
+
+		Score += bIsTeammate ? (TeammateProximityWeight * Falloff) : -(EnemyProximityWeight * Falloff);
+	});
+
+	Entry.ProximityScores.Emplace(TeamId, Score);
+	return Score;
 }
@@ -0,0 +1,155 @@
+// Copyright © 2024 Botanibots Team. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "BioCharacterSpawnSubsystem.generated.h"
+
+class AAIController;
+class UBioCharacterSpawnerComponent;
+class UBotaniBotDefinition;
+
+/**
+ * FBioCharacterSpawnStats
+ *
+ * Spawn statistics of all character spawners in a world.
+ * Latency is measured from the spawn request to the bot being possessed and placed in the world.
+ */
+USTRUCT(BlueprintType)
+struct FBioCharacterSpawnStats
+{
+	GENERATED_BODY()
+
+	/** Number of spawns that were requested by spawners. */
+	UPROPERTY(BlueprintReadOnly, Category = "Spawner")
+	int32 NumRequested = 0;
+
+	/** Number of bots that were spawned from scratch. */
+	UPROPERTY(BlueprintReadOnly, Category = "Spawner")
+	int32 NumSpawned = 0;
+
+	/** Number of bots that were taken out of the pool. */
+	UPROPERTY(BlueprintReadOnly, Category = "Spawner")
+	int32 NumReused = 0;
+
+	/** Number of bots that are currently waiting in the pool. */
+	UPROPERTY(BlueprintReadOnly, Category = "Spawner")
+	int32 NumPooled = 0;
+
+	/** Number of requests that are currently waiting for spawn budget. */
+	UPROPERTY(BlueprintReadOnly, Category = "Spawner")
+	int32 NumPending = 0;
+
+	/** Average request to spawn latency. */
+	UPROPERTY(BlueprintReadOnly, Category = "Spawner", meta = (Units = "s"))
+	float AverageLatency = 0.f;
+
+	/** Highest request to spawn latency. */
+	UPROPERTY(BlueprintReadOnly, Category = "Spawner", meta = (Units = "s"))
+	float MaxLatency = 0.f;
+
+	/** Average game thread time spent spawning a bot from scratch. */
+	UPROPERTY(BlueprintReadOnly, Category = "Spawner", meta = (Units = "ms"))
+	float AverageSpawnCostMs = 0.f;
+
+	/** Average game thread time spent waking up a pooled bot. */
+	UPROPERTY(BlueprintReadOnly, Category = "Spawner", meta = (Units = "ms"))
+	float AverageReuseCostMs = 0.f;
+
+public:
+	FString ToString() const;
+};
+
+/**
+ * UBioCharacterSpawnSubsystem
+ *
+ * Spawns the bots requested by all character spawners of a world.
+ * Requests are queued and processed under a shared per-frame budget, so wave spawners don't hitch the server.
+ * Bots that get despawned are returned to a pool per bot definition and reused by later requests.
+ */
+UCLASS()
+class BIODEVICES_API UBioCharacterSpawnSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UBioCharacterSpawnSubsystem();
+
+	//~ Begin UWorldSubsystem Interface
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Deinitialize() override;
+	//~ End UWorldSubsystem Interface
+
+	//~ Begin FTickableGameObject Interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface
+
+	/** Utility to get this spawn subsystem from an actor, will return null if actor is null or not in a world. */
+	static UBioCharacterSpawnSubsystem* GetForActor(const AActor* Actor);
+
+	/** Queues a bot spawn for the given spawner. The spawner is notified once the bot is in the world. */
+	void RequestSpawn(UBioCharacterSpawnerComponent* Spawner, const FTransform& SpawnTransform);
+
+	/** Drops all queued requests of the given spawner. */
+	void CancelSpawnRequests(const UBioCharacterSpawnerComponent* Spawner);
+
+	/** Returns the number of queued requests of the given spawner. */
+	int32 GetNumPendingRequests(const UBioCharacterSpawnerComponent* Spawner) const;
+
+	/**
+	 * Puts a living bot to sleep and keeps it for reuse by spawners using the same bot definition.
+	 * Destroys the bot instead if the pool is full.
+	 */
+	void ReleaseBot(const UBotaniBotDefinition* BotDefinition, AAIController* Controller);
+
+	/** Returns the spawn statistics of this world. */
+	UFUNCTION(BlueprintCallable, Category = "Spawner")
+	FBioCharacterSpawnStats GetSpawnStats() const;
+
+private:
+	struct FSpawnRequest
+	{
+		TWeakObjectPtr<UBioCharacterSpawnerComponent> Spawner;
+		FTransform SpawnTransform;
+		double RequestTime = 0.0;
+	};
+
+	struct FPooledBot
+	{
+		TWeakObjectPtr<AAIController> Controller;
+		TSubclassOf<AAIController> ControllerClass;
+	};
+
+	/** Processes a single request. Returns false if the request failed. */
+	bool ProcessRequest(const FSpawnRequest& Request);
+
+	/** Takes a matching bot out of the pool and wakes it up at the given transform. */
+	AAIController* AcquirePooledBot(const UBotaniBotDefinition* BotDefinition, TSubclassOf<AAIController> ControllerClass, const FTransform& SpawnTransform);
+
+	/** Spawns a new controller and lets the game mode spawn its pawn at the given transform. */
+	AAIController* SpawnNewBot(TSubclassOf<AAIController> ControllerClass, const FTransform& SpawnTransform);
+
+	/** Hides, freezes and stops the logic of a bot, or reverses it. */
+	static void SetBotDormant(AAIController* Controller, bool bDormant);
+
+	/** Destroys a bot and its pawn. */
+	static void DestroyBot(AAIController* Controller);
+
+	void RecordLatency(double RequestTime);
+
+private:
+	/** Requests waiting for spawn budget, in request order */
+	TArray<FSpawnRequest> PendingRequests;
+
+	/** Dormant bots, keyed by the bot definition they were spawned with */
+	TMap<FObjectKey, TArray<FPooledBot>> BotPool;
+
+	/** Stats */
+	FBioCharacterSpawnStats SpawnStats;
+	double TotalLatency = 0.0;
+	double TotalSpawnCostMs = 0.0;
+	double TotalReuseCostMs = 0.0;
+};
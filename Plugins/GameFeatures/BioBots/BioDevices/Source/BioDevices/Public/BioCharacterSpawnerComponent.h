@@ -6,6 +6,8 @@
 #include "Game/Components/BotaniGameplayReceiverMessageComponent.h"
 #include "BioCharacterSpawnerComponent.generated.h"
 
+class AAIController;
+
 /**
  * UBioCharacterSpawnerComponent
  *
@@ -43,8 +45,14 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spawner")
 	TObjectPtr<class UBotaniBotDefinition> BotDefinition;
 
+	/** The controller class that will possess the spawned AI */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spawner", AdvancedDisplay)
+	TSubclassOf<AAIController> BotControllerClass;
 		
-	/** When the device is disabled, this determines whether already spawned AIs remain or are despawned. */
+	/**
+	 * When the device is disabled, this determines whether already spawned AIs remain or are despawned.
+	 * Despawned AIs are kept in a pool and reused by spawners with the same Bot Definition.
+	 */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spawner", AdvancedDisplay, meta = (DisplayName = "Despawn AIs when Disabled"))
 	uint32 bDespawnAIOnDisable : 1;
 
@@ -60,12 +68,21 @@ protected:
 	/** Called by the timer to spawn a single AI. */
 	void TimerCallSpawnAI();
 
+	/** Requests a single AI, which is spawned by the spawn subsystem once there is budget for it. */
 	virtual void SpawnAI(const FVector& SpawnLocation, const FRotator& SpawnRotation);
 
+	/** Called by the spawn subsystem once a requested AI was spawned or taken out of the pool. */
+	virtual void HandleBotSpawned(AAIController* Controller);
+
+	/** Forgets about AIs that died or got destroyed, returns the number of AIs that are still alive. */
+	int32 PruneSpawnedAIs();
+
 private:
+	friend class UBioCharacterSpawnSubsystem;
+
 	/** The timer handle used to spawn the AI */
 	FTimerHandle SpawnTimerHandle;
 
 	/** List of AI's that have been spawned */
-	TArray<FObjectKey> SpawnedAIs;
+	TArray<TWeakObjectPtr<AAIController>> SpawnedAIs;
 };
@@ -4,12 +4,33 @@
 
 #include "CoreMinimal.h"
 #include "Components/GameStateComponent.h"
+#include "Player/BotaniPlayerStart.h"
 #include "BioPlayerSpawningManager.generated.h"
 
+class ADevice_BioPlayerStart;
+struct FComponentRequestHandle;
+
+/**
+ * EBioPlayerStartSelectionMode
+ *
+ * How the spawning manager picks a player start.
+ */
+UENUM(BlueprintType)
+enum class EBioPlayerStartSelectionMode : uint8
+{
+	/** Picks a free start of the highest priority, randomly among starts of the same priority. */
+	Priority,
+
+	/** Scores every free start by priority, distance to enemies and closeness to teammates. */
+	Scored
+};
+
 /**
  * UBioPlayerSpawningManager
  *
  * A player spawning manager for BioDevices
+ * Player start devices are kept in priority buckets as they come and go, and pawn positions are cached in a coarse grid
+ * that is refreshed at a fixed rate, so many simultaneous respawns don't each scan the world or run overlap checks.
  */
 UCLASS()
 class BIODEVICES_API UBioPlayerSpawningManager : public UGameStateComponent
@@ -19,16 +40,95 @@ class BIODEVICES_API UBioPlayerSpawningManager : public UGameStateComponent
 public:
 	//~ Begin UActorComponent Interface
 	virtual void InitializeComponent() override;
+	virtual void UninitializeComponent() override;
 	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 	//~ End UActorComponent Interface
+
 protected:
+	/** How player starts are picked */
+	UPROPERTY(EditDefaultsOnly, Category = "Spawning")
+	EBioPlayerStartSelectionMode SelectionMode = EBioPlayerStartSelectionMode::Priority;
+
+	/** Maximum age of the cached occupancy, before the next spawn request refreshes it */
+	UPROPERTY(EditDefaultsOnly, Category = "Spawning", meta = (ClampMin = "0", ForceUnits = "s"))
+	float OccupancyRefreshInterval = 0.25f;
+
+	/** Score per point of player start priority */
+	UPROPERTY(EditDefaultsOnly, Category = "Spawning|Scoring", meta = (EditCondition = "SelectionMode == EBioPlayerStartSelectionMode::Scored"))
+	float PriorityWeight = 100.f;
+
+	/** Score subtracted from starts that are only partially free */
+	UPROPERTY(EditDefaultsOnly, Category = "Spawning|Scoring", meta = (EditCondition = "SelectionMode == EBioPlayerStartSelectionMode::Scored"))
+	float PartialOccupancyPenalty = 250.f;
+
+	/** Pawns within this distance of a start influence its score */
+	UPROPERTY(EditDefaultsOnly, Category = "Spawning|Scoring", meta = (EditCondition = "SelectionMode == EBioPlayerStartSelectionMode::Scored", ClampMin = "1", ForceUnits = "cm"))
+	float InfluenceRadius = 3000.f;
+
+	/** Score subtracted for an enemy standing on the start, falling off with distance */
+	UPROPERTY(EditDefaultsOnly, Category = "Spawning|Scoring", meta = (EditCondition = "SelectionMode == EBioPlayerStartSelectionMode::Scored"))
+	float EnemyProximityWeight = 400.f;
+
+	/** Score added for a teammate standing on the start, falling off with distance */
+	UPROPERTY(EditDefaultsOnly, Category = "Spawning|Scoring", meta = (EditCondition = "SelectionMode == EBioPlayerStartSelectionMode::Scored"))
+	float TeammateProximityWeight = 50.f;
+
 private:
-	virtual void OnLevelAdded(ULevel* InLevel, UWorld* InWorld);
-	virtual void HandleOnActorSpawned(AActor* Actor);
-	
+	struct FPlayerStartEntry
+	{
+		TWeakObjectPtr<ADevice_BioPlayerStart> PlayerStart;
+		FVector Location = FVector::ZeroVector;
+		float Radius = 0.f;
+		float HalfHeight = 0.f;
+
+		/** Cached at the last occupancy refresh, or marked full once picked until the next one */
+		EBotaniPlayerStartLocationOccupancy::Type Occupancy = EBotaniPlayerStartLocationOccupancy::Empty;
+
+		/** Proximity score per team id, cleared on every occupancy refresh */
+		TArray<TPair<int32, float>, TInlineAllocator<4>> ProximityScores;
+	};
+
+	struct FPlayerStartBucket
+	{
+		int32 Priority = 0;
+		TArray<FPlayerStartEntry> Starts;
+	};
+
+	struct FCachedPawn
+	{
+		FVector Location = FVector::ZeroVector;
+		float Radius = 0.f;
+		int32 TeamId = INDEX_NONE;
+	};
+
+	void HandlePlayerStartExtension(AActor* Actor, FName EventName);
+	void AddPlayerStart(ADevice_BioPlayerStart* PlayerStart);
+	void RemovePlayerStart(ADevice_BioPlayerStart* PlayerStart);
+
 	virtual AActor* DeterminePlayerStartSpot(AController* Player);
+	FPlayerStartEntry* ChooseByPriority(AController* Player);
+	FPlayerStartEntry* ChooseByScore(AController* Player);
+
+	/** Rebuilds the pawn grid and the occupancy of every start, if the cache is older than the refresh interval */
+	void RefreshOccupancyIfStale();
+	EBotaniPlayerStartLocationOccupancy::Type ComputeOccupancy(const FPlayerStartEntry& Entry) const;
+	float GetProximityScore(FPlayerStartEntry& Entry, int32 TeamId) const;
+
+	FIntPoint GetGridCell(const FVector& Location) const;
+
+	template <typename FuncType>
+	void ForEachCachedPawnInRadius(const FVector& Location, float Radius, FuncType&& Func) const;
 
 private:
-	UPROPERTY(Transient)
-	TArray<TWeakObjectPtr<class ADevice_BioPlayerStart>> PlayerStartDevices;
+	/** Player start devices, by descending priority */
+	TArray<FPlayerStartBucket> PlayerStartBuckets;
+
+	/** Keeps us notified of player start devices being added or removed */
+	TSharedPtr<FComponentRequestHandle> PlayerStartExtensionHandle;
+
+	/** Pawn positions at the last occupancy refresh, indexed by grid cell */
+	TArray<FCachedPawn> CachedPawns;
+	TMap<FIntPoint, TArray<int32>> PawnGrid;
+	float MaxCachedPawnRadius = 0.f;
+	double LastOccupancyRefreshTime = -UE_BIG_NUMBER;
 };
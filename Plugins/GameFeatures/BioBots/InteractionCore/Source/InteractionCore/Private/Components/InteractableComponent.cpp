@@ -0,0 +1,25 @@
+// Copyright © 2024 Botanibots Team. All rights reserved.
+
+
+#include "Components/InteractableComponent.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(InteractableComponent)
+
+UInteractableComponent::UInteractableComponent(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	SetCollisionProfileName(TEXT("Botani_ScanInteraction"));
+	SetGenerateOverlapEvents(false);
+	SetCanEverAffectNavigation(false);
+}
+
+void UInteractableComponent::GatherInteractionOptions(const FBotaniInteractionQuery& InteractionQuery, FBotaniInteractionOptionBuilder& OptionBuilder)
+{
+	OptionBuilder.AddInteractionOption(InteractionOption);
+}
+
+int32 UInteractableComponent::GetInteractionOptionsGeneration() const
+{
+	// The interaction option is set up in the defaults and never changes at runtime
+	return 0;
+}
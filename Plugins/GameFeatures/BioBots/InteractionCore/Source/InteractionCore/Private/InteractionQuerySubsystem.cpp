@@ -0,0 +1,536 @@
+// Copyright © 2024 Botanibots Team. All rights reserved.
+
+
+#include "InteractionQuerySubsystem.h"
+
+#include "BotaniLogChannels.h"
+#include "Components/PrimitiveComponent.h"
+#include "Components/SceneComponent.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "InteractionStatics.h"
+#include "Interfaces/InteractableTarget.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(InteractionQuerySubsystem)
+
+namespace InteractionQueryCVars
+{
+	static float GridCellSize = 500.f;
+	static FAutoConsoleVariableRef CVarGridCellSize(
+		TEXT("Interaction.Query.GridCellSize"),
+		GridCellSize,
+		TEXT("Cell size in cm of the interactable registry grid. Only applies to worlds created afterward."),
+		ECVF_Default);
+
+	static float UpdateIntervalScale = 1.f;
+	static FAutoConsoleVariableRef CVarUpdateIntervalScale(
+		TEXT("Interaction.Query.UpdateIntervalScale"),
+		UpdateIntervalScale,
+		TEXT("Scales the update interval of every interaction querier. Larger values trade responsiveness for less work."),
+		ECVF_Default);
+
+	static FAutoConsoleCommandWithWorld CmdDumpStats(
+		TEXT("Interaction.Query.DumpStats"),
+		TEXT("Logs the number of registered interactables and queriers of the current world."),
+		FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+		{
+			if (const UInteractionQuerySubsystem* Subsystem = UInteractionQuerySubsystem::Get(World))
+			{
+				UE_LOG(LogBotani, Display, TEXT("%s"), *Subsystem->GetDebugString());
+			}
+		}));
+}
+
+UInteractionQuerySubsystem::UInteractionQuerySubsystem()
+{
+}
+
+bool UInteractionQuerySubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	if (!Super::ShouldCreateSubsystem(Outer))
+	{
+		return false;
+	}
+
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld();
+}
+
+void UInteractionQuerySubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// Interactables don't need to know about the registry, pick them up as they come and go
+	ActorSpawnedHandle = InWorld.AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &ThisClass::RegisterActorInteractables));
+	ActorDestroyedHandle = InWorld.AddOnActorDestroyedHandler(FOnActorDestroyed::FDelegate::CreateUObject(this, &ThisClass::UnregisterActorInteractables));
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &ThisClass::HandleLevelAddedToWorld);
+	LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &ThisClass::HandleLevelRemovedFromWorld);
+
+	for (ULevel* Level : InWorld.GetLevels())
+	{
+		HandleLevelAddedToWorld(Level, &InWorld);
+	}
+}
+
+void UInteractionQuerySubsystem::Deinitialize()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+		World->RemoveOnActorDestroyededHandler(ActorDestroyedHandle);
+	}
+
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+
+	for (const FInteractableEntry& Entry : Entries)
+	{
+		if (USceneComponent* SceneComponent = Entry.SceneComponent.Get())
+		{
+			SceneComponent->TransformUpdated.Remove(Entry.TransformUpdatedHandle);
+		}
+	}
+
+	Entries.Empty();
+	EntryIndexByObject.Empty();
+	Grid.Empty();
+	Queriers.Empty();
+
+	Super::Deinitialize();
+}
+
+void UInteractionQuerySubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	// Collect first, change notifications may add or remove queriers
+	TArray<FObjectKey, TInlineAllocator<32>> DueQueriers;
+	for (auto It = Queriers.CreateIterator(); It; ++It)
+	{
+		FQuerier& Querier = It.Value();
+		if (!Querier.Avatar.IsValid())
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		if (Now >= Querier.NextUpdateTime)
+		{
+			Querier.NextUpdateTime = Now + (Querier.UpdateInterval * InteractionQueryCVars::UpdateIntervalScale);
+			DueQueriers.Add(It.Key());
+		}
+	}
+
+	for (const FObjectKey& QuerierKey : DueQueriers)
+	{
+		if (FQuerier* Querier = Queriers.Find(QuerierKey))
+		{
+			UpdateQuerier(*Querier);
+		}
+	}
+}
+
+bool UInteractionQuerySubsystem::IsTickable() const
+{
+	return !IsTemplate() && Queriers.Num() > 0;
+}
+
+TStatId UInteractionQuerySubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UInteractionQuerySubsystem, STATGROUP_Tickables);
+}
+
+UInteractionQuerySubsystem* UInteractionQuerySubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UInteractionQuerySubsystem>() : nullptr;
+}
+
+void UInteractionQuerySubsystem::RegisterInteractable(UObject* InteractableObject)
+{
+	if (InteractableObject == nullptr || !InteractableObject->Implements<UInteractableTarget>())
+	{
+		return;
+	}
+
+	if (EntryIndexByObject.Contains(InteractableObject))
+	{
+		return;
+	}
+
+	if (GridCellSize <= 0.f)
+	{
+		GridCellSize = FMath::Max(InteractionQueryCVars::GridCellSize, 50.f);
+	}
+
+	USceneComponent* SceneComponent = Cast<USceneComponent>(InteractableObject);
+	if (SceneComponent == nullptr)
+	{
+		const AActor* Actor = UInteractionStatics::GetActorFromInteractableTarget(InteractableObject);
+		SceneComponent = Actor ? Actor->GetRootComponent() : nullptr;
+	}
+
+	if (SceneComponent == nullptr)
+	{
+		UE_LOG(LogBotani, Warning, TEXT("Interactable [%s] has no scene component and can't be registered for queries."), *GetNameSafe(InteractableObject));
+		return;
+	}
+
+	const int32 EntryIndex = Entries.Add(FInteractableEntry());
+	FInteractableEntry& Entry = Entries[EntryIndex];
+	Entry.Object = InteractableObject;
+	Entry.SceneComponent = SceneComponent;
+	UpdateEntryBounds(Entry);
+
+	// Static interactables never move, no need to listen
+	if (SceneComponent->Mobility != EComponentMobility::Static)
+	{
+		Entry.TransformUpdatedHandle = SceneComponent->TransformUpdated.AddWeakLambda(this, [this, EntryIndex](USceneComponent*, EUpdateTransformFlags, ETeleportType)
+		{
+			HandleEntryMoved(EntryIndex);
+		});
+	}
+
+	EntryIndexByObject.Add(InteractableObject, EntryIndex);
+	MaxEntryRadius = FMath::Max(MaxEntryRadius, Entry.Radius);
+	AddToGrid(EntryIndex);
+}
+
+void UInteractionQuerySubsystem::UnregisterInteractable(UObject* InteractableObject)
+{
+	int32 EntryIndex = INDEX_NONE;
+	if (!EntryIndexByObject.RemoveAndCopyValue(InteractableObject, EntryIndex))
+	{
+		return;
+	}
+
+	RemoveFromGrid(EntryIndex);
+
+	if (USceneComponent* SceneComponent = Entries[EntryIndex].SceneComponent.Get())
+	{
+		SceneComponent->TransformUpdated.Remove(Entries[EntryIndex].TransformUpdatedHandle);
+	}
+
+	Entries.RemoveAt(EntryIndex);
+
+	// Nobody should see the interactable anymore, even before their next update
+	TArray<FObjectKey, TInlineAllocator<8>> ChangedQueriers;
+	for (TPair<FObjectKey, FQuerier>& Pair : Queriers)
+	{
+		if (Pair.Value.NearbyInteractables.RemoveAll([InteractableObject](const TScriptInterface<IInteractableTarget>& Target) { return Target.GetObject() == InteractableObject; }) > 0)
+		{
+			ChangedQueriers.Add(Pair.Key);
+		}
+	}
+
+	for (const FObjectKey& QuerierKey : ChangedQueriers)
+	{
+		if (const FQuerier* Querier = Queriers.Find(QuerierKey))
+		{
+			// Copied, listeners may remove the querier while being notified
+			const FOnNearbyInteractablesChanged OnChanged = Querier->OnChanged;
+			OnChanged.Broadcast();
+		}
+	}
+}
+
+void UInteractionQuerySubsystem::QueryInteractablesInSphere(const FVector& Center, float Radius, TArray<TScriptInterface<IInteractableTarget>>& OutInteractableTargets) const
+{
+	if (Entries.Num() == 0)
+	{
+		return;
+	}
+
+	const float SearchRadius = Radius + MaxEntryRadius;
+	const FIntVector MinCell = GetGridCell(Center - FVector(SearchRadius));
+	const FIntVector MaxCell = GetGridCell(Center + FVector(SearchRadius));
+
+	for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+		{
+			for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+			{
+				const TArray<int32>* CellEntries = Grid.Find(FIntVector(X, Y, Z));
+				if (CellEntries == nullptr)
+				{
+					continue;
+				}
+
+				for (const int32 EntryIndex : *CellEntries)
+				{
+					const FInteractableEntry& Entry = Entries[EntryIndex];
+					if (FVector::DistSquared(Center, Entry.Location) > FMath::Square(Radius + Entry.Radius))
+					{
+						continue;
+					}
+
+					if (UObject* Object = Entry.Object.Get())
+					{
+						OutInteractableTargets.Add(TScriptInterface<IInteractableTarget>(Object));
+					}
+				}
+			}
+		}
+	}
+}
+
+FDelegateHandle UInteractionQuerySubsystem::AddQuerier(AActor* Avatar, float Range, float UpdateInterval, const FOnNearbyInteractablesChanged::FDelegate& OnChanged)
+{
+	if (Avatar == nullptr)
+	{
+		return FDelegateHandle();
+	}
+
+	FQuerier& Querier = Queriers.FindOrAdd(Avatar);
+	const bool bNewQuerier = !Querier.Avatar.IsValid();
+	Querier.Avatar = Avatar;
+
+	const FDelegateHandle Handle = Querier.OnChanged.Add(OnChanged);
+
+	FQuerierSubscription& Subscription = Querier.Subscriptions.AddDefaulted_GetRef();
+	Subscription.Handle = Handle;
+	Subscription.Range = Range;
+	Subscription.UpdateInterval = UpdateInterval;
+
+	RefreshQuerierSettings(Querier);
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	if (bNewQuerier)
+	{
+		// Spread the updates of avatars with the same interval over that interval
+		Querier.NextUpdateTime = Now + FMath::FRand() * Querier.UpdateInterval;
+	}
+
+	// Get the new querier going right away, it may have a larger range than what's cached
+	UpdateQuerier(Querier);
+
+	return Handle;
+}
+
+void UInteractionQuerySubsystem::RemoveQuerier(AActor* Avatar, FDelegateHandle Handle)
+{
+	FQuerier* Querier = Queriers.Find(Avatar);
+	if (Querier == nullptr)
+	{
+		return;
+	}
+
+	Querier->OnChanged.Remove(Handle);
+	Querier->Subscriptions.RemoveAll([Handle](const FQuerierSubscription& Subscription) { return Subscription.Handle == Handle; });
+
+	if (Querier->Subscriptions.Num() == 0)
+	{
+		Queriers.Remove(Avatar);
+	}
+	else
+	{
+		RefreshQuerierSettings(*Querier);
+	}
+}
+
+const TArray<TScriptInterface<IInteractableTarget>>& UInteractionQuerySubsystem::GetNearbyInteractables(const AActor* Avatar) const
+{
+	static const TArray<TScriptInterface<IInteractableTarget>> EmptyInteractables;
+
+	const FQuerier* Querier = Queriers.Find(Avatar);
+	return Querier ? Querier->NearbyInteractables : EmptyInteractables;
+}
+
+void UInteractionQuerySubsystem::RegisterActorInteractables(AActor* Actor)
+{
+	if (Actor == nullptr)
+	{
+		return;
+	}
+
+	if (Actor->Implements<UInteractableTarget>())
+	{
+		RegisterInteractable(Actor);
+	}
+
+	for (UActorComponent* Component : Actor->GetComponents())
+	{
+		if (Component && Component->Implements<UInteractableTarget>())
+		{
+			RegisterInteractable(Component);
+		}
+	}
+}
+
+void UInteractionQuerySubsystem::UnregisterActorInteractables(AActor* Actor)
+{
+	if (Actor == nullptr)
+	{
+		return;
+	}
+
+	UnregisterInteractable(Actor);
+
+	for (UActorComponent* Component : Actor->GetComponents())
+	{
+		UnregisterInteractable(Component);
+	}
+}
+
+void UInteractionQuerySubsystem::HandleLevelAddedToWorld(ULevel* Level, UWorld* World)
+{
+	if (Level == nullptr || World != GetWorld())
+	{
+		return;
+	}
+
+	for (AActor* Actor : Level->Actors)
+	{
+		RegisterActorInteractables(Actor);
+	}
+}
+
+void UInteractionQuerySubsystem::HandleLevelRemovedFromWorld(ULevel* Level, UWorld* World)
+{
+	// A null level means the whole world is going away, which Deinitialize takes care of
+	if (Level == nullptr || World != GetWorld())
+	{
+		return;
+	}
+
+	for (AActor* Actor : Level->Actors)
+	{
+		UnregisterActorInteractables(Actor);
+	}
+}
+
+FString UInteractionQuerySubsystem::GetDebugString() const
+{
+	return FString::Printf(TEXT("Interactables: %d, Grid Cells: %d, Max Radius: %.0f, Queriers: %d"),
+		Entries.Num(), Grid.Num(), MaxEntryRadius, Queriers.Num());
+}
+
+void UInteractionQuerySubsystem::UpdateEntryBounds(FInteractableEntry& Entry) const
+{
+	// Primitive components know their bounds, actors are approximated by the bounds of their colliding components
+	if (const UPrimitiveComponent* PrimitiveComponent = Cast<UPrimitiveComponent>(Entry.Object.Get()))
+	{
+		Entry.Location = PrimitiveComponent->Bounds.Origin;
+		Entry.Radius = PrimitiveComponent->Bounds.SphereRadius;
+	}
+	else if (const AActor* Actor = Cast<AActor>(Entry.Object.Get()))
+	{
+		FVector Origin;
+		FVector Extent;
+		Actor->GetActorBounds(/*bOnlyCollidingComponents*/true, Origin, Extent);
+
+		Entry.Location = Origin;
+		Entry.Radius = Extent.Size();
+	}
+	else if (const USceneComponent* SceneComponent = Entry.SceneComponent.Get())
+	{
+		Entry.Location = SceneComponent->GetComponentLocation();
+		Entry.Radius = 0.f;
+	}
+
+	// Actors without colliding components still need a position
+	if (Entry.Radius <= 0.f && Entry.SceneComponent.IsValid())
+	{
+		Entry.Location = Entry.SceneComponent->GetComponentLocation();
+	}
+}
+
+void UInteractionQuerySubsystem::AddToGrid(int32 EntryIndex)
+{
+	FInteractableEntry& Entry = Entries[EntryIndex];
+	Entry.Cell = GetGridCell(Entry.Location);
+	Grid.FindOrAdd(Entry.Cell).Add(EntryIndex);
+}
+
+void UInteractionQuerySubsystem::RemoveFromGrid(int32 EntryIndex)
+{
+	const FInteractableEntry& Entry = Entries[EntryIndex];
+	if (TArray<int32>* CellEntries = Grid.Find(Entry.Cell))
+	{
+		CellEntries->RemoveSingleSwap(EntryIndex);
+		if (CellEntries->Num() == 0)
+		{
+			Grid.Remove(Entry.Cell);
+		}
+	}
+}
+
+void UInteractionQuerySubsystem::HandleEntryMoved(int32 EntryIndex)
+{
+	if (!Entries.IsValidIndex(EntryIndex))
+	{
+		return;
+	}
+
+	FInteractableEntry& Entry = Entries[EntryIndex];
+	const USceneComponent* SceneComponent = Entry.SceneComponent.Get();
+	if (SceneComponent == nullptr)
+	{
+		return;
+	}
+
+	// Bounds are already updated when the transform change is broadcast
+	UpdateEntryBounds(Entry);
+	MaxEntryRadius = FMath::Max(MaxEntryRadius, Entry.Radius);
+
+	const FIntVector NewCell = GetGridCell(Entry.Location);
+	if (NewCell != Entry.Cell)
+	{
+		RemoveFromGrid(EntryIndex);
+		AddToGrid(EntryIndex);
+	}
+}
+
+void UInteractionQuerySubsystem::RefreshQuerierSettings(FQuerier& Querier) const
+{
+	Querier.Range = 0.f;
+	Querier.UpdateInterval = UE_BIG_NUMBER;
+	for (const FQuerierSubscription& Subscription : Querier.Subscriptions)
+	{
+		Querier.Range = FMath::Max(Querier.Range, Subscription.Range);
+		Querier.UpdateInterval = FMath::Min(Querier.UpdateInterval, Subscription.UpdateInterval);
+	}
+}
+
+void UInteractionQuerySubsystem::UpdateQuerier(FQuerier& Querier)
+{
+	const AActor* Avatar = Querier.Avatar.Get();
+	if (Avatar == nullptr)
+	{
+		return;
+	}
+
+	TArray<TScriptInterface<IInteractableTarget>> NewNearbyInteractables;
+	QueryInteractablesInSphere(Avatar->GetActorLocation(), Querier.Range, NewNearbyInteractables);
+
+	// The avatar itself is never its own interactable
+	NewNearbyInteractables.RemoveAll([Avatar](const TScriptInterface<IInteractableTarget>& Target)
+	{
+		return UInteractionStatics::GetActorFromInteractableTarget(Target) == Avatar;
+	});
+
+	auto SortByObject = [](const TScriptInterface<IInteractableTarget>& A, const TScriptInterface<IInteractableTarget>& B)
+	{
+		return A.GetObject() < B.GetObject();
+	};
+	NewNearbyInteractables.Sort(SortByObject);
+
+	if (NewNearbyInteractables != Querier.NearbyInteractables)
+	{
+		Querier.NearbyInteractables = MoveTemp(NewNearbyInteractables);
+		const FOnNearbyInteractablesChanged OnChanged = Querier.OnChanged;
+		OnChanged.Broadcast();
+	}
+}
+
+FIntVector UInteractionQuerySubsystem::GetGridCell(const FVector& Location) const
+{
+	const float CellSize = GridCellSize > 0.f ? GridCellSize : FMath::Max(InteractionQueryCVars::GridCellSize, 50.f);
+	return FIntVector(
+		FMath::FloorToInt32(Location.X / CellSize),
+		FMath::FloorToInt32(Location.Y / CellSize),
+		FMath::FloorToInt32(Location.Z / CellSize));
+}
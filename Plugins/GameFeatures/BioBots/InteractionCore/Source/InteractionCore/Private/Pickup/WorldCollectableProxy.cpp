@@ -25,6 +25,12 @@ void AWorldCollectableProxy::GatherInteractionOptions(
 	OptionBuilder.AddInteractionOption(InteractionOption);
 }
 
+int32 AWorldCollectableProxy::GetInteractionOptionsGeneration() const
+{
+	// The interaction option is set up in the defaults and never changes at runtime
+	return 0;
+}
+
 void AWorldCollectableProxy::OnPickupCollisionBeginOverlap_Implementation(
 	UPrimitiveComponent* OverlappedComp, AActor* OtherActor, UPrimitiveComponent* OtherComp,
 	int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
@@ -3,16 +3,11 @@
 
 #include "Tasks/AbilityTask_GrantNearbyInteraction.h"
 
-#include "BotaniCollisionChannels.h"
-#include "InteractionStatics.h"
+#include "InteractionQuerySubsystem.h"
 #include "Interfaces/InteractableTarget.h"
 #include "AbilitySystemComponent.h"
 #include "InteractionQuery.h"
-#include "Engine/World.h"
-#include "Engine/OverlapResult.h"
 #include "GameFramework/Controller.h"
-#include "TimerManager.h"
-#include "Components/PrimitiveComponent.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AbilityTask_GrantNearbyInteraction)
 
@@ -35,50 +30,53 @@ UAbilityTask_GrantNearbyInteraction* UAbilityTask_GrantNearbyInteraction::GrantA
 void UAbilityTask_GrantNearbyInteraction::Activate()
 {
 	SetWaitingOnAvatar();
-	
-	if (const UWorld* World = GetWorld())
+
+	AActor* ActorOwner = GetAvatarActor();
+	UInteractionQuerySubsystem* QuerySubsystem = UInteractionQuerySubsystem::Get(this);
+	if (ActorOwner && QuerySubsystem)
 	{
-		World->GetTimerManager().SetTimer(QueryTimerHandle, this, &ThisClass::QueryInteractables, InteractionScanRate, true);
+		QueryAvatar = ActorOwner;
+		QueryHandle = QuerySubsystem->AddQuerier(ActorOwner, InteractionScanRange, InteractionScanRate,
+			FOnNearbyInteractablesChanged::FDelegate::CreateUObject(this, &ThisClass::OnNearbyInteractablesChanged));
+
+		// Pick up whatever was already nearby before we subscribed
+		OnNearbyInteractablesChanged();
 	}
 }
 
 void UAbilityTask_GrantNearbyInteraction::OnDestroy(bool AbilityEnded)
 {
-	if (const UWorld* World = GetWorld())
+	if (UInteractionQuerySubsystem* QuerySubsystem = UInteractionQuerySubsystem::Get(this))
 	{
-		World->GetTimerManager().ClearTimer(QueryTimerHandle);
+		QuerySubsystem->RemoveQuerier(QueryAvatar.Get(), QueryHandle);
 	}
+
+	QueryHandle.Reset();
 	
 	Super::OnDestroy(AbilityEnded);
 }
 
-void UAbilityTask_GrantNearbyInteraction::QueryInteractables()
+void UAbilityTask_GrantNearbyInteraction::OnNearbyInteractablesChanged()
 {
-	const UWorld* World = GetWorld();
-	AActor* ActorOwner = GetAvatarActor();
+	AActor* ActorOwner = QueryAvatar.Get();
+	const UInteractionQuerySubsystem* QuerySubsystem = UInteractionQuerySubsystem::Get(this);
 
-	if (!World || !ActorOwner)
+	if (!ActorOwner || !QuerySubsystem)
 	{
 		return;
 	}
 
-	const FCollisionQueryParams Params(SCENE_QUERY_STAT(UAbilityTask_GrantNearbyInteraction), false);
-	TArray<FOverlapResult> OverlapResults;
+	const TArray<TScriptInterface<IInteractableTarget>>& InteractableTargets = QuerySubsystem->GetNearbyInteractables(ActorOwner);
 
-	World->OverlapMultiByChannel(OUT OverlapResults, ActorOwner->GetActorLocation(), FQuat::Identity, BOTANI_TRACE_CHANNEL_INTERACTION, FCollisionShape::MakeSphere(InteractionScanRange), Params);
-
-	if (OverlapResults.Num() > 0)
+	if (InteractableTargets.Num() > 0)
 	{
-		TArray<TScriptInterface<IInteractableTarget>> InteractableTargets;
-		UInteractionStatics::AppendInteractableTargetsFromOverlapResults(OverlapResults, OUT InteractableTargets);
-
 		FBotaniInteractionQuery InteractionQuery;
 		InteractionQuery.RequestingAvatar = ActorOwner;
 		InteractionQuery.RequestingController = Cast<AController>(ActorOwner->GetOwner());
 
 		// Gather all interaction options from the interactable targets.
 		TArray<FBotaniInteractionOption> Options;
-		for (TScriptInterface<IInteractableTarget>& InteractiveTarget : InteractableTargets)
+		for (const TScriptInterface<IInteractableTarget>& InteractiveTarget : InteractableTargets)
 		{
 			FBotaniInteractionOptionBuilder Builder(InteractiveTarget, Options);
 			InteractiveTarget->GatherInteractionOptions(InteractionQuery, Builder);
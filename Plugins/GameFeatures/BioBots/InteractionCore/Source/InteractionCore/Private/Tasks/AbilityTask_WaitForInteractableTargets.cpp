@@ -8,11 +8,28 @@
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AbilityTask_WaitForInteractableTargets)
 
+namespace InteractionOptionCVars
+{
+	static bool bCacheInteractionOptions = true;
+	static FAutoConsoleVariableRef CVarCacheInteractionOptions(
+		TEXT("Interaction.Options.Cache"),
+		bCacheInteractionOptions,
+		TEXT("Caches the interaction options of each target between updates. Disable to gather them every update."),
+		ECVF_Default);
+}
+
 UAbilityTask_WaitForInteractableTargets::UAbilityTask_WaitForInteractableTargets(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
 }
 
+void UAbilityTask_WaitForInteractableTargets::OnDestroy(bool AbilityEnded)
+{
+	CachedTargetOptions.Empty();
+
+	Super::OnDestroy(AbilityEnded);
+}
+
 void UAbilityTask_WaitForInteractableTargets::LineTrace(
 	FHitResult& OutHit, const UWorld* World, const FVector& Start,
 	const FVector& End, FName ProfileName, const FCollisionQueryParams Params)
@@ -108,74 +125,99 @@ bool UAbilityTask_WaitForInteractableTargets::ClipCameraRayToAbilityRange(
 void UAbilityTask_WaitForInteractableTargets::UpdateInteractableOptions(
 	const FBotaniInteractionQuery& InteractQuery, const TArray<TScriptInterface<IInteractableTarget>>& InteractableTargets)
 {
+	const bool bUseCache = InteractionOptionCVars::bCacheInteractionOptions;
+	++UpdateCounter;
+
 	TArray<FBotaniInteractionOption> NewOptions;
 
 	for (const TScriptInterface<IInteractableTarget>& InteractiveTarget : InteractableTargets)
 	{
-		TArray<FBotaniInteractionOption> TempOptions;
-		FBotaniInteractionOptionBuilder Builder(InteractiveTarget, TempOptions);
-		InteractiveTarget->GatherInteractionOptions(InteractQuery, Builder);
+		if (!InteractiveTarget)
+		{
+			continue;
+		}
+
+		const int32 Generation = InteractiveTarget->GetInteractionOptionsGeneration();
+		FCachedTargetOptions& CachedOptions = CachedTargetOptions.FindOrAdd(InteractiveTarget.GetObject());
+		CachedOptions.LastSeenUpdate = UpdateCounter;
 
-		for (FBotaniInteractionOption& Option : TempOptions)
+		const bool bRegather = !bUseCache || !CachedOptions.bResolved || (Generation == INDEX_NONE) || (CachedOptions.Generation != Generation);
+		if (bRegather)
 		{
-			FGameplayAbilitySpec* InteractionAbilitySpec = nullptr;
+			GatherTargetOptions(InteractQuery, InteractiveTarget, CachedOptions);
+			CachedOptions.Generation = Generation;
+		}
 
-			// If there is a handle and a target ability system, we're triggering the ability on the target.
-			if (Option.TargetAbilitySystem && Option.TargetInteractionAbilityHandle.IsValid())
-			{
-				// Find the spec
-				InteractionAbilitySpec = Option.TargetAbilitySystem->FindAbilitySpecFromHandle(Option.TargetInteractionAbilityHandle);
-			}
-			// If there is an interaction-ability, then we're activating it on ourselves.
-			else if (Option.InteractionAbilityToGrant)
+		// Filter any options that we can't activate right now for whatever reason.
+		// Not cached, activation depends on costs, cooldowns, already active abilities and blueprint overrides too.
+		for (const FBotaniInteractionOption& Option : CachedOptions.Options)
+		{
+			const FGameplayAbilitySpec* InteractionAbilitySpec = Option.TargetAbilitySystem
+				? Option.TargetAbilitySystem->FindAbilitySpecFromHandle(Option.TargetInteractionAbilityHandle)
+				: nullptr;
+
+			if (InteractionAbilitySpec == nullptr)
 			{
-				// Find the spec
-				InteractionAbilitySpec = AbilitySystemComponent->FindAbilitySpecFromClass(Option.InteractionAbilityToGrant);
-
-				if (InteractionAbilitySpec)
-				{
-					// Update the option
-					Option.TargetAbilitySystem = AbilitySystemComponent.Get();
-					Option.TargetInteractionAbilityHandle = InteractionAbilitySpec->Handle;
-				}
+				// The spec went away, gather the options again next update
+				CachedOptions.bResolved = false;
+				continue;
 			}
 
-			if (InteractionAbilitySpec)
+			if (InteractionAbilitySpec->Ability->CanActivateAbility(InteractionAbilitySpec->Handle, AbilitySystemComponent->AbilityActorInfo.Get()))
 			{
-				// Filter any options that we can't activate right now for whatever reason.
-				if (InteractionAbilitySpec->Ability->CanActivateAbility(InteractionAbilitySpec->Handle, AbilitySystemComponent->AbilityActorInfo.Get()))
-				{
-					NewOptions.Add(Option);
-				}
+				NewOptions.Add(Option);
 			}
 		}
 	}
 
-	bool bOptionsChanged = false;
-	if (NewOptions.Num() == CurrentOptions.Num())
+	// Drop the targets that went out of range
+	for (auto It = CachedTargetOptions.CreateIterator(); It; ++It)
 	{
-		NewOptions.Sort();
-
-		for (int OptionIdx = 0; OptionIdx < NewOptions.Num(); OptionIdx++)
+		if (It.Value().LastSeenUpdate != UpdateCounter)
 		{
-			const FBotaniInteractionOption& NewOption = NewOptions[OptionIdx];
-			const FBotaniInteractionOption& CurrentOption = CurrentOptions[OptionIdx];
-
-			if (NewOption != CurrentOption)
-			{
-				bOptionsChanged = true;
-				break;
-			}
+			It.RemoveCurrent();
 		}
 	}
-	else
+
+	NewOptions.Sort();
+
+	if (NewOptions != CurrentOptions)
 	{
-		bOptionsChanged = true;
+		CurrentOptions = MoveTemp(NewOptions);
+		InteractableObjectsChanged.Broadcast(CurrentOptions);
 	}
+}
+
+void UAbilityTask_WaitForInteractableTargets::GatherTargetOptions(
+	const FBotaniInteractionQuery& InteractQuery, const TScriptInterface<IInteractableTarget>& InteractiveTarget, FCachedTargetOptions& OutCachedOptions) const
+{
+	TArray<FBotaniInteractionOption> TempOptions;
+	FBotaniInteractionOptionBuilder Builder(InteractiveTarget, TempOptions);
+	InteractiveTarget->GatherInteractionOptions(InteractQuery, Builder);
+
+	OutCachedOptions.Options.Reset(TempOptions.Num());
+	OutCachedOptions.bResolved = true;
 
-	if (bOptionsChanged)
+	for (FBotaniInteractionOption& Option : TempOptions)
 	{
-		CurrentOptions = NewOptions;
-		InteractableObjectsChanged.Broadcast(CurrentOptions);
+		// If there is a handle and a target ability system, we're triggering the ability on the target.
+		// If there is an interaction-ability, then we're activating it on ourselves, once it has been granted.
+		if (!(Option.TargetAbilitySystem && Option.TargetInteractionAbilityHandle.IsValid()) && Option.InteractionAbilityToGrant)
+		{
+			if (const FGameplayAbilitySpec* InteractionAbilitySpec = AbilitySystemComponent->FindAbilitySpecFromClass(Option.InteractionAbilityToGrant))
+			{
+				// Update the option
+				Option.TargetAbilitySystem = AbilitySystemComponent.Get();
+				Option.TargetInteractionAbilityHandle = InteractionAbilitySpec->Handle;
+			}
+			else
+			{
+				// Not granted yet, try again next update
+				OutCachedOptions.bResolved = false;
+				continue;
+			}
+		}
+
+		OutCachedOptions.Options.Add(MoveTemp(Option));
 	}
 }
@@ -3,10 +3,21 @@
 
 #include "Tasks/AbilityTask_WaitForInteractableTargets_SingleTrace.h"
 
+#include "InteractionQuerySubsystem.h"
 #include "InteractionStatics.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AbilityTask_WaitForInteractableTargets_SingleTrace)
 
+namespace InteractionTraceCVars
+{
+	static bool bSkipTraceWithoutNearbyInteractables = true;
+	static FAutoConsoleVariableRef CVarSkipTraceWithoutNearbyInteractables(
+		TEXT("Interaction.Trace.SkipWithoutNearbyInteractables"),
+		bSkipTraceWithoutNearbyInteractables,
+		TEXT("Skips the interaction trace while no registered interactable is in reach of the avatar. Interactable components added after their actor spawned have to register themselves, disable to trace regardless."),
+		ECVF_Default);
+}
+
 UAbilityTask_WaitForInteractableTargets_SingleTrace::UAbilityTask_WaitForInteractableTargets_SingleTrace(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
@@ -33,6 +44,16 @@ void UAbilityTask_WaitForInteractableTargets_SingleTrace::Activate()
 
 	const UWorld* World = GetWorld();
 	World->GetTimerManager().SetTimer(TimerHandle, this, &ThisClass::PerformTrace, InteractionScanRate, true);
+
+	// Share the nearby interactables of our avatar with anyone else querying for it
+	AActor* AvatarActor = GetAvatarActor();
+	UInteractionQuerySubsystem* QuerySubsystem = UInteractionQuerySubsystem::Get(this);
+	if (AvatarActor && QuerySubsystem)
+	{
+		QueryAvatar = AvatarActor;
+		QueryHandle = QuerySubsystem->AddQuerier(AvatarActor, InteractionScanRange, InteractionScanRate,
+			FOnNearbyInteractablesChanged::FDelegate::CreateUObject(this, &ThisClass::OnNearbyInteractablesChanged));
+	}
 }
 
 void UAbilityTask_WaitForInteractableTargets_SingleTrace::OnDestroy(bool AbilityEnded)
@@ -41,6 +62,13 @@ void UAbilityTask_WaitForInteractableTargets_SingleTrace::OnDestroy(bool Ability
 	{
 		World->GetTimerManager().ClearTimer(TimerHandle);
 	}
+
+	if (UInteractionQuerySubsystem* QuerySubsystem = UInteractionQuerySubsystem::Get(this))
+	{
+		QuerySubsystem->RemoveQuerier(QueryAvatar.Get(), QueryHandle);
+	}
+
+	QueryHandle.Reset();
 	
 	Super::OnDestroy(AbilityEnded);
 }
@@ -53,6 +81,17 @@ void UAbilityTask_WaitForInteractableTargets_SingleTrace::PerformTrace()
 		return;
 	}
 
+	// Nothing in reach, no need to aim or trace. The trace still decides what is actually visible otherwise.
+	if (InteractionTraceCVars::bSkipTraceWithoutNearbyInteractables && QueryHandle.IsValid())
+	{
+		const UInteractionQuerySubsystem* QuerySubsystem = UInteractionQuerySubsystem::Get(this);
+		if (QuerySubsystem && QuerySubsystem->GetNearbyInteractables(AvatarActor).Num() == 0)
+		{
+			UpdateInteractableOptions(InteractionQuery, TArray<TScriptInterface<IInteractableTarget>>());
+			return;
+		}
+	}
+
 	UWorld* World = GetWorld();
 
 	TArray<AActor*> ActorsToIgnore;
@@ -90,3 +129,13 @@ void UAbilityTask_WaitForInteractableTargets_SingleTrace::PerformTrace()
 	}
 #endif
 }
+
+void UAbilityTask_WaitForInteractableTargets_SingleTrace::OnNearbyInteractablesChanged()
+{
+	// Drop the options right away once everything went out of reach, instead of waiting for the next trace
+	const UInteractionQuerySubsystem* QuerySubsystem = UInteractionQuerySubsystem::Get(this);
+	if (InteractionTraceCVars::bSkipTraceWithoutNearbyInteractables && QuerySubsystem && QuerySubsystem->GetNearbyInteractables(QueryAvatar.Get()).Num() == 0)
+	{
+		UpdateInteractableOptions(InteractionQuery, TArray<TScriptInterface<IInteractableTarget>>());
+	}
+}
@@ -0,0 +1,162 @@
+// Copyright © 2024 Botanibots Team. All rights reserved.
+
+#include "InteractionQuerySubsystem.h"
+
+#include "BotaniCollisionChannels.h"
+#include "Components/InteractableComponent.h"
+#include "Engine/OverlapResult.h"
+#include "Engine/World.h"
+#include "InteractionStatics.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/ScopeExit.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInteractionQueryRegistryTest, "InteractionCore.Query.Registry", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FInteractionQueryRegistryTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumInteractables = 512;
+	constexpr int32 NumQueriers = 32;
+	constexpr float AreaSize = 8000.f;
+	constexpr float QueryRange = 600.f;
+
+	// Interactables touching the query sphere within this distance may go either way
+	constexpr float BoundaryTolerance = 1.f;
+
+	FRandomStream Random(0x1A7E);
+	auto RandomLocation = [&Random]()
+	{
+		return FVector(Random.FRandRange(0.f, AreaSize), Random.FRandRange(0.f, AreaSize), Random.FRandRange(-100.f, 100.f));
+	};
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("InteractionQueryTestWorld"));
+	ON_SCOPE_EXIT
+	{
+		World->DestroyWorld(false);
+	};
+
+	UInteractionQuerySubsystem* Subsystem = UInteractionQuerySubsystem::Get(World);
+	if (!TestNotNull(TEXT("Interaction query subsystem"), Subsystem))
+	{
+		return false;
+	}
+
+	// Interactables added after their actor spawned register themselves, like any component added at runtime has to
+	TArray<UInteractableComponent*> Interactables;
+	for (int32 Index = 0; Index < NumInteractables; ++Index)
+	{
+		const FVector Location = RandomLocation();
+		AActor* Actor = World->SpawnActor<AActor>(Location, FRotator::ZeroRotator);
+
+		UInteractableComponent* Interactable = NewObject<UInteractableComponent>(Actor);
+		Interactable->SetSphereRadius(Random.FRandRange(25.f, 100.f));
+		Actor->SetRootComponent(Interactable);
+		Interactable->RegisterComponent();
+		Interactable->SetWorldLocation(Location);
+
+		Subsystem->RegisterInteractable(Interactable);
+		Interactables.Add(Interactable);
+	}
+
+	TArray<AActor*> Avatars;
+	for (int32 Index = 0; Index < NumQueriers; ++Index)
+	{
+		AActor* Avatar = World->SpawnActor<AActor>();
+		USceneComponent* Root = NewObject<USceneComponent>(Avatar);
+		Avatar->SetRootComponent(Root);
+		Root->RegisterComponent();
+		Avatar->SetActorLocation(RandomLocation());
+
+		Subsystem->AddQuerier(Avatar, QueryRange, 0.1f, FOnNearbyInteractablesChanged::FDelegate::CreateLambda([]() {}));
+		Avatars.Add(Avatar);
+	}
+
+	int32 NumPhysicsResults = 0;
+	auto TestAgreesWithPhysics = [&](const TCHAR* Step, const FVector& Center, const TArray<TScriptInterface<IInteractableTarget>>& RegistryResults)
+	{
+		TArray<FOverlapResult> OverlapResults;
+		const FCollisionQueryParams Params(SCENE_QUERY_STAT(InteractionQueryRegistryTest), false);
+		World->OverlapMultiByChannel(OverlapResults, Center, FQuat::Identity, BOTANI_TRACE_CHANNEL_INTERACTION, FCollisionShape::MakeSphere(QueryRange), Params);
+
+		TArray<TScriptInterface<IInteractableTarget>> PhysicsResults;
+		UInteractionStatics::AppendInteractableTargetsFromOverlapResults(OverlapResults, PhysicsResults);
+		NumPhysicsResults += PhysicsResults.Num();
+
+		TSet<UObject*> RegistryObjects;
+		for (const TScriptInterface<IInteractableTarget>& Target : RegistryResults)
+		{
+			RegistryObjects.Add(Target.GetObject());
+		}
+
+		TSet<UObject*> PhysicsObjects;
+		for (const TScriptInterface<IInteractableTarget>& Target : PhysicsResults)
+		{
+			PhysicsObjects.Add(Target.GetObject());
+		}
+
+		for (UObject* Object : RegistryObjects.Union(PhysicsObjects).Difference(RegistryObjects.Intersect(PhysicsObjects)))
+		{
+			const UInteractableComponent* Interactable = Cast<UInteractableComponent>(Object);
+			const float Distance = Interactable ? FVector::Dist(Center, Interactable->GetComponentLocation()) : 0.f;
+			const float Reach = Interactable ? QueryRange + Interactable->GetScaledSphereRadius() : 0.f;
+			if (FMath::Abs(Distance - Reach) > BoundaryTolerance)
+			{
+				AddError(FString::Printf(TEXT("%s: %s was found by the %s only."), Step, *GetNameSafe(Object), PhysicsObjects.Contains(Object) ? TEXT("physics scene") : TEXT("registry")));
+			}
+		}
+	};
+
+	// Every querier starts with the interactables in its range
+	for (AActor* Avatar : Avatars)
+	{
+		TestAgreesWithPhysics(TEXT("Querier"), Avatar->GetActorLocation(), Subsystem->GetNearbyInteractables(Avatar));
+	}
+
+	if (!TestTrue(TEXT("Queriers have interactables in range"), NumPhysicsResults > 0))
+	{
+		return false;
+	}
+
+	// The registry follows interactables that move, across grid cells too
+	for (int32 Index = 0; Index < Interactables.Num(); Index += 4)
+	{
+		Interactables[Index]->SetWorldLocation(RandomLocation());
+	}
+
+	for (AActor* Avatar : Avatars)
+	{
+		Avatar->SetActorLocation(RandomLocation());
+
+		TArray<TScriptInterface<IInteractableTarget>> Results;
+		Subsystem->QueryInteractablesInSphere(Avatar->GetActorLocation(), QueryRange, Results);
+		TestAgreesWithPhysics(TEXT("Moved"), Avatar->GetActorLocation(), Results);
+	}
+
+	// Unregistered interactables leave the nearby sets right away
+	for (int32 Index = 0; Index < Interactables.Num(); Index += 8)
+	{
+		Subsystem->UnregisterInteractable(Interactables[Index]);
+		Interactables[Index]->GetOwner()->Destroy();
+	}
+
+	for (AActor* Avatar : Avatars)
+	{
+		for (const TScriptInterface<IInteractableTarget>& Target : Subsystem->GetNearbyInteractables(Avatar))
+		{
+			if (!IsValid(Target.GetObject()) || !IsValid(UInteractionStatics::GetActorFromInteractableTarget(Target)))
+			{
+				AddError(FString::Printf(TEXT("Removed: %s still sees a destroyed interactable."), *Avatar->GetName()));
+				break;
+			}
+		}
+
+		TArray<TScriptInterface<IInteractableTarget>> Results;
+		Subsystem->QueryInteractablesInSphere(Avatar->GetActorLocation(), QueryRange, Results);
+		TestAgreesWithPhysics(TEXT("Removed"), Avatar->GetActorLocation(), Results);
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
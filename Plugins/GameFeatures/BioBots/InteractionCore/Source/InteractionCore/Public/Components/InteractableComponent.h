@@ -0,0 +1,32 @@
+// Copyright © 2024 Botanibots Team. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/SphereComponent.h"
+#include "InteractionOption.h"
+#include "Interfaces/InteractableTarget.h"
+#include "InteractableComponent.generated.h"
+
+/**
+ * UInteractableComponent
+ *
+ * A sphere that makes its actor interactable with a single interaction option, e.g. for buttons or doors.
+ * Uses the Botani_ScanInteraction profile so the interaction trace hits it.
+ */
+UCLASS(ClassGroup = (Interaction), meta = (BlueprintSpawnableComponent), HideCategories = ("Activation", "Tags", "AssetUserData", "Navigation"))
+class INTERACTIONCORE_API UInteractableComponent : public USphereComponent, public IInteractableTarget
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+	//~ Begin IInteractableTarget Interface
+	virtual void GatherInteractionOptions(const FBotaniInteractionQuery& InteractionQuery, FBotaniInteractionOptionBuilder& OptionBuilder) override;
+	virtual int32 GetInteractionOptionsGeneration() const override;
+	//~ End IInteractableTarget Interface
+
+protected:
+	/** Determines the interaction option. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Interaction")
+	FBotaniInteractionOption InteractionOption;
+};
@@ -0,0 +1,141 @@
+// Copyright © 2024 Botanibots Team. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "InteractionQuerySubsystem.generated.h"
+
+class IInteractableTarget;
+class ULevel;
+class USceneComponent;
+
+DECLARE_MULTICAST_DELEGATE(FOnNearbyInteractablesChanged);
+
+/**
+ * UInteractionQuerySubsystem
+ *
+ * Spatial registry of all interactable targets in a world, kept in a coarse grid that is updated when targets
+ * register, unregister or move.
+ * Actors and components implementing IInteractableTarget are registered when they spawn or stream in, and
+ * unregistered when they are destroyed or stream out.
+ * Avatars that want to know about nearby interactables register as a querier with their own range and update rate.
+ * The nearby set of each avatar is refreshed at that rate and shared by everyone querying for the same avatar,
+ * e.g. the ability granting task on the server and the interaction trace task on the owning client.
+ */
+UCLASS()
+class INTERACTIONCORE_API UInteractionQuerySubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UInteractionQuerySubsystem();
+
+	//~ Begin UWorldSubsystem Interface
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	//~ End UWorldSubsystem Interface
+
+	//~ Begin FTickableGameObject Interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface
+
+	/** Utility to get this subsystem from any world context object, returns null if there is no world. */
+	static UInteractionQuerySubsystem* Get(const UObject* WorldContextObject);
+
+	/**
+	 * Adds an interactable target (an actor or a component implementing IInteractableTarget) to the registry.
+	 * Only needed for interactable components added to an actor after it was spawned.
+	 */
+	void RegisterInteractable(UObject* InteractableObject);
+
+	/** Removes an interactable target from the registry and from every nearby set. */
+	void UnregisterInteractable(UObject* InteractableObject);
+
+	/** Appends every registered interactable whose bounds overlap the given sphere. */
+	void QueryInteractablesInSphere(const FVector& Center, float Radius, TArray<TScriptInterface<IInteractableTarget>>& OutInteractableTargets) const;
+
+	/**
+	 * Starts tracking the interactables near the given avatar.
+	 * The avatar is queried at the smallest update interval and the largest range of all its queriers.
+	 * The delegate is called whenever the nearby set of the avatar changes.
+	 */
+	FDelegateHandle AddQuerier(AActor* Avatar, float Range, float UpdateInterval, const FOnNearbyInteractablesChanged::FDelegate& OnChanged);
+
+	/** Stops tracking for the querier that was added with the given handle. */
+	void RemoveQuerier(AActor* Avatar, FDelegateHandle Handle);
+
+	/** Returns the interactables near the avatar as of its last update, empty if the avatar has no querier. */
+	const TArray<TScriptInterface<IInteractableTarget>>& GetNearbyInteractables(const AActor* Avatar) const;
+
+	/** Returns a one line summary of the registry, for debugging. */
+	FString GetDebugString() const;
+
+private:
+	struct FInteractableEntry
+	{
+		TWeakObjectPtr<UObject> Object;
+		TWeakObjectPtr<USceneComponent> SceneComponent;
+		FVector Location = FVector::ZeroVector;
+		float Radius = 0.f;
+		FIntVector Cell = FIntVector::ZeroValue;
+		FDelegateHandle TransformUpdatedHandle;
+	};
+
+	struct FQuerierSubscription
+	{
+		FDelegateHandle Handle;
+		float Range = 0.f;
+		float UpdateInterval = 0.f;
+	};
+
+	struct FQuerier
+	{
+		TWeakObjectPtr<AActor> Avatar;
+		TArray<FQuerierSubscription, TInlineAllocator<2>> Subscriptions;
+		FOnNearbyInteractablesChanged OnChanged;
+		TArray<TScriptInterface<IInteractableTarget>> NearbyInteractables;
+		float Range = 0.f;
+		float UpdateInterval = 0.f;
+		double NextUpdateTime = 0.0;
+	};
+
+	void RegisterActorInteractables(AActor* Actor);
+	void UnregisterActorInteractables(AActor* Actor);
+	void HandleLevelAddedToWorld(ULevel* Level, UWorld* World);
+	void HandleLevelRemovedFromWorld(ULevel* Level, UWorld* World);
+
+	void UpdateEntryBounds(FInteractableEntry& Entry) const;
+	void AddToGrid(int32 EntryIndex);
+	void RemoveFromGrid(int32 EntryIndex);
+	void HandleEntryMoved(int32 EntryIndex);
+
+	void RefreshQuerierSettings(FQuerier& Querier) const;
+	void UpdateQuerier(FQuerier& Querier);
+
+	FIntVector GetGridCell(const FVector& Location) const;
+
+private:
+	/** All registered interactables, indices are stable */
+	TSparseArray<FInteractableEntry> Entries;
+	TMap<FObjectKey, int32> EntryIndexByObject;
+
+	/** Entry indices by grid cell */
+	TMap<FIntVector, TArray<int32>> Grid;
+
+	/** Largest bounds radius of any registered interactable, used to widen queries */
+	float MaxEntryRadius = 0.f;
+
+	TMap<FObjectKey, FQuerier> Queriers;
+
+	/** Cell size the grid was built with */
+	float GridCellSize = 0.f;
+
+	FDelegateHandle ActorSpawnedHandle;
+	FDelegateHandle ActorDestroyedHandle;
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle LevelRemovedHandle;
+};
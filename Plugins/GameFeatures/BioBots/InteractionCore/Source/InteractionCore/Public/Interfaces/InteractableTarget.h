@@ -47,6 +47,12 @@ public:
 	/** Called to gather all the possible interaction options for the given query. */
 	virtual void GatherInteractionOptions(const FBotaniInteractionQuery& InteractionQuery, FBotaniInteractionOptionBuilder& OptionBuilder) = 0;
 
+	/**
+	 * Returns a counter that changes whenever the gathered interaction options would change.
+	 * Queries cache the options of a target until its generation changes, INDEX_NONE opts out of caching.
+	 */
+	virtual int32 GetInteractionOptionsGeneration() const { return INDEX_NONE; }
+
 	/** Called to customize the interaction event data for the given interaction event tag. */
 	virtual void CustomizeInteractionEventData(const FGameplayTag& InteractionEventTag, FGameplayEventData& InOutEventData) { }
 };
@@ -21,6 +21,7 @@ class AWorldCollectableProxy : public ABotaniPickupProxy, public IInteractableTa
 public:
 	//~ Begin IInteractableTarget Interface
 	INTERACTIONCORE_API virtual void GatherInteractionOptions(const FBotaniInteractionQuery& InteractionQuery, FBotaniInteractionOptionBuilder& OptionBuilder) override;
+	INTERACTIONCORE_API virtual int32 GetInteractionOptionsGeneration() const override;
 	//~ End IInteractableTarget Interface
 
 	//~ Begin APickupProxyActor Interface
@@ -16,6 +16,7 @@ struct FObjectKey;
  * UAbilityTask_GrantNearbyInteraction
  *
  * Grants abilities to any reachable interactables.
+ * Reachable interactables come from the UInteractionQuerySubsystem, which only notifies us when they change.
  */
 UCLASS()
 class INTERACTIONCORE_API UAbilityTask_GrantNearbyInteraction : public UAbilityTask
@@ -36,12 +37,14 @@ private:
 	virtual void OnDestroy(bool AbilityEnded) override;
 	//~ End UAbilityTask Interface
 
-	void QueryInteractables();
+	void OnNearbyInteractablesChanged();
 
 private:
 	float InteractionScanRange;
 	float InteractionScanRate;
 
-	FTimerHandle QueryTimerHandle;
+	/** The avatar we registered as a querier for, and the handle of that registration */
+	TWeakObjectPtr<AActor> QueryAvatar;
+	FDelegateHandle QueryHandle;
 	TMap<FObjectKey, FGameplayAbilitySpecHandle> InteractionAbilityCache;
 };
@@ -4,11 +4,12 @@
 
 #include "CoreMinimal.h"
 #include "Abilities/Tasks/AbilityTask.h"
+#include "UObject/ObjectKey.h"
+#include "InteractionOption.h"
 #include "AbilityTask_WaitForInteractableTargets.generated.h"
 
 struct FBotaniInteractionQuery;
 class IInteractableTarget;
-struct FBotaniInteractionOption;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FInteractableObjectsChangedSignature, const TArray<FBotaniInteractionOption>&, InteractableOptions);
 
@@ -16,6 +17,8 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FInteractableObjectsChangedSignature
  * UAbilityTask_WaitForInteractableTargets
  *
  * Waits for interactable targets to be available
+ * The options of each target are cached until the target's options generation changes,
+ * whether they can be activated is evaluated every update.
  */
 UCLASS(Abstract)
 class INTERACTIONCORE_API UAbilityTask_WaitForInteractableTargets : public UAbilityTask
@@ -28,6 +31,10 @@ public:
 	FInteractableObjectsChangedSignature InteractableObjectsChanged;
 
 protected:
+	//~ Begin UAbilityTask Interface
+	virtual void OnDestroy(bool AbilityEnded) override;
+	//~ End UAbilityTask Interface
+
 	/** Performs the interaction query */
 	static void LineTrace(FHitResult& OutHit, const UWorld* World, const FVector& Start, const FVector& End, FName ProfileName, const FCollisionQueryParams Params);
 
@@ -37,6 +44,27 @@ protected:
 
 	void UpdateInteractableOptions(const FBotaniInteractionQuery& InteractQuery, const TArray<TScriptInterface<IInteractableTarget>>& InteractableTargets);
 
+private:
+	struct FCachedTargetOptions
+	{
+		/** Options generation of the target when the options were gathered */
+		int32 Generation = INDEX_NONE;
+
+		/** Update in which the target was last seen, used to drop targets out of range */
+		uint32 LastSeenUpdate = 0;
+
+		/** False if an option's ability spec couldn't be found yet, e.g. because the granted ability didn't replicate */
+		bool bResolved = false;
+
+		TArray<FBotaniInteractionOption> Options;
+	};
+
+	void GatherTargetOptions(const FBotaniInteractionQuery& InteractQuery, const TScriptInterface<IInteractableTarget>& InteractiveTarget, FCachedTargetOptions& OutCachedOptions) const;
+	/** Cached options of the targets seen in the last update */
+	TMap<FObjectKey, FCachedTargetOptions> CachedTargetOptions;
+
+	uint32 UpdateCounter = 0;
+
 public:
 	FCollisionProfileName TraceProfile;
 
@@ -27,6 +27,7 @@ protected:
 	//~ End UAbilityTask Interface
 
 	void PerformTrace();
+	void OnNearbyInteractablesChanged();
 
 private:
 	UPROPERTY()
@@ -40,4 +41,8 @@ private:
 	bool bShowDebug = false;
 
 	FTimerHandle TimerHandle;
+
+	/** The avatar we registered as a querier for, used to skip traces when nothing is in reach */
+	TWeakObjectPtr<AActor> QueryAvatar;
+	FDelegateHandle QueryHandle;
 };
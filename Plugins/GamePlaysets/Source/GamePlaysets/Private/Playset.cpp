@@ -82,6 +82,44 @@ UTexture2D* UPlayset::GetIcon(const bool bUseLargeIfNotFound) const
 	return Icon;
 }
 
+void UPlayset::GatherSpawnEntries(TArray<FPlaysetSpawnEntry>& OutEntries) const
+{
+	// Index the actor data by class and template id once, instead of searching it for every instance.
+	TMap<TPair<FSoftObjectPath, int32>, int32> ActorDataByTemplate;
+	ActorDataByTemplate.Reserve(ActorData.Num());
+
+	for (int32 DataIdx = 0; DataIdx < ActorData.Num(); ++DataIdx)
+	{
+		const FPlaysetActorData& Data = ActorData[DataIdx];
+		ActorDataByTemplate.FindOrAdd(TPair<FSoftObjectPath, int32>(Data.ActorClass.ToSoftObjectPath(), Data.ActorTemplateID), DataIdx);
+	}
+
+	for (const TPair<TSoftClassPtr<AActor>, int32>& KVP : ActorClassCount)
+	{
+		const FSoftObjectPath& ActorClassPath = KVP.Key.ToSoftObjectPath();
+
+		for (int32 TemplateId = 0; TemplateId < KVP.Value; ++TemplateId)
+		{
+			const int32* DataIdx = ActorDataByTemplate.Find(TPair<FSoftObjectPath, int32>(ActorClassPath, TemplateId));
+			if (DataIdx == nullptr)
+			{
+				// Try finding an actor data with template id of -1
+				DataIdx = ActorDataByTemplate.Find(TPair<FSoftObjectPath, int32>(ActorClassPath, INDEX_NONE));
+			}
+
+			if (DataIdx == nullptr)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("Failed to find actor data for class %s with template id %d"), *ActorClassPath.ToString(), TemplateId);
+				continue;
+			}
+
+			FPlaysetSpawnEntry& Entry = OutEntries.AddDefaulted_GetRef();
+			Entry.ActorClass = KVP.Key;
+			Entry.ActorDataIndex = *DataIdx;
+		}
+	}
+}
+
 #if WITH_EDITOR
 void UPlayset::InitializeDisplayInfo(const FPlaysetDisplayInfo& InDisplayInfo)
 {
@@ -100,18 +138,33 @@ void UPlayset::InitializeOffsetType(EPlaysetOffsetType InOffsetType)
 
 void UPlayset::InitializeSavedActors(TArray<FAssetData> InActorData)
 {
-	UWorld* World = InActorData.Top().GetAsset()->GetWorld();
+	// Resolve the actors once, every pass below works on the resolved list.
+	TArray<AActor*> Actors;
+	Actors.Reserve(InActorData.Num());
+
+	for (const FAssetData& FoundData : InActorData)
+	{
+		AActor* Actor = Cast<AActor>(FoundData.GetAsset());
+		if (!ensure(Actor))
+		{
+			continue;
+		}
+
+		Actors.Add(Actor);
+	}
+
+	if (Actors.IsEmpty())
+	{
+		return;
+	}
+
+	AActor* FirstActor = Actors.Last();
+	UWorld* World = FirstActor->GetWorld();
 
 	FActorSpawnParameters SpawnParams;
 	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
 	
 	AActor* PlaysetRoot = World->SpawnActor<APlaysetRootActor>(APlaysetRootActor::StaticClass(), FTransform::Identity, SpawnParams);
-	
-	AActor* FirstActor = Cast<AActor>(InActorData.Top().GetAsset());
-	if (!ensure(FirstActor))
-	{
-		return;
-	}
 
 	PlaysetRoot->SetActorLocation(FirstActor->GetActorLocation());
 	PlaysetRoot->SetActorRotation(FirstActor->GetActorRotation());
@@ -120,14 +173,8 @@ void UPlayset::InitializeSavedActors(TArray<FAssetData> InActorData)
 	SharedBounds.Origin = PlaysetRoot->GetActorLocation();
 
 	// Attach all assets to the root actor
-	for (const FAssetData& FoundData : InActorData)
+	for (AActor* Actor : Actors)
 	{
-		AActor* Actor = Cast<AActor>(FoundData.GetAsset());
-		if (!ensure(Actor))
-		{
-			continue;
-		}
-
 		Actor->GetRootComponent()->Mobility = EComponentMobility::Movable;
 		Actor->AttachToActor(PlaysetRoot, FAttachmentTransformRules::KeepWorldTransform);
 
@@ -196,83 +243,44 @@ void UPlayset::InitializeSavedActors(TArray<FAssetData> InActorData)
 	PlaysetRoot->SetActorLocation(NewLocation);
 	
 	// Restore the relative locations of the actors
-	for (const FAssetData& FoundData : InActorData)
+	for (AActor* Actor : Actors)
 	{
-		AActor* Actor = Cast<AActor>(FoundData.GetAsset());
-		if (!ensure(Actor))
-		{
-			continue;
-		}
-
 		Actor->SetActorLocation(
 			(Actor->GetActorLocation() + (PreviousLocation - PlaysetRoot->GetActorLocation())) +
 			CachedOffset
 			);
 	}
 
-	for (const FAssetData& FoundData : InActorData)
+	// Next free template id per class, seeded from the actor data that is already saved
+	TMap<FSoftObjectPath, int32> NextTemplateIds;
+	for (const FPlaysetActorData& ExistingData : ActorData)
 	{
-		InitializeSavedActor_Internal(PlaysetRoot->GetActorLocation(), FoundData);
+		NextTemplateIds.FindOrAdd(ExistingData.ActorClass.ToSoftObjectPath())++;
 	}
 
-	MarkPackageDirty();
-}
-
-void UPlayset::InitializeSavedActor_Internal(const FVector& RelativeOrigin, const FAssetData& InActorData)
-{
-	AActor* Actor = Cast<AActor>(InActorData.GetAsset());
-	if (!ensure(Actor))
+	ActorData.Reserve(ActorData.Num() + Actors.Num());
+	for (AActor* Actor : Actors)
 	{
-		return;
+		InitializeSavedActor_Internal(PlaysetRoot->GetActorLocation(), Actor, NextTemplateIds);
 	}
 
-	/*FArchive Ar;
-	Actor->Serialize(Ar);
-	UE_LOG(LogTemp, Warning, TEXT("Actor: %s was serialized. (Ar: %s)"), *Actor->GetName(), *Ar.GetArchiveName());*/
-
-	/*FArchiveUObject Ar;
-	Ar.ArContainsCode = true;
-
-	Actor->Serialize(Ar);
-	UE_LOG(LogTemp, Warning, TEXT("Actor: %s was serialized. (Ar: %s)"), *Actor->GetName(), *Ar.GetArchiveName());*/
-
-	// Get all the modified properties of the actor
-	/*FPropertyPairsMap PropMap;
-	Actor->GetActorDescProperties(PropMap);
+	MarkPackageDirty();
+}
 
-	auto ForEachProp = [](FName Key, FName Val)
-	{
-		UE_LOG(LogTemp, Warning, TEXT("Key: %s, Val: %s"), *Key.ToString(), *Val.ToString());
-	};
+void UPlayset::InitializeSavedActor_Internal(const FVector& RelativeOrigin, AActor* Actor, TMap<FSoftObjectPath, int32>& NextTemplateIds)
+{
+	check(Actor);
 
-	PropMap.ForEachProperty(ForEachProp);*/
-	
 	const UClass* ActorClass = Actor->GetClass();
 	int32& Count = ActorClassCount.FindOrAdd(ActorClass);
 	Count++;
 
-	auto GetActorTemplateId = [&] (const FPlaysetActorData& Data)
-	{
-		int32 Id = INDEX_NONE;
-		for (const auto& ExistingData : ActorData)
-		{
-			if (Data.ActorClass->GetPathName() != ExistingData.ActorClass->GetPathName())
-			{
-				continue;
-			}
-
-			++Id;
-		}
-
-		return Id;
-	};
-
 	FPlaysetActorData& NewActorData = ActorData.AddDefaulted_GetRef();
 	NewActorData.ActorClass = ActorClass;
 	NewActorData.RelativeLocation = Actor->GetActorLocation() - RelativeOrigin;
 	NewActorData.RelativeRotation = Actor->GetActorRotation();
 	NewActorData.RelativeScale = Actor->GetActorScale3D();
-	NewActorData.ActorTemplateID = GetActorTemplateId(NewActorData);
+	NewActorData.ActorTemplateID = NextTemplateIds.FindOrAdd(NewActorData.ActorClass.ToSoftObjectPath())++;
 	NewActorData.CollectActorName();
 }
 #endif
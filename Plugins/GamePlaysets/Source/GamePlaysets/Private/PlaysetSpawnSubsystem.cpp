@@ -0,0 +1,387 @@
+// Copyright © 2024 MajorT. All rights reserved.
+
+#include "PlaysetSpawnSubsystem.h"
+
+#include "Playset.h"
+#include "Engine/AssetManager.h"
+#include "Engine/World.h"
+#include "Components/SceneComponent.h"
+#include "GameFramework/Actor.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(PlaysetSpawnSubsystem)
+
+DEFINE_LOG_CATEGORY_STATIC(LogPlaysetSpawn, Log, All);
+
+namespace PlaysetSpawnCVars
+{
+	static float FrameBudgetMs = 2.f;
+	static FAutoConsoleVariableRef CVarFrameBudgetMs(
+		TEXT("Playset.Spawn.FrameBudgetMs"),
+		FrameBudgetMs,
+		TEXT("Time in milliseconds that may be spent spawning and finishing playset actors per frame. At least one actor is processed per frame."),
+		ECVF_Default);
+}
+
+bool UPlaysetSpawnSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	if (!Super::ShouldCreateSubsystem(Outer))
+	{
+		return false;
+	}
+
+	// Editor worlds need it as well, playsets are placed through it.
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && (World->IsGameWorld() || World->WorldType == EWorldType::Editor);
+}
+
+void UPlaysetSpawnSubsystem::Deinitialize()
+{
+	for (FSpawnRequest& Request : Requests)
+	{
+		if (Request.LoadHandle.IsValid())
+		{
+			Request.LoadHandle->CancelHandle();
+		}
+	}
+
+	Requests.Empty();
+
+	Super::Deinitialize();
+}
+
+void UPlaysetSpawnSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const double EndTime = FPlatformTime::Seconds() + (PlaysetSpawnCVars::FrameBudgetMs / 1000.0);
+
+	while (Requests.Num() > 0)
+	{
+		if (!ProcessRequest(Requests[0], EndTime))
+		{
+			break;
+		}
+
+		// Remove the request before completing it, the delegate may queue new requests.
+		FSpawnRequest CompletedRequest = MoveTemp(Requests[0]);
+		Requests.RemoveAt(0);
+
+		CompleteRequest(CompletedRequest);
+
+		if (FPlatformTime::Seconds() >= EndTime)
+		{
+			break;
+		}
+	}
+}
+
+bool UPlaysetSpawnSubsystem::IsTickable() const
+{
+	return !IsTemplate() && (Requests.Num() > 0);
+}
+
+TStatId UPlaysetSpawnSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UPlaysetSpawnSubsystem, STATGROUP_Tickables);
+}
+
+UPlaysetSpawnSubsystem* UPlaysetSpawnSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UPlaysetSpawnSubsystem>() : nullptr;
+}
+
+int32 UPlaysetSpawnSubsystem::SpawnPlayset(const UPlayset* Playset, const FPlaysetSpawnParams& Params, FOnPlaysetSpawned OnSpawned)
+{
+	if (Playset == nullptr)
+	{
+		return INDEX_NONE;
+	}
+
+	FSpawnRequest Request;
+	Request.RequestId = NextRequestId++;
+	Request.Playset = Playset;
+	Request.Params = Params;
+	Request.OnSpawned = MoveTemp(OnSpawned);
+
+	Playset->GatherSpawnEntries(Request.Entries);
+
+	if (Params.bSpawnImmediately)
+	{
+		// Without a load handle the classes are loaded synchronously as the request is processed.
+		ProcessRequest(Request, TNumericLimits<double>::Max());
+		CompleteRequest(Request);
+		return Request.RequestId;
+	}
+
+	// Load every class the playset needs in one batch.
+	TArray<FSoftObjectPath> ClassPaths;
+	ClassPaths.Reserve(Playset->ActorClassCount.Num());
+
+	for (const FPlaysetSpawnEntry& Entry : Request.Entries)
+	{
+		if (!Entry.ActorClass.IsNull())
+		{
+			ClassPaths.AddUnique(Entry.ActorClass.ToSoftObjectPath());
+		}
+
+		for (const TSoftClassPtr<UActorComponent>& ComponentClass : Playset->ActorData[Entry.ActorDataIndex].ActorComponents)
+		{
+			if (!ComponentClass.IsNull())
+			{
+				ClassPaths.AddUnique(ComponentClass.ToSoftObjectPath());
+			}
+		}
+	}
+
+	if (ClassPaths.Num() > 0)
+	{
+		Request.LoadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(ClassPaths);
+	}
+
+	const int32 RequestId = Request.RequestId;
+	Requests.Add(MoveTemp(Request));
+	return RequestId;
+}
+
+void UPlaysetSpawnSubsystem::CancelSpawn(int32 RequestId)
+{
+	const int32 RequestIdx = Requests.IndexOfByPredicate([RequestId](const FSpawnRequest& Request)
+	{
+		return Request.RequestId == RequestId;
+	});
+
+	if (RequestIdx == INDEX_NONE)
+	{
+		return;
+	}
+
+	FSpawnRequest& Request = Requests[RequestIdx];
+
+	// Actors that are still deferred have to be finished, they are already part of the world.
+	if (Request.Phase == ESpawnPhase::Spawning)
+	{
+		Request.Phase = ESpawnPhase::Finishing;
+		Request.SpawnedActors.SetNum(Request.NextEntry);
+		Request.NextEntry = 0;
+	}
+
+	if (Request.Phase == ESpawnPhase::Finishing)
+	{
+		for (int32 EntryIdx = Request.NextEntry; EntryIdx < Request.SpawnedActors.Num(); ++EntryIdx)
+		{
+			FinishEntry(Request, EntryIdx);
+		}
+	}
+
+	if (Request.LoadHandle.IsValid())
+	{
+		Request.LoadHandle->CancelHandle();
+	}
+
+	Requests.RemoveAt(RequestIdx);
+}
+
+bool UPlaysetSpawnSubsystem::IsSpawnPending(int32 RequestId) const
+{
+	return Requests.ContainsByPredicate([RequestId](const FSpawnRequest& Request)
+	{
+		return Request.RequestId == RequestId;
+	});
+}
+
+void UPlaysetSpawnSubsystem::ResolveClasses(FSpawnRequest& Request) const
+{
+	const UPlayset* Playset = Request.Playset.Get();
+	check(Playset);
+
+	// Resolve each class once, playsets usually spawn many instances of few classes.
+	TMap<FSoftObjectPath, UClass*> ResolvedClasses;
+
+	Request.EntryClasses.Reset(Request.Entries.Num());
+	for (const FPlaysetSpawnEntry& Entry : Request.Entries)
+	{
+		UClass*& ActorClass = ResolvedClasses.FindOrAdd(Entry.ActorClass.ToSoftObjectPath());
+		if (ActorClass == nullptr)
+		{
+			ActorClass = Entry.ActorClass.Get();
+			if (ActorClass == nullptr)
+			{
+				ActorClass = Entry.ActorClass.LoadSynchronous();
+			}
+		}
+
+		Request.EntryClasses.Add(ActorClass);
+
+		// The additional components are looked up when the actor is finished, make sure they are loaded by then.
+		for (const TSoftClassPtr<UActorComponent>& ComponentClass : Playset->ActorData[Entry.ActorDataIndex].ActorComponents)
+		{
+			if (!ComponentClass.IsNull() && ComponentClass.Get() == nullptr)
+			{
+				ComponentClass.LoadSynchronous();
+			}
+		}
+	}
+
+	Request.SpawnTransforms.SetNum(Request.Entries.Num());
+	Request.SpawnedActors.SetNum(Request.Entries.Num());
+}
+
+bool UPlaysetSpawnSubsystem::ProcessRequest(FSpawnRequest& Request, double EndTime)
+{
+	if (!Request.Playset.IsValid())
+	{
+		UE_LOG(LogPlaysetSpawn, Warning, TEXT("Playset of spawn request %d is gone, spawned %d of %d actors."), Request.RequestId, Request.NextEntry, Request.Entries.Num());
+
+		// Still finish what has been spawned deferred, so no half constructed actors are left behind.
+		if (Request.Phase == ESpawnPhase::Spawning)
+		{
+			Request.Phase = ESpawnPhase::Finishing;
+			Request.SpawnedActors.SetNum(Request.NextEntry);
+			Request.NextEntry = 0;
+		}
+
+		for (int32 EntryIdx = Request.NextEntry; (Request.Phase == ESpawnPhase::Finishing) && (EntryIdx < Request.SpawnedActors.Num()); ++EntryIdx)
+		{
+			FinishEntry(Request, EntryIdx);
+		}
+
+		return true;
+	}
+
+	if (Request.Phase == ESpawnPhase::Loading)
+	{
+		if (Request.LoadHandle.IsValid() && Request.LoadHandle->IsLoadingInProgress())
+		{
+			return false;
+		}
+
+		ResolveClasses(Request);
+		Request.Phase = ESpawnPhase::Spawning;
+	}
+
+	// Always process at least one entry so requests advance even when the budget is already used up.
+	bool bFirstEntry = true;
+	auto HasTimeLeft = [&bFirstEntry, EndTime]()
+	{
+		const bool bHasTimeLeft = bFirstEntry || (FPlatformTime::Seconds() < EndTime);
+		bFirstEntry = false;
+		return bHasTimeLeft;
+	};
+
+	if (Request.Phase == ESpawnPhase::Spawning)
+	{
+		while ((Request.NextEntry < Request.Entries.Num()) && HasTimeLeft())
+		{
+			SpawnEntry(Request, Request.NextEntry++);
+		}
+
+		if (Request.NextEntry < Request.Entries.Num())
+		{
+			return false;
+		}
+
+		Request.Phase = ESpawnPhase::Finishing;
+		Request.NextEntry = 0;
+	}
+
+	while ((Request.NextEntry < Request.Entries.Num()) && HasTimeLeft())
+	{
+		FinishEntry(Request, Request.NextEntry++);
+	}
+
+	return Request.NextEntry >= Request.Entries.Num();
+}
+
+void UPlaysetSpawnSubsystem::SpawnEntry(FSpawnRequest& Request, int32 EntryIdx) const
+{
+	UClass* ActorClass = Request.EntryClasses[EntryIdx];
+	if (ActorClass == nullptr)
+	{
+		UE_LOG(LogPlaysetSpawn, Warning, TEXT("Failed to load actor class %s"), *Request.Entries[EntryIdx].ActorClass.ToString());
+		return;
+	}
+
+	const FPlaysetActorData& ActorData = Request.Playset->ActorData[Request.Entries[EntryIdx].ActorDataIndex];
+
+	const AActor* RootActor = Request.Params.RootActor.Get();
+	const FTransform RootTransform = RootActor ? RootActor->GetActorTransform() : Request.Params.RootTransform;
+	const FTransform RelativeTransform(ActorData.RelativeRotation, ActorData.RelativeLocation, ActorData.RelativeScale);
+
+	FTransform& SpawnTransform = Request.SpawnTransforms[EntryIdx];
+	SpawnTransform = RelativeTransform * RootTransform;
+
+	Request.SpawnedActors[EntryIdx] = GetWorld()->SpawnActorDeferred<AActor>(ActorClass, SpawnTransform);
+}
+
+void UPlaysetSpawnSubsystem::FinishEntry(FSpawnRequest& Request, int32 EntryIdx) const
+{
+	AActor* NewActor = Request.SpawnedActors[EntryIdx].Get();
+	if (NewActor == nullptr)
+	{
+		return;
+	}
+
+	const UPlayset* Playset = Request.Playset.Get();
+	const FPlaysetActorData* ActorData = Playset ? &Playset->ActorData[Request.Entries[EntryIdx].ActorDataIndex] : nullptr;
+
+	// Apply the saved state before the actor finishes spawning, so its construction script and BeginPlay already see it.
+	if (Request.Params.bDisableCollision)
+	{
+		NewActor->SetActorEnableCollision(false);
+	}
+
+	// Scene components wait for the construction script, otherwise they would become the root of blueprint actors.
+	TArray<UClass*, TInlineAllocator<4>> SceneComponentClasses;
+	if (ActorData)
+	{
+		for (const TSoftClassPtr<UActorComponent>& ComponentClass : ActorData->ActorComponents)
+		{
+			if (UClass* LoadedComponentClass = ComponentClass.Get())
+			{
+				if (LoadedComponentClass->IsChildOf<USceneComponent>())
+				{
+					SceneComponentClasses.Add(LoadedComponentClass);
+				}
+				else
+				{
+					NewActor->AddComponentByClass(LoadedComponentClass, false, FTransform::Identity, false);
+				}
+			}
+		}
+	}
+
+	NewActor->FinishSpawning(Request.SpawnTransforms[EntryIdx]);
+
+	for (UClass* SceneComponentClass : SceneComponentClasses)
+	{
+		NewActor->AddComponentByClass(SceneComponentClass, false, FTransform::Identity, false);
+	}
+
+	if (USceneComponent* RootComponent = NewActor->GetRootComponent())
+	{
+		RootComponent->Mobility = EComponentMobility::Movable;
+	}
+
+	if (AActor* RootActor = Request.Params.RootActor.Get())
+	{
+		NewActor->AttachToActor(RootActor, FAttachmentTransformRules::KeepWorldTransform);
+	}
+}
+
+void UPlaysetSpawnSubsystem::CompleteRequest(FSpawnRequest& Request) const
+{
+	TArray<AActor*> SpawnedActors;
+	SpawnedActors.Reserve(Request.SpawnedActors.Num());
+
+	for (const TWeakObjectPtr<AActor>& SpawnedActor : Request.SpawnedActors)
+	{
+		if (AActor* Actor = SpawnedActor.Get())
+		{
+			SpawnedActors.Add(Actor);
+		}
+	}
+
+	Request.LoadHandle.Reset();
+	Request.OnSpawned.ExecuteIfBound(SpawnedActors);
+}
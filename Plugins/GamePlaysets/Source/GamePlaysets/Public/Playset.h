@@ -34,6 +34,12 @@ public:
 	/** Returns the playset tags. */ 
 	virtual const FGameplayTagContainer& GetGameplayTags() const { return PlaysetTags; }
 
+	/**
+	 * Resolves every actor this playset spawns, matching each class instance to its actor data by template id.
+	 * Instances without matching actor data are skipped.
+	 */
+	void GatherSpawnEntries(TArray<FPlaysetSpawnEntry>& OutEntries) const;
+
 public:
 #if WITH_EDITOR
 	virtual void InitializeDisplayInfo(const FPlaysetDisplayInfo& InDisplayInfo);
@@ -54,7 +60,8 @@ protected:
 	virtual EDataValidationResult IsDataValid(FDataValidationContext& Context) const override;
 	//~ End UObject Interface
 
-	virtual void InitializeSavedActor_Internal(const FVector& RelativeOrigin, const FAssetData& InActorData);
+	/** Saves the actor data of a single actor, NextTemplateIds holds the next free template id per class. */
+	virtual void InitializeSavedActor_Internal(const FVector& RelativeOrigin, AActor* Actor, TMap<FSoftObjectPath, int32>& NextTemplateIds);
 #endif
 
 public:
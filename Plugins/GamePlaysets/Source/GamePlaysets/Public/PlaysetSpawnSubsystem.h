@@ -0,0 +1,135 @@
+// Copyright © 2024 MajorT. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PlaysetTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "PlaysetSpawnSubsystem.generated.h"
+
+class UPlayset;
+struct FStreamableHandle;
+
+/** Called once every actor of a playset spawn request has finished spawning. */
+DECLARE_DELEGATE_OneParam(FOnPlaysetSpawned, const TArray<AActor*>& /*SpawnedActors*/);
+
+/**
+ * FPlaysetSpawnParams
+ *
+ * Parameters of a playset spawn request.
+ */
+struct FPlaysetSpawnParams
+{
+	/** Transform the playset's relative actor transforms are applied to. */
+	FTransform RootTransform = FTransform::Identity;
+
+	/** Optional actor the spawned actors are attached to, its transform is used as root transform if set. */
+	TWeakObjectPtr<AActor> RootActor;
+
+	/** Whether collision should be disabled on the spawned actors, e.g. for placement previews. */
+	bool bDisableCollision = false;
+
+	/** Whether the request should be processed right away instead of over multiple frames. */
+	bool bSpawnImmediately = false;
+};
+
+/**
+ * UPlaysetSpawnSubsystem
+ *
+ * Instantiates playsets in batches so placing large playsets does not hitch.
+ * The classes of a playset are resolved and loaded once per request, then every actor is spawned deferred with its
+ * saved transform and finished in a later step, both spread across frames within a configurable time budget.
+ * The saved collision setting and additional components are applied before the actor finishes spawning,
+ * additional scene components right after its construction script ran.
+ */
+UCLASS()
+class GAMEPLAYSETS_API UPlaysetSpawnSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UWorldSubsystem Interface
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Deinitialize() override;
+	//~ End UWorldSubsystem Interface
+
+	//~ Begin FTickableGameObject Interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual bool IsTickableInEditor() const override { return true; }
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface
+
+	/** Utility to get this subsystem from any world context object, returns null if there is no world. */
+	static UPlaysetSpawnSubsystem* Get(const UObject* WorldContextObject);
+
+	/**
+	 * Queues the actors of the given playset for spawning.
+	 * The delegate is called once all actors are spawned, which may happen before this function returns.
+	 * @returns An id that can be used to cancel the request, INDEX_NONE if nothing was queued.
+	 */
+	int32 SpawnPlayset(const UPlayset* Playset, const FPlaysetSpawnParams& Params, FOnPlaysetSpawned OnSpawned = FOnPlaysetSpawned());
+
+	/** Cancels a pending spawn request, actors that have already been spawned are kept. */
+	void CancelSpawn(int32 RequestId);
+
+	/** Returns whether the given spawn request is still pending. */
+	bool IsSpawnPending(int32 RequestId) const;
+
+	/** Returns the number of pending spawn requests. */
+	int32 GetNumPendingSpawns() const { return Requests.Num(); }
+
+private:
+	enum class ESpawnPhase : uint8
+	{
+		/** Waiting for the actor classes to load */
+		Loading,
+
+		/** Spawning the actors deferred */
+		Spawning,
+
+		/** Finishing the spawned actors */
+		Finishing
+	};
+
+	struct FSpawnRequest
+	{
+		int32 RequestId = INDEX_NONE;
+		TWeakObjectPtr<const UPlayset> Playset;
+		FPlaysetSpawnParams Params;
+		FOnPlaysetSpawned OnSpawned;
+
+		ESpawnPhase Phase = ESpawnPhase::Loading;
+		TArray<FPlaysetSpawnEntry> Entries;
+
+		/** Resolved class per entry, filled once loading completed */
+		TArray<UClass*> EntryClasses;
+
+		/** World transform per entry, computed when the entry is spawned */
+		TArray<FTransform> SpawnTransforms;
+
+		/** Spawned actors per entry, null for entries that failed to spawn */
+		TArray<TWeakObjectPtr<AActor>> SpawnedActors;
+
+		/** Next entry to spawn or finish in the current phase */
+		int32 NextEntry = 0;
+
+		TSharedPtr<FStreamableHandle> LoadHandle;
+	};
+
+	/** Resolves the entry classes of a request whose classes are loaded. */
+	void ResolveClasses(FSpawnRequest& Request) const;
+
+	/** Processes the given request until it is complete or the end time has passed, returns true once the request is complete. */
+	bool ProcessRequest(FSpawnRequest& Request, double EndTime);
+
+	void SpawnEntry(FSpawnRequest& Request, int32 EntryIdx) const;
+	void FinishEntry(FSpawnRequest& Request, int32 EntryIdx) const;
+	void CompleteRequest(FSpawnRequest& Request) const;
+
+private:
+	/** Pending requests, processed in order */
+	TArray<FSpawnRequest> Requests;
+
+	int32 NextRequestId = 0;
+};
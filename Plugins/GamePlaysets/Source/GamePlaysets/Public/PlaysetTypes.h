@@ -146,3 +146,17 @@ public:
 	void CollectActorName();
 #endif
 };
+
+/**
+ * FPlaysetSpawnEntry
+ *
+ * A single actor to spawn for a playset, resolved from the playset's actor class count and actor data.
+ */
+struct FPlaysetSpawnEntry
+{
+	/** The class of the actor to spawn. */
+	TSoftClassPtr<AActor> ActorClass;
+
+	/** Index of the actor data to apply to the spawned actor. */
+	int32 ActorDataIndex = INDEX_NONE;
+};
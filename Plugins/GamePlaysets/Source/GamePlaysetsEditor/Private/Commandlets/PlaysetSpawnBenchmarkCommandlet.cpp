@@ -0,0 +1,225 @@
+// Copyright © 2024 MajorT. All rights reserved.
+
+#include "PlaysetSpawnBenchmarkCommandlet.h"
+
+#include "Playset.h"
+#include "PlaysetSpawnSubsystem.h"
+#include "Components/PawnNoiseEmitterComponent.h"
+#include "Components/TextRenderComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/Note.h"
+#include "Engine/PointLight.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/TargetPoint.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/Package.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(PlaysetSpawnBenchmarkCommandlet)
+
+DEFINE_LOG_CATEGORY_STATIC(LogPlaysetSpawnBenchmark, Log, All);
+
+UPlaysetSpawnBenchmarkCommandlet::UPlaysetSpawnBenchmarkCommandlet(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UPlaysetSpawnBenchmarkCommandlet::Main(const FString& Params)
+{
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamVals;
+	ParseCommandLine(*Params, Tokens, Switches, ParamVals);
+
+	const int32 NumActors = ParamVals.Contains(TEXT("Count")) ? FCString::Atoi(*ParamVals[TEXT("Count")]) : 2000;
+	const float BudgetMs = ParamVals.Contains(TEXT("BudgetMs")) ? FCString::Atof(*ParamVals[TEXT("BudgetMs")]) : 2.f;
+
+	if (NumActors <= 0)
+	{
+		UE_LOG(LogPlaysetSpawnBenchmark, Error, TEXT("Count must be greater than zero."));
+		return 1;
+	}
+
+	if (IConsoleVariable* BudgetCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("Playset.Spawn.FrameBudgetMs")))
+	{
+		BudgetCVar->Set(BudgetMs);
+	}
+
+	// Spawn into a transient game world, so the subsystem behaves like it does at runtime.
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("PlaysetSpawnBenchmark"));
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+	World->InitializeActorsForPlay(FURL());
+	World->BeginPlay();
+
+	UPlaysetSpawnSubsystem* SpawnSubsystem = UPlaysetSpawnSubsystem::Get(World);
+	check(SpawnSubsystem);
+
+	UPlayset* Playset = CreateSyntheticPlayset(NumActors);
+
+	auto DestroyActors = [](const TArray<AActor*>& Actors)
+	{
+		for (AActor* Actor : Actors)
+		{
+			Actor->Destroy();
+		}
+	};
+
+	TSet<FIntVector> ExpectedLocations;
+	int32 NumExpectedWithComponents = 0;
+	for (const FPlaysetActorData& Data : Playset->ActorData)
+	{
+		ExpectedLocations.Add(FIntVector(Data.RelativeLocation.GridSnap(1.f)));
+		NumExpectedWithComponents += Data.ActorComponents.IsEmpty() ? 0 : 1;
+	}
+
+	// Every actor has to be spawned at its saved location with its saved state, the run fails otherwise
+	int32 NumFailures = 0;
+	auto CheckSpawnedActors = [&](const TCHAR* Mode, const TArray<AActor*>& Actors, bool bExpectCollision)
+	{
+		if (Actors.Num() != NumActors)
+		{
+			UE_LOG(LogPlaysetSpawnBenchmark, Error, TEXT("%s: Spawned %d of %d actors."), Mode, Actors.Num(), NumActors);
+			NumFailures++;
+		}
+
+		int32 NumWithComponents = 0;
+		for (const AActor* Actor : Actors)
+		{
+			if (!ExpectedLocations.Contains(FIntVector(Actor->GetActorLocation().GridSnap(1.f))))
+			{
+				UE_LOG(LogPlaysetSpawnBenchmark, Error, TEXT("%s: %s was spawned at %s, which is not a saved location."), Mode, *Actor->GetName(), *Actor->GetActorLocation().ToString());
+				NumFailures++;
+				return;
+			}
+
+			if (Actor->GetActorEnableCollision() != bExpectCollision)
+			{
+				UE_LOG(LogPlaysetSpawnBenchmark, Error, TEXT("%s: Collision of %s is %s."), Mode, *Actor->GetName(), bExpectCollision ? TEXT("disabled") : TEXT("enabled"));
+				NumFailures++;
+				return;
+			}
+
+			const bool bHasSceneComponent = Actor->FindComponentByClass<UTextRenderComponent>() != nullptr;
+			const bool bHasComponent = Actor->FindComponentByClass<UPawnNoiseEmitterComponent>() != nullptr;
+			if (bHasSceneComponent != bHasComponent)
+			{
+				UE_LOG(LogPlaysetSpawnBenchmark, Error, TEXT("%s: %s only got some of its additional components."), Mode, *Actor->GetName());
+				NumFailures++;
+				return;
+			}
+
+			NumWithComponents += bHasComponent ? 1 : 0;
+		}
+
+		if (NumWithComponents != NumExpectedWithComponents)
+		{
+			UE_LOG(LogPlaysetSpawnBenchmark, Error, TEXT("%s: %d actors got their additional components, expected %d."), Mode, NumWithComponents, NumExpectedWithComponents);
+			NumFailures++;
+		}
+	};
+
+	// Everything in a single frame, like the editor placement does.
+	{
+		TArray<AActor*> SpawnedActors;
+		FPlaysetSpawnParams SpawnParams;
+		SpawnParams.bSpawnImmediately = true;
+
+		const double StartTime = FPlatformTime::Seconds();
+		SpawnSubsystem->SpawnPlayset(Playset, SpawnParams, FOnPlaysetSpawned::CreateLambda([&SpawnedActors](const TArray<AActor*>& Actors)
+		{
+			SpawnedActors = Actors;
+		}));
+		const double TotalMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+		UE_LOG(LogPlaysetSpawnBenchmark, Display, TEXT("Immediate: %d actors in %.2f ms (%.2f us per actor)"),
+			SpawnedActors.Num(), TotalMs, SpawnedActors.Num() > 0 ? (TotalMs * 1000.0) / SpawnedActors.Num() : 0.0);
+
+		CheckSpawnedActors(TEXT("Immediate"), SpawnedActors, true);
+		DestroyActors(SpawnedActors);
+	}
+
+	// Batched across frames within the frame budget.
+	{
+		TArray<AActor*> SpawnedActors;
+		bool bCompleted = false;
+
+		// Batched spawns are placement previews in the editor, which have no collision
+		FPlaysetSpawnParams SpawnParams;
+		SpawnParams.bDisableCollision = true;
+
+		const double StartTime = FPlatformTime::Seconds();
+		SpawnSubsystem->SpawnPlayset(Playset, SpawnParams, FOnPlaysetSpawned::CreateLambda([&SpawnedActors, &bCompleted](const TArray<AActor*>& Actors)
+		{
+			SpawnedActors = Actors;
+			bCompleted = true;
+		}));
+
+		int32 NumFrames = 0;
+		double MaxFrameMs = 0.0;
+		while (!bCompleted)
+		{
+			const double FrameStartTime = FPlatformTime::Seconds();
+			SpawnSubsystem->Tick(1.f / 60.f);
+			MaxFrameMs = FMath::Max(MaxFrameMs, (FPlatformTime::Seconds() - FrameStartTime) * 1000.0);
+			NumFrames++;
+		}
+
+		const double TotalMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+		UE_LOG(LogPlaysetSpawnBenchmark, Display, TEXT("Batched (%.2f ms budget): %d actors in %.2f ms over %d frames, longest frame %.2f ms (%.2f us per actor)"),
+			BudgetMs, SpawnedActors.Num(), TotalMs, NumFrames, MaxFrameMs, SpawnedActors.Num() > 0 ? (TotalMs * 1000.0) / SpawnedActors.Num() : 0.0);
+
+		CheckSpawnedActors(TEXT("Batched"), SpawnedActors, false);
+		DestroyActors(SpawnedActors);
+	}
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+
+	UE_LOG(LogPlaysetSpawnBenchmark, Display, TEXT("Playset spawn benchmark %s."), (NumFailures == 0) ? TEXT("passed") : TEXT("failed"));
+	return (NumFailures == 0) ? 0 : 1;
+}
+
+UPlayset* UPlaysetSpawnBenchmarkCommandlet::CreateSyntheticPlayset(int32 NumActors) const
+{
+	const TArray<UClass*> ActorClasses =
+	{
+		AStaticMeshActor::StaticClass(),
+		APointLight::StaticClass(),
+		ATargetPoint::StaticClass(),
+		ANote::StaticClass()
+	};
+
+	UPlayset* Playset = NewObject<UPlayset>(GetTransientPackage(), NAME_None, RF_Transient);
+	Playset->ActorData.Reserve(NumActors);
+
+	// Lay the actors out on a grid, a few meters apart.
+	const int32 GridSize = FMath::CeilToInt(FMath::Sqrt(static_cast<float>(NumActors)));
+	const FRandomStream RandomStream(NumActors);
+
+	for (int32 ActorIdx = 0; ActorIdx < NumActors; ++ActorIdx)
+	{
+		UClass* ActorClass = ActorClasses[ActorIdx % ActorClasses.Num()];
+		int32& Count = Playset->ActorClassCount.FindOrAdd(ActorClass);
+
+		FPlaysetActorData& Data = Playset->ActorData.AddDefaulted_GetRef();
+		Data.ActorClass = ActorClass;
+		Data.ActorTemplateID = Count++;
+		Data.RelativeLocation = FVector((ActorIdx % GridSize) * 300.f, (ActorIdx / GridSize) * 300.f, 0.f);
+		Data.RelativeRotation = FRotator(0.f, RandomStream.FRandRange(0.f, 360.f), 0.f);
+
+		// Some actors carry additional components, one that is added before and one after the actor finishes spawning
+		if ((ActorIdx % 8) == 0)
+		{
+			Data.ActorComponents.Add(UPawnNoiseEmitterComponent::StaticClass());
+			Data.ActorComponents.Add(UTextRenderComponent::StaticClass());
+		}
+	}
+
+	return Playset;
+}
@@ -0,0 +1,30 @@
+// Copyright © 2024 MajorT. All rights reserved.
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "PlaysetSpawnBenchmarkCommandlet.generated.h"
+
+class UPlayset;
+
+/**
+ * UPlaysetSpawnBenchmarkCommandlet
+ *
+ * Instantiates a large synthetic playset in a transient world, both immediately and batched across frames,
+ * and reports the time spent per actor. Returns 1 if any actor is missing, misplaced or lacks its saved state.
+ *
+ * Usage: -run=PlaysetSpawnBenchmark [-Count=2000] [-BudgetMs=2]
+ */
+UCLASS()
+class UPlaysetSpawnBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+	//~ Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet Interface
+
+private:
+	/** Creates a transient playset with the given number of actors spread over a few engine actor classes. */
+	UPlayset* CreateSyntheticPlayset(int32 NumActors) const;
+};
@@ -6,6 +6,7 @@
 #include "GamePlaysetsEditor.h"
 #include "Playset.h"
 #include "PlaysetRootActor.h"
+#include "PlaysetSpawnSubsystem.h"
 #include "Elements/Actor/ActorElementData.h"
 #include "Subsystems/PlacementSubsystem.h"
 
@@ -207,54 +208,19 @@ void UActorFactory_Playset::SpawnPlaysetActors(AActor* RootActor, const UPlayset
 	
 	check(Playset);
 	check(InLevel);
-	
-	for (const auto& KVP : Playset->ActorClassCount)
+
+	UPlaysetSpawnSubsystem* SpawnSubsystem = UPlaysetSpawnSubsystem::Get(InLevel->GetWorld());
+	if (!ensure(SpawnSubsystem))
 	{
-		for (int i = 0; i < KVP.Value; i++)
-		{
-			bool bAllowTemplate = false;
-			const FSoftObjectPath& ActorClassPath = KVP.Key.ToSoftObjectPath();
-			
-			auto Predicate = [i, ActorClassPath, bAllowTemplate](const FPlaysetActorData& Data)
-			{
-				if (Data.ActorClass.ToSoftObjectPath() != ActorClassPath )
-				{
-					return false;
-				}
-
-				return bAllowTemplate ?
-					(Data.ActorTemplateID == i || Data.ActorTemplateID == -1) :
-					(Data.ActorTemplateID == i);
-			};
-			
-			
-			const FPlaysetActorData* ActorData = Playset->ActorData.FindByPredicate(Predicate);
-
-			if (ActorData == nullptr)
-			{
-				// Try finding an actor data with template id of -1
-				bAllowTemplate = true;
-				ActorData = Playset->ActorData.FindByPredicate(Predicate);
-			}
-			
-			if (ActorData == nullptr)
-			{
-				UE_LOG(LogTemp, Warning, TEXT("Failed to find actor data for class %s with template id %d"), *ActorClassPath.ToString(), i);
-				continue;
-			}
-			
-			UClass* ActorClass = KVP.Key.LoadSynchronous();
-			AActor* NewActor = InLevel->GetWorld()->SpawnActor<AActor>(ActorClass, RootActor->GetActorLocation(), RootActor->GetActorRotation());
-
-			// Apply the actor data to the new actor
-			NewActor->SetActorRelativeLocation(ActorData->RelativeLocation);
-			NewActor->SetActorRelativeRotation(ActorData->RelativeRotation);
-			NewActor->SetActorRelativeScale3D(ActorData->RelativeScale);
-			NewActor->GetRootComponent()->Mobility = EComponentMobility::Movable;
-			
-			NewActor->AttachToActor(RootActor, FAttachmentTransformRules::KeepRelativeTransform);
-		}
+		return;
 	}
+
+	// Placement is part of the editor transaction, so spawn everything right away.
+	FPlaysetSpawnParams SpawnParams;
+	SpawnParams.RootActor = RootActor;
+	SpawnParams.bSpawnImmediately = true;
+
+	SpawnSubsystem->SpawnPlayset(Playset, SpawnParams);
 }
 
 void UActorFactory_Playset::SpawnPlaysetPreviewActors(AActor* RootActor, const UPlayset* Playset, const ULevel* InLevel)
@@ -267,55 +233,19 @@ void UActorFactory_Playset::SpawnPlaysetPreviewActors(AActor* RootActor, const U
 	
 	check(Playset);
 	check(InLevel);
-	
-	for (const auto& KVP : Playset->ActorClassCount)
+
+	UPlaysetSpawnSubsystem* SpawnSubsystem = UPlaysetSpawnSubsystem::Get(InLevel->GetWorld());
+	if (!ensure(SpawnSubsystem))
 	{
-		for (int i = 0; i < KVP.Value; i++)
-		{
-			bool bAllowTemplate = false;
-			const FSoftObjectPath& ActorClassPath = KVP.Key.ToSoftObjectPath();
-			
-			auto Predicate = [i, ActorClassPath, bAllowTemplate](const FPlaysetActorData& Data)
-			{
-				if (Data.ActorClass.ToSoftObjectPath() != ActorClassPath )
-				{
-					return false;
-				}
-
-				return bAllowTemplate ?
-					(Data.ActorTemplateID == i || Data.ActorTemplateID == -1) :
-					(Data.ActorTemplateID == i);
-			};
-			
-			
-			const FPlaysetActorData* ActorData = Playset->ActorData.FindByPredicate(Predicate);
-
-			if (ActorData == nullptr)
-			{
-				// Try finding an actor data with template id of -1
-				bAllowTemplate = true;
-				ActorData = Playset->ActorData.FindByPredicate(Predicate);
-			}
-			
-			if (ActorData == nullptr)
-			{
-				UE_LOG(LogTemp, Warning, TEXT("Failed to find actor data for class %s with template id %d"), *ActorClassPath.ToString(), i);
-				continue;
-			}
-			
-			UClass* ActorClass = KVP.Key.LoadSynchronous();
-			AActor* NewActor = InLevel->GetWorld()->SpawnActor<AActor>(ActorClass, RootActor->GetActorLocation(), RootActor->GetActorRotation());
-			NewActor->SetActorEnableCollision(false);
-
-			// Apply the actor data to the new actor
-			NewActor->SetActorRelativeLocation(ActorData->RelativeLocation);
-			NewActor->SetActorRelativeRotation(ActorData->RelativeRotation);
-			NewActor->SetActorRelativeScale3D(ActorData->RelativeScale);
-			NewActor->GetRootComponent()->Mobility = EComponentMobility::Movable;
-			
-			NewActor->AttachToActor(RootActor, FAttachmentTransformRules::KeepRelativeTransform);
-		}
+		return;
 	}
+
+	FPlaysetSpawnParams SpawnParams;
+	SpawnParams.RootActor = RootActor;
+	SpawnParams.bDisableCollision = true;
+	SpawnParams.bSpawnImmediately = true;
+
+	SpawnSubsystem->SpawnPlayset(Playset, SpawnParams);
 }
 
 AActor* UActorFactory_Playset::GetActorFromHandle(TArrayView<const FTypedElementHandle> InHandle)
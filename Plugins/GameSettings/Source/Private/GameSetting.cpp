@@ -1,6 +1,7 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "GameSetting.h"
+#include "GameSettingRegistry.h"
 #include "Framework/Text/ITextDecorator.h"
 #include "Framework/Text/RichTextMarkupProcessing.h"
 #include "Engine/LocalPlayer.h"
@@ -100,6 +101,11 @@ void UGameSetting::OnInitialized()
 {
 	ensureMsgf(bReady, TEXT("OnInitialized called directly instead of via StartupComplete."));
 	EditableStateCache = ComputeEditableState();
+
+	if (OwningRegistry)
+	{
+		OwningRegistry->InvalidateFilterCache();
+	}
 }
 
 void UGameSetting::OnApply()
@@ -144,6 +150,22 @@ const FString& UGameSetting::GetDescriptionPlainText() const
 	return AutoGenerated_DescriptionPlainText;
 }
 
+const TArray<FString>& UGameSetting::GetSearchTokens() const
+{
+	RefreshPlainText();
+	return AutoGenerated_SearchTokens;
+}
+
+void UGameSetting::InvalidateSearchableText()
+{
+	bRefreshPlainSearchableText = true;
+
+	if (OwningRegistry)
+	{
+		OwningRegistry->InvalidateSearchIndex();
+	}
+}
+
 void UGameSetting::RefreshPlainText() const
 {
 	//TODO: GameSettings
@@ -171,6 +193,8 @@ void UGameSetting::RefreshPlainText() const
 			}
 		}
 
+		FGameSettingFilterState::TokenizeSearchText(DisplayName.ToString() + TEXT(" ") + AutoGenerated_DescriptionPlainText, AutoGenerated_SearchTokens);
+
 		bRefreshPlainSearchableText = false;
 	}
 }
@@ -232,9 +256,22 @@ void UGameSetting::RefreshEditableState(bool bNotifyEditConditionsChanged)
 	if (!bOnEditConditionsChangedEventGuard)
 	{
 		TGuardValue<bool> Guard(bOnEditConditionsChangedEventGuard, true);
-	
+
+		const bool bWasVisible = EditableStateCache.IsVisible();
+		const bool bWasEnabled = EditableStateCache.IsEnabled();
+		const bool bWasResetable = EditableStateCache.IsResetable();
+
 		EditableStateCache = ComputeEditableState();
 
+		// Cached filter results depend on the edit state, even when nobody is notified about the change.
+		if (OwningRegistry
+			&& (bWasVisible != EditableStateCache.IsVisible()
+				|| bWasEnabled != EditableStateCache.IsEnabled()
+				|| bWasResetable != EditableStateCache.IsResetable()))
+		{
+			OwningRegistry->InvalidateFilterCache();
+		}
+
 		if (bNotifyEditConditionsChanged)
 		{
 			NotifyEditConditionsChanged();
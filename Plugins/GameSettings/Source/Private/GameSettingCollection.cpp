@@ -1,6 +1,7 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "GameSettingCollection.h"
+#include "GameSettingRegistry.h"
 #include "Templates/Casts.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(GameSettingCollection)
@@ -26,6 +27,11 @@ void UGameSettingCollection::AddSetting(UGameSetting* Setting)
 	Settings.Add(Setting);
 	Setting->SetSettingParent(this);
 
+	if (OwningRegistry)
+	{
+		OwningRegistry->InvalidateFilterCache();
+	}
+
 	if (LocalPlayer)
 	{
 		Setting->Initialize(LocalPlayer);
@@ -7,32 +7,11 @@
 
 #define LOCTEXT_NAMESPACE "GameSetting"
 
-class FSettingFilterExpressionContext : public ITextFilterExpressionContext
-{
-public:
-	explicit FSettingFilterExpressionContext(const UGameSetting& InSetting) : Setting(InSetting) {}
-
-	virtual bool TestBasicStringExpression(const FTextFilterString& InValue, const ETextFilterTextComparisonMode InTextComparisonMode) const override
-	{
-		return TextFilterUtils::TestBasicStringExpression(Setting.GetDescriptionPlainText(), InValue, InTextComparisonMode);
-	}
-
-	virtual bool TestComplexExpression(const FName& InKey, const FTextFilterString& InValue, const ETextFilterComparisonOperation InComparisonOperation, const ETextFilterTextComparisonMode InTextComparisonMode) const override
-	{
-		return false;
-	}
-
-private:
-	/** Setting being filtered. */
-	const UGameSetting& Setting;
-};
-
 //--------------------------------------
 // FGameSettingFilterState
 //--------------------------------------
 
 FGameSettingFilterState::FGameSettingFilterState()
-	: SearchTextEvaluator(ETextFilterExpressionEvaluatorMode::BasicString)
 {
 }
 
@@ -49,7 +28,58 @@ void FGameSettingFilterState::AddSettingToAllowList(UGameSetting* InSetting)
 
 void FGameSettingFilterState::SetSearchText(const FString& InSearchText)
 {
-	SearchTextEvaluator.SetFilterText(FText::FromString(InSearchText));
+	TokenizeSearchText(InSearchText, SearchTerms);
+	SearchMatches.Reset();
+}
+
+void FGameSettingFilterState::TokenizeSearchText(const FString& InText, TArray<FString>& OutTokens)
+{
+	OutTokens.Reset();
+
+	FString Token;
+	for (const TCHAR Character : InText)
+	{
+		if (FChar::IsAlnum(Character))
+		{
+			Token.AppendChar(FChar::ToLower(Character));
+		}
+		else if (!Token.IsEmpty())
+		{
+			OutTokens.AddUnique(MoveTemp(Token));
+			Token.Reset();
+		}
+	}
+
+	if (!Token.IsEmpty())
+	{
+		OutTokens.AddUnique(MoveTemp(Token));
+	}
+}
+
+bool FGameSettingFilterState::IsEquivalent(const FGameSettingFilterState& Other) const
+{
+	if (bIncludeDisabled != Other.bIncludeDisabled
+		|| bIncludeHidden != Other.bIncludeHidden
+		|| bIncludeResetable != Other.bIncludeResetable
+		|| bIncludeNestedPages != Other.bIncludeNestedPages)
+	{
+		return false;
+	}
+
+	if (SearchTerms != Other.SearchTerms || SettingRootList != Other.SettingRootList || SettingAllowList.Num() != Other.SettingAllowList.Num())
+	{
+		return false;
+	}
+
+	for (const TObjectKey<UGameSetting>& AllowedSetting : SettingAllowList)
+	{
+		if (!Other.SettingAllowList.Contains(AllowedSetting))
+		{
+			return false;
+		}
+	}
+
+	return true;
 }
 
 bool FGameSettingFilterState::DoesSettingPassFilter(const UGameSetting& InSetting) const
@@ -99,9 +129,21 @@ bool FGameSettingFilterState::DoesSettingPassFilter(const UGameSetting& InSettin
 	// TODO more filters...
 
 	// Always search text last, it's generally the most expensive filter.
-	if (!SearchTextEvaluator.TestTextFilter(FSettingFilterExpressionContext(InSetting)))
+	if (SearchTerms.Num() > 0)
 	{
-		return false;
+		if (SearchMatches.IsValid())
+		{
+			return SearchMatches->Contains(&InSetting);
+		}
+
+		const TArray<FString>& SettingTokens = InSetting.GetSearchTokens();
+		for (const FString& SearchTerm : SearchTerms)
+		{
+			if (!SettingTokens.ContainsByPredicate([&SearchTerm](const FString& Token) { return Token.StartsWith(SearchTerm, ESearchCase::CaseSensitive); }))
+			{
+				return false;
+			}
+		}
 	}
 
 	return true;
@@ -4,12 +4,19 @@
 
 #include "GameSettingCollection.h"
 #include "GameSettingAction.h"
+#include "Algo/BinarySearch.h"
 #include "UObject/WeakObjectPtr.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(GameSettingRegistry)
 
 #define LOCTEXT_NAMESPACE "GameSetting"
 
+namespace GameSettingRegistryPrivate
+{
+	/** Number of filter results kept, enough for the panel, its navigation stack and the reset to default query. */
+	static constexpr int32 MaxCachedFilters = 8;
+}
+
 //--------------------------------------
 // UGameSettingRegistry
 //--------------------------------------
@@ -33,7 +40,9 @@ void UGameSettingRegistry::Regenerate()
 		Setting->MarkAsGarbage();
 	}
 	RegisteredSettings.Reset();
+	RegisteredSettingsByDevName.Reset();
 	TopLevelSettings.Reset();
+	InvalidateSearchIndex();
 
 	OnInitialize(OwningLocalPlayer);
 }
@@ -60,43 +69,154 @@ void UGameSettingRegistry::SaveChanges()
 
 void UGameSettingRegistry::GetSettingsForFilter(const FGameSettingFilterState& FilterState, TArray<UGameSetting*>& InOutSettings)
 {
+	for (int32 EntryIdx = 0; EntryIdx < FilterCache.Num(); ++EntryIdx)
+	{
+		const FFilterCacheEntry& CachedEntry = FilterCache[EntryIdx];
+		if (CachedEntry.Generation == FilterCacheGeneration && CachedEntry.FilterState.IsEquivalent(FilterState))
+		{
+			InOutSettings.Append(CachedEntry.Settings);
+
+			if (EntryIdx > 0)
+			{
+				FFilterCacheEntry UsedEntry = MoveTemp(FilterCache[EntryIdx]);
+				FilterCache.RemoveAt(EntryIdx, 1, EAllowShrinking::No);
+				FilterCache.Insert(MoveTemp(UsedEntry), 0);
+			}
+			return;
+		}
+	}
+
+	// Look up the search terms once, instead of testing them against every setting.
+	FGameSettingFilterState PreparedFilterState = FilterState;
+	if (PreparedFilterState.GetSearchTerms().Num() > 0)
+	{
+		PreparedFilterState.SearchMatches = FindSettingsMatchingSearch(PreparedFilterState.GetSearchTerms());
+	}
+
 	TArray<UGameSetting*> RootSettings;
-	if (FilterState.GetSettingRootList().Num() > 0)
+	if (PreparedFilterState.GetSettingRootList().Num() > 0)
 	{
-		RootSettings.Append(FilterState.GetSettingRootList());
+		RootSettings.Append(PreparedFilterState.GetSettingRootList());
 	}
 	else
 	{
 		RootSettings.Append(TopLevelSettings);
 	}
 
+	TArray<UGameSetting*> FilteredSettings;
 	for (UGameSetting* TopLevelSetting : RootSettings)
 	{
 		if (const UGameSettingCollection* TopLevelCollection = Cast<UGameSettingCollection>(TopLevelSetting))
 		{
-			TopLevelCollection->GetSettingsForFilter(FilterState, InOutSettings);
+			TopLevelCollection->GetSettingsForFilter(PreparedFilterState, FilteredSettings);
 		}
 		else
 		{
-			if (FilterState.DoesSettingPassFilter(*TopLevelSetting))
+			if (PreparedFilterState.DoesSettingPassFilter(*TopLevelSetting))
 			{
-				InOutSettings.Add(TopLevelSetting);
+				FilteredSettings.Add(TopLevelSetting);
 			}
 		}
 	}
+
+	InOutSettings.Append(FilteredSettings);
+
+	if (FilterCache.Num() >= GameSettingRegistryPrivate::MaxCachedFilters)
+	{
+		FilterCache.Pop(EAllowShrinking::No);
+	}
+
+	FFilterCacheEntry& NewEntry = FilterCache.InsertDefaulted_GetRef(0);
+	NewEntry.FilterState = MoveTemp(PreparedFilterState);
+	NewEntry.Settings = MoveTemp(FilteredSettings);
+	NewEntry.Generation = FilterCacheGeneration;
 }
 
 UGameSetting* UGameSettingRegistry::FindSettingByDevName(const FName& SettingDevName)
 {
-	for (UGameSetting* Setting : RegisteredSettings)
+	const TObjectPtr<UGameSetting>* Setting = RegisteredSettingsByDevName.Find(SettingDevName);
+	return Setting ? Setting->Get() : nullptr;
+}
+
+void UGameSettingRegistry::InvalidateFilterCache()
+{
+	++FilterCacheGeneration;
+	FilterCache.Reset();
+}
+
+void UGameSettingRegistry::InvalidateSearchIndex()
+{
+	bSearchTokenIndexDirty = true;
+	InvalidateFilterCache();
+}
+
+TSharedRef<const TSet<const UGameSetting*>> UGameSettingRegistry::FindSettingsMatchingSearch(const TArray<FString>& SearchTerms)
+{
+	auto TokenLess = [](const FString& A, const FString& B)
 	{
-		if (Setting->GetDevName() == SettingDevName)
+		return A.Compare(B, ESearchCase::CaseSensitive) < 0;
+	};
+
+	if (bSearchTokenIndexDirty)
+	{
+		TMap<FString, TArray<UGameSetting*>> SettingsByToken;
+		for (UGameSetting* Setting : RegisteredSettings)
+		{
+			for (const FString& Token : Setting->GetSearchTokens())
+			{
+				SettingsByToken.FindOrAdd(Token).Add(Setting);
+			}
+		}
+
+		SearchTokenIndex.Reset(SettingsByToken.Num());
+		for (TPair<FString, TArray<UGameSetting*>>& Pair : SettingsByToken)
 		{
-			return Setting;
+			SearchTokenIndex.Add({ MoveTemp(Pair.Key), MoveTemp(Pair.Value) });
 		}
+
+		SearchTokenIndex.Sort([&TokenLess](const FSearchTokenEntry& A, const FSearchTokenEntry& B)
+		{
+			return TokenLess(A.Token, B.Token);
+		});
+
+		bSearchTokenIndexDirty = false;
 	}
 
-	return nullptr;
+	// Every term has to be the start of a word of the setting, so partially typed words already match.
+	TSharedRef<TSet<const UGameSetting*>> Matches = MakeShared<TSet<const UGameSetting*>>();
+	for (int32 TermIdx = 0; TermIdx < SearchTerms.Num(); ++TermIdx)
+	{
+		const FString& SearchTerm = SearchTerms[TermIdx];
+
+		// Tokens starting with the term are a contiguous range beginning at the first token not less than it
+		TSet<const UGameSetting*> TermMatches;
+		for (int32 EntryIdx = Algo::LowerBoundBy(SearchTokenIndex, SearchTerm, &FSearchTokenEntry::Token, TokenLess); EntryIdx < SearchTokenIndex.Num(); ++EntryIdx)
+		{
+			const FSearchTokenEntry& Entry = SearchTokenIndex[EntryIdx];
+			if (!Entry.Token.StartsWith(SearchTerm, ESearchCase::CaseSensitive))
+			{
+				break;
+			}
+
+			TermMatches.Append(Entry.Settings);
+		}
+
+		if (TermIdx == 0)
+		{
+			*Matches = MoveTemp(TermMatches);
+		}
+		else
+		{
+			*Matches = Matches->Intersect(TermMatches);
+		}
+
+		if (Matches->Num() == 0)
+		{
+			break;
+		}
+	}
+
+	return Matches;
 }
 
 void UGameSettingRegistry::RegisterSetting(UGameSetting* InSetting)
@@ -104,13 +224,15 @@ void UGameSettingRegistry::RegisterSetting(UGameSetting* InSetting)
 	if (InSetting)
 	{
 		TopLevelSettings.Add(InSetting);
-		InSetting->SetRegistry(this);
 		RegisterInnerSettings(InSetting);
+		InvalidateSearchIndex();
 	}
 }
 
 void UGameSettingRegistry::RegisterInnerSettings(UGameSetting* InSetting)
 {
+	InSetting->SetRegistry(this);
+
 	InSetting->OnSettingChangedEvent.AddUObject(this, &ThisClass::HandleSettingChanged);
 	InSetting->OnSettingAppliedEvent.AddUObject(this, &ThisClass::HandleSettingApplied);
 	InSetting->OnSettingEditConditionChangedEvent.AddUObject(this, &ThisClass::HandleSettingEditConditionsChanged);
@@ -128,10 +250,11 @@ void UGameSettingRegistry::RegisterInnerSettings(UGameSetting* InSetting)
 
 #if !UE_BUILD_SHIPPING
 	ensureAlwaysMsgf(!RegisteredSettings.Contains(InSetting), TEXT("This setting has already been registered!"));
-	ensureAlwaysMsgf(nullptr == RegisteredSettings.FindByPredicate([&InSetting](UGameSetting* ExistingSetting) { return InSetting->GetDevName() == ExistingSetting->GetDevName(); }), TEXT("A setting with this DevName has already been registered!  DevNames must be unique within a registry."));
+	ensureAlwaysMsgf(!RegisteredSettingsByDevName.Contains(InSetting->GetDevName()), TEXT("A setting with this DevName has already been registered!  DevNames must be unique within a registry."));
 #endif
 
 	RegisteredSettings.Add(InSetting);
+	RegisteredSettingsByDevName.FindOrAdd(InSetting->GetDevName(), InSetting);
 
 	for (UGameSetting* ChildSetting : InSetting->GetChildSettings())
 	{
@@ -151,6 +274,7 @@ void UGameSettingRegistry::HandleSettingChanged(UGameSetting* Setting, EGameSett
 
 void UGameSettingRegistry::HandleSettingEditConditionsChanged(UGameSetting* Setting)
 {
+	InvalidateFilterCache();
 	OnSettingEditConditionChangedEvent.Broadcast(Setting);
 }
 
@@ -53,7 +53,7 @@ public:
 
 	UFUNCTION(BlueprintCallable)
 	FText GetDisplayName() const { return DisplayName; }
-	void SetDisplayName(const FText& Value) { DisplayName = Value; }
+	void SetDisplayName(const FText& Value) { DisplayName = Value; InvalidateSearchableText(); }
 #if !UE_BUILD_SHIPPING
 	void SetDisplayName(const FString& Value) { SetDisplayName(FText::FromString(Value)); }
 #endif
@@ -78,6 +78,9 @@ public:
 	/** Gets the searchable plain text for the description. */
 	const FString& GetDescriptionPlainText() const;
 
+	/** Gets the unique lowercase words of the display name and description, used when searching settings. */
+	const TArray<FString>& GetSearchTokens() const;
+
 	/** Initializes the setting, giving it the owning local player.  Containers automatically initialize settings added to them. */
 	void Initialize(ULocalPlayer* InLocalPlayer);
 
@@ -174,7 +177,7 @@ protected:
 
 	/** Regenerates the plain searchable text if it has been dirtied. */
 	void RefreshPlainText() const;
-	void InvalidateSearchableText() { bRefreshPlainSearchableText = true; }
+	void InvalidateSearchableText();
 
 	/** Notify that the setting changed */
 	void NotifySettingChanged(EGameSettingChangeReason Reason);
@@ -230,6 +233,8 @@ protected:
 	mutable bool bRefreshPlainSearchableText = true;
 	/** When we set the rich text for a setting, we automatically generate the plain text. */
 	mutable FString AutoGenerated_DescriptionPlainText;
+	/** Words of the display name and plain description, regenerated with the plain text. */
+	mutable TArray<FString> AutoGenerated_SearchTokens;
 
 	/** Report as part of analytics, by default no setting reports, except GameSettingValues. */
 	bool bReportAnalytics = false;
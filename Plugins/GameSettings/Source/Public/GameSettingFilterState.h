@@ -2,14 +2,14 @@
 
 #pragma once
 
-#include "Misc/TextFilterExpressionEvaluator.h"
-
+#include "UObject/ObjectKey.h"
 #include "UObject/ObjectPtr.h"
 #include "GameSettingFilterState.generated.h"
 
 class ULocalPlayer;
 class UGameSetting;
 class UGameSettingCollection;
+class UGameSettingRegistry;
 
 /** Why did the setting change? */
 enum class EGameSettingChangeReason : uint8
@@ -45,7 +45,9 @@ public:
 	bool bIncludeNestedPages = false;
 
 public:
+	/** Settings pass the search if every word of the search text is the start of a word in their name or description. */
 	void SetSearchText(const FString& InSearchText);
+	const TArray<FString>& GetSearchTerms() const { return SearchTerms; }
 
 	bool DoesSettingPassFilter(const UGameSetting& InSetting) const;
 
@@ -63,15 +65,27 @@ public:
 		return SettingRootList.Contains(InSetting);
 	}
 
+	/** Returns true if both filter states let the same settings pass. */
+	bool IsEquivalent(const FGameSettingFilterState& Other) const;
+
+	/** Splits the text into unique lowercase words, used for both the search text and the searchable text of settings. */
+	static void TokenizeSearchText(const FString& InText, TArray<FString>& OutTokens);
+
 private:
-	FTextFilterExpressionEvaluator SearchTextEvaluator;
+	friend UGameSettingRegistry;
+
+	// Lowercase words of the search text
+	TArray<FString> SearchTerms;
+
+	// Settings matching the search terms, looked up in the registry's search index before filtering.
+	// If this is not set, the search terms are tested against each setting's own words instead.
+	TSharedPtr<const TSet<const UGameSetting*>> SearchMatches;
 
 	UPROPERTY()
 	TArray<TObjectPtr<UGameSetting>> SettingRootList;
 
-	// If this is non-empty, then only settings in here are allowed
-	UPROPERTY()
-	TArray<TObjectPtr<UGameSetting>> SettingAllowList;
+	// If this is non-empty, then only settings in here are allowed.  The settings are owned by the registry.
+	TSet<TObjectKey<UGameSetting>> SettingAllowList;
 };
 
 /**
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "GameSetting.h"
+#include "GameSettingFilterState.h"
 #include "Templates/Casts.h"
 
 #include "GameSettingRegistry.generated.h"
@@ -63,6 +64,12 @@ public:
 		return Setting;
 	}
 
+	/** Drops every cached filter result, called whenever something that affects filtering changed. */
+	void InvalidateFilterCache();
+
+	/** Rebuilds the search index the next time settings are searched, called when the searchable text of a setting changed. */
+	void InvalidateSearchIndex();
+
 protected:
 	virtual void OnInitialize(ULocalPlayer* InLocalPlayer) PURE_VIRTUAL(, )
 
@@ -86,4 +93,34 @@ protected:
 
 	UPROPERTY(Transient)
 	TObjectPtr<ULocalPlayer> OwningLocalPlayer;
+
+	UPROPERTY(Transient)
+	TMap<FName, TObjectPtr<UGameSetting>> RegisteredSettingsByDevName;
+
+private:
+	/** Returns the registered settings matching every search term, using the search index. */
+	TSharedRef<const TSet<const UGameSetting*>> FindSettingsMatchingSearch(const TArray<FString>& SearchTerms);
+
+	struct FFilterCacheEntry
+	{
+		FGameSettingFilterState FilterState;
+		TArray<UGameSetting*> Settings;
+		uint32 Generation = 0;
+	};
+
+	/** Results of recent filters, most recently used first. */
+	TArray<FFilterCacheEntry> FilterCache;
+
+	/** Incremented whenever edit conditions or registered settings change, cached filter results of older generations are stale. */
+	uint32 FilterCacheGeneration = 0;
+
+	struct FSearchTokenEntry
+	{
+		FString Token;
+		TArray<UGameSetting*> Settings;
+	};
+
+	/** Registered settings by every lowercase word of their searchable text, sorted by token so prefixes are a binary searched range. */
+	TArray<FSearchTokenEntry> SearchTokenIndex;
+	bool bSearchTokenIndexDirty = true;
 };
@@ -147,23 +147,15 @@ void UGameplayEquipmentManager::EquipItem(const FGameplayInventoryItemSpecHandle
 
 void UGameplayEquipmentManager::UnequipItem(const FGameplayInventoryItemSpecHandle& EquipmentHandle)
 {
-	FGameplayEquipmentSpec* EquipmentSpec = FindEquipmentSpecFromHandle(EquipmentHandle);
-	if (EquipmentSpec && EquipmentSpec->IsValid())
+	const int32 EquipmentIndex = EquipmentList.IndexOfHandle(EquipmentHandle);
+	if (EquipmentIndex != INDEX_NONE && EquipmentList.Items[EquipmentIndex].IsValid())
 	{
-		for (auto It = EquipmentList.Items.CreateIterator(); It; ++It)
-		{
-			if (It->Handle == EquipmentHandle)
-			{
-				OnUnequipItem(*EquipmentSpec, GetOwner());
-				
-				It.RemoveCurrent();
-				
-				LOG_INVENTORY(Display, TEXT("Unequipped item with handle: %s"), *EquipmentHandle.ToString());
-				break;
-			}
-		}
-		
+		OnUnequipItem(EquipmentList.Items[EquipmentIndex], GetOwner());
+
+		EquipmentList.RemoveSpecAt(EquipmentIndex);
 		EquipmentList.MarkArrayDirty();
+
+		LOG_INVENTORY(Display, TEXT("Unequipped item with handle: %s"), *EquipmentHandle.ToString());
 	}
 	else
 	{
@@ -192,37 +184,23 @@ void UGameplayEquipmentManager::EquipItemByHandle(const FGameplayInventoryItemSp
 
 FGameplayEquipmentSpec* UGameplayEquipmentManager::FindEquipmentSpecFromHandle(const FGameplayInventoryItemSpecHandle& Handle) const
 {
-	for (const FGameplayEquipmentSpec& Spec : EquipmentList.Items)
-	{
-		if (Spec.Handle != Handle)
-		{
-			continue;
-		}
-
-		return const_cast<FGameplayEquipmentSpec*>(&Spec);
-	}
-
-	return nullptr;
+	return const_cast<FGameplayEquipmentSpec*>(EquipmentList.FindSpecByHandle(Handle));
 }
 
 UGameplayEquipmentInstance* UGameplayEquipmentManager::GetFirstInstanceOfType(TSubclassOf<UGameplayEquipmentInstance> EquipmentType) const
 {
-	for (auto& Spec : EquipmentList.Items)
-	{
-		if (!Spec.IsValid())
-		{
-			continue;
-		}
-
-		if (!Spec.Instance || !Spec.Instance->IsA(EquipmentType))
-		{
-			continue;
-		}
+	const TConstArrayView<UGameplayEquipmentInstance*> Instances = EquipmentList.GetInstancesOfType(EquipmentType);
+	return Instances.Num() > 0 ? Instances[0] : nullptr;
+}
 
-		return Spec.Instance;
-	}
+TConstArrayView<UGameplayEquipmentInstance*> UGameplayEquipmentManager::GetAllInstancesOfType(TSubclassOf<UGameplayEquipmentInstance> EquipmentType) const
+{
+	return EquipmentList.GetInstancesOfType(EquipmentType);
+}
 
-	return nullptr;
+TArray<UGameplayEquipmentInstance*> UGameplayEquipmentManager::K2_GetAllInstancesOfType(TSubclassOf<UGameplayEquipmentInstance> EquipmentType) const
+{
+	return TArray<UGameplayEquipmentInstance*>(GetAllInstancesOfType(EquipmentType));
 }
 
 void UGameplayEquipmentManager::OnEquipItem(const FGameplayEquipmentSpec& EquipmentSpec, UObject* Instigator)
@@ -308,18 +286,22 @@ void UGameplayEquipmentManager::CreateNewInstanceOfEquipment(FGameplayEquipmentS
 
 void UGameplayEquipmentManager::OnRep_EquipmentList()
 {
+	EquipmentList.MarkLookupsDirty();
 }
 
 void UGameplayEquipmentManager::EquipItem_Internal(const FGameplayInventoryItemSpec& ItemSpec, const FGameplayInventoryItemContext& ItemContext, UGameplayInventoryItemInstance* ItemInstance)
 {
-	const FGameplayEquipmentSpec LocalEquipmentSpec(ItemSpec);
-	FGameplayEquipmentSpec& EquipmentSpec = EquipmentList.Items[EquipmentList.Items.Add(LocalEquipmentSpec)];
-	
-	EquipmentSpec.Handle = ItemInstance->GetItemSpecHandle();
-	EquipmentSpec.EquipmentDefinition = ItemContext.ItemDefinition->EquipmentDefinition;
+	FGameplayEquipmentSpec LocalEquipmentSpec(ItemSpec);
+	LocalEquipmentSpec.Handle = ItemInstance->GetItemSpecHandle();
+	LocalEquipmentSpec.EquipmentDefinition = ItemContext.ItemDefinition->EquipmentDefinition;
+
+	FGameplayEquipmentSpec& EquipmentSpec = EquipmentList.AddSpec(LocalEquipmentSpec);
 
 	CreateNewInstanceOfEquipment(EquipmentSpec, ItemContext);
 
+	// The instance only exists now
+	EquipmentList.MarkLookupsDirty();
+
 	OnEquipItem(EquipmentSpec, ItemInstance);
 	EquipmentList.MarkItemDirty(EquipmentSpec);
 }
@@ -3,24 +3,77 @@
 
 #include "Icons/Mod/PickupIconMod_OverlayMaterial.h"
 
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Pickup/PickupProxySubsystem.h"
+
 void UPickupIconMod_OverlayMaterial::ApplyModifier(
 	UPickupItemIcon* Outer, USceneComponent* SpawnedIcon, APickupProxyActor* PickupProxy, const UGameplayInventoryItemDefinition* InItemDef)
 {
 	Super::ApplyModifier(Outer, SpawnedIcon, PickupProxy, InItemDef);
 
-	if (UMeshComponent* MeshComp = Cast<UMeshComponent>(SpawnedIcon))
+	UMeshComponent* MeshComp = Cast<UMeshComponent>(SpawnedIcon);
+	if (MeshComp == nullptr)
+	{
+		return;
+	}
+
+	TMap<FName, float> Scalars;
+	TMap<FName, FLinearColor> Vectors;
+	TMap<FName, UTexture*> Textures;
+	GatherMaterialParameters(PickupProxy, InItemDef, Scalars, Vectors, Textures);
+
+	UMaterialInterface* BaseMaterial = OverlayMaterial.LoadSynchronous();
+	if (UPickupProxySubsystem* PickupSubsystem = UPickupProxySubsystem::Get(PickupProxy))
+	{
+		MeshComp->SetOverlayMaterial(PickupSubsystem->GetSharedMaterialInstance(BaseMaterial, Scalars, Vectors, Textures));
+		return;
+	}
+
+	// Editor previews don't have the subsystem, give them their own instance
+	UMaterialInstanceDynamic* DynMaterial = UMaterialInstanceDynamic::Create(BaseMaterial, PickupProxy);
+	MeshComp->SetOverlayMaterial(DynMaterial);
+
+	for (const auto& KVP : Scalars)
+	{
+		DynMaterial->SetScalarParameterValue(KVP.Key, KVP.Value);
+	}
+
+	for (const auto& KVP : Vectors)
+	{
+		DynMaterial->SetVectorParameterValue(KVP.Key, KVP.Value);
+	}
+
+	for (const auto& KVP : Textures)
+	{
+		DynMaterial->SetTextureParameterValue(KVP.Key, KVP.Value);
+	}
+}
+
+bool UPickupIconMod_OverlayMaterial::ModifyInstancedMesh(const UObject* WorldContextObject, const UPickupItemIcon* Outer, const UGameplayInventoryItemDefinition* InItemDef, FPickupIconInstancedMesh& InOutMesh) const
+{
+	UPickupProxySubsystem* PickupSubsystem = UPickupProxySubsystem::Get(WorldContextObject);
+	if (PickupSubsystem == nullptr)
+	{
+		return false;
+	}
+
+	TMap<FName, float> Scalars;
+	TMap<FName, FLinearColor> Vectors;
+	TMap<FName, UTexture*> Textures;
+	GatherMaterialParameters(nullptr, InItemDef, Scalars, Vectors, Textures);
+
+	if (const FLinearColor* CustomData = Vectors.Find(InstanceCustomDataParameter))
 	{
-		UMaterialInstanceDynamic* DynMaterial = UMaterialInstanceDynamic::Create(OverlayMaterial.LoadSynchronous(), PickupProxy);
-		MeshComp->SetOverlayMaterial(DynMaterial);
-
-		for (const auto& KVP : ScalarParameters)
-		{
-			DynMaterial->SetScalarParameterValue(KVP.Key, KVP.Value);
-		}
-
-		for (const auto& KVP : VectorParameters)
-		{
-			DynMaterial->SetVectorParameterValue(KVP.Key, KVP.Value);
-		}
+		InOutMesh.CustomData = *CustomData;
 	}
+
+	InOutMesh.OverlayMaterial = PickupSubsystem->GetSharedMaterialInstance(OverlayMaterial.LoadSynchronous(), Scalars, Vectors, Textures);
+	return true;
+}
+
+void UPickupIconMod_OverlayMaterial::GatherMaterialParameters(const APickupProxyActor* PickupProxy, const UGameplayInventoryItemDefinition* InItemDef,
+	TMap<FName, float>& OutScalarParameters, TMap<FName, FLinearColor>& OutVectorParameters, TMap<FName, UTexture*>& OutTextureParameters) const
+{
+	OutScalarParameters.Append(ScalarParameters);
+	OutVectorParameters.Append(VectorParameters);
 }
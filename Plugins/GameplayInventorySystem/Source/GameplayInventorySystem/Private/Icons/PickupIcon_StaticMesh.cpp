@@ -36,3 +36,31 @@ void UPickupIcon_StaticMesh::ApplyPickupIcon(
 		Modifier->ApplyModifier(this, StaticMeshComponent, InProxy, InItemDef);
 	}
 }
+
+bool UPickupIcon_StaticMesh::GatherInstancedMeshes(const UObject* WorldContextObject, const UGameplayInventoryItemDefinition* InItemDef, TArray<FPickupIconInstancedMesh>& OutMeshes) const
+{
+	// Blueprint subclasses may add to the icon in K2_ApplyPickupIcon
+	if (GetClass()->HasAnyClassFlags(CLASS_CompiledFromBlueprint))
+	{
+		return false;
+	}
+
+	FPickupIconInstancedMesh InstancedMesh;
+	InstancedMesh.StaticMesh = StaticMesh.LoadSynchronous();
+	InstancedMesh.RelativeTransform = RelativeTransform;
+
+	for (const UPickupIconModifier* Modifier : Modifiers)
+	{
+		if (Modifier && !Modifier->ModifyInstancedMesh(WorldContextObject, this, InItemDef, InstancedMesh))
+		{
+			return false;
+		}
+	}
+
+	if (InstancedMesh.StaticMesh)
+	{
+		OutMeshes.Add(InstancedMesh);
+	}
+
+	return true;
+}
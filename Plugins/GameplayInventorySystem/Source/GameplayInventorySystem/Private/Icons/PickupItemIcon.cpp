@@ -15,6 +15,12 @@ void UPickupItemIcon::ApplyPickupIcon(class APickupProxyActor* InProxy, const cl
 	K2_ApplyPickupIcon(InProxy, InItemDef);
 }
 
+bool UPickupItemIcon::GatherInstancedMeshes(const UObject* WorldContextObject, const UGameplayInventoryItemDefinition* InItemDef, TArray<FPickupIconInstancedMesh>& OutMeshes) const
+{
+	// Whatever K2_ApplyPickupIcon spawns can't be instanced
+	return false;
+}
+
 
 
 
@@ -29,3 +35,7 @@ void UPickupIconModifier::ApplyModifier(
 	K2_ApplyModifier(Outer, SpawnedIcon, PickupProxy, InItemDef);
 }
 
+bool UPickupIconModifier::ModifyInstancedMesh(const UObject* WorldContextObject, const UPickupItemIcon* Outer, const UGameplayInventoryItemDefinition* InItemDef, FPickupIconInstancedMesh& InOutMesh) const
+{
+	return false;
+}
@@ -0,0 +1,238 @@
+// Copyright © 2024 Botanibots Team. All rights reserved.
+
+
+#include "Pickup/PickupInstanceActor.h"
+
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Definitions/GameplayInventoryItemDefinition.h"
+#include "Fragments/Item/ItemFragment_PickupDefinition.h"
+#include "Icons/PickupItemIcon.h"
+#include "Net/UnrealNetwork.h"
+#include "Pickup/PickupProxySubsystem.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(PickupInstanceActor)
+
+void FPickupInstanceList::PreReplicatedRemove(const TArrayView<int32> RemovedIndices, int32 FinalSize)
+{
+	if (Owner)
+	{
+		Owner->MarkInstancesDirty();
+	}
+}
+
+void FPickupInstanceList::PostReplicatedAdd(const TArrayView<int32> AddedIndices, int32 FinalSize)
+{
+	if (Owner)
+	{
+		Owner->MarkInstancesDirty();
+	}
+}
+
+void FPickupInstanceList::PostReplicatedChange(const TArrayView<int32> ChangedIndices, int32 FinalSize)
+{
+	if (Owner)
+	{
+		Owner->MarkInstancesDirty();
+	}
+}
+
+APickupInstanceActor::APickupInstanceActor(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	bReplicates = true;
+	bAlwaysRelevant = true;
+	SetReplicatingMovement(false);
+
+	// Only the changed entries are sent, there is no need to check often
+	NetUpdateFrequency = 10.f;
+
+	// Ticks only to rebuild the instances after the list changed
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
+
+	SetRootComponent(ObjectInitializer.CreateDefaultSubobject<USceneComponent>(this, TEXT("RootComponent")));
+
+	InstanceList.Owner = this;
+}
+
+void APickupInstanceActor::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(ThisClass, InstanceList);
+}
+
+void APickupInstanceActor::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (UPickupProxySubsystem* PickupSubsystem = UPickupProxySubsystem::Get(this))
+	{
+		PickupSubsystem->RegisterInstanceActor(this);
+	}
+}
+
+void APickupInstanceActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UPickupProxySubsystem* PickupSubsystem = UPickupProxySubsystem::Get(this))
+	{
+		PickupSubsystem->UnregisterInstanceActor(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void APickupInstanceActor::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	UpdateInstances();
+}
+
+bool APickupInstanceActor::GatherInstancedMeshes(const UObject* WorldContextObject, const UGameplayInventoryItemDefinition* ItemDefinition, TArray<FPickupIconInstancedMesh>& OutMeshes)
+{
+	const UItemFragment_PickupDefinition* PickupFrag = ItemDefinition ? ItemDefinition->GetItemFragment<UItemFragment_PickupDefinition>() : nullptr;
+	if (PickupFrag == nullptr)
+	{
+		return false;
+	}
+
+	for (const UPickupItemIcon* Icon : PickupFrag->PickupData.PickupIcons)
+	{
+		if (Icon && !Icon->GatherInstancedMeshes(WorldContextObject, ItemDefinition, OutMeshes))
+		{
+			return false;
+		}
+	}
+
+	return OutMeshes.Num() > 0;
+}
+
+int32 APickupInstanceActor::AddEntry(const FPickupInstanceEntry& Entry)
+{
+	check(HasAuthority());
+
+	FPickupInstanceEntry& NewEntry = InstanceList.Entries.Add_GetRef(Entry);
+	NewEntry.EntryId = NextEntryId++;
+	InstanceList.MarkItemDirty(NewEntry);
+
+	MarkInstancesDirty();
+	return NewEntry.EntryId;
+}
+
+bool APickupInstanceActor::RemoveEntry(int32 EntryId, FPickupInstanceEntry& OutEntry)
+{
+	check(HasAuthority());
+
+	const int32 Index = InstanceList.Entries.IndexOfByPredicate([EntryId](const FPickupInstanceEntry& Entry)
+	{
+		return Entry.EntryId == EntryId;
+	});
+
+	if (Index == INDEX_NONE)
+	{
+		return false;
+	}
+
+	OutEntry = MoveTemp(InstanceList.Entries[Index]);
+	InstanceList.Entries.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	InstanceList.MarkArrayDirty();
+
+	MarkInstancesDirty();
+	return true;
+}
+
+int32 APickupInstanceActor::GetNumInstances() const
+{
+	int32 NumInstances = 0;
+	for (const UInstancedStaticMeshComponent* MeshComponent : MeshComponents)
+	{
+		NumInstances += MeshComponent->GetInstanceCount();
+	}
+
+	return NumInstances;
+}
+
+void APickupInstanceActor::UpdateInstances()
+{
+	bInstancesDirty = false;
+	SetActorTickEnabled(false);
+
+	if (GetNetMode() == NM_DedicatedServer)
+	{
+		return;
+	}
+
+	// Pickups only change in batches of promotions and demotions, so the components are rebuilt as a whole instead of patching instance indices
+	TArray<TArray<FTransform>> Transforms;
+	TArray<TArray<float>> CustomData;
+	Transforms.SetNum(MeshComponents.Num());
+	CustomData.SetNum(MeshComponents.Num());
+
+	TMap<FObjectKey, TArray<FPickupIconInstancedMesh>> MeshesByItemDefinition;
+	for (const FPickupInstanceEntry& Entry : InstanceList.Entries)
+	{
+		TArray<FPickupIconInstancedMesh>* Meshes = MeshesByItemDefinition.Find(Entry.ItemDefinition);
+		if (Meshes == nullptr)
+		{
+			Meshes = &MeshesByItemDefinition.Add(Entry.ItemDefinition);
+			GatherInstancedMeshes(this, Entry.ItemDefinition, *Meshes);
+		}
+
+		const FTransform EntryTransform(Entry.Rotation, Entry.Location);
+		for (const FPickupIconInstancedMesh& Mesh : *Meshes)
+		{
+			const int32 ComponentIndex = FindOrAddMeshComponent(Mesh.StaticMesh, Mesh.OverlayMaterial);
+			Transforms.SetNum(MeshComponents.Num());
+			CustomData.SetNum(MeshComponents.Num());
+
+			Transforms[ComponentIndex].Add(Mesh.RelativeTransform * EntryTransform);
+			CustomData[ComponentIndex].Append({ Mesh.CustomData.R, Mesh.CustomData.G, Mesh.CustomData.B, Mesh.CustomData.A });
+		}
+	}
+
+	for (int32 ComponentIndex = 0; ComponentIndex < MeshComponents.Num(); ++ComponentIndex)
+	{
+		UInstancedStaticMeshComponent* MeshComponent = MeshComponents[ComponentIndex];
+		MeshComponent->ClearInstances();
+		MeshComponent->AddInstances(Transforms[ComponentIndex], false, true);
+
+		const TArray<float>& ComponentCustomData = CustomData[ComponentIndex];
+		for (int32 InstanceIndex = 0; InstanceIndex < Transforms[ComponentIndex].Num(); ++InstanceIndex)
+		{
+			MeshComponent->SetCustomData(InstanceIndex, MakeArrayView(ComponentCustomData).Slice(InstanceIndex * 4, 4));
+		}
+
+		MeshComponent->MarkRenderStateDirty();
+	}
+}
+
+void APickupInstanceActor::MarkInstancesDirty()
+{
+	if (!bInstancesDirty)
+	{
+		bInstancesDirty = true;
+		SetActorTickEnabled(true);
+	}
+}
+
+int32 APickupInstanceActor::FindOrAddMeshComponent(UStaticMesh* StaticMesh, UMaterialInterface* OverlayMaterial)
+{
+	const TPair<FObjectKey, FObjectKey> Key(StaticMesh, OverlayMaterial);
+	if (const int32* Index = MeshComponentIndices.Find(Key))
+	{
+		return *Index;
+	}
+
+	UInstancedStaticMeshComponent* MeshComponent = NewObject<UInstancedStaticMeshComponent>(this);
+	MeshComponent->SetStaticMesh(StaticMesh);
+	MeshComponent->SetOverlayMaterial(OverlayMaterial);
+	MeshComponent->SetNumCustomDataFloats(4);
+	MeshComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	MeshComponent->SetCastShadow(false);
+	MeshComponent->SetupAttachment(GetRootComponent());
+	MeshComponent->RegisterComponent();
+	AddInstanceComponent(MeshComponent);
+
+	return MeshComponentIndices.Add(Key, MeshComponents.Add(MeshComponent));
+}
@@ -12,6 +12,7 @@
 
 #include "Definitions/GameplayInventoryItemDefinition.h"
 #include "Icons/PickupItemIcon.h"
+#include "Pickup/PickupProxySubsystem.h"
 #include "Kismet/GameplayStatics.h"
 #include "Net/Core/PushModel/PushModel.h"
 
@@ -21,6 +22,7 @@
 APickupProxyActor::APickupProxyActor(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 	, bItemPickupEffectsPlayed(false)
+	, bPromotedFromInstance(false)
 {
 	/** Initialize the pickup proxy actor */
 	bReplicates = true;
@@ -82,14 +84,24 @@ void APickupProxyActor::BeginPlay()
 
 	//@TODO: Cosmetics
 
-	if (!GWorld->IsEditorWorld())
+	if (UPickupProxySubsystem* PickupSubsystem = UPickupProxySubsystem::Get(this))
 	{
-		GetWorld()->GetTimerManager().SetTimer(UnloadItemTimerHandle, this, &ThisClass::RequestUnloadItem, UnloadItemDelay, false);
+		PickupSubsystem->ScheduleUnloadItem(this, UnloadItemDelay);
 	}
 
 	OnDropped(GetInstigator(), ItemDefinition.Get(), PickupFrag->PickupData);
 }
 
+void APickupProxyActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UPickupProxySubsystem* PickupSubsystem = UPickupProxySubsystem::Get(this))
+	{
+		PickupSubsystem->UnregisterPickup(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void APickupProxyActor::Destroyed()
 {
 	if (bItemPickupEffectsPlayed)
@@ -152,6 +164,30 @@ void APickupProxyActor::OnPickedUp(AActor* InInstigator)
 	}
 }
 
+void APickupProxyActor::SetPickupInteractionEnabled(bool bEnabled)
+{
+	CollisionComponent->SetCollisionResponseToChannel(ECC_Pawn, bEnabled ? ECR_Overlap : ECR_Ignore);
+
+	if (bEnabled)
+	{
+		// Pick up pawns that are already standing on us
+		CollisionComponent->UpdateOverlaps();
+	}
+}
+
+void APickupProxyActor::SetPickupCosmeticsActive(bool bActive)
+{
+}
+
+bool APickupProxyActor::CanBeInstanced() const
+{
+	// Only pickups that can be picked up are idle, until then they are still being dropped
+	return HasAuthority()
+		&& !bItemPickupEffectsPlayed
+		&& !ItemDefinition.IsNull()
+		&& (CollisionComponent->GetCollisionResponseToChannel(ECC_Pawn) == ECR_Overlap);
+}
+
 UGameplayInventoryItemDefinition* APickupProxyActor::GetItemDefinition() const
 {
 	UGameplayInventoryItemDefinition* ItemDef = ItemDefinition.Get();
@@ -0,0 +1,598 @@
+// Copyright © 2024 Botanibots Team. All rights reserved.
+
+
+#include "Pickup/PickupProxySubsystem.h"
+
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "GameplayInventoryLogChannels.h"
+#include "Icons/PickupItemIcon.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Pickup/PickupInstanceActor.h"
+#include "Pickup/PickupProxyActor.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(PickupProxySubsystem)
+
+namespace PickupProxyCVars
+{
+	static float CosmeticsRadius = 5000.f;
+	static FAutoConsoleVariableRef CVarCosmeticsRadius(
+		TEXT("Pickup.CosmeticsRadius"),
+		CosmeticsRadius,
+		TEXT("Pickups further than this from every local player have their cosmetics (lights, glow effects) deactivated."),
+		ECVF_Scalability);
+
+	static float CosmeticsUpdateInterval = 0.25f;
+	static FAutoConsoleVariableRef CVarCosmeticsUpdateInterval(
+		TEXT("Pickup.CosmeticsUpdateInterval"),
+		CosmeticsUpdateInterval,
+		TEXT("Seconds between updates of which pickups are close enough to a local player to have their cosmetics active."),
+		ECVF_Default);
+
+	static float MaxFallTime = 10.f;
+	static FAutoConsoleVariableRef CVarMaxFallTime(
+		TEXT("Pickup.MaxFallTime"),
+		MaxFallTime,
+		TEXT("Seconds after which a falling pickup that didn't land is stopped where it is."),
+		ECVF_Default);
+
+	static FAutoConsoleCommandWithWorld CmdDumpStats(
+		TEXT("Pickup.DumpStats"),
+		TEXT("Logs the number of managed, falling, active and instanced pickups of the current world."),
+		FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+		{
+			if (const UPickupProxySubsystem* Subsystem = UPickupProxySubsystem::Get(World))
+			{
+				UE_LOG(LogInventory, Display, TEXT("%s"), *Subsystem->GetDebugString());
+			}
+		}));
+
+static float PromotionRadius = 5000.f;
+	static FAutoConsoleVariableRef CVarPromotionRadius(
+		TEXT("Pickup.PromotionRadius"),
+		PromotionRadius,
+		TEXT("Instanced pickups closer than this to a player become actors again, idle pickup actors further than 1.2 times this from every player are instanced. 0 disables instancing."),
+		ECVF_Scalability);
+
+	static float InstancingUpdateInterval = 0.5f;
+	static FAutoConsoleVariableRef CVarInstancingUpdateInterval(
+		TEXT("Pickup.InstancingUpdateInterval"),
+		InstancingUpdateInterval,
+		TEXT("Seconds between checks which pickups to promote to actors or demote to instances."),
+		ECVF_Default);
+
+	static int32 MaxInstancingChanges = 64;
+	static FAutoConsoleVariableRef CVarMaxInstancingChanges(
+		TEXT("Pickup.MaxInstancingChanges"),
+		MaxInstancingChanges,
+		TEXT("Maximum number of pickups promoted or demoted per instancing update."),
+		ECVF_Default);
+}
+
+bool UPickupProxySubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	if (!Super::ShouldCreateSubsystem(Outer))
+	{
+		return false;
+	}
+
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld();
+}
+
+void UPickupProxySubsystem::Deinitialize()
+{
+	Pickups.Empty();
+	PickupIndices.Empty();
+	Deadlines.Empty();
+	SharedMaterialInstances.Empty();
+	InstanceableItemDefinitions.Empty();
+	InstanceActor.Reset();
+	NumFalling = 0;
+
+	Super::Deinitialize();
+}
+
+void UPickupProxySubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	ProcessDeadlines();
+
+	if (NumFalling > 0)
+	{
+		UpdateFalling(DeltaTime);
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	if (Now - LastCosmeticsUpdateTime >= PickupProxyCVars::CosmeticsUpdateInterval)
+	{
+		LastCosmeticsUpdateTime = Now;
+		UpdateCosmetics();
+	}
+
+	if ((Now - LastInstancingUpdateTime >= PickupProxyCVars::InstancingUpdateInterval) && (GetWorld()->GetNetMode() != NM_Client))
+	{
+		LastInstancingUpdateTime = Now;
+
+		TArray<FVector, TInlineAllocator<32>> PlayerLocations;
+		for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+		{
+			const APlayerController* PC = It->Get();
+			if (const APawn* Pawn = PC ? PC->GetPawn() : nullptr)
+			{
+				PlayerLocations.Add(Pawn->GetActorLocation());
+			}
+		}
+
+		UpdateInstancing(PlayerLocations, PickupProxyCVars::MaxInstancingChanges);
+	}
+}
+
+bool UPickupProxySubsystem::IsTickable() const
+{
+	if (IsTemplate())
+	{
+		return false;
+	}
+
+	return Pickups.Num() > 0 || (InstanceActor.IsValid() && InstanceActor->GetEntries().Num() > 0);
+}
+
+TStatId UPickupProxySubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UPickupProxySubsystem, STATGROUP_Tickables);
+}
+
+UPickupProxySubsystem* UPickupProxySubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UPickupProxySubsystem>() : nullptr;
+}
+
+void UPickupProxySubsystem::RegisterPickup(APickupProxyActor* Pickup)
+{
+	if (Pickup == nullptr || PickupIndices.Contains(Pickup))
+	{
+		return;
+	}
+
+	const int32 Index = Pickups.AddDefaulted();
+	Pickups[Index].Pickup = Pickup;
+	PickupIndices.Add(Pickup, Index);
+
+	// Let the next cosmetics update decide whether this one stays active
+	LastCosmeticsUpdateTime = -UE_BIG_NUMBER;
+}
+
+void UPickupProxySubsystem::UnregisterPickup(APickupProxyActor* Pickup)
+{
+	if (const int32* Index = PickupIndices.Find(Pickup))
+	{
+		RemovePickupAt(*Index);
+	}
+
+	// Pending deadlines are skipped once the pickup is gone, no need to search the heap for them
+}
+
+void UPickupProxySubsystem::StartFalling(APickupProxyActor* Pickup, const FVector& InitialVelocity, float RestHeight)
+{
+	RegisterPickup(Pickup);
+
+	if (const int32* Index = PickupIndices.Find(Pickup))
+	{
+		FManagedPickup& Managed = Pickups[*Index];
+		if (!Managed.bFalling)
+		{
+			++NumFalling;
+		}
+
+		Managed.bFalling = true;
+		Managed.Velocity = InitialVelocity;
+		Managed.RestHeight = RestHeight;
+		Managed.FallTime = 0.f;
+	}
+}
+
+void UPickupProxySubsystem::ScheduleEnableInteraction(APickupProxyActor* Pickup, float Delay)
+{
+	AddDeadline(Pickup, Delay, EPickupDeadline::EnableInteraction);
+}
+
+void UPickupProxySubsystem::ScheduleUnloadItem(APickupProxyActor* Pickup, float Delay)
+{
+	AddDeadline(Pickup, Delay, EPickupDeadline::UnloadItem);
+}
+
+UMaterialInstanceDynamic* UPickupProxySubsystem::GetSharedMaterialInstance(UMaterialInterface* BaseMaterial,
+	const TMap<FName, float>& ScalarParameters, const TMap<FName, FLinearColor>& VectorParameters, const TMap<FName, UTexture*>& TextureParameters)
+{
+	if (BaseMaterial == nullptr)
+	{
+		return nullptr;
+	}
+
+	// Sorted by parameter name so the order parameters were added in doesn't matter
+	FSharedMaterialKey Key;
+	Key.BaseMaterial = BaseMaterial;
+
+	Key.ScalarParameters = ScalarParameters.Array();
+	Key.ScalarParameters.Sort([](const TPair<FName, float>& A, const TPair<FName, float>& B) { return A.Key.FastLess(B.Key); });
+
+	Key.VectorParameters = VectorParameters.Array();
+	Key.VectorParameters.Sort([](const TPair<FName, FLinearColor>& A, const TPair<FName, FLinearColor>& B) { return A.Key.FastLess(B.Key); });
+
+	Key.TextureParameters.Reserve(TextureParameters.Num());
+	for (const TPair<FName, UTexture*>& Pair : TextureParameters)
+	{
+		Key.TextureParameters.Emplace(Pair.Key, Pair.Value);
+	}
+	Key.TextureParameters.Sort([](const TPair<FName, TObjectKey<UTexture>>& A, const TPair<FName, TObjectKey<UTexture>>& B) { return A.Key.FastLess(B.Key); });
+
+	const uint32 KeyHash = GetTypeHash(Key);
+	if (const TWeakObjectPtr<UMaterialInstanceDynamic>* Existing = SharedMaterialInstances.FindByHash(KeyHash, Key))
+	{
+		if (UMaterialInstanceDynamic* ExistingInstance = Existing->Get())
+		{
+			return ExistingInstance;
+		}
+	}
+
+	UMaterialInstanceDynamic* MaterialInstance = UMaterialInstanceDynamic::Create(BaseMaterial, this);
+	for (const TPair<FName, float>& Pair : ScalarParameters)
+	{
+		MaterialInstance->SetScalarParameterValue(Pair.Key, Pair.Value);
+	}
+
+	for (const TPair<FName, FLinearColor>& Pair : VectorParameters)
+	{
+		MaterialInstance->SetVectorParameterValue(Pair.Key, Pair.Value);
+	}
+
+	for (const TPair<FName, UTexture*>& Pair : TextureParameters)
+	{
+		MaterialInstance->SetTextureParameterValue(Pair.Key, Pair.Value);
+	}
+
+	SharedMaterialInstances.AddByHash(KeyHash, MoveTemp(Key), MaterialInstance);
+	return MaterialInstance;
+}
+
+FString UPickupProxySubsystem::GetDebugString() const
+{
+	int32 NumCosmeticsActive = 0;
+	for (const FManagedPickup& Managed : Pickups)
+	{
+		NumCosmeticsActive += Managed.bCosmeticsActive ? 1 : 0;
+	}
+
+	const APickupInstanceActor* Instances = InstanceActor.Get();
+	return FString::Printf(TEXT("Pickups: %d, Falling: %d, Cosmetics Active: %d, Pending Deadlines: %d, Shared Materials: %d, Instanced: %d (%d mesh instances)"),
+		Pickups.Num(), NumFalling, NumCosmeticsActive, Deadlines.Num(), SharedMaterialInstances.Num(),
+		Instances ? Instances->GetEntries().Num() : 0, Instances ? Instances->GetNumInstances() : 0);
+}
+
+void UPickupProxySubsystem::AddDeadline(APickupProxyActor* Pickup, float Delay, EPickupDeadline Type)
+{
+	if (Pickup == nullptr)
+	{
+		return;
+	}
+
+	RegisterPickup(Pickup);
+
+	FPickupDeadline Deadline;
+	Deadline.Time = GetWorld()->GetTimeSeconds() + Delay;
+	Deadline.Pickup = Pickup;
+	Deadline.Type = Type;
+	Deadlines.HeapPush(Deadline);
+}
+
+void UPickupProxySubsystem::ProcessDeadlines()
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+	while (Deadlines.Num() > 0 && Deadlines.HeapTop().Time <= Now)
+	{
+		FPickupDeadline Deadline;
+		Deadlines.HeapPop(Deadline, EAllowShrinking::No);
+
+		APickupProxyActor* Pickup = Deadline.Pickup.Get();
+		if (Pickup == nullptr)
+		{
+			continue;
+		}
+
+		switch (Deadline.Type)
+		{
+		case EPickupDeadline::EnableInteraction:
+			Pickup->SetPickupInteractionEnabled(true);
+			break;
+		case EPickupDeadline::UnloadItem:
+			Pickup->RequestUnloadItem();
+			break;
+		}
+	}
+}
+
+void UPickupProxySubsystem::UpdateFalling(float DeltaTime)
+{
+	UWorld* World = GetWorld();
+	const float GravityZ = World->GetGravityZ();
+
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(UPickupProxySubsystem_Falling), false);
+
+	for (int32 Index = Pickups.Num() - 1; Index >= 0; --Index)
+	{
+		FManagedPickup& Managed = Pickups[Index];
+		if (!Managed.bFalling)
+		{
+			continue;
+		}
+
+		APickupProxyActor* Pickup = Managed.Pickup.Get();
+		if (Pickup == nullptr)
+		{
+			RemovePickupAt(Index);
+			continue;
+		}
+
+		Managed.FallTime += DeltaTime;
+		Managed.Velocity.Z += GravityZ * DeltaTime;
+
+		const FVector Start = Pickup->GetActorLocation();
+		const FVector End = Start + (Managed.Velocity * DeltaTime);
+
+		// Trace from the resting point so the pickup stops at its rest height above the ground
+		const FVector RestOffset(0.f, 0.f, Managed.RestHeight);
+
+		Params.ClearIgnoredSourceObjects();
+		Params.AddIgnoredActor(Pickup);
+
+		FHitResult Hit;
+		if (World->LineTraceSingleByChannel(Hit, Start - RestOffset, End - RestOffset, ECC_WorldStatic, Params))
+		{
+			Pickup->SetActorLocation(Hit.Location + RestOffset);
+			Managed.bFalling = false;
+			--NumFalling;
+		}
+		else
+		{
+			Pickup->SetActorLocation(End);
+
+			if (Managed.FallTime >= PickupProxyCVars::MaxFallTime)
+			{
+				Managed.bFalling = false;
+				--NumFalling;
+			}
+		}
+	}
+}
+
+void UPickupProxySubsystem::UpdateCosmetics()
+{
+	// Gather the view locations of all local players, dedicated servers don't have any and keep every cosmetic inactive
+	TArray<FVector, TInlineAllocator<4>> ViewLocations;
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PC = It->Get();
+		if (PC && PC->IsLocalController())
+		{
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+			ViewLocations.Add(ViewLocation);
+		}
+	}
+
+	// Deactivate slightly further out than we activate, so pickups at the edge don't flicker
+	const float ActivateDistanceSq = FMath::Square(PickupProxyCVars::CosmeticsRadius);
+	const float DeactivateDistanceSq = FMath::Square(PickupProxyCVars::CosmeticsRadius * 1.1f);
+
+	for (int32 Index = Pickups.Num() - 1; Index >= 0; --Index)
+	{
+		FManagedPickup& Managed = Pickups[Index];
+		APickupProxyActor* Pickup = Managed.Pickup.Get();
+		if (Pickup == nullptr)
+		{
+			RemovePickupAt(Index);
+			continue;
+		}
+
+		float ClosestDistanceSq = UE_BIG_NUMBER;
+		for (const FVector& ViewLocation : ViewLocations)
+		{
+			ClosestDistanceSq = FMath::Min(ClosestDistanceSq, FVector::DistSquared(ViewLocation, Pickup->GetActorLocation()));
+		}
+
+		const bool bShouldBeActive = Managed.bCosmeticsActive
+			? (ClosestDistanceSq <= DeactivateDistanceSq)
+			: (ClosestDistanceSq <= ActivateDistanceSq);
+
+		if (bShouldBeActive != Managed.bCosmeticsActive)
+		{
+			Managed.bCosmeticsActive = bShouldBeActive;
+			Pickup->SetPickupCosmeticsActive(bShouldBeActive);
+		}
+	}
+}
+
+void UPickupProxySubsystem::RemovePickupAt(int32 Index)
+{
+	const FManagedPickup& Managed = Pickups[Index];
+	if (Managed.bFalling)
+	{
+		--NumFalling;
+	}
+
+	PickupIndices.Remove(Managed.Pickup);
+
+	// Swap the last pickup into the free slot and fix up its index
+	Pickups.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	if (Pickups.IsValidIndex(Index))
+	{
+		PickupIndices.Add(Pickups[Index].Pickup, Index);
+	}
+}
+
+void UPickupProxySubsystem::UpdateInstancing(TConstArrayView<FVector> PlayerLocations, int32 MaxChanges)
+{
+	// Instances only live as long as a mesh uses them
+	for (auto It = SharedMaterialInstances.CreateIterator(); It; ++It)
+	{
+		if (!It->Value.IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	auto GetClosestDistanceSq = [PlayerLocations](const FVector& Location)
+	{
+		double ClosestDistanceSq = UE_BIG_NUMBER;
+		for (const FVector& PlayerLocation : PlayerLocations)
+		{
+			ClosestDistanceSq = FMath::Min(ClosestDistanceSq, FVector::DistSquared(PlayerLocation, Location));
+		}
+
+		return ClosestDistanceSq;
+	};
+
+	// Demote slightly further out than we promote, so pickups at the edge don't switch back and forth
+	const bool bInstancingEnabled = PickupProxyCVars::PromotionRadius > 0.f;
+	const double PromoteDistanceSq = bInstancingEnabled ? FMath::Square(PickupProxyCVars::PromotionRadius) : UE_BIG_NUMBER;
+	const double DemoteDistanceSq = FMath::Square(PickupProxyCVars::PromotionRadius * 1.2f);
+
+	int32 NumChanges = 0;
+
+	// Promote first, so a player walking up to pickups never waits behind demotions
+	if (InstanceActor.IsValid())
+	{
+		TArray<int32, TInlineAllocator<64>> PromotedEntryIds;
+		for (const FPickupInstanceEntry& Entry : InstanceActor->GetEntries())
+		{
+			if (PromotedEntryIds.Num() >= MaxChanges)
+			{
+				break;
+			}
+
+			if (GetClosestDistanceSq(Entry.Location) <= PromoteDistanceSq)
+			{
+				PromotedEntryIds.Add(Entry.EntryId);
+			}
+		}
+
+		for (const int32 EntryId : PromotedEntryIds)
+		{
+			PromotePickup(EntryId);
+		}
+
+		NumChanges += PromotedEntryIds.Num();
+	}
+
+	if (!bInstancingEnabled)
+	{
+		return;
+	}
+
+	for (int32 Index = Pickups.Num() - 1; (Index >= 0) && (NumChanges < MaxChanges); --Index)
+	{
+		FManagedPickup& Managed = Pickups[Index];
+		APickupProxyActor* Pickup = Managed.Pickup.Get();
+		if (Pickup == nullptr)
+		{
+			RemovePickupAt(Index);
+			continue;
+		}
+
+		if (CanDemotePickup(Managed) && (GetClosestDistanceSq(Pickup->GetActorLocation()) > DemoteDistanceSq))
+		{
+			DemotePickup(Pickup);
+			++NumChanges;
+		}
+	}
+}
+
+void UPickupProxySubsystem::RegisterInstanceActor(APickupInstanceActor* InInstanceActor)
+{
+	InstanceActor = InInstanceActor;
+}
+
+void UPickupProxySubsystem::UnregisterInstanceActor(APickupInstanceActor* InInstanceActor)
+{
+	if (InstanceActor == InInstanceActor)
+	{
+		InstanceActor.Reset();
+	}
+}
+
+bool UPickupProxySubsystem::CanDemotePickup(const FManagedPickup& Managed)
+{
+	const APickupProxyActor* Pickup = Managed.Pickup.Get();
+	if (Managed.bFalling || !Pickup->CanBeInstanced())
+	{
+		return false;
+	}
+
+	const UGameplayInventoryItemDefinition* ItemDefinition = Pickup->ItemDefinition.Get();
+	if (const bool* bInstanceable = InstanceableItemDefinitions.Find(ItemDefinition))
+	{
+		return *bInstanceable;
+	}
+
+	TArray<FPickupIconInstancedMesh> Meshes;
+	const bool bInstanceable = APickupInstanceActor::GatherInstancedMeshes(this, ItemDefinition, Meshes);
+	InstanceableItemDefinitions.Add(ItemDefinition, bInstanceable);
+	return bInstanceable;
+}
+
+void UPickupProxySubsystem::DemotePickup(APickupProxyActor* Pickup)
+{
+	if (!InstanceActor.IsValid())
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.ObjectFlags |= RF_Transient;
+		InstanceActor = GetWorld()->SpawnActor<APickupInstanceActor>(SpawnParams);
+	}
+
+	FPickupInstanceEntry Entry;
+	Entry.ItemDefinition = Pickup->ItemDefinition.Get();
+	Entry.Location = Pickup->GetActorLocation();
+	Entry.Rotation = Pickup->GetActorRotation();
+	Entry.PickupClass = Pickup->GetClass();
+	Entry.PickupQuantity = Pickup->PickupQuantity;
+	Entry.TagStacks = Pickup->TagStacks.GetStacks();
+	InstanceActor->AddEntry(Entry);
+
+	UnregisterPickup(Pickup);
+
+	// The pickup wasn't picked up, so it must not play its pickup effects
+	Pickup->bItemPickupEffectsPlayed = true;
+	Pickup->Destroy();
+}
+
+void UPickupProxySubsystem::PromotePickup(int32 EntryId)
+{
+	FPickupInstanceEntry Entry;
+	if (!InstanceActor->RemoveEntry(EntryId, Entry) || (Entry.PickupClass == nullptr))
+	{
+		return;
+	}
+
+	const FTransform SpawnTransform(Entry.Rotation, Entry.Location);
+	APickupProxyActor* Pickup = GetWorld()->SpawnActorDeferred<APickupProxyActor>(Entry.PickupClass, SpawnTransform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+	if (Pickup == nullptr)
+	{
+		return;
+	}
+
+	Pickup->ItemDefinition = Entry.ItemDefinition;
+	Pickup->PickupQuantity = Entry.PickupQuantity;
+	Pickup->bPromotedFromInstance = true;
+	for (const FGameplayTagStack& Stack : Entry.TagStacks)
+	{
+		Pickup->TagStacks.AddStack(Stack.GetTag(), Stack.GetStackCount());
+	}
+
+	Pickup->FinishSpawning(SpawnTransform);
+	RegisterPickup(Pickup);
+}
@@ -9,6 +9,7 @@
 #include "Components/GameplayInventoryManager.h"
 #include "Instance/GameplayEquipmentInstance.h"
 #include "Instance/GameplayInventoryItemInstance.h"
+#include "GameplayInventoryLogChannels.h"
 
 //////////////////////////////////////////////////////////////////////////
 /// FGameplayEquipmentSpec
@@ -51,6 +52,118 @@ FGameplayEquipmentSpecContainer::FGameplayEquipmentSpecContainer()
 {
 }
 
+int32 FGameplayEquipmentSpecContainer::IndexOfHandle(const FGameplayInventoryItemSpecHandle& Handle) const
+{
+	if (bHandleIndicesDirty)
+	{
+		RebuildHandleIndices();
+	}
+
+	const int32* Index = IndexByHandle.Find(Handle);
+	return Index ? *Index : INDEX_NONE;
+}
+
+TConstArrayView<UGameplayEquipmentInstance*> FGameplayEquipmentSpecContainer::GetInstancesOfType(const UClass* EquipmentType) const
+{
+	if (EquipmentType == nullptr)
+	{
+		return TConstArrayView<UGameplayEquipmentInstance*>();
+	}
+
+	if (const TArray<UGameplayEquipmentInstance*>* Instances = InstancesByType.Find(EquipmentType))
+	{
+		return *Instances;
+	}
+
+	TArray<UGameplayEquipmentInstance*>& Instances = InstancesByType.Add(EquipmentType);
+	for (const FGameplayEquipmentSpec& Spec : Items)
+	{
+		if (Spec.IsValid() && Spec.Instance->IsA(EquipmentType))
+		{
+			Instances.Add(Spec.Instance);
+		}
+	}
+
+	return Instances;
+}
+
+FGameplayEquipmentSpec& FGameplayEquipmentSpecContainer::AddSpec(const FGameplayEquipmentSpec& Spec)
+{
+	const int32 Index = Items.Add(Spec);
+
+	// Appending doesn't move other specs, keep the handle indices if they are up to date
+	if (!bHandleIndicesDirty && !IndexByHandle.Contains(Spec.Handle))
+	{
+		IndexByHandle.Add(Spec.Handle, Index);
+	}
+
+	InstancesByType.Reset();
+	return Items[Index];
+}
+
+void FGameplayEquipmentSpecContainer::RemoveSpecAt(int32 Index)
+{
+	Items.RemoveAt(Index);
+	MarkLookupsDirty();
+}
+
+void FGameplayEquipmentSpecContainer::MarkLookupsDirty() const
+{
+	bHandleIndicesDirty = true;
+	InstancesByType.Reset();
+}
+
+void FGameplayEquipmentSpecContainer::RebuildHandleIndices() const
+{
+	IndexByHandle.Reset();
+	for (int32 Index = 0; Index < Items.Num(); ++Index)
+	{
+		// Keep the first spec of a handle, like the linear search used to
+		if (!IndexByHandle.Contains(Items[Index].Handle))
+		{
+			IndexByHandle.Add(Items[Index].Handle, Index);
+		}
+	}
+
+	bHandleIndicesDirty = false;
+}
+
+#if !UE_BUILD_SHIPPING
+bool FGameplayEquipmentSpecContainer::VerifyLookups() const
+{
+	for (int32 Index = 0; Index < Items.Num(); ++Index)
+	{
+		const FGameplayInventoryItemSpecHandle& Handle = Items[Index].Handle;
+		const int32 ExpectedIndex = Items.IndexOfByPredicate([&Handle](const FGameplayEquipmentSpec& Spec) { return Spec.Handle == Handle; });
+		if (IndexOfHandle(Handle) != ExpectedIndex)
+		{
+			return false;
+		}
+	}
+
+	for (const TPair<TObjectKey<UClass>, TArray<UGameplayEquipmentInstance*>>& Pair : InstancesByType)
+	{
+		const UClass* EquipmentType = Pair.Key.ResolveObjectPtr();
+
+		TArray<UGameplayEquipmentInstance*> Expected;
+		for (const FGameplayEquipmentSpec& Spec : Items)
+		{
+			if (EquipmentType && Spec.IsValid() && Spec.Instance->IsA(EquipmentType))
+			{
+				Expected.Add(Spec.Instance);
+			}
+		}
+
+		if (Expected != Pair.Value)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+#endif
+
 void FGameplayEquipmentSpecContainer::PreReplicatedRemove(const TArrayView<int32> RemovedIndices, int32 FinalSize)
 {
 	for (const int32 Index : RemovedIndices)
@@ -58,23 +171,29 @@ void FGameplayEquipmentSpecContainer::PreReplicatedRemove(const TArrayView<int32
 		const FGameplayEquipmentSpec& Spec = Items[Index];
 		UGameplayEquipmentInstance* EquipmentInstance = Spec.Instance;
 
-		if (!IsValid(EquipmentInstance))
+		// The definition may not have been mapped yet
+		if (!IsValid(EquipmentInstance) || Spec.EquipmentDefinition == nullptr)
 		{
 			continue;
 		}
 
 		EquipmentInstance->OnUnequipped(Spec);
 	}
+
+	MarkLookupsDirty();
 }
 
 void FGameplayEquipmentSpecContainer::PostReplicatedAdd(const TArrayView<int32> AddedIndices, int32 FinalSize)
 {
+	MarkLookupsDirty();
+
 	for (const int32 Index : AddedIndices)
 	{
 		const FGameplayEquipmentSpec& Spec = Items[Index];
 		UGameplayEquipmentInstance* EquipmentInstance = Spec.Instance;
 
-		if (!IsValid(EquipmentInstance))
+		// The definition may not have been mapped yet
+		if (!IsValid(EquipmentInstance) || Spec.EquipmentDefinition == nullptr)
 		{
 			continue;
 		}
@@ -85,4 +204,12 @@ void FGameplayEquipmentSpecContainer::PostReplicatedAdd(const TArrayView<int32>
 
 void FGameplayEquipmentSpecContainer::PostReplicatedChange(const TArrayView<int32> ChangedIndices, int32 FinalSize)
 {
+	// Instances may replicate after their spec, or handles change
+	MarkLookupsDirty();
+}
+
+void FGameplayEquipmentSpecContainer::PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters)
+{
+	// Removed specs are only gone from the list once all callbacks ran, anything queried during them must be rebuilt
+	MarkLookupsDirty();
 }
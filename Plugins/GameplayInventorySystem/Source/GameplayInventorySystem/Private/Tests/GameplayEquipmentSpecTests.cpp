@@ -0,0 +1,118 @@
+// Copyright © 2024 MajorT. All rights reserved.
+
+#include "Spec/GameplayEquipmentSpec.h"
+
+#include "Instance/GameplayEquipmentInstance.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/FastArrayTestReplicator.h"
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGameplayEquipmentSpecReplicatedLookupsTest, "GameplayInventorySystem.Equipment.ReplicatedLookups", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FGameplayEquipmentSpecReplicatedLookupsTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumSteps = 500;
+	const FRandomStream Random(0x38);
+
+	FGameplayEquipmentSpecContainer Server;
+	FGameplayEquipmentSpecContainer Client;
+	FastArrayTests::TFastArrayTestReplicator<FGameplayEquipmentSpecContainer> Replicator;
+	TArray<TStrongObjectPtr<UGameplayEquipmentInstance>> KeepAlive;
+
+	auto NewInstance = [&KeepAlive, &Random]() -> UGameplayEquipmentInstance*
+	{
+		if (Random.FRand() < 0.2f)
+		{
+			return nullptr;
+		}
+
+		UGameplayEquipmentInstance* Instance = NewObject<UGameplayEquipmentInstance>(GetTransientPackage());
+		KeepAlive.Emplace(Instance);
+		return Instance;
+	};
+
+	for (int32 Step = 0; Step < NumSteps; ++Step)
+	{
+		const int32 Action = Random.RandRange(0, 9);
+		if (Action < 4 || Server.Items.Num() == 0)
+		{
+			FGameplayEquipmentSpec Spec;
+			Spec.Handle.GenerateNewHandle();
+			Spec.Instance = NewInstance();
+			Server.MarkItemDirty(Server.AddSpec(Spec));
+		}
+		else if (Action < 7)
+		{
+			FGameplayEquipmentSpec& Spec = Server.Items[Random.RandRange(0, Server.Items.Num() - 1)];
+			Spec.Instance = NewInstance();
+			Server.MarkItemDirty(Spec);
+			Server.MarkLookupsDirty();
+		}
+		else
+		{
+			Server.RemoveSpecAt(Random.RandRange(0, Server.Items.Num() - 1));
+			Server.MarkArrayDirty();
+		}
+
+		// Query the client before the update, so stale lookups carried over from the last update would be caught
+		Client.GetInstancesOfType(UGameplayEquipmentInstance::StaticClass());
+		if (Client.Items.Num() > 0)
+		{
+			Client.FindSpecByHandle(Client.Items[Random.RandRange(0, Client.Items.Num() - 1)].Handle);
+		}
+
+		// Several changes may go out in the same update
+		if (Random.FRand() < 0.5f && Step < NumSteps - 1)
+		{
+			continue;
+		}
+
+		if (!Replicator.Replicate(Server, Client))
+		{
+			AddError(FString::Printf(TEXT("Delta serialization failed at step %d."), Step));
+			return false;
+		}
+
+		Server.GetInstancesOfType(UGameplayEquipmentInstance::StaticClass());
+		const TConstArrayView<UGameplayEquipmentInstance*> ClientInstances = Client.GetInstancesOfType(UGameplayEquipmentInstance::StaticClass());
+
+		if (!Server.VerifyLookups() || !Client.VerifyLookups())
+		{
+			AddError(FString::Printf(TEXT("Lookups diverged from a full scan at step %d, server %d specs, client %d specs."), Step, Server.Items.Num(), Client.Items.Num()));
+			return false;
+		}
+
+		if (Client.Items.Num() != Server.Items.Num())
+		{
+			AddError(FString::Printf(TEXT("Client has %d specs instead of %d at step %d."), Client.Items.Num(), Server.Items.Num(), Step));
+			return false;
+		}
+
+		// The client may order the specs differently, compare by handle
+		int32 NumServerInstances = 0;
+		for (const FGameplayEquipmentSpec& ServerSpec : Server.Items)
+		{
+			const FGameplayEquipmentSpec* ClientSpec = Client.FindSpecByHandle(ServerSpec.Handle);
+			if (ClientSpec == nullptr || ClientSpec->Instance != ServerSpec.Instance)
+			{
+				AddError(FString::Printf(TEXT("Client lookup of handle %s is wrong at step %d."), *ServerSpec.Handle.ToString(), Step));
+				return false;
+			}
+
+			NumServerInstances += ServerSpec.IsValid() ? 1 : 0;
+		}
+
+		if (ClientInstances.Num() != NumServerInstances)
+		{
+			AddError(FString::Printf(TEXT("Client has %d instances by type instead of %d at step %d."), ClientInstances.Num(), NumServerInstances, Step));
+			return false;
+		}
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
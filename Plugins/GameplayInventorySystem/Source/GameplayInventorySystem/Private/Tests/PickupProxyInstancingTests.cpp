@@ -0,0 +1,170 @@
+// Copyright © 2024 Botanibots Team. All rights reserved.
+
+#include "Pickup/PickupProxySubsystem.h"
+
+#include "EngineUtils.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "Fragments/Item/ItemFragment_PickupDefinition.h"
+#include "HAL/IConsoleManager.h"
+#include "Icons/PickupIcon_StaticMesh.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/ScopeExit.h"
+#include "Pickup/PickupInstanceActor.h"
+#include "Pickup/PickupProxyActor.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPickupProxyInstancingTest, "GameplayInventorySystem.Pickup.Instancing", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FPickupProxyInstancingTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 GridSize = 32;
+	constexpr float GridSpacing = 400.f;
+	constexpr int32 NumPickups = GridSize * GridSize;
+	constexpr int32 PickupQuantity = 3;
+
+	const float PromotionRadius = IConsoleManager::Get().FindConsoleVariable(TEXT("Pickup.PromotionRadius"))->GetFloat();
+	if (!TestTrue(TEXT("Instancing is enabled"), PromotionRadius > 0.f))
+	{
+		return false;
+	}
+
+	UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	if (!TestNotNull(TEXT("Pickup mesh"), Cube))
+	{
+		return false;
+	}
+
+	// An item drawn by a single static mesh icon
+	UGameplayInventoryItemDefinition* ItemDefinition = NewObject<UGameplayInventoryItemDefinition>(GetTransientPackage());
+	UItemFragment_PickupDefinition* PickupFragment = NewObject<UItemFragment_PickupDefinition>(ItemDefinition);
+	UPickupIcon_StaticMesh* Icon = NewObject<UPickupIcon_StaticMesh>(PickupFragment);
+	Icon->StaticMesh = Cube;
+	PickupFragment->PickupData.PickupIcons.Add(Icon);
+	ItemDefinition->ItemFragments.Add(PickupFragment);
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("PickupProxyInstancingTestWorld"));
+	ON_SCOPE_EXIT
+	{
+		World->DestroyWorld(false);
+	};
+
+	UPickupProxySubsystem* Subsystem = World->GetSubsystem<UPickupProxySubsystem>();
+	if (!TestNotNull(TEXT("Pickup subsystem"), Subsystem))
+	{
+		return false;
+	}
+
+	// A grid of idle pickups centered on the origin
+	TArray<FVector> PickupLocations;
+	for (int32 Index = 0; Index < NumPickups; ++Index)
+	{
+		const FVector Location(((Index % GridSize) - (GridSize / 2)) * GridSpacing, ((Index / GridSize) - (GridSize / 2)) * GridSpacing, 0.f);
+		PickupLocations.Add(Location);
+
+		APickupProxyActor* Pickup = World->SpawnActorDeferred<APickupProxyActor>(APickupProxyActor::StaticClass(), FTransform(Location));
+		Pickup->ItemDefinition = ItemDefinition;
+		Pickup->PickupQuantity = PickupQuantity;
+		Pickup->FinishSpawning(FTransform(Location));
+		Subsystem->RegisterPickup(Pickup);
+	}
+
+	auto CountPickupActors = [World]()
+	{
+		int32 NumActors = 0;
+		for (TActorIterator<APickupProxyActor> It(World); It; ++It)
+		{
+			NumActors += IsValid(*It) ? 1 : 0;
+		}
+
+		return NumActors;
+	};
+
+	auto CountPickupsNear = [&PickupLocations](const FVector& PlayerLocation, float Radius)
+	{
+		int32 NumNear = 0;
+		for (const FVector& Location : PickupLocations)
+		{
+			NumNear += (FVector::DistSquared(Location, PlayerLocation) <= FMath::Square(Radius)) ? 1 : 0;
+		}
+
+		return NumNear;
+	};
+
+	auto TestCounts = [this, Subsystem, &CountPickupActors](const TCHAR* Step, int32 ExpectedActors)
+	{
+		APickupInstanceActor* InstanceActor = Subsystem->GetInstanceActor();
+		if (InstanceActor == nullptr)
+		{
+			AddError(FString::Printf(TEXT("%s: No instance actor was spawned."), Step));
+			return;
+		}
+
+		InstanceActor->UpdateInstances();
+
+		const int32 ExpectedInstances = NumPickups - ExpectedActors;
+		const int32 NumActors = CountPickupActors();
+		if ((NumActors != ExpectedActors) || (Subsystem->GetNumPickupActors() != ExpectedActors)
+			|| (InstanceActor->GetEntries().Num() != ExpectedInstances) || (InstanceActor->GetNumInstances() != ExpectedInstances))
+		{
+			AddError(FString::Printf(TEXT("%s: Expected %d actors and %d instances, got %d actors (%d managed), %d entries and %d mesh instances."),
+				Step, ExpectedActors, ExpectedInstances, NumActors, Subsystem->GetNumPickupActors(), InstanceActor->GetEntries().Num(), InstanceActor->GetNumInstances()));
+		}
+	};
+
+	const FVector FarAway(1000000.f, 0.f, 0.f);
+	const FVector Center = FVector::ZeroVector;
+
+	// Without a player nearby every idle pickup is instanced
+	Subsystem->UpdateInstancing({ FarAway }, MAX_int32);
+	TestCounts(TEXT("Player far away"), 0);
+
+	// A player in the middle promotes the pickups within the radius
+	const int32 NumNearCenter = CountPickupsNear(Center, PromotionRadius);
+	if (!TestTrue(TEXT("Pickups near the center"), (NumNearCenter > 0) && (NumNearCenter < NumPickups)))
+	{
+		return false;
+	}
+
+	Subsystem->UpdateInstancing({ Center }, MAX_int32);
+	TestCounts(TEXT("Player in the middle"), NumNearCenter);
+
+	for (TActorIterator<APickupProxyActor> It(World); It; ++It)
+	{
+		if (IsValid(*It) && ((It->ItemDefinition.Get() != ItemDefinition) || (It->PickupQuantity != PickupQuantity) || !It->WasPromotedFromInstance()))
+		{
+			AddError(FString::Printf(TEXT("Promoted pickup %s lost its item or quantity."), *It->GetName()));
+			break;
+		}
+	}
+
+	// Moving a little keeps the promoted pickups, only the ones now within the radius are added
+	const FVector Nudged(PromotionRadius * 0.1f, 0.f, 0.f);
+	Subsystem->UpdateInstancing({ Nudged }, MAX_int32);
+
+	int32 NumExpectedAfterNudge = 0;
+	for (const FVector& Location : PickupLocations)
+	{
+		const bool bWasPromoted = FVector::DistSquared(Location, Center) <= FMath::Square(PromotionRadius);
+		const bool bPromoted = FVector::DistSquared(Location, Nudged) <= FMath::Square(PromotionRadius);
+		const bool bKept = FVector::DistSquared(Location, Nudged) <= FMath::Square(PromotionRadius * 1.2f);
+		NumExpectedAfterNudge += (bPromoted || (bWasPromoted && bKept)) ? 1 : 0;
+	}
+
+	TestCounts(TEXT("Player moved a little"), NumExpectedAfterNudge);
+
+	// Once the player left everything is instanced again
+	Subsystem->UpdateInstancing({ FarAway }, MAX_int32);
+	TestCounts(TEXT("Player left"), 0);
+
+	// Changes are spread over several updates
+	constexpr int32 MaxChanges = 16;
+	Subsystem->UpdateInstancing({ Center }, MaxChanges);
+	TestCounts(TEXT("Budgeted promotion"), FMath::Min(MaxChanges, NumNearCenter));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -52,6 +52,23 @@ public:
 		return static_cast<T*>(GetFirstInstanceOfType(T::StaticClass()));
 	}
 
+	/** Returns all equipment instances of the specified type. The view is only valid until the equipment changes. */
+	TConstArrayView<UGameplayEquipmentInstance*> GetAllInstancesOfType(TSubclassOf<UGameplayEquipmentInstance> EquipmentType) const;
+
+	template <typename T>
+	TConstArrayView<T*> GetAllInstancesOfType() const
+	{
+		static_assert(TIsDerivedFrom<T, UGameplayEquipmentInstance>::Value, "T must derive from UGameplayEquipmentInstance");
+
+		// Every instance in the view is a T, and UObject pointers don't need adjusting between base and derived classes
+		const TConstArrayView<UGameplayEquipmentInstance*> Instances = GetAllInstancesOfType(T::StaticClass());
+		return TConstArrayView<T*>(reinterpret_cast<T* const*>(Instances.GetData()), Instances.Num());
+	}
+
+	/** Returns all equipment instances of the specified type */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Equipment", meta = (DisplayName = "Get All Instances Of Type"))
+	TArray<UGameplayEquipmentInstance*> K2_GetAllInstancesOfType(TSubclassOf<UGameplayEquipmentInstance> EquipmentType) const;
+
 public:
 	virtual void OnEquipItem(const FGameplayEquipmentSpec& EquipmentSpec, UObject* Instigator);
 	virtual void OnUnequipItem(const FGameplayEquipmentSpec& EquipmentSpec, UObject* Instigator);
@@ -6,10 +6,14 @@
 #include "Icons/PickupItemIcon.h"
 #include "PickupIconMod_OverlayMaterial.generated.h"
 
+class UTexture;
+
 /**
  * UPickupIconMod_OverlayMaterial
  *
  * Attempts to apply an overlay material to the icon.
+ * Icons with the same material parameters share one material instance, created by the UPickupProxySubsystem.
+ * Instanced pickups use the same shared instance as overlay and additionally pass InstanceCustomDataParameter as per instance custom data.
  */
 UCLASS(meta = (DisplayName = "Modifier: Overlay Material"), MinimalAPI)
 class UPickupIconMod_OverlayMaterial : public UPickupIconModifier
@@ -19,9 +23,14 @@ class UPickupIconMod_OverlayMaterial : public UPickupIconModifier
 public:
 	//~ Begin UPickupIconModifier Interface
 	GAMEPLAYINVENTORYSYSTEM_API virtual void ApplyModifier(UPickupItemIcon* Outer, USceneComponent* SpawnedIcon, APickupProxyActor* PickupProxy, const UGameplayInventoryItemDefinition* InItemDef) override;
+	GAMEPLAYINVENTORYSYSTEM_API virtual bool ModifyInstancedMesh(const UObject* WorldContextObject, const UPickupItemIcon* Outer, const UGameplayInventoryItemDefinition* InItemDef, FPickupIconInstancedMesh& InOutMesh) const override;
 	//~ End UPickupIconModifier Interface
 
 protected:
+	/** Gathers the parameters to set on the overlay material, subclasses can add their own on top. PickupProxy is null for instanced pickups. */
+	GAMEPLAYINVENTORYSYSTEM_API virtual void GatherMaterialParameters(const APickupProxyActor* PickupProxy, const UGameplayInventoryItemDefinition* InItemDef,
+		TMap<FName, float>& OutScalarParameters, TMap<FName, FLinearColor>& OutVectorParameters, TMap<FName, UTexture*>& OutTextureParameters) const;
+
 	/** The overlay material to apply to the icon. */
 	UPROPERTY(EditAnywhere, Category = "Modifier")
 	TSoftObjectPtr<UMaterialInterface> OverlayMaterial;
@@ -33,4 +42,8 @@ protected:
 	/** Additional vector parameters to set on the overlay material. */
 	UPROPERTY(EditAnywhere, Category = "Modifier")
 	TMap<FName, FLinearColor> VectorParameters;
+
+	/** Vector parameter that instanced pickups also write to their per instance custom data (0-3), for materials that tint the mesh itself. */
+	UPROPERTY(EditAnywhere, Category = "Modifier")
+	FName InstanceCustomDataParameter = TEXT("Color");
 };
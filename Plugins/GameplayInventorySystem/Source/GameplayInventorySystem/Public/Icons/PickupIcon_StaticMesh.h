@@ -15,10 +15,14 @@ UCLASS(meta = (DisplayName = "Icon: Static Mesh"))
 class UPickupIcon_StaticMesh : public UPickupItemIcon
 {
 	GENERATED_UCLASS_BODY()
+#if WITH_DEV_AUTOMATION_TESTS
+	friend class FPickupProxyInstancingTest;
+#endif
 
 public:
 	//~ Begin UPickupItemIcon Interface
 	virtual void ApplyPickupIcon(APickupProxyActor* InProxy, const UGameplayInventoryItemDefinition* InItemDef) override;
+	virtual bool GatherInstancedMeshes(const UObject* WorldContextObject, const UGameplayInventoryItemDefinition* InItemDef, TArray<FPickupIconInstancedMesh>& OutMeshes) const override;
 	//~ End UPickupItemIcon Interface
 
 protected:
@@ -7,6 +7,29 @@
 #include "UObject/Object.h"
 #include "PickupItemIcon.generated.h"
 
+class UMaterialInterface;
+class UStaticMesh;
+
+/**
+ * FPickupIconInstancedMesh
+ *
+ * A static mesh an icon is drawn with while its pickup is idle and represented by an instance instead of an actor.
+ */
+struct FPickupIconInstancedMesh
+{
+	/** The mesh to instance. */
+	UStaticMesh* StaticMesh = nullptr;
+
+	/** Transform of the mesh relative to the pickup. */
+	FTransform RelativeTransform;
+
+	/** Overlay material of the instances, shared by every pickup with the same mesh and overlay. */
+	UMaterialInterface* OverlayMaterial = nullptr;
+
+	/** Per instance custom data (0-3), materials read it through PerInstanceCustomData. */
+	FLinearColor CustomData = FLinearColor::White;
+};
+
 /**
  * UPickupItemIcon
  *
@@ -36,6 +59,12 @@ public:
 	UFUNCTION(BlueprintImplementableEvent, Category = "Pickup", meta = (DisplayName = "Apply Pickup Icon"))
 	GAMEPLAYINVENTORYSYSTEM_API void K2_ApplyPickupIcon(class APickupProxyActor* InProxy, const class UGameplayInventoryItemDefinition* InItemDef);
 
+	/**
+	 * Gathers the static meshes to draw this icon with while the pickup is instanced.
+	 * Returns false if instanced static meshes can't show the icon, which keeps pickups using it as actors.
+	 */
+	GAMEPLAYINVENTORYSYSTEM_API virtual bool GatherInstancedMeshes(const UObject* WorldContextObject, const class UGameplayInventoryItemDefinition* InItemDef, TArray<FPickupIconInstancedMesh>& OutMeshes) const;
+
 protected:
 #if WITH_EDITORONLY_DATA
 	/** The icon's display name to show in the editor. */
@@ -62,4 +91,7 @@ public:
 	/** Called to apply this modifier to the specified pickup icon. */
 	UFUNCTION(BlueprintImplementableEvent, Category = "Pickup", meta = (DisplayName = "Apply Pickup Icon Modifier"))
 	GAMEPLAYINVENTORYSYSTEM_API void K2_ApplyModifier(UPickupItemIcon* Outer, USceneComponent* SpawnedIcon, APickupProxyActor* PickupProxy, const UGameplayInventoryItemDefinition* InItemDef);
+
+	/** Applies this modifier to an instanced mesh of the icon. Returns false if instances can't show the modifier. */
+	GAMEPLAYINVENTORYSYSTEM_API virtual bool ModifyInstancedMesh(const UObject* WorldContextObject, const UPickupItemIcon* Outer, const UGameplayInventoryItemDefinition* InItemDef, FPickupIconInstancedMesh& InOutMesh) const;
 };
@@ -0,0 +1,149 @@
+// Copyright © 2024 Botanibots Team. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagStackContainer.h"
+#include "GameFramework/Actor.h"
+#include "Net/Serialization/FastArraySerializer.h"
+#include "PickupInstanceActor.generated.h"
+
+class APickupInstanceActor;
+class APickupProxyActor;
+class UGameplayInventoryItemDefinition;
+class UInstancedStaticMeshComponent;
+class UMaterialInterface;
+class UStaticMesh;
+struct FPickupIconInstancedMesh;
+
+/**
+ * FPickupInstanceEntry
+ *
+ * An idle pickup that is represented by mesh instances instead of an actor.
+ */
+USTRUCT()
+struct FPickupInstanceEntry : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	/** Unique id of the entry, assigned by the server. */
+	UPROPERTY()
+	int32 EntryId = INDEX_NONE;
+
+	/** The item definition the pickup holds, its pickup icons are what the instances draw. */
+	UPROPERTY()
+	TObjectPtr<UGameplayInventoryItemDefinition> ItemDefinition;
+
+	UPROPERTY()
+	FVector_NetQuantize10 Location = FVector::ZeroVector;
+
+	UPROPERTY()
+	FRotator Rotation = FRotator::ZeroRotator;
+
+	/** Authority-only state the pickup actor is restored with once it gets promoted again. */
+	UPROPERTY(NotReplicated)
+	TSubclassOf<APickupProxyActor> PickupClass;
+
+	UPROPERTY(NotReplicated)
+	int32 PickupQuantity = 1;
+
+	UPROPERTY(NotReplicated)
+	TArray<FGameplayTagStack> TagStacks;
+};
+
+/**
+ * FPickupInstanceList
+ *
+ * Replicated list of instanced pickups, clients rebuild their instances whenever it changes.
+ */
+USTRUCT()
+struct FPickupInstanceList : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	//~ Begin FFastArraySerializer Interface
+	void PreReplicatedRemove(const TArrayView<int32> RemovedIndices, int32 FinalSize);
+	void PostReplicatedAdd(const TArrayView<int32> AddedIndices, int32 FinalSize);
+	void PostReplicatedChange(const TArrayView<int32> ChangedIndices, int32 FinalSize);
+	//~ End FFastArraySerializer Interface
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParams)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FPickupInstanceEntry, FPickupInstanceList>(Entries, DeltaParams, *this);
+	}
+
+public:
+	UPROPERTY()
+	TArray<FPickupInstanceEntry> Entries;
+
+	UPROPERTY(NotReplicated)
+	TObjectPtr<APickupInstanceActor> Owner;
+};
+
+template<>
+struct TStructOpsTypeTraits<FPickupInstanceList> : public TStructOpsTypeTraitsBase2<FPickupInstanceList>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
+
+/**
+ * APickupInstanceActor
+ *
+ * Holds the idle pickups of a world that are far from every player, spawned and filled by the UPickupProxySubsystem.
+ * Each pickup is an entry of a replicated list instead of an actor and is drawn by one instanced static mesh
+ * component per mesh and overlay material, with the overlay's color as per instance custom data.
+ */
+UCLASS(MinimalAPI, NotBlueprintable, NotPlaceable, Transient)
+class APickupInstanceActor : public AActor
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+	//~ Begin AActor Interface
+	GAMEPLAYINVENTORYSYSTEM_API virtual void BeginPlay() override;
+	GAMEPLAYINVENTORYSYSTEM_API virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	GAMEPLAYINVENTORYSYSTEM_API virtual void Tick(float DeltaSeconds) override;
+	//~ End AActor Interface
+
+	/**
+	 * Gathers the meshes all pickup icons of the item are drawn with as instances.
+	 * Returns false if any icon can't be instanced or there is nothing to draw, such pickups stay actors.
+	 */
+	static GAMEPLAYINVENTORYSYSTEM_API bool GatherInstancedMeshes(const UObject* WorldContextObject, const UGameplayInventoryItemDefinition* ItemDefinition, TArray<FPickupIconInstancedMesh>& OutMeshes);
+
+	/** Adds the entry, assigning it a new id, and returns that id. Authority only. */
+	GAMEPLAYINVENTORYSYSTEM_API int32 AddEntry(const FPickupInstanceEntry& Entry);
+
+	/** Removes the entry with the given id and copies it to OutEntry. Authority only. */
+	GAMEPLAYINVENTORYSYSTEM_API bool RemoveEntry(int32 EntryId, FPickupInstanceEntry& OutEntry);
+
+	/** Returns every instanced pickup. */
+	const TArray<FPickupInstanceEntry>& GetEntries() const { return InstanceList.Entries; }
+
+	/** Returns the number of mesh instances currently drawn. */
+	GAMEPLAYINVENTORYSYSTEM_API int32 GetNumInstances() const;
+
+	/** Rebuilds the instances of the changed list right away instead of on the next tick. */
+	GAMEPLAYINVENTORYSYSTEM_API void UpdateInstances();
+
+	/** Rebuilds the instances on the next tick. */
+	GAMEPLAYINVENTORYSYSTEM_API void MarkInstancesDirty();
+
+private:
+	/** Returns the index of the component drawing the mesh with the overlay, adding it if there is none yet. */
+	int32 FindOrAddMeshComponent(UStaticMesh* StaticMesh, UMaterialInterface* OverlayMaterial);
+
+	UPROPERTY(Replicated)
+	FPickupInstanceList InstanceList;
+
+	/** One component per mesh and overlay material, indexed by MeshComponentIndices */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UInstancedStaticMeshComponent>> MeshComponents;
+	TMap<TPair<FObjectKey, FObjectKey>, int32> MeshComponentIndices;
+
+	int32 NextEntryId = 0;
+	bool bInstancesDirty = false;
+};
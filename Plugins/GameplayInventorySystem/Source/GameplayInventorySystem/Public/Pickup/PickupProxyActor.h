@@ -25,6 +25,7 @@ class APickupProxyActor : public AActor, public IGameplayTagStackInterface
 public:
 	//~ Begin AActor Interface
 	GAMEPLAYINVENTORYSYSTEM_API virtual void BeginPlay() override;
+	GAMEPLAYINVENTORYSYSTEM_API virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	GAMEPLAYINVENTORYSYSTEM_API virtual void Destroyed() override;
 	//~ End AActor Interface
 
@@ -40,6 +41,21 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Pickup")
 	GAMEPLAYINVENTORYSYSTEM_API virtual void OnPickedUp(AActor* InInstigator);
 
+	/** Enables or disables overlaps with pawns, which is what lets players pick this up. */
+	GAMEPLAYINVENTORYSYSTEM_API virtual void SetPickupInteractionEnabled(bool bEnabled);
+
+	/** Called by the UPickupProxySubsystem when local players get close or move away, to toggle expensive cosmetics like lights and effects. */
+	GAMEPLAYINVENTORYSYSTEM_API virtual void SetPickupCosmeticsActive(bool bActive);
+
+	/**
+	 * Returns true if the pickup is idle, so the UPickupProxySubsystem may replace it by mesh instances while no player is near.
+	 * Subclasses that move or show anything besides their pickup icons must return false while they do.
+	 */
+	GAMEPLAYINVENTORYSYSTEM_API virtual bool CanBeInstanced() const;
+
+	/** Returns true if this pickup was instanced before and got promoted back to an actor, it is already at rest. */
+	bool WasPromotedFromInstance() const { return bPromotedFromInstance; }
+
 	/** Returns the item definition for this pickup. */
 	UPROPERTY(ReplicatedUsing = OnRep_ItemDefinition, EditAnywhere, BlueprintReadOnly, Category = "Pickup", meta = (ExposeOnSpawn = true))
 	TSoftObjectPtr<UGameplayInventoryItemDefinition> ItemDefinition;
@@ -101,9 +117,11 @@ protected:
 	UPROPERTY(Config)
 	float UnloadItemDelay = 5.0f;
 
-	/** The timer handle for unloading the item definition. */
-	FTimerHandle UnloadItemTimerHandle;
+	friend class UPickupProxySubsystem;
 
 	/** Whether the item pickup effects have been played. */
 	uint8 bItemPickupEffectsPlayed : 1;
+
+	/** Whether this pickup was spawned for an instanced pickup a player came close to. */
+	uint8 bPromotedFromInstance : 1;
 };
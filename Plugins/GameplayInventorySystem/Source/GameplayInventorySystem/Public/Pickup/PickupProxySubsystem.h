@@ -0,0 +1,196 @@
+// Copyright © 2024 Botanibots Team. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "PickupProxySubsystem.generated.h"
+
+class APickupInstanceActor;
+class APickupProxyActor;
+class UMaterialInstanceDynamic;
+class UMaterialInterface;
+class UTexture;
+
+/**
+ * UPickupProxySubsystem
+ *
+ * Manages every pickup proxy in a world so dropped pickups stay cheap while idle.
+ * Falling, delayed interaction and unloading of all pickups run in one batched update instead of per actor timers
+ * and movement components, cosmetics are only active for pickups near a local player, and pickups with the same
+ * overlay material parameters share a single material instance.
+ * Idle pickups far from every player are demoted to entries of an APickupInstanceActor, drawn as mesh instances,
+ * and promoted back to actors once a player comes close.
+ */
+UCLASS(MinimalAPI)
+class UPickupProxySubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UWorldSubsystem Interface
+	GAMEPLAYINVENTORYSYSTEM_API virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	GAMEPLAYINVENTORYSYSTEM_API virtual void Deinitialize() override;
+	//~ End UWorldSubsystem Interface
+
+	//~ Begin FTickableGameObject Interface
+	GAMEPLAYINVENTORYSYSTEM_API virtual void Tick(float DeltaTime) override;
+	GAMEPLAYINVENTORYSYSTEM_API virtual bool IsTickable() const override;
+	GAMEPLAYINVENTORYSYSTEM_API virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface
+
+	/** Utility to get this subsystem from any world context object, returns null if there is no world. */
+	static GAMEPLAYINVENTORYSYSTEM_API UPickupProxySubsystem* Get(const UObject* WorldContextObject);
+
+	/** Starts managing the given pickup, called by the pickup itself. */
+	GAMEPLAYINVENTORYSYSTEM_API void RegisterPickup(APickupProxyActor* Pickup);
+
+	/** Stops managing the given pickup and drops any pending work for it. */
+	GAMEPLAYINVENTORYSYSTEM_API void UnregisterPickup(APickupProxyActor* Pickup);
+
+	/**
+	 * Lets the pickup fall with the given initial velocity until it lands.
+	 * @param RestHeight	Height above the ground the pickup's origin comes to rest at.
+	 */
+	GAMEPLAYINVENTORYSYSTEM_API void StartFalling(APickupProxyActor* Pickup, const FVector& InitialVelocity, float RestHeight = 0.f);
+
+	/** Calls SetPickupInteractionEnabled(true) on the pickup once the delay has passed. */
+	GAMEPLAYINVENTORYSYSTEM_API void ScheduleEnableInteraction(APickupProxyActor* Pickup, float Delay);
+
+	/** Calls RequestUnloadItem on the pickup once the delay has passed. */
+	GAMEPLAYINVENTORYSYSTEM_API void ScheduleUnloadItem(APickupProxyActor* Pickup, float Delay);
+
+	/**
+	 * Returns a material instance of the base material with the given parameters, shared by every caller asking for the same combination.
+	 * The returned instance must not be modified.
+	 */
+	GAMEPLAYINVENTORYSYSTEM_API UMaterialInstanceDynamic* GetSharedMaterialInstance(UMaterialInterface* BaseMaterial, const TMap<FName, float>& ScalarParameters, const TMap<FName, FLinearColor>& VectorParameters, const TMap<FName, UTexture*>& TextureParameters);
+
+	/**
+	 * Promotes instanced pickups near any of the players to actors and demotes idle pickup actors far from all of them to instances.
+	 * Called by the tick with the pawn locations of all players. Authority only.
+	 * @param MaxChanges	Maximum number of promotions and demotions, spreads large changes over several updates.
+	 */
+	GAMEPLAYINVENTORYSYSTEM_API void UpdateInstancing(TConstArrayView<FVector> PlayerLocations, int32 MaxChanges);
+
+	/** Returns the actor holding the instanced pickups, null if no pickup was instanced yet. */
+	APickupInstanceActor* GetInstanceActor() const { return InstanceActor.Get(); }
+
+	/** Called by the instance actor itself, which clients receive through replication. */
+	GAMEPLAYINVENTORYSYSTEM_API void RegisterInstanceActor(APickupInstanceActor* InInstanceActor);
+	GAMEPLAYINVENTORYSYSTEM_API void UnregisterInstanceActor(APickupInstanceActor* InInstanceActor);
+
+	/** Returns the number of pickups that are actors managed by this subsystem. */
+	int32 GetNumPickupActors() const { return Pickups.Num(); }
+
+	/** Returns a one line summary of the managed pickups, for debugging. */
+	GAMEPLAYINVENTORYSYSTEM_API FString GetDebugString() const;
+
+private:
+	enum class EPickupDeadline : uint8
+	{
+		EnableInteraction,
+		UnloadItem
+	};
+
+	struct FManagedPickup
+	{
+		TWeakObjectPtr<APickupProxyActor> Pickup;
+		FVector Velocity = FVector::ZeroVector;
+		float RestHeight = 0.f;
+		float FallTime = 0.f;
+		bool bFalling = false;
+		bool bCosmeticsActive = true;
+	};
+
+	/** Base material and parameters of a shared material instance, parameters sorted by name */
+	struct FSharedMaterialKey
+	{
+		TObjectKey<UMaterialInterface> BaseMaterial;
+		TArray<TPair<FName, float>> ScalarParameters;
+		TArray<TPair<FName, FLinearColor>> VectorParameters;
+		TArray<TPair<FName, TObjectKey<UTexture>>> TextureParameters;
+
+		bool operator==(const FSharedMaterialKey& Other) const
+		{
+			return BaseMaterial == Other.BaseMaterial
+				&& ScalarParameters == Other.ScalarParameters
+				&& VectorParameters == Other.VectorParameters
+				&& TextureParameters == Other.TextureParameters;
+		}
+
+		friend uint32 GetTypeHash(const FSharedMaterialKey& Key)
+		{
+			uint32 Hash = GetTypeHash(Key.BaseMaterial);
+			for (const TPair<FName, float>& Parameter : Key.ScalarParameters)
+			{
+				Hash = HashCombineFast(Hash, GetTypeHash(Parameter));
+			}
+
+			for (const TPair<FName, FLinearColor>& Parameter : Key.VectorParameters)
+			{
+				Hash = HashCombineFast(Hash, GetTypeHash(Parameter));
+			}
+
+			for (const TPair<FName, TObjectKey<UTexture>>& Parameter : Key.TextureParameters)
+			{
+				Hash = HashCombineFast(Hash, GetTypeHash(Parameter));
+			}
+
+			return Hash;
+		}
+	};
+
+	struct FPickupDeadline
+	{
+		double Time = 0.0;
+		TWeakObjectPtr<APickupProxyActor> Pickup;
+		EPickupDeadline Type = EPickupDeadline::EnableInteraction;
+
+		bool operator<(const FPickupDeadline& Other) const
+		{
+			return Time < Other.Time;
+		}
+	};
+
+	void AddDeadline(APickupProxyActor* Pickup, float Delay, EPickupDeadline Type);
+	void ProcessDeadlines();
+	void UpdateFalling(float DeltaTime);
+	void UpdateCosmetics();
+	void RemovePickupAt(int32 Index);
+
+	/** Returns true if the pickup is idle and its icons can be drawn as instances. */
+	bool CanDemotePickup(const FManagedPickup& Managed);
+	void DemotePickup(APickupProxyActor* Pickup);
+	void PromotePickup(int32 EntryId);
+
+private:
+	/** Every registered pickup, indexed by PickupIndices */
+	TArray<FManagedPickup> Pickups;
+	TMap<FObjectKey, int32> PickupIndices;
+
+	/** Number of pickups that are currently falling */
+	int32 NumFalling = 0;
+
+	/** Pending deadlines, as a heap ordered by time */
+	TArray<FPickupDeadline> Deadlines;
+
+	/** Time the cosmetics were last updated at */
+	double LastCosmeticsUpdateTime = -UE_BIG_NUMBER;
+
+	/** Time promotions and demotions were last checked at */
+	double LastInstancingUpdateTime = -UE_BIG_NUMBER;
+
+	/** Holds the instanced pickups, spawned with the first demotion */
+	TWeakObjectPtr<APickupInstanceActor> InstanceActor;
+
+	/** Whether the icons of an item definition can be drawn as instances, by item definition */
+	TMap<FObjectKey, bool> InstanceableItemDefinitions;
+
+	/**
+	 * Shared overlay material instances.
+	 * Held weakly so an instance lives only as long as a mesh uses it, stale entries are pruned with the instancing update.
+	 */
+	TMap<FSharedMaterialKey, TWeakObjectPtr<UMaterialInstanceDynamic>> SharedMaterialInstances;
+};
@@ -7,6 +7,7 @@
 #include "GameplayInventoryItemSpec.h"
 #include "GameplayInventoryItemSpecHandle.h"
 #include "Net/Serialization/FastArraySerializer.h"
+#include "UObject/ObjectKey.h"
 
 #include "GameplayEquipmentSpec.generated.h"
 
@@ -118,6 +119,8 @@ public:
  * FGameplayEquipmentSpecContainer
  *
  * A list of equipment entries
+ * Lookups by handle and by instance type go through indices that are rebuilt lazily after the list changed,
+ * either locally or through replication.
  */
 USTRUCT(BlueprintType)
 struct FGameplayEquipmentSpecContainer : public FFastArraySerializer
@@ -137,6 +140,7 @@ public:
 	void PreReplicatedRemove(const TArrayView<int32> RemovedIndices, int32 FinalSize);
 	void PostReplicatedAdd(const TArrayView<int32> AddedIndices, int32 FinalSize);
 	void PostReplicatedChange(const TArrayView<int32> ChangedIndices, int32 FinalSize);
+	void PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters);
 	//~ End FFastArraySerializer Interface
 	
 	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParams)
@@ -144,19 +148,42 @@ public:
 		return FFastArraySerializer::FastArrayDeltaSerialize<FGameplayEquipmentSpec, FGameplayEquipmentSpecContainer>(Items, DeltaParams, *this);
 	}
 
+	/** Returns the spec with the given handle, or nullptr if there is none */
 	const FGameplayEquipmentSpec* FindSpecByHandle(const FGameplayInventoryItemSpecHandle& Handle) const
 	{
-		for (const FGameplayEquipmentSpec& Spec : Items)
-		{
-			if (Spec.Handle == Handle)
-			{
-				return &Spec;
-			}
-		}
-
-		return nullptr;
+		const int32 Index = IndexOfHandle(Handle);
+		return Index != INDEX_NONE ? &Items[Index] : nullptr;
 	}
 
+	/** Returns the index of the spec with the given handle, or INDEX_NONE if there is none */
+	GAMEPLAYINVENTORYSYSTEM_API int32 IndexOfHandle(const FGameplayInventoryItemSpecHandle& Handle) const;
+
+	/** Returns all valid equipment instances of the given type, in list order. The view is invalidated by the next change to the list. */
+	GAMEPLAYINVENTORYSYSTEM_API TConstArrayView<UGameplayEquipmentInstance*> GetInstancesOfType(const UClass* EquipmentType) const;
+
+	/** Adds a new spec and returns it */
+	GAMEPLAYINVENTORYSYSTEM_API FGameplayEquipmentSpec& AddSpec(const FGameplayEquipmentSpec& Spec);
+
+	/** Removes the spec at the given index, keeping the order of the other specs */
+	GAMEPLAYINVENTORYSYSTEM_API void RemoveSpecAt(int32 Index);
+
+	/** Invalidates the lookups, must be called after changing the handle or instance of a spec */
+	GAMEPLAYINVENTORYSYSTEM_API void MarkLookupsDirty() const;
+
+#if !UE_BUILD_SHIPPING
+	/** Returns true if the lookups match a full scan of the list */
+	GAMEPLAYINVENTORYSYSTEM_API bool VerifyLookups() const;
+#endif
+
+private:
+	void RebuildHandleIndices() const;
+
+	/** Index of each spec in Items, by handle */
+	mutable TMap<FGameplayInventoryItemSpecHandle, int32> IndexByHandle;
+	mutable bool bHandleIndicesDirty = true;
+
+	/** Instances of every queried type, filled on demand */
+	mutable TMap<TObjectKey<UClass>, TArray<UGameplayEquipmentInstance*>> InstancesByType;
 
 public:
 	/** The list of equipment items. */
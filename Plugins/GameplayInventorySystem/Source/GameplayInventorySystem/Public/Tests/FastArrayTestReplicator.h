@@ -0,0 +1,165 @@
+// Copyright © 2024 MajorT. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Net/Serialization/FastArraySerializer.h"
+#include "UObject/CoreNet.h"
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
+
+namespace FastArrayTests
+{
+	/**
+	 * Serializes the replicated properties of fast array items without a net driver.
+	 * Object references are written as indices into a table shared by both ends, standing in for net guids.
+	 */
+	class FTestNetSerializeCB : public INetSerializeCB
+	{
+	public:
+		//~ Begin INetSerializeCB Interface
+		virtual void NetSerializeStruct(FNetDeltaSerializeInfo& Params) override
+		{
+			FArchive& Ar = Params.Writer ? static_cast<FArchive&>(*Params.Writer) : static_cast<FArchive&>(*Params.Reader);
+			SerializeStruct(Params.Struct, Params.Data, Ar);
+		}
+
+		virtual void GatherGuidReferencesForFastArray(FFastArrayDeltaSerializeParams& Params) override {}
+		virtual bool MoveGuidToUnmappedForFastArray(FFastArrayDeltaSerializeParams& Params) override { return false; }
+		virtual void UpdateUnmappedGuidsForFastArray(FFastArrayDeltaSerializeParams& Params) override {}
+		virtual bool NetDeltaSerializeForFastArray(FFastArrayDeltaSerializeParams& Params) override { return false; }
+		//~ End INetSerializeCB Interface
+
+	private:
+		void SerializeStruct(const UStruct* Struct, void* Data, FArchive& Ar)
+		{
+			for (TFieldIterator<FProperty> It(Struct); It; ++It)
+			{
+				if (It->HasAnyPropertyFlags(CPF_RepSkip))
+				{
+					continue;
+				}
+
+				for (int32 ArrayIdx = 0; ArrayIdx < It->ArrayDim; ++ArrayIdx)
+				{
+					SerializeValue(*It, It->ContainerPtrToValuePtr<void>(Data, ArrayIdx), Ar);
+				}
+			}
+		}
+
+		void SerializeValue(const FProperty* Property, void* ValuePtr, FArchive& Ar)
+		{
+			if (const FObjectPropertyBase* ObjectProperty = CastField<FObjectPropertyBase>(Property))
+			{
+				int32 ObjectIndex = Ar.IsSaving() ? ObjectTable.AddUnique(ObjectProperty->GetObjectPropertyValue(ValuePtr)) : INDEX_NONE;
+				Ar << ObjectIndex;
+
+				if (Ar.IsLoading())
+				{
+					ObjectProperty->SetObjectPropertyValue(ValuePtr, ObjectTable.IsValidIndex(ObjectIndex) ? ObjectTable[ObjectIndex] : nullptr);
+				}
+			}
+			else if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+			{
+				SerializeStruct(StructProperty->Struct, ValuePtr, Ar);
+			}
+			else if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+			{
+				FScriptArrayHelper ArrayHelper(ArrayProperty, ValuePtr);
+				int32 Num = ArrayHelper.Num();
+				Ar << Num;
+
+				if (Ar.IsLoading())
+				{
+					ArrayHelper.Resize(Num);
+				}
+
+				for (int32 Index = 0; Index < Num; ++Index)
+				{
+					SerializeValue(ArrayProperty->Inner, ArrayHelper.GetRawPtr(Index), Ar);
+				}
+			}
+			else
+			{
+				FString ValueText;
+				if (Ar.IsSaving())
+				{
+					Property->ExportTextItem_Direct(ValueText, ValuePtr, nullptr, nullptr, PPF_None);
+				}
+
+				Ar << ValueText;
+
+				if (Ar.IsLoading())
+				{
+					Property->ImportText_Direct(*ValueText, ValuePtr, nullptr, PPF_None);
+				}
+			}
+		}
+
+		TArray<UObject*> ObjectTable;
+	};
+
+	/** Delta serializes a server fast array into a client one, like a replication update of the owning object would */
+	template<typename ContainerType>
+	struct TFastArrayTestReplicator
+	{
+		TFastArrayTestReplicator()
+			: PackageMap(NewObject<UPackageMap>())
+		{
+		}
+
+		/** Returns false if the server had nothing to send or the client failed to read it, HasReadError tells them apart. */
+		bool Replicate(ContainerType& Server, ContainerType& Client)
+		{
+			LastNumBits = 0;
+			bReadError = false;
+
+			FNetBitWriter Writer(PackageMap.Get(), 1024 * 1024 * 8);
+
+			TSharedPtr<INetDeltaBaseState> NewState;
+			FNetDeltaSerializeInfo WriteParams;
+			WriteParams.Writer = &Writer;
+			WriteParams.Map = PackageMap.Get();
+			WriteParams.NetSerializeCB = &SerializeCB;
+			WriteParams.Object = GetTransientPackage();
+			WriteParams.OldState = ServerState.Get();
+			WriteParams.NewState = &NewState;
+
+			if (!Server.NetDeltaSerialize(WriteParams))
+			{
+				return false;
+			}
+
+			ServerState = NewState;
+			LastNumBits = Writer.GetNumBits();
+
+			FNetBitReader Reader(PackageMap.Get(), Writer.GetData(), Writer.GetNumBits());
+			FNetDeltaSerializeInfo ReadParams;
+			ReadParams.Reader = &Reader;
+			ReadParams.Map = PackageMap.Get();
+			ReadParams.NetSerializeCB = &SerializeCB;
+			ReadParams.Object = GetTransientPackage();
+
+			bReadError = !Client.NetDeltaSerialize(ReadParams) || Reader.IsError();
+			return !bReadError;
+		}
+
+		/** Returns the number of bits the last update wrote, 0 if there was nothing to send. */
+		int64 GetLastNumBits() const { return LastNumBits; }
+
+		/** Returns whether the client failed to read the last update. */
+		bool HasReadError() const { return bReadError; }
+
+	private:
+		TStrongObjectPtr<UPackageMap> PackageMap;
+		FTestNetSerializeCB SerializeCB;
+		TSharedPtr<INetDeltaBaseState> ServerState;
+		int64 LastNumBits = 0;
+		bool bReadError = false;
+	};
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
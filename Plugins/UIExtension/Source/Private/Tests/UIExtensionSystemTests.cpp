@@ -0,0 +1,243 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "UIExtensionSystem.h"
+
+#include "NativeGameplayTags.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerState.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace UIExtensionTests
+{
+	UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Test_Slot, "UIExtension.Test.Slot");
+	UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Test_Slot_Child, "UIExtension.Test.Slot.Child");
+
+	/**
+	 * Registers the same extension points and extensions on a transient world, and records every notification as
+	 * "<Point>:<+|-><Data>(<Priority>)" in the order it is delivered.
+	 *
+	 * Extension points:
+	 *   ChildExact   Slot.Child  ExactMatch    no context
+	 *   ChildPlayer  Slot.Child  ExactMatch    PlayerA
+	 *   SlotPartial  Slot        PartialMatch  no context
+	 *   SlotExact    Slot        ExactMatch    no context
+	 *   SlotState    Slot        PartialMatch  PlayerState
+	 */
+	struct FExtensionTestFixture
+	{
+		UWorld* World = nullptr;
+		UUIExtensionSubsystem* Subsystem = nullptr;
+		ULocalPlayer* PlayerA = nullptr;
+		ULocalPlayer* PlayerB = nullptr;
+		APlayerState* PlayerState = nullptr;
+
+		TArray<FString> Calls;
+		TMap<FString, int32> NumBatchCalls;
+		TArray<FUIExtensionPointHandle> PointHandles;
+
+		FExtensionTestFixture()
+		{
+			World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("UIExtensionTestWorld"));
+			Subsystem = World->GetSubsystem<UUIExtensionSubsystem>();
+			PlayerA = NewObject<ULocalPlayer>(GetTransientPackage(), TEXT("PlayerA"));
+			PlayerB = NewObject<ULocalPlayer>(GetTransientPackage(), TEXT("PlayerB"));
+			PlayerState = World->SpawnActor<APlayerState>();
+		}
+
+		~FExtensionTestFixture()
+		{
+			for (FUIExtensionPointHandle& Handle : PointHandles)
+			{
+				Handle.Unregister();
+			}
+
+			World->DestroyWorld(false);
+		}
+
+		void RegisterExtensionPoints(bool bUseBatchCallbacks)
+		{
+			RegisterExtensionPoint(TEXT("ChildExact"), TAG_Test_Slot_Child, nullptr, EUIExtensionPointMatch::ExactMatch, bUseBatchCallbacks);
+			RegisterExtensionPoint(TEXT("ChildPlayer"), TAG_Test_Slot_Child, PlayerA, EUIExtensionPointMatch::ExactMatch, bUseBatchCallbacks);
+			RegisterExtensionPoint(TEXT("SlotPartial"), TAG_Test_Slot, nullptr, EUIExtensionPointMatch::PartialMatch, bUseBatchCallbacks);
+			RegisterExtensionPoint(TEXT("SlotExact"), TAG_Test_Slot, nullptr, EUIExtensionPointMatch::ExactMatch, bUseBatchCallbacks);
+			RegisterExtensionPoint(TEXT("SlotState"), TAG_Test_Slot, PlayerState, EUIExtensionPointMatch::PartialMatch, bUseBatchCallbacks);
+		}
+
+		/** Parent and child tag extensions, with and without context and with distinct priorities */
+		TArray<FUIExtensionRequest> MakeRequests() const
+		{
+			TArray<FUIExtensionRequest> Requests;
+			AddRequest(Requests, TEXT("ChildAny"), TAG_Test_Slot_Child, nullptr, 10);
+			AddRequest(Requests, TEXT("SlotAny"), TAG_Test_Slot, nullptr, 5);
+			AddRequest(Requests, TEXT("ChildForA"), TAG_Test_Slot_Child, PlayerA, 1);
+			AddRequest(Requests, TEXT("ChildForB"), TAG_Test_Slot_Child, PlayerB, 2);
+			AddRequest(Requests, TEXT("SlotForState"), TAG_Test_Slot, PlayerState, 3);
+			AddRequest(Requests, TEXT("ChildForState"), TAG_Test_Slot_Child, PlayerState, 4);
+			return Requests;
+		}
+
+		FString GetCalls() const
+		{
+			return FString::Join(Calls, TEXT(", "));
+		}
+
+	private:
+		void RegisterExtensionPoint(const FString& PointName, const FGameplayTag& Tag, UObject* ContextObject, EUIExtensionPointMatch MatchType, bool bUseBatchCallback)
+		{
+			FExtendExtensionPointDelegate Callback = FExtendExtensionPointDelegate::CreateLambda([this, PointName](EUIExtensionAction Action, const FUIExtensionRequest& Request)
+			{
+				Record(PointName, Action, Request);
+			});
+
+			FExtendExtensionPointBatchDelegate BatchCallback;
+			if (bUseBatchCallback)
+			{
+				BatchCallback = FExtendExtensionPointBatchDelegate::CreateLambda([this, PointName](const TArray<FUIExtensionChange>& Changes)
+				{
+					NumBatchCalls.FindOrAdd(PointName)++;
+					for (const FUIExtensionChange& Change : Changes)
+					{
+						Record(PointName, Change.Action, Change.Request);
+					}
+				});
+			}
+
+			PointHandles.Add(Subsystem->RegisterExtensionPointForContext(Tag, ContextObject, MatchType, { UObject::StaticClass() }, Callback, BatchCallback));
+		}
+
+		void Record(const FString& PointName, EUIExtensionAction Action, const FUIExtensionRequest& Request)
+		{
+			Calls.Add(FString::Printf(TEXT("%s:%s%s(%d)"), *PointName, Action == EUIExtensionAction::Added ? TEXT("+") : TEXT("-"), *GetNameSafe(Request.Data), Request.Priority));
+		}
+
+		static void AddRequest(TArray<FUIExtensionRequest>& Requests, const TCHAR* DataName, const FGameplayTag& Tag, UObject* ContextObject, int32 Priority)
+		{
+			FUIExtensionRequest& Request = Requests.AddDefaulted_GetRef();
+			Request.ExtensionPointTag = Tag;
+			Request.ContextObject = ContextObject;
+			Request.Data = NewObject<UObject>(GetTransientPackage(), DataName);
+			Request.Priority = Priority;
+		}
+	};
+
+	/**
+	 * Every extension is offered to the points on its own tag first, then to the partial match points of its parents.
+	 * Extensions for another context, or on a child tag of an exact match point, are filtered out.
+	 */
+	static const TCHAR* ExpectedAddedCalls =
+		TEXT("ChildExact:+ChildAny(10), SlotPartial:+ChildAny(10), ")
+		TEXT("SlotPartial:+SlotAny(5), SlotExact:+SlotAny(5), ")
+		TEXT("ChildPlayer:+ChildForA(1), ")
+		TEXT("SlotState:+SlotForState(3), ")
+		TEXT("SlotState:+ChildForState(4)");
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUIExtensionSingleRegistrationTest, "UIExtension.Subsystem.SingleRegistration", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FUIExtensionSingleRegistrationTest::RunTest(const FString& Parameters)
+{
+	using namespace UIExtensionTests;
+
+	FExtensionTestFixture Fixture;
+	if (!TestNotNull(TEXT("Extension subsystem"), Fixture.Subsystem))
+	{
+		return false;
+	}
+
+	Fixture.RegisterExtensionPoints(false);
+
+	TArray<FUIExtensionHandle> Handles;
+	for (const FUIExtensionRequest& Request : Fixture.MakeRequests())
+	{
+		Handles.Add(Fixture.Subsystem->RegisterExtensionAsData(Request.ExtensionPointTag, Request.ContextObject, Request.Data, Request.Priority));
+	}
+
+	TestEqual(TEXT("Added notifications"), Fixture.GetCalls(), FString(ExpectedAddedCalls));
+
+	Fixture.Calls.Reset();
+	Fixture.Subsystem->UnregisterExtension(Handles[0]);
+	Fixture.Subsystem->UnregisterExtension(Handles[2]);
+
+	TestEqual(TEXT("Removed notifications"), Fixture.GetCalls(), FString(TEXT("ChildExact:-ChildAny(10), SlotPartial:-ChildAny(10), ChildPlayer:-ChildForA(1)")));
+
+	// A point registered late is offered the extensions on its own tag first, then those on its parents
+	Fixture.Calls.Reset();
+	Fixture.PointHandles.Add(Fixture.Subsystem->RegisterExtensionPointForContext(TAG_Test_Slot_Child, Fixture.PlayerState, EUIExtensionPointMatch::PartialMatch, { UObject::StaticClass() },
+		FExtendExtensionPointDelegate::CreateLambda([&Fixture](EUIExtensionAction Action, const FUIExtensionRequest& Request)
+		{
+			Fixture.Calls.Add(FString::Printf(TEXT("LateState:%s%s(%d)"), Action == EUIExtensionAction::Added ? TEXT("+") : TEXT("-"), *GetNameSafe(Request.Data), Request.Priority));
+		})));
+
+	TestEqual(TEXT("Late extension point notifications"), Fixture.GetCalls(), FString(TEXT("LateState:+ChildForState(4), LateState:+SlotForState(3)")));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUIExtensionBatchedRegistrationTest, "UIExtension.Subsystem.BatchedRegistration", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FUIExtensionBatchedRegistrationTest::RunTest(const FString& Parameters)
+{
+	using namespace UIExtensionTests;
+
+	// Points without a batch callback get the per extension callback, in the same order as single registrations
+	{
+		FExtensionTestFixture Fixture;
+		if (!TestNotNull(TEXT("Extension subsystem"), Fixture.Subsystem))
+		{
+			return false;
+		}
+
+		Fixture.RegisterExtensionPoints(false);
+
+		const TArray<FUIExtensionHandle> Handles = Fixture.Subsystem->RegisterExtensionsAsData(Fixture.MakeRequests());
+		TestEqual(TEXT("Number of handles"), Handles.Num(), 6);
+		TestEqual(TEXT("Added notifications"), Fixture.GetCalls(), FString(ExpectedAddedCalls));
+
+		Fixture.Calls.Reset();
+		Fixture.Subsystem->UnregisterExtensions({ Handles[0], Handles[2] });
+		TestEqual(TEXT("Removed notifications"), Fixture.GetCalls(), FString(TEXT("ChildExact:-ChildAny(10), SlotPartial:-ChildAny(10), ChildPlayer:-ChildForA(1)")));
+	}
+
+	// Batch callbacks get all changes of their point in a single call
+	{
+		FExtensionTestFixture Fixture;
+		if (!TestNotNull(TEXT("Extension subsystem"), Fixture.Subsystem))
+		{
+			return false;
+		}
+
+		Fixture.RegisterExtensionPoints(true);
+
+		const TArray<FUIExtensionHandle> Handles = Fixture.Subsystem->RegisterExtensionsAsData(Fixture.MakeRequests());
+		TestEqual(TEXT("Added notifications"), Fixture.GetCalls(),
+			FString(TEXT("ChildExact:+ChildAny(10), SlotPartial:+ChildAny(10), SlotPartial:+SlotAny(5), SlotExact:+SlotAny(5), ChildPlayer:+ChildForA(1), SlotState:+SlotForState(3), SlotState:+ChildForState(4)")));
+
+		TestEqual(TEXT("SlotPartial batch calls"), Fixture.NumBatchCalls.FindRef(TEXT("SlotPartial")), 1);
+		TestEqual(TEXT("SlotState batch calls"), Fixture.NumBatchCalls.FindRef(TEXT("SlotState")), 1);
+		TestEqual(TEXT("ChildPlayer batch calls"), Fixture.NumBatchCalls.FindRef(TEXT("ChildPlayer")), 1);
+
+		// Extensions added and removed within the same batch are never delivered
+		Fixture.Calls.Reset();
+		Fixture.NumBatchCalls.Reset();
+		{
+			FUIExtensionBatchScope BatchScope(Fixture.Subsystem);
+
+			UObject* TransientData = NewObject<UObject>(GetTransientPackage(), TEXT("Transient"));
+			const FUIExtensionHandle TransientHandle = Fixture.Subsystem->RegisterExtensionAsData(TAG_Test_Slot_Child, nullptr, TransientData, 0);
+			Fixture.Subsystem->UnregisterExtension(TransientHandle);
+
+			TestEqual(TEXT("Notifications within the batch"), Fixture.Calls.Num(), 0);
+		}
+
+		TestEqual(TEXT("Notifications of dropped extensions"), Fixture.GetCalls(), FString());
+		TestEqual(TEXT("Batch calls of dropped extensions"), Fixture.NumBatchCalls.Num(), 0);
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
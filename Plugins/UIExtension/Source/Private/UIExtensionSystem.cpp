@@ -32,6 +32,25 @@ void FUIExtensionHandle::Unregister()
 
 //=========================================================
 
+FUIExtensionBatchScope::FUIExtensionBatchScope(UUIExtensionSubsystem* InExtensionSubsystem)
+	: ExtensionSubsystem(InExtensionSubsystem)
+{
+	if (InExtensionSubsystem)
+	{
+		InExtensionSubsystem->BeginExtensionBatch();
+	}
+}
+
+FUIExtensionBatchScope::~FUIExtensionBatchScope()
+{
+	if (UUIExtensionSubsystem* ExtensionSubsystemPtr = ExtensionSubsystem.Get())
+	{
+		ExtensionSubsystemPtr->EndExtensionBatch();
+	}
+}
+
+//=========================================================
+
 bool FUIExtensionPoint::DoesExtensionPassContract(const FUIExtension* Extension) const
 {
 	if (UObject* DataPtr = Extension->Data)
@@ -89,15 +108,18 @@ void UUIExtensionSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 
 void UUIExtensionSubsystem::Deinitialize()
 {
+	PendingNotifications.Reset();
+	ExtensionPointRoutingCache.Reset();
+
 	Super::Deinitialize();
 }
 
-FUIExtensionPointHandle UUIExtensionSubsystem::RegisterExtensionPoint(const FGameplayTag& ExtensionPointTag, EUIExtensionPointMatch ExtensionPointTagMatchType, const TArray<UClass*>& AllowedDataClasses, FExtendExtensionPointDelegate ExtensionCallback)
+FUIExtensionPointHandle UUIExtensionSubsystem::RegisterExtensionPoint(const FGameplayTag& ExtensionPointTag, EUIExtensionPointMatch ExtensionPointTagMatchType, const TArray<UClass*>& AllowedDataClasses, FExtendExtensionPointDelegate ExtensionCallback, FExtendExtensionPointBatchDelegate BatchCallback)
 {
-	return RegisterExtensionPointForContext(ExtensionPointTag, nullptr, ExtensionPointTagMatchType, AllowedDataClasses, ExtensionCallback);
+	return RegisterExtensionPointForContext(ExtensionPointTag, nullptr, ExtensionPointTagMatchType, AllowedDataClasses, MoveTemp(ExtensionCallback), MoveTemp(BatchCallback));
 }
 
-FUIExtensionPointHandle UUIExtensionSubsystem::RegisterExtensionPointForContext(const FGameplayTag& ExtensionPointTag, UObject* ContextObject, EUIExtensionPointMatch ExtensionPointTagMatchType, const TArray<UClass*>& AllowedDataClasses, FExtendExtensionPointDelegate ExtensionCallback)
+FUIExtensionPointHandle UUIExtensionSubsystem::RegisterExtensionPointForContext(const FGameplayTag& ExtensionPointTag, UObject* ContextObject, EUIExtensionPointMatch ExtensionPointTagMatchType, const TArray<UClass*>& AllowedDataClasses, FExtendExtensionPointDelegate ExtensionCallback, FExtendExtensionPointBatchDelegate BatchCallback)
 {
 	if (!ExtensionPointTag.IsValid())
 	{
@@ -125,6 +147,9 @@ FUIExtensionPointHandle UUIExtensionSubsystem::RegisterExtensionPointForContext(
 	Entry->ExtensionPointTagMatchType = ExtensionPointTagMatchType;
 	Entry->AllowedDataClasses = AllowedDataClasses;
 	Entry->Callback = MoveTemp(ExtensionCallback);
+	Entry->BatchCallback = MoveTemp(BatchCallback);
+
+	ExtensionPointRoutingCache.Reset();
 
 	UE_LOG(LogUIExtension, Verbose, TEXT("Extension Point [%s] Registered"), *ExtensionPointTag.ToString());
 
@@ -181,6 +206,8 @@ FUIExtensionHandle UUIExtensionSubsystem::RegisterExtensionAsData(const FGamepla
 
 void UUIExtensionSubsystem::NotifyExtensionPointOfExtensions(TSharedPtr<FUIExtensionPoint>& ExtensionPoint)
 {
+	TArray<FUIExtensionChange> Changes;
+
 	for (FGameplayTag Tag = ExtensionPoint->ExtensionPointTag; Tag.IsValid(); Tag = Tag.RequestDirectParent())
 	{
 		if (const FExtensionList* ListPtr = ExtensionMap.Find(Tag))
@@ -193,7 +220,14 @@ void UUIExtensionSubsystem::NotifyExtensionPointOfExtensions(TSharedPtr<FUIExten
 				if (ExtensionPoint->DoesExtensionPassContract(Extension.Get()))
 				{
 					FUIExtensionRequest Request = CreateExtensionRequest(Extension);
-					ExtensionPoint->Callback.ExecuteIfBound(EUIExtensionAction::Added, Request);
+					if (ExtensionPoint->BatchCallback.IsBound())
+					{
+						Changes.Add({ EUIExtensionAction::Added, MoveTemp(Request) });
+					}
+					else
+					{
+						ExtensionPoint->Callback.ExecuteIfBound(EUIExtensionAction::Added, Request);
+					}
 				}
 			}
 		}
@@ -203,33 +237,190 @@ void UUIExtensionSubsystem::NotifyExtensionPointOfExtensions(TSharedPtr<FUIExten
 			break;
 		}
 	}
+
+	if (Changes.Num() > 0)
+	{
+		ExtensionPoint->BatchCallback.ExecuteIfBound(Changes);
+	}
 }
 
 void UUIExtensionSubsystem::NotifyExtensionPointsOfExtension(EUIExtensionAction Action, TSharedPtr<FUIExtension>& Extension)
 {
+	// Copy in case there are removals while handling callbacks
+	const FExtensionPointList ExtensionPointArray(GetRoutedExtensionPoints(Extension->ExtensionPointTag));
+
+	for (const TSharedPtr<FUIExtensionPoint>& ExtensionPoint : ExtensionPointArray)
+	{
+		if (ExtensionPoint->DoesExtensionPassContract(Extension.Get()))
+		{
+			if (BatchDepth > 0)
+			{
+				// An extension that is added and removed within the same batch is never seen by the extension point
+				if (Action == EUIExtensionAction::Removed)
+				{
+					const int32 AddedIndex = PendingNotifications.IndexOfByPredicate([&](const FPendingNotification& Pending)
+					{
+						return Pending.Extension == Extension && Pending.ExtensionPoint == ExtensionPoint && Pending.Action == EUIExtensionAction::Added;
+					});
+
+					if (AddedIndex != INDEX_NONE)
+					{
+						PendingNotifications.RemoveAt(AddedIndex);
+						continue;
+					}
+				}
+
+				PendingNotifications.Add({ ExtensionPoint, Extension, Action });
+			}
+			else
+			{
+				FUIExtensionRequest Request = CreateExtensionRequest(Extension);
+				ExtensionPoint->Callback.ExecuteIfBound(Action, Request);
+			}
+		}
+	}
+}
+
+const UUIExtensionSubsystem::FExtensionPointList& UUIExtensionSubsystem::GetRoutedExtensionPoints(const FGameplayTag& ExtensionTag)
+{
+	if (const FExtensionPointList* CachedList = ExtensionPointRoutingCache.Find(ExtensionTag))
+	{
+		return *CachedList;
+	}
+
+	// Same order as walking the tag hierarchy on every notification: every point on the tag itself,
+	// then the partial match points of each parent tag.
+	FExtensionPointList RoutedList;
 	bool bOnInitialTag = true;
-	for (FGameplayTag Tag = Extension->ExtensionPointTag; Tag.IsValid(); Tag = Tag.RequestDirectParent())
+	for (FGameplayTag Tag = ExtensionTag; Tag.IsValid(); Tag = Tag.RequestDirectParent())
 	{
 		if (const FExtensionPointList* ListPtr = ExtensionPointMap.Find(Tag))
 		{
-			// Copy in case there are removals while handling callbacks
-			FExtensionPointList ExtensionPointArray(*ListPtr);
-
-			for (const TSharedPtr<FUIExtensionPoint>& ExtensionPoint : ExtensionPointArray)
+			for (const TSharedPtr<FUIExtensionPoint>& ExtensionPoint : *ListPtr)
 			{
 				if (bOnInitialTag || (ExtensionPoint->ExtensionPointTagMatchType == EUIExtensionPointMatch::PartialMatch))
 				{
-					if (ExtensionPoint->DoesExtensionPassContract(Extension.Get()))
-					{
-						FUIExtensionRequest Request = CreateExtensionRequest(Extension);
-						ExtensionPoint->Callback.ExecuteIfBound(Action, Request);
-					}
+					RoutedList.Add(ExtensionPoint);
 				}
 			}
 		}
-		
+
 		bOnInitialTag = false;
 	}
+
+	return ExtensionPointRoutingCache.Add(ExtensionTag, MoveTemp(RoutedList));
+}
+
+bool UUIExtensionSubsystem::IsExtensionPointRegistered(const TSharedPtr<FUIExtensionPoint>& ExtensionPoint) const
+{
+	const FExtensionPointList* ListPtr = ExtensionPointMap.Find(ExtensionPoint->ExtensionPointTag);
+	return ListPtr && ListPtr->Contains(ExtensionPoint);
+}
+
+TArray<FUIExtensionHandle> UUIExtensionSubsystem::RegisterExtensionsAsData(const TArray<FUIExtensionRequest>& Requests)
+{
+	TArray<FUIExtensionHandle> Handles;
+	Handles.Reserve(Requests.Num());
+
+	FUIExtensionBatchScope BatchScope(this);
+	for (const FUIExtensionRequest& Request : Requests)
+	{
+		Handles.Add(RegisterExtensionAsData(Request.ExtensionPointTag, Request.ContextObject, Request.Data, Request.Priority));
+	}
+
+	return Handles;
+}
+
+void UUIExtensionSubsystem::UnregisterExtensions(const TArray<FUIExtensionHandle>& ExtensionHandles)
+{
+	FUIExtensionBatchScope BatchScope(this);
+	for (const FUIExtensionHandle& Handle : ExtensionHandles)
+	{
+		// Handles of failed registrations are expected here, skip them quietly
+		if (Handle.IsValid())
+		{
+			UnregisterExtension(Handle);
+		}
+	}
+}
+
+void UUIExtensionSubsystem::BeginExtensionBatch()
+{
+	++BatchDepth;
+}
+
+void UUIExtensionSubsystem::EndExtensionBatch()
+{
+	if (!ensureMsgf(BatchDepth > 0, TEXT("EndExtensionBatch called without a matching BeginExtensionBatch.")))
+	{
+		return;
+	}
+
+	if (--BatchDepth == 0)
+	{
+		FlushPendingNotifications();
+	}
+}
+
+void UUIExtensionSubsystem::FlushPendingNotifications()
+{
+	if (PendingNotifications.Num() == 0)
+	{
+		return;
+	}
+
+	TArray<FPendingNotification> Notifications = MoveTemp(PendingNotifications);
+	PendingNotifications.Reset();
+
+	// Group by the object behind the callbacks, so a widget owning several extension points handles the batch in one pass
+	TArray<const void*> GroupOrder;
+	TMap<const void*, TArray<int32>> Groups;
+	for (int32 Index = 0; Index < Notifications.Num(); ++Index)
+	{
+		const FUIExtensionPoint* ExtensionPoint = Notifications[Index].ExtensionPoint.Get();
+		const void* GroupKey = ExtensionPoint->Callback.GetUObject() ? static_cast<const void*>(ExtensionPoint->Callback.GetUObject()) : ExtensionPoint;
+
+		TArray<int32>* Group = Groups.Find(GroupKey);
+		if (!Group)
+		{
+			GroupOrder.Add(GroupKey);
+			Group = &Groups.Add(GroupKey);
+		}
+		Group->Add(Index);
+	}
+
+	for (const void* GroupKey : GroupOrder)
+	{
+		TArray<FUIExtensionChange> Changes;
+		FExtendExtensionPointBatchDelegate BatchCallback;
+
+		for (const int32 Index : Groups.FindChecked(GroupKey))
+		{
+			const FPendingNotification& Pending = Notifications[Index];
+
+			// The extension point may have been unregistered by an earlier callback of this flush
+			if (!IsExtensionPointRegistered(Pending.ExtensionPoint))
+			{
+				continue;
+			}
+
+			FUIExtensionRequest Request = CreateExtensionRequest(Pending.Extension);
+			if (Pending.ExtensionPoint->BatchCallback.IsBound())
+			{
+				BatchCallback = Pending.ExtensionPoint->BatchCallback;
+				Changes.Add({ Pending.Action, MoveTemp(Request) });
+			}
+			else
+			{
+				Pending.ExtensionPoint->Callback.ExecuteIfBound(Pending.Action, Request);
+			}
+		}
+
+		if (Changes.Num() > 0)
+		{
+			BatchCallback.ExecuteIfBound(Changes);
+		}
+	}
 }
 
 void UUIExtensionSubsystem::UnregisterExtension(const FUIExtensionHandle& ExtensionHandle)
@@ -278,6 +469,7 @@ void UUIExtensionSubsystem::UnregisterExtensionPoint(const FUIExtensionPointHand
 			UE_LOG(LogUIExtension, Verbose, TEXT("Extension Point [%s] Unregistered"), *ExtensionPoint->ExtensionPointTag.ToString());
 
 			ListPtr->RemoveSwap(ExtensionPoint);
+			ExtensionPointRoutingCache.Reset();
 			if (ListPtr->Num() == 0)
 			{
 				ExtensionPointMap.Remove(ExtensionPoint->ExtensionPointTag);
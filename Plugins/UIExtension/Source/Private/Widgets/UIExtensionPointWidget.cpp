@@ -89,12 +89,14 @@ void UUIExtensionPointWidget::RegisterExtensionPoint()
 
 		ExtensionPointHandles.Add(ExtensionSubsystem->RegisterExtensionPoint(
 			ExtensionPointTag, ExtensionPointTagMatch, AllowedDataClasses,
-			FExtendExtensionPointDelegate::CreateUObject(this, &ThisClass::OnAddOrRemoveExtension)
+			FExtendExtensionPointDelegate::CreateUObject(this, &ThisClass::OnAddOrRemoveExtension),
+			FExtendExtensionPointBatchDelegate::CreateUObject(this, &ThisClass::OnAddOrRemoveExtensions)
 		));
 
 		ExtensionPointHandles.Add(ExtensionSubsystem->RegisterExtensionPointForContext(
 			ExtensionPointTag, GetOwningLocalPlayer(), ExtensionPointTagMatch, AllowedDataClasses,
-			FExtendExtensionPointDelegate::CreateUObject(this, &ThisClass::OnAddOrRemoveExtension)
+			FExtendExtensionPointDelegate::CreateUObject(this, &ThisClass::OnAddOrRemoveExtension),
+			FExtendExtensionPointBatchDelegate::CreateUObject(this, &ThisClass::OnAddOrRemoveExtensions)
 		));
 	}
 }
@@ -109,7 +111,8 @@ void UUIExtensionPointWidget::RegisterExtensionPointForPlayerState(UCommonLocalP
 
 		ExtensionPointHandles.Add(ExtensionSubsystem->RegisterExtensionPointForContext(
 			ExtensionPointTag, PlayerState, ExtensionPointTagMatch, AllowedDataClasses,
-			FExtendExtensionPointDelegate::CreateUObject(this, &ThisClass::OnAddOrRemoveExtension)
+			FExtendExtensionPointDelegate::CreateUObject(this, &ThisClass::OnAddOrRemoveExtension),
+			FExtendExtensionPointBatchDelegate::CreateUObject(this, &ThisClass::OnAddOrRemoveExtensions)
 		));
 	}
 }
@@ -154,6 +157,26 @@ void UUIExtensionPointWidget::OnAddOrRemoveExtension(EUIExtensionAction Action,
 	}
 }
 
+void UUIExtensionPointWidget::OnAddOrRemoveExtensions(const TArray<FUIExtensionChange>& Changes)
+{
+	// Removals first, so their entry widgets are back in the pool before the additions create theirs
+	for (const FUIExtensionChange& Change : Changes)
+	{
+		if (Change.Action == EUIExtensionAction::Removed)
+		{
+			OnAddOrRemoveExtension(Change.Action, Change.Request);
+		}
+	}
+
+	for (const FUIExtensionChange& Change : Changes)
+	{
+		if (Change.Action == EUIExtensionAction::Added)
+		{
+			OnAddOrRemoveExtension(Change.Action, Change.Request);
+		}
+	}
+}
+
 #if WITH_EDITOR
 void UUIExtensionPointWidget::ValidateCompiledDefaults(IWidgetCompilerLog& CompileLog) const
 {
@@ -39,6 +39,9 @@ enum class EUIExtensionAction : uint8
 
 DECLARE_DELEGATE_TwoParams(FExtendExtensionPointDelegate, EUIExtensionAction Action, const FUIExtensionRequest& Request);
 
+struct FUIExtensionChange;
+DECLARE_DELEGATE_OneParam(FExtendExtensionPointBatchDelegate, const TArray<FUIExtensionChange>& Changes);
+
 /*
  *
  */
@@ -65,6 +68,9 @@ public:
 	TArray<TObjectPtr<UClass>> AllowedDataClasses;
 	FExtendExtensionPointDelegate Callback;
 
+	// Optional, receives all changes of a batch in one call instead of one Callback per change
+	FExtendExtensionPointBatchDelegate BatchCallback;
+
 	// Tests if the extension and the extension point match up, if they do then this extension point should learn
 	// about this extension.
 	bool DoesExtensionPassContract(const FUIExtension* Extension) const;
@@ -181,8 +187,29 @@ public:
 	TObjectPtr<UObject> ContextObject = nullptr;
 };
 
+/**
+ * A single add or remove, as delivered to batch callbacks
+ */
+struct FUIExtensionChange
+{
+	EUIExtensionAction Action = EUIExtensionAction::Added;
+	FUIExtensionRequest Request;
+};
+
 DECLARE_DYNAMIC_DELEGATE_TwoParams(FExtendExtensionPointDynamicDelegate, EUIExtensionAction, Action, const FUIExtensionRequest&, ExtensionRequest);
 
+/**
+ * Keeps an extension batch open for its lifetime, see UUIExtensionSubsystem::BeginExtensionBatch.
+ */
+struct UIEXTENSION_API FUIExtensionBatchScope
+{
+	explicit FUIExtensionBatchScope(UUIExtensionSubsystem* InExtensionSubsystem);
+	~FUIExtensionBatchScope();
+
+private:
+	TWeakObjectPtr<UUIExtensionSubsystem> ExtensionSubsystem;
+};
+
 /**
  * 
  */
@@ -192,13 +219,31 @@ class UIEXTENSION_API UUIExtensionSubsystem : public UWorldSubsystem
 	GENERATED_BODY()
 
 public:
-	FUIExtensionPointHandle RegisterExtensionPoint(const FGameplayTag& ExtensionPointTag, EUIExtensionPointMatch ExtensionPointTagMatchType, const TArray<UClass*>& AllowedDataClasses, FExtendExtensionPointDelegate ExtensionCallback);
-	FUIExtensionPointHandle RegisterExtensionPointForContext(const FGameplayTag& ExtensionPointTag, UObject* ContextObject, EUIExtensionPointMatch ExtensionPointTagMatchType, const TArray<UClass*>& AllowedDataClasses, FExtendExtensionPointDelegate ExtensionCallback);
+	FUIExtensionPointHandle RegisterExtensionPoint(const FGameplayTag& ExtensionPointTag, EUIExtensionPointMatch ExtensionPointTagMatchType, const TArray<UClass*>& AllowedDataClasses, FExtendExtensionPointDelegate ExtensionCallback, FExtendExtensionPointBatchDelegate BatchCallback = FExtendExtensionPointBatchDelegate());
+	FUIExtensionPointHandle RegisterExtensionPointForContext(const FGameplayTag& ExtensionPointTag, UObject* ContextObject, EUIExtensionPointMatch ExtensionPointTagMatchType, const TArray<UClass*>& AllowedDataClasses, FExtendExtensionPointDelegate ExtensionCallback, FExtendExtensionPointBatchDelegate BatchCallback = FExtendExtensionPointBatchDelegate());
 
 	FUIExtensionHandle RegisterExtensionAsWidget(const FGameplayTag& ExtensionPointTag, TSubclassOf<UUserWidget> WidgetClass, int32 Priority);
 	FUIExtensionHandle RegisterExtensionAsWidgetForContext(const FGameplayTag& ExtensionPointTag, UObject* ContextObject, TSubclassOf<UUserWidget> WidgetClass, int32 Priority);
 	FUIExtensionHandle RegisterExtensionAsData(const FGameplayTag& ExtensionPointTag, UObject* ContextObject, UObject* Data, int32 Priority);
 
+	/**
+	 * Registers many extensions at once, using the tag, context, data and priority of each request.
+	 * Extension points are notified once all of them are registered, see BeginExtensionBatch.
+	 * Returns one handle per request, invalid for requests that failed to register.
+	 */
+	TArray<FUIExtensionHandle> RegisterExtensionsAsData(const TArray<FUIExtensionRequest>& Requests);
+
+	/** Unregisters many extensions at once, extension points are notified once all of them are unregistered. */
+	void UnregisterExtensions(const TArray<FUIExtensionHandle>& ExtensionHandles);
+
+	/**
+	 * Defers extension point notifications until the matching EndExtensionBatch.
+	 * Changes are then delivered in order, grouped per callback owner, and extensions that were added and removed
+	 * within the batch are dropped. Batches can be nested, only the outermost one delivers.
+	 */
+	void BeginExtensionBatch();
+	void EndExtensionBatch();
+
 	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "UI Extension")
 	void UnregisterExtension(const FUIExtensionHandle& ExtensionHandle);
 
@@ -245,6 +290,25 @@ private:
 	typedef TArray<TSharedPtr<FUIExtensionPoint>> FExtensionPointList;
 	TMap<FGameplayTag, FExtensionPointList> ExtensionPointMap;
 
+	// Returns every extension point interested in extensions of the given tag, in notification order
+	const FExtensionPointList& GetRoutedExtensionPoints(const FGameplayTag& ExtensionTag);
+	bool IsExtensionPointRegistered(const TSharedPtr<FUIExtensionPoint>& ExtensionPoint) const;
+	void FlushPendingNotifications();
+
+	// Extension tag to interested extension points, rebuilt lazily whenever an extension point is registered or unregistered
+	TMap<FGameplayTag, FExtensionPointList> ExtensionPointRoutingCache;
+
+	struct FPendingNotification
+	{
+		TSharedPtr<FUIExtensionPoint> ExtensionPoint;
+		TSharedPtr<FUIExtension> Extension;
+		EUIExtensionAction Action;
+	};
+
+	// Notifications deferred by an open batch, in the order they happened
+	TArray<FPendingNotification> PendingNotifications;
+	int32 BatchDepth = 0;
+
 	typedef TArray<TSharedPtr<FUIExtension>> FExtensionList;
 	TMap<FGameplayTag, FExtensionList> ExtensionMap;
 };
@@ -40,6 +40,7 @@ private:
 	void RegisterExtensionPoint();
 	void RegisterExtensionPointForPlayerState(UCommonLocalPlayer* LocalPlayer, APlayerState* PlayerState);
 	void OnAddOrRemoveExtension(EUIExtensionAction Action, const FUIExtensionRequest& Request);
+	void OnAddOrRemoveExtensions(const TArray<FUIExtensionChange>& Changes);
 
 protected:
 	/** The tag that defines this extension point */
@@ -3,10 +3,28 @@
 
 #include "Bot/BotaniBotDefinition.h"
 
+#include "Bot/Modifiers/BotaniCharacterModifier.h"
+
 UBotaniBotDefinition::UBotaniBotDefinition(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
 	bOverrideDefaultPawnData = false;
 	bInheritDefaultAbilities = true;
 	bInheritDefaultTagRelationshipMappings = true;
-}
\ No newline at end of file
+}
+
+void UBotaniBotDefinition::ApplyToCharacter(ACharacter* Character) const
+{
+	if (Character == nullptr)
+	{
+		return;
+	}
+
+	for (const UBotaniCharacterModifier* Modifier : Modifiers)
+	{
+		if (Modifier != nullptr)
+		{
+			Modifier->ApplyToCharacter(Character);
+		}
+	}
+}
@@ -3,6 +3,10 @@
 
 #include "Bot/Modifiers/CharacterModifier_Behavior.h"
 
+#include "AIController.h"
+#include "BehaviorTree/BehaviorTree.h"
+#include "GameFramework/Character.h"
+
 #include UE_INLINE_GENERATED_CPP_BY_NAME(CharacterModifier_Behavior)
 
 UCharacterModifier_Behavior::UCharacterModifier_Behavior(const FObjectInitializer& ObjectInitializer)
@@ -50,4 +54,19 @@ UCharacterModifier_Behavior::UCharacterModifier_Behavior(const FObjectInitialize
 void UCharacterModifier_Behavior::ApplyToCharacter(ACharacter* Character) const
 {
 	Super::ApplyToCharacter(Character);
+
+	if (Character == nullptr)
+	{
+		return;
+	}
+
+	// Restarts the tree as well, so reused characters don't continue where they left off
+	AAIController* AIController = Character->GetController<AAIController>();
+	if (AIController && !BehaviorTree.IsNull())
+	{
+		if (UBehaviorTree* LoadedTree = BehaviorTree.LoadSynchronous())
+		{
+			AIController->RunBehaviorTree(LoadedTree);
+		}
+	}
 }
@@ -0,0 +1,538 @@
+// Copyright © 2024 Botanibots Team. All rights reserved.
+
+
+#include "Development/BotaniSoakTestSubsystem.h"
+
+#include "AIController.h"
+#include "BotaniLogChannels.h"
+#include "Bot/BotaniBotController.h"
+#include "Bot/BotaniBotDefinition.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "Game/BotaniGameModeBase.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/PlayerState.h"
+#include "Misc/App.h"
+#include "Misc/FileHelper.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "System/Tasks/AsyncAction_WaitExperienceReady.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(BotaniSoakTestSubsystem)
+
+namespace BotaniSoakTest
+{
+	static const ETickingGroup MeasuredTickGroups[] =
+	{
+		TG_PrePhysics,
+		TG_StartPhysics,
+		TG_DuringPhysics,
+		TG_EndPhysics,
+		TG_PostPhysics,
+		TG_PostUpdateWork,
+		TG_LastDemotable
+	};
+
+	static const TCHAR* MeasuredTickGroupNames[] =
+	{
+		TEXT("PrePhysics"),
+		TEXT("StartPhysics"),
+		TEXT("DuringPhysics"),
+		TEXT("EndPhysics"),
+		TEXT("PostPhysics"),
+		TEXT("PostUpdateWork"),
+		TEXT("LastDemotable")
+	};
+
+	static constexpr int32 NumMeasuredTickGroups = UE_ARRAY_COUNT(MeasuredTickGroups);
+
+	/** Returns the value at the given percentile (0..1) of an already sorted array */
+	static float GetPercentile(const TArray<float>& SortedValues, float Percentile)
+	{
+		if (SortedValues.IsEmpty())
+		{
+			return 0.f;
+		}
+
+		const int32 Index = FMath::Clamp(FMath::CeilToInt(Percentile * SortedValues.Num()) - 1, 0, SortedValues.Num() - 1);
+		return SortedValues[Index];
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// FBotaniSoakTickGroupMarker
+
+void FBotaniSoakTickGroupMarker::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Owner != nullptr)
+	{
+		Owner->MarkTickGroupStart(MarkerIndex);
+	}
+}
+
+FString FBotaniSoakTickGroupMarker::DiagnosticMessage()
+{
+	return FString::Printf(TEXT("BotaniSoakTickGroupMarker[%d]"), MarkerIndex);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// UBotaniSoakTestSubsystem
+
+UBotaniSoakTestSubsystem::UBotaniSoakTestSubsystem()
+{
+}
+
+bool UBotaniSoakTestSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	if (!Super::ShouldCreateSubsystem(Outer))
+	{
+		return false;
+	}
+
+	// Soak tests measure the server, never run them on pure clients
+	if (IsRunningClientOnly() || !FParse::Param(FCommandLine::Get(), TEXT("BotaniSoak")))
+	{
+		return false;
+	}
+
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld();
+}
+
+void UBotaniSoakTestSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	const TCHAR* CommandLine = FCommandLine::Get();
+	FParse::Value(CommandLine, TEXT("SoakBots="), NumBotsToSpawn);
+	FParse::Value(CommandLine, TEXT("SoakWarmup="), WarmupDuration);
+	FParse::Value(CommandLine, TEXT("SoakDuration="), MeasureDuration);
+	FParse::Value(CommandLine, TEXT("SoakMaxWorkTimeP95="), MaxWorkTimeP95Ms);
+	FParse::Value(CommandLine, TEXT("SoakMaxFrameTimeP99="), MaxFrameTimeP99Ms);
+	FParse::Value(CommandLine, TEXT("SoakMaxMemoryGrowth="), MaxMemoryGrowthMB);
+	bExitWhenFinished = !FParse::Param(CommandLine, TEXT("SoakNoExit"));
+
+	NumBotsToSpawn = FMath::Max(NumBotsToSpawn, 0);
+	WarmupDuration = FMath::Max(WarmupDuration, 0.f);
+	MeasureDuration = FMath::Max(MeasureDuration, 1.f);
+
+	FString BotDefinitionPath;
+	if (FParse::Value(CommandLine, TEXT("SoakBotDefinition="), BotDefinitionPath))
+	{
+		BotDefinition = Cast<UBotaniBotDefinition>(FSoftObjectPath(BotDefinitionPath).TryLoad());
+		if (BotDefinition == nullptr)
+		{
+			UE_LOG(LogBotani, Error, TEXT("Soak test: failed to load bot definition %s, spawning bots without modifiers"), *BotDefinitionPath);
+		}
+	}
+
+	BotControllerClass = ABotaniBotController::StaticClass();
+
+	FString BotControllerPath;
+	if (FParse::Value(CommandLine, TEXT("SoakBotController="), BotControllerPath))
+	{
+		if (UClass* LoadedClass = FSoftClassPath(BotControllerPath).TryLoadClass<AAIController>())
+		{
+			BotControllerClass = LoadedClass;
+		}
+		else
+		{
+			UE_LOG(LogBotani, Error, TEXT("Soak test: failed to load bot controller class %s, using %s"), *BotControllerPath, *GetNameSafe(BotControllerClass));
+		}
+	}
+
+	OutputDirectory = FPaths::ProfilingDir() / TEXT("Soak") / FDateTime::Now().ToString();
+
+	UE_LOG(LogBotani, Display, TEXT("Soak test: %d bots, %.0fs warmup, %.0fs measurement, output to %s"), NumBotsToSpawn, WarmupDuration, MeasureDuration, *OutputDirectory);
+}
+
+void UBotaniSoakTestSubsystem::Deinitialize()
+{
+	UnregisterTickGroupMarkers();
+
+	Super::Deinitialize();
+}
+
+void UBotaniSoakTestSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	UAsyncAction_WaitExperienceReady* WaitForExperience = UAsyncAction_WaitExperienceReady::WaitForExperienceReady(&InWorld);
+	WaitForExperience->OnReady.AddDynamic(this, &ThisClass::HandleExperienceReady);
+	WaitForExperience->Activate();
+}
+
+void UBotaniSoakTestSubsystem::HandleExperienceReady()
+{
+	if (SoakState != ESoakState::WaitingForExperience)
+	{
+		return;
+	}
+
+	SpawnBots();
+
+	SoakState = ESoakState::WarmingUp;
+	StateStartTime = FPlatformTime::Seconds();
+}
+
+void UBotaniSoakTestSubsystem::SpawnBots()
+{
+	UWorld* World = GetWorld();
+	ABotaniGameModeBase* GameMode = World->GetAuthGameMode<ABotaniGameModeBase>();
+	if (GameMode == nullptr)
+	{
+		UE_LOG(LogBotani, Error, TEXT("Soak test: no Botani game mode in %s, can't spawn bots"), *GetNameSafe(World));
+		return;
+	}
+
+	FActorSpawnParameters SpawnInfo;
+	SpawnInfo.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	SpawnInfo.OverrideLevel = World->PersistentLevel;
+	SpawnInfo.ObjectFlags |= RF_Transient;
+
+	for (int32 BotIndex = 0; BotIndex < NumBotsToSpawn; ++BotIndex)
+	{
+		AAIController* NewBot = World->SpawnActor<AAIController>(BotControllerClass, SpawnInfo);
+		if (NewBot == nullptr)
+		{
+			continue;
+		}
+
+		GameMode->GenericPlayerInitialization(NewBot);
+		GameMode->RestartPlayer(NewBot);
+
+		if (NewBot->PlayerState != nullptr)
+		{
+			NewBot->PlayerState->SetPlayerName(FString::Printf(TEXT("SoakBot %d"), BotIndex));
+		}
+
+		if (BotDefinition != nullptr)
+		{
+			BotDefinition->ApplyToCharacter(Cast<ACharacter>(NewBot->GetPawn()));
+		}
+
+		SpawnedBots.Add(NewBot);
+	}
+
+	UE_LOG(LogBotani, Display, TEXT("Soak test: spawned %d of %d bots"), SpawnedBots.Num(), NumBotsToSpawn);
+}
+
+void UBotaniSoakTestSubsystem::StartMeasuring()
+{
+	SoakState = ESoakState::Measuring;
+	StateStartTime = FPlatformTime::Seconds();
+
+	const int32 ExpectedFrames = FMath::CeilToInt(MeasureDuration * 120.f);
+	FrameTimesMs.Reset(ExpectedFrames);
+	WorkTimesMs.Reset(ExpectedFrames);
+	TotalTickGroupMs.Init(0.0, BotaniSoakTest::NumMeasuredTickGroups);
+	Samples.Reset(FMath::CeilToInt(MeasureDuration) + 1);
+
+	CurrentSample = FSoakSample();
+	CurrentSample.TickGroupSumMs.Init(0.0, BotaniSoakTest::NumMeasuredTickGroups);
+
+	StartUsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+	PeakUsedPhysical = StartUsedPhysical;
+
+	RegisterTickGroupMarkers();
+
+#if CSV_PROFILER
+	if (FCsvProfiler* CsvProfiler = FCsvProfiler::Get())
+	{
+		CsvProfiler->BeginCapture(-1, OutputDirectory, TEXT("CsvProfile.csv"));
+	}
+#endif
+
+	UE_LOG(LogBotani, Display, TEXT("Soak test: warmup done, measuring for %.0f seconds"), MeasureDuration);
+}
+
+void UBotaniSoakTestSubsystem::FinishSoakTest()
+{
+	SoakState = ESoakState::Finished;
+
+	UnregisterTickGroupMarkers();
+
+#if CSV_PROFILER
+	if (FCsvProfiler* CsvProfiler = FCsvProfiler::Get())
+	{
+		CsvProfiler->EndCapture();
+	}
+#endif
+
+	if (CurrentSample.NumFrames > 0)
+	{
+		FlushSample();
+	}
+
+	const TArray<FString> Failures = CheckPassCriteria();
+	WriteResults(Failures);
+
+	for (const FString& Failure : Failures)
+	{
+		UE_LOG(LogBotani, Error, TEXT("Soak test: %s"), *Failure);
+	}
+
+	UE_LOG(LogBotani, Display, TEXT("Soak test: %s"), Failures.IsEmpty() ? TEXT("passed") : TEXT("failed"));
+
+	if (bExitWhenFinished)
+	{
+		// Automation picks the result up from the exit code
+		FPlatformMisc::RequestExitWithStatus(false, Failures.IsEmpty() ? 0 : 1);
+	}
+}
+
+void UBotaniSoakTestSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const double Now = FPlatformTime::Seconds();
+	const double TimeInState = Now - StateStartTime;
+
+	if (SoakState == ESoakState::WarmingUp)
+	{
+		if (TimeInState >= WarmupDuration)
+		{
+			StartMeasuring();
+		}
+
+		return;
+	}
+
+	if (SoakState != ESoakState::Measuring)
+	{
+		return;
+	}
+
+	// Frame time includes the idle time of a fixed tick rate server, work time is what was actually spent
+	const float FrameTimeMs = DeltaTime * 1000.f;
+	const float WorkTimeMs = FMath::Max(0.f, static_cast<float>((FApp::GetDeltaTime() - FApp::GetIdleTime()) * 1000.0));
+
+	FrameTimesMs.Add(FrameTimeMs);
+	WorkTimesMs.Add(WorkTimeMs);
+
+	++CurrentSample.NumFrames;
+	CurrentSample.FrameTimeSumMs += FrameTimeMs;
+	CurrentSample.FrameTimeMaxMs = FMath::Max<double>(CurrentSample.FrameTimeMaxMs, FrameTimeMs);
+	CurrentSample.WorkTimeSumMs += WorkTimeMs;
+
+	if (TimeInState >= Samples.Num() + 1)
+	{
+		FlushSample();
+	}
+
+	if (TimeInState >= MeasureDuration)
+	{
+		FinishSoakTest();
+	}
+}
+
+bool UBotaniSoakTestSubsystem::IsTickable() const
+{
+	return SoakState == ESoakState::WarmingUp || SoakState == ESoakState::Measuring;
+}
+
+TStatId UBotaniSoakTestSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UBotaniSoakTestSubsystem, STATGROUP_Tickables);
+}
+
+void UBotaniSoakTestSubsystem::MarkTickGroupStart(int32 MarkerIndex)
+{
+	if (TickGroupStartTimes.IsValidIndex(MarkerIndex))
+	{
+		TickGroupStartTimes[MarkerIndex] = FPlatformTime::Seconds();
+	}
+}
+
+void UBotaniSoakTestSubsystem::RegisterTickGroupMarkers()
+{
+	UWorld* World = GetWorld();
+	check(World);
+
+	TickGroupStartTimes.Init(0.0, BotaniSoakTest::NumMeasuredTickGroups);
+
+	for (int32 MarkerIndex = 0; MarkerIndex < BotaniSoakTest::NumMeasuredTickGroups; ++MarkerIndex)
+	{
+		TUniquePtr<FBotaniSoakTickGroupMarker>& Marker = TickGroupMarkers.Add_GetRef(MakeUnique<FBotaniSoakTickGroupMarker>());
+		Marker->Owner = this;
+		Marker->MarkerIndex = MarkerIndex;
+		Marker->bCanEverTick = true;
+		Marker->bHighPriority = true;
+		Marker->bTickEvenWhenPaused = true;
+		Marker->TickGroup = BotaniSoakTest::MeasuredTickGroups[MarkerIndex];
+		Marker->EndTickGroup = Marker->TickGroup;
+		Marker->RegisterTickFunction(World->PersistentLevel);
+	}
+
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &ThisClass::OnWorldPostActorTick);
+}
+
+void UBotaniSoakTestSubsystem::UnregisterTickGroupMarkers()
+{
+	for (TUniquePtr<FBotaniSoakTickGroupMarker>& Marker : TickGroupMarkers)
+	{
+		Marker->UnRegisterTickFunction();
+	}
+
+	TickGroupMarkers.Reset();
+
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+	PostActorTickHandle.Reset();
+}
+
+void UBotaniSoakTestSubsystem::OnWorldPostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds)
+{
+	if (InWorld != GetWorld() || SoakState != ESoakState::Measuring)
+	{
+		return;
+	}
+
+	// A group's cost is the time until the next group started, the last one ends with the actor tick
+	const double EndTime = FPlatformTime::Seconds();
+	for (int32 GroupIndex = 0; GroupIndex < BotaniSoakTest::NumMeasuredTickGroups; ++GroupIndex)
+	{
+		const double GroupStart = TickGroupStartTimes[GroupIndex];
+		const double GroupEnd = (GroupIndex + 1 < BotaniSoakTest::NumMeasuredTickGroups) ? TickGroupStartTimes[GroupIndex + 1] : EndTime;
+		if (GroupStart <= 0.0 || GroupEnd < GroupStart)
+		{
+			continue;
+		}
+
+		const double GroupMs = (GroupEnd - GroupStart) * 1000.0;
+		CurrentSample.TickGroupSumMs[GroupIndex] += GroupMs;
+		TotalTickGroupMs[GroupIndex] += GroupMs;
+	}
+
+	TickGroupStartTimes.Init(0.0, BotaniSoakTest::NumMeasuredTickGroups);
+}
+
+void UBotaniSoakTestSubsystem::FlushSample()
+{
+	CurrentSample.Time = FPlatformTime::Seconds() - StateStartTime;
+	CurrentSample.UsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+	CurrentSample.NumBots = SpawnedBots.Num();
+
+	if (const UNetDriver* NetDriver = GetWorld()->GetNetDriver())
+	{
+		CurrentSample.NetInBytesPerSecond = NetDriver->InBytesPerSecond;
+		CurrentSample.NetOutBytesPerSecond = NetDriver->OutBytesPerSecond;
+	}
+
+	PeakUsedPhysical = FMath::Max(PeakUsedPhysical, CurrentSample.UsedPhysical);
+	TotalNetInBytes += CurrentSample.NetInBytesPerSecond;
+	TotalNetOutBytes += CurrentSample.NetOutBytesPerSecond;
+
+	Samples.Add(MoveTemp(CurrentSample));
+
+	CurrentSample = FSoakSample();
+	CurrentSample.TickGroupSumMs.Init(0.0, BotaniSoakTest::NumMeasuredTickGroups);
+}
+
+TArray<FString> UBotaniSoakTestSubsystem::CheckPassCriteria() const
+{
+	constexpr double BytesToMB = 1.0 / (1024.0 * 1024.0);
+
+	TArray<FString> Failures;
+
+	if (SpawnedBots.Num() < NumBotsToSpawn)
+	{
+		Failures.Add(FString::Printf(TEXT("only %d of %d bots were spawned"), SpawnedBots.Num(), NumBotsToSpawn));
+	}
+
+	if (FrameTimesMs.IsEmpty())
+	{
+		Failures.Add(TEXT("no frames were measured"));
+		return Failures;
+	}
+
+	TArray<float> SortedFrameTimes = FrameTimesMs;
+	TArray<float> SortedWorkTimes = WorkTimesMs;
+	SortedFrameTimes.Sort();
+	SortedWorkTimes.Sort();
+
+	const float WorkTimeP95Ms = BotaniSoakTest::GetPercentile(SortedWorkTimes, 0.95f);
+	if (MaxWorkTimeP95Ms > 0.f && WorkTimeP95Ms > MaxWorkTimeP95Ms)
+	{
+		Failures.Add(FString::Printf(TEXT("95th percentile work time %.3f ms exceeds %.3f ms"), WorkTimeP95Ms, MaxWorkTimeP95Ms));
+	}
+
+	const float FrameTimeP99Ms = BotaniSoakTest::GetPercentile(SortedFrameTimes, 0.99f);
+	if (MaxFrameTimeP99Ms > 0.f && FrameTimeP99Ms > MaxFrameTimeP99Ms)
+	{
+		Failures.Add(FString::Printf(TEXT("99th percentile frame time %.3f ms exceeds %.3f ms"), FrameTimeP99Ms, MaxFrameTimeP99Ms));
+	}
+
+	const uint64 EndUsedPhysical = Samples.Num() > 0 ? Samples.Last().UsedPhysical : StartUsedPhysical;
+	const double MemoryGrowthMB = (static_cast<double>(EndUsedPhysical) - static_cast<double>(StartUsedPhysical)) * BytesToMB;
+	if (MaxMemoryGrowthMB > 0.f && MemoryGrowthMB > MaxMemoryGrowthMB)
+	{
+		Failures.Add(FString::Printf(TEXT("used physical memory grew by %.1f MB, more than %.1f MB"), MemoryGrowthMB, MaxMemoryGrowthMB));
+	}
+
+	return Failures;
+}
+
+void UBotaniSoakTestSubsystem::WriteResults(const TArray<FString>& Failures) const
+{
+	constexpr double BytesToMB = 1.0 / (1024.0 * 1024.0);
+
+	// Per second samples
+	{
+		FString Csv = TEXT("TimeSeconds,Frames,FrameTimeAvgMs,FrameTimeMaxMs,WorkTimeAvgMs");
+		for (const TCHAR* GroupName : BotaniSoakTest::MeasuredTickGroupNames)
+		{
+			Csv += FString::Printf(TEXT(",%sAvgMs"), GroupName);
+		}
+		Csv += TEXT(",NetInKBps,NetOutKBps,UsedPhysicalMB,Bots\n");
+
+		for (const FSoakSample& Sample : Samples)
+		{
+			const double Frames = FMath::Max(Sample.NumFrames, 1);
+			Csv += FString::Printf(TEXT("%.2f,%d,%.3f,%.3f,%.3f"), Sample.Time, Sample.NumFrames, Sample.FrameTimeSumMs / Frames, Sample.FrameTimeMaxMs, Sample.WorkTimeSumMs / Frames);
+			for (const double GroupSumMs : Sample.TickGroupSumMs)
+			{
+				Csv += FString::Printf(TEXT(",%.3f"), GroupSumMs / Frames);
+			}
+			Csv += FString::Printf(TEXT(",%.2f,%.2f,%.1f,%d\n"), Sample.NetInBytesPerSecond / 1024.0, Sample.NetOutBytesPerSecond / 1024.0, Sample.UsedPhysical * BytesToMB, Sample.NumBots);
+		}
+
+		FFileHelper::SaveStringToFile(Csv, *(OutputDirectory / TEXT("Samples.csv")));
+	}
+
+	// Summary
+	{
+		TArray<float> SortedFrameTimes = FrameTimesMs;
+		TArray<float> SortedWorkTimes = WorkTimesMs;
+		SortedFrameTimes.Sort();
+		SortedWorkTimes.Sort();
+
+		const double NumFrames = FMath::Max(FrameTimesMs.Num(), 1);
+		const double NumSeconds = FMath::Max(Samples.Num(), 1);
+
+		FString Csv = TEXT("Metric,Value\n");
+		Csv += FString::Printf(TEXT("Bots,%d\n"), SpawnedBots.Num());
+		Csv += FString::Printf(TEXT("Frames,%d\n"), FrameTimesMs.Num());
+
+		for (const float Percentile : { 0.5f, 0.9f, 0.95f, 0.99f, 1.f })
+		{
+			const int32 PercentileLabel = FMath::RoundToInt(Percentile * 100.f);
+			Csv += FString::Printf(TEXT("FrameTimeP%dMs,%.3f\n"), PercentileLabel, BotaniSoakTest::GetPercentile(SortedFrameTimes, Percentile));
+			Csv += FString::Printf(TEXT("WorkTimeP%dMs,%.3f\n"), PercentileLabel, BotaniSoakTest::GetPercentile(SortedWorkTimes, Percentile));
+		}
+
+		for (int32 GroupIndex = 0; GroupIndex < BotaniSoakTest::NumMeasuredTickGroups; ++GroupIndex)
+		{
+			Csv += FString::Printf(TEXT("TickGroup%sAvgMs,%.3f\n"), BotaniSoakTest::MeasuredTickGroupNames[GroupIndex], TotalTickGroupMs[GroupIndex] / NumFrames);
+		}
+
+		Csv += FString::Printf(TEXT("NetInAvgKBps,%.2f\n"), TotalNetInBytes / 1024.0 / NumSeconds);
+		Csv += FString::Printf(TEXT("NetOutAvgKBps,%.2f\n"), TotalNetOutBytes / 1024.0 / NumSeconds);
+		Csv += FString::Printf(TEXT("UsedPhysicalStartMB,%.1f\n"), StartUsedPhysical * BytesToMB);
+		Csv += FString::Printf(TEXT("UsedPhysicalPeakMB,%.1f\n"), PeakUsedPhysical * BytesToMB);
+		Csv += FString::Printf(TEXT("UsedPhysicalEndMB,%.1f\n"), Samples.Num() > 0 ? Samples.Last().UsedPhysical * BytesToMB : 0.0);
+		Csv += FString::Printf(TEXT("Result,%s\n"), Failures.IsEmpty() ? TEXT("Passed") : TEXT("Failed"));
+
+		FFileHelper::SaveStringToFile(Csv, *(OutputDirectory / TEXT("Summary.csv")));
+	}
+
+	UE_LOG(LogBotani, Display, TEXT("Soak test: wrote %d samples to %s"), Samples.Num(), *OutputDirectory);
+}
@@ -6,6 +6,8 @@
 #include "Engine/DataAsset.h"
 #include "BotaniBotDefinition.generated.h"
 
+class ACharacter;
+
 /**
  * @class UBotaniBotDefinition
  *
@@ -18,6 +20,9 @@ class UBotaniBotDefinition : public UPrimaryDataAsset
 	GENERATED_UCLASS_BODY()
 
 public:
+	/** Applies all modifiers of this definition to the given character. */
+	BOTANIAI_API void ApplyToCharacter(ACharacter* Character) const;
+
 	/** Determines whether this bot should override the default pawn data. */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Bot Data")
 	uint32 bOverrideDefaultPawnData : 1;
@@ -19,7 +19,7 @@ class BOTANIAI_API UBotaniCharacterModifier : public UObject
 
 public:
 	/** Called when the character has been spawned and the modifier should be applied to it. */
-	virtual void ApplyToCharacter(ACharacter* Character) const PURE_VIRTUAL(UBotaniCharacterModifier::ApplyToCharacter, );
+	virtual void ApplyToCharacter(ACharacter* Character) const {}
 	
 protected:
 #if WITH_EDITORONLY_DATA
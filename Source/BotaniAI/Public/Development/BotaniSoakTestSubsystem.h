@@ -0,0 +1,155 @@
+// Copyright © 2024 Botanibots Team. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "BotaniSoakTestSubsystem.generated.h"
+
+class AAIController;
+class UBotaniBotDefinition;
+class UBotaniSoakTestSubsystem;
+
+/** Marker tick function that records when its tick group starts, used to approximate per tick group costs */
+struct FBotaniSoakTickGroupMarker : public FTickFunction
+{
+	UBotaniSoakTestSubsystem* Owner = nullptr;
+	int32 MarkerIndex = INDEX_NONE;
+
+	//~ Begin FTickFunction Interface
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+	//~ End FTickFunction Interface
+};
+
+/**
+ * UBotaniSoakTestSubsystem
+ *
+ * Headless bot soak test, used as a regression baseline for server performance.
+ * Only created when the server is started with -BotaniSoak, e.g.:
+ *
+ *	BotanibotsServer.exe /Game/Maps/L_Arena -Experience=B_Experience_Arena -nullrhi -BotaniSoak
+ *		-SoakBots=32 -SoakDuration=600 -SoakWarmup=15 -SoakBotDefinition=/Game/Bots/BD_Default.BD_Default
+ *
+ * Once the experience is loaded, the bots are spawned through the regular bot controller restart path,
+ * then the game runs for the warmup and measurement time. Per second samples and a summary with frame time
+ * percentiles, tick group costs, net bandwidth and memory are written to Saved/Profiling/Soak.
+ * A CSV profiler capture is taken alongside when available.
+ *
+ * The run fails if not every bot spawned or a threshold is exceeded, 0 disables a threshold:
+ *	-SoakMaxWorkTimeP95=33.3	95th percentile of the server work time per frame, in milliseconds
+ *	-SoakMaxFrameTimeP99=100	99th percentile of the frame time, in milliseconds
+ *	-SoakMaxMemoryGrowth=256	Used physical memory at the end over the start of the measurement, in MB
+ * The process exits afterwards with exit code 0 if the run passed and 1 if it failed, unless -SoakNoExit is set.
+ */
+UCLASS()
+class UBotaniSoakTestSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UBotaniSoakTestSubsystem();
+
+	//~ Begin UWorldSubsystem Interface
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	//~ End UWorldSubsystem Interface
+
+	//~ Begin FTickableGameObject Interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface
+
+	/** Called by the tick group markers */
+	void MarkTickGroupStart(int32 MarkerIndex);
+
+private:
+	enum class ESoakState : uint8
+	{
+		WaitingForExperience,
+		WarmingUp,
+		Measuring,
+		Finished
+	};
+
+	/** A single row of the per second samples */
+	struct FSoakSample
+	{
+		double Time = 0.0;
+		int32 NumFrames = 0;
+		double FrameTimeSumMs = 0.0;
+		double FrameTimeMaxMs = 0.0;
+		double WorkTimeSumMs = 0.0;
+		TArray<double> TickGroupSumMs;
+		uint32 NetInBytesPerSecond = 0;
+		uint32 NetOutBytesPerSecond = 0;
+		uint64 UsedPhysical = 0;
+		int32 NumBots = 0;
+	};
+
+	UFUNCTION()
+	void HandleExperienceReady();
+
+	void SpawnBots();
+	void StartMeasuring();
+	void FinishSoakTest();
+
+	void RegisterTickGroupMarkers();
+	void UnregisterTickGroupMarkers();
+	void OnWorldPostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds);
+
+	/** Closes the current per second sample and starts the next one */
+	void FlushSample();
+
+	/** Returns a description of every failed pass criterion, empty if the run passed */
+	TArray<FString> CheckPassCriteria() const;
+	void WriteResults(const TArray<FString>& Failures) const;
+
+private:
+	/** Settings, parsed from the command line */
+	int32 NumBotsToSpawn = 16;
+	float WarmupDuration = 10.f;
+	float MeasureDuration = 300.f;
+	bool bExitWhenFinished = true;
+
+	/** Pass criteria, parsed from the command line, 0 disables them */
+	float MaxWorkTimeP95Ms = 33.3f;
+	float MaxFrameTimeP99Ms = 100.f;
+	float MaxMemoryGrowthMB = 256.f;
+
+	UPROPERTY(Transient)
+	TObjectPtr<const UBotaniBotDefinition> BotDefinition;
+
+	UPROPERTY(Transient)
+	TSubclassOf<AAIController> BotControllerClass;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<AAIController>> SpawnedBots;
+
+	ESoakState SoakState = ESoakState::WaitingForExperience;
+	double StateStartTime = 0.0;
+	FString OutputDirectory;
+
+	/** Tick group markers, in tick group order */
+	TArray<TUniquePtr<FBotaniSoakTickGroupMarker>> TickGroupMarkers;
+	TArray<double> TickGroupStartTimes;
+	FDelegateHandle PostActorTickHandle;
+
+	/** Every measured frame, in milliseconds */
+	TArray<float> FrameTimesMs;
+	TArray<float> WorkTimesMs;
+
+	/** Accumulated tick group time over the whole measurement, in milliseconds */
+	TArray<double> TotalTickGroupMs;
+
+	TArray<FSoakSample> Samples;
+	FSoakSample CurrentSample;
+	uint64 StartUsedPhysical = 0;
+	uint64 PeakUsedPhysical = 0;
+	uint64 TotalNetInBytes = 0;
+	uint64 TotalNetOutBytes = 0;
+};
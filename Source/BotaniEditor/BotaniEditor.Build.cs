@@ -23,6 +23,7 @@ public class BotaniEditor : ModuleRules
             {
                 "CoreUObject",
                 "Engine",
+                "ImageCore",
                 "Slate",
                 "SlateCore",
                 "UMGEditor",
@@ -0,0 +1,159 @@
+// Copyright © 2024 Botanibots Team. All rights reserved.
+
+#include "BotaniItemIconCommandlet.h"
+
+#include "ImageCore.h"
+#include "ImageUtils.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Inventory/Data/BotaniRarityStyleAsset.h"
+#include "Inventory/Definitions/BotaniInventoryItemDefinition.h"
+#include "Misc/FileHelper.h"
+#include "ThumbnailRenderer/BotaniItemThumbnailRenderer.h"
+#include "UObject/GCObjectScopeGuard.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(BotaniItemIconCommandlet)
+
+DEFINE_LOG_CATEGORY_STATIC(LogBotaniItemIcon, Log, All);
+
+UBotaniItemIconCommandlet::UBotaniItemIconCommandlet(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UBotaniItemIconCommandlet::Main(const FString& Params)
+{
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamVals;
+	ParseCommandLine(*Params, Tokens, Switches, ParamVals);
+
+	const int32 Size = ParamVals.Contains(TEXT("Size")) ? FCString::Atoi(*ParamVals[TEXT("Size")]) : 128;
+	const int32 Columns = ParamVals.Contains(TEXT("Columns")) ? FCString::Atoi(*ParamVals[TEXT("Columns")]) : 16;
+	const FString OutputDir = ParamVals.Contains(TEXT("OutputDir")) ? ParamVals[TEXT("OutputDir")] : FPaths::ProjectSavedDir() / TEXT("ItemIcons");
+	const bool bRenderBackground = !Switches.Contains(TEXT("NoBackground"));
+
+	if (Size <= 0 || Columns <= 0)
+	{
+		UE_LOG(LogBotaniItemIcon, Error, TEXT("Size and Columns must be greater than zero."));
+		return 1;
+	}
+
+	TArray<FString> Paths;
+	if (ParamVals.Contains(TEXT("Paths")))
+	{
+		ParamVals[TEXT("Paths")].ParseIntoArray(Paths, TEXT("+"));
+	}
+	else
+	{
+		Paths.Add(TEXT("/Game"));
+	}
+
+	FARFilter Filter;
+	Filter.ClassPaths.Add(UBotaniInventoryItemDefinition::StaticClass()->GetClassPathName());
+	Filter.bRecursiveClasses = true;
+	Filter.bRecursivePaths = true;
+	for (const FString& Path : Paths)
+	{
+		Filter.PackagePaths.Add(*Path);
+	}
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssets(Filter, Assets);
+	Assets.Sort([](const FAssetData& A, const FAssetData& B)
+	{
+		return A.PackageName.LexicalLess(B.PackageName);
+	});
+
+	if (Assets.IsEmpty())
+	{
+		UE_LOG(LogBotaniItemIcon, Warning, TEXT("No items found."));
+		return 0;
+	}
+
+	// Kept alive across the garbage collections between items
+	const UBotaniRarityStyleAsset* StyleAsset = UBotaniItemThumbnailRenderer::LoadRarityStyleAsset();
+	FGCObjectScopeGuard StyleAssetGuard(StyleAsset);
+	if (StyleAsset == nullptr)
+	{
+		UE_LOG(LogBotaniItemIcon, Warning, TEXT("No rarity style asset set in the game data, icons are baked without rarity background."));
+	}
+
+	const int32 MaxRows = FMath::DivideAndRoundUp(Assets.Num(), Columns);
+	FImage Sheet(Columns * Size, MaxRows * Size, ERawImageFormat::BGRA8, EGammaSpace::sRGB);
+	FMemory::Memzero(Sheet.RawData.GetData(), Sheet.RawData.Num());
+	TArrayView64<FColor> SheetPixels = Sheet.AsBGRA8();
+
+	TArray<FString> IndexLines;
+	IndexLines.Add(TEXT("Item,Column,Row"));
+
+	const double StartTime = FPlatformTime::Seconds();
+	int32 NumBaked = 0;
+
+	for (int32 AssetIdx = 0; AssetIdx < Assets.Num(); AssetIdx++)
+	{
+		const FAssetData& AssetData = Assets[AssetIdx];
+		const UBotaniInventoryItemDefinition* Item = Cast<UBotaniInventoryItemDefinition>(AssetData.GetAsset());
+
+		FImage Icon;
+		if (!UBotaniItemThumbnailRenderer::CompositeItemThumbnail(Item, StyleAsset, Size, Size, bRenderBackground, Icon))
+		{
+			UE_LOG(LogBotaniItemIcon, Display, TEXT("Skipped %s, it has no thumbnail image with source data."), *AssetData.GetObjectPathString());
+			continue;
+		}
+
+		const FString IconFilename = OutputDir / TEXT("Items") / AssetData.AssetName.ToString() + TEXT(".png");
+		if (!FImageUtils::SaveImageByExtension(*IconFilename, Icon))
+		{
+			UE_LOG(LogBotaniItemIcon, Error, TEXT("Failed to write %s."), *IconFilename);
+			return 1;
+		}
+
+		const int32 Column = NumBaked % Columns;
+		const int32 Row = NumBaked / Columns;
+		const TArrayView64<FColor> IconPixels = Icon.AsBGRA8();
+
+		for (int32 PixelY = 0; PixelY < Size; PixelY++)
+		{
+			const int64 SheetOffset = (static_cast<int64>(Row) * Size + PixelY) * Sheet.SizeX + static_cast<int64>(Column) * Size;
+			FMemory::Memcpy(&SheetPixels[SheetOffset], &IconPixels[static_cast<int64>(PixelY) * Size], Size * sizeof(FColor));
+		}
+
+		IndexLines.Add(FString::Printf(TEXT("%s,%d,%d"), *AssetData.GetObjectPathString(), Column, Row));
+		NumBaked++;
+
+		// Items are only needed until they are baked
+		if ((AssetIdx + 1) % 64 == 0)
+		{
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		}
+	}
+
+	if (NumBaked == 0)
+	{
+		UE_LOG(LogBotaniItemIcon, Warning, TEXT("None of the %d items has a thumbnail image."), Assets.Num());
+		return 0;
+	}
+
+	// Drop the rows of the items that were skipped, rows are stored contiguously
+	Sheet.SizeY = FMath::DivideAndRoundUp(NumBaked, Columns) * Size;
+	Sheet.RawData.SetNum(Sheet.GetImageSizeBytes());
+
+	const FString SheetFilename = OutputDir / TEXT("ItemIconSheet.png");
+	const FString IndexFilename = OutputDir / TEXT("ItemIconSheet.csv");
+	if (!FImageUtils::SaveImageByExtension(*SheetFilename, Sheet) || !FFileHelper::SaveStringArrayToFile(IndexLines, *IndexFilename))
+	{
+		UE_LOG(LogBotaniItemIcon, Error, TEXT("Failed to write the icon sheet to %s."), *OutputDir);
+		return 1;
+	}
+
+	UE_LOG(LogBotaniItemIcon, Display, TEXT("Baked %d of %d item icons to %s in %.2f s."), NumBaked, Assets.Num(), *OutputDir, FPlatformTime::Seconds() - StartTime);
+
+	return 0;
+}
@@ -0,0 +1,26 @@
+// Copyright © 2024 Botanibots Team. All rights reserved.
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "BotaniItemIconCommandlet.generated.h"
+
+/**
+ * UBotaniItemIconCommandlet
+ *
+ * Bakes the item thumbnails composited over their rarity background, like the content browser shows them,
+ * into one image per item and an icon sheet with an index of where each item is placed.
+ * Only the texture source data is used, so it runs on build machines with -nullrhi.
+ *
+ * Usage: -run=BotaniItemIcon [-Paths=/Game] [-OutputDir=<Saved>/ItemIcons] [-Size=128] [-Columns=16] [-NoBackground]
+ */
+UCLASS()
+class UBotaniItemIconCommandlet : public UCommandlet
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+	//~ Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet Interface
+};
@@ -5,22 +5,78 @@
 
 #include "CanvasItem.h"
 #include "CanvasTypes.h"
-#include "CubemapUnwrapUtils.h"
-#include "ImageUtils.h"
+#include "ImageCore.h"
 #include "ObjectTools.h"
-#include "Texture2DPreview.h"
-#include "Engine/Texture2DArray.h"
-#include "Engine/TextureCube.h"
-#include "Engine/TextureCubeArray.h"
-#include "Engine/TextureRenderTargetCube.h"
+#include "Engine/Texture2D.h"
+#include "GameFeatures/Data/BotaniGameData.h"
 #include "Inventory/Data/BotaniRarityStyleAsset.h"
-#include "Kismet/KismetRenderingLibrary.h"
 #include "Settings/BotaniEditorSettings.h"
 #include "Slate/SlateBrushAsset.h"
 #include "Subsystems/UnrealEditorSubsystem.h"
 #include "System/BotaniAssetManager.h"
 #include "ThumbnailRendering/ThumbnailManager.h"
 
+namespace BotaniItemThumbnail
+{
+	/** Composites are dropped all at once beyond this count, which only happens for very large folders */
+	constexpr int32 MaxCachedThumbnails = 512;
+
+	/** Number of checker squares per side drawn under translucent icons without a rarity background */
+	constexpr int32 CheckerDensity = 8;
+
+	static bool UsesTranslucentBlend(const UTexture2D* Texture)
+	{
+		// Non-UI textures often have uncorrelated data in the alpha channel, so only UI textures are blended
+		return (Texture->LODGroup == TEXTUREGROUP_UI) || (Texture->LODGroup == TEXTUREGROUP_Pixels2D);
+	}
+
+	static bool GetSourceImage(UTexture2D* Texture, int32 Width, int32 Height, FImage& OutImage)
+	{
+		if (Texture == nullptr || !Texture->Source.IsValid())
+		{
+			return false;
+		}
+
+		FImage SourceImage;
+		if (!Texture->Source.GetMipImage(SourceImage, 0, 0, 0))
+		{
+			return false;
+		}
+
+		SourceImage.ResizeTo(OutImage, Width, Height, ERawImageFormat::BGRA8, EGammaSpace::sRGB);
+		return true;
+	}
+}
+
+void UBotaniItemThumbnailRenderer::PostInitProperties()
+{
+	Super::PostInitProperties();
+
+	if (!HasAnyFlags(RF_ClassDefaultObject))
+	{
+		ObjectPropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddUObject(this, &ThisClass::HandleObjectPropertyChanged);
+	}
+}
+
+void UBotaniItemThumbnailRenderer::BeginDestroy()
+{
+	FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(ObjectPropertyChangedHandle);
+	CachedThumbnails.Empty();
+
+	Super::BeginDestroy();
+}
+
+void UBotaniItemThumbnailRenderer::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
+{
+	Super::AddReferencedObjects(InThis, Collector);
+
+	UBotaniItemThumbnailRenderer* This = CastChecked<UBotaniItemThumbnailRenderer>(InThis);
+	for (TPair<FObjectKey, FCachedItemThumbnail>& Pair : This->CachedThumbnails)
+	{
+		Collector.AddReferencedObject(Pair.Value.Texture);
+	}
+}
+
 bool UBotaniItemThumbnailRenderer::CanVisualizeAsset(UObject* Object)
 {
 	const bool bCanDraw = (GetThumbnailTextureFromObject(Object) != nullptr);
@@ -47,201 +103,207 @@ void UBotaniItemThumbnailRenderer::Draw(UObject* Object, int32 X, int32 Y, uint3
 		return;
 	}
 
-	
-	UBotaniAssetManager& AssetManager = UBotaniAssetManager::Get();
-	const UBotaniGameData& GameData = AssetManager.GetGameData();
-	const UBotaniRarityStyleAsset* StyleAsset = GameData.BotaniRarityData.LoadSynchronous();
-	checkf(StyleAsset, TEXT("Failed to load Botani Rarity Style Asset"));
-
 	const UBotaniInventoryItemDefinition* Item = Cast<UBotaniInventoryItemDefinition>(Object);
 	checkf(Item, TEXT("Failed to cast Object (%s) to UBotaniInventoryItemDefinition"), *Object->GetFullName());
-	
-	const FBotaniRarityStyleInfo& StyleInfo = StyleAsset->GetRarityStyle(Item->Rarity);
-	UTexture2D* RarityTexture = StyleAsset->GetDefaultIcon();
 
-	Object = ThumbnailImage;
+	UTexture2D* CompositeTexture = FindOrCreateCompositeTexture(Item, Width, Height);
+	if (CompositeTexture && CompositeTexture->GetResource())
+	{
+		FCanvasTileItem CanvasTile(FVector2D(X, Y), CompositeTexture->GetResource(), FVector2D(Width, Height), FLinearColor::White);
+		CanvasTile.BlendMode = SE_BLEND_Opaque;
+		CanvasTile.Draw(Canvas);
+		return;
+	}
 
-	
-	UTexture* Texture = Cast<UTexture>(Object);
-	if (Texture != nullptr && Texture->GetResource() != nullptr)
+	// Without source data, e.g. for cooked icons, draw the icon itself
+	if (!ThumbnailImage->GetPackage()->HasAnyPackageFlags(PKG_Cooked | PKG_FilterEditorOnly))
+	{
+		ThumbnailImage->FinishCachePlatformData();
+		ThumbnailImage->UpdateResource();
+	}
+
+	Super::Draw(ThumbnailImage, X, Y, Width, Height, Viewport, Canvas, bAdditionalViewFamily);
+}
+
+bool UBotaniItemThumbnailRenderer::CompositeItemThumbnail(const UBotaniInventoryItemDefinition* Item, const UBotaniRarityStyleAsset* StyleAsset, int32 Width, int32 Height, bool bRenderBackground, FImage& OutImage)
+{
+	UTexture2D* Icon = Item ? Item->DataList.GetThumbnailImage() : nullptr;
+	if (Icon == nullptr || Width <= 0 || Height <= 0)
+	{
+		return false;
+	}
+
+	FImage IconImage;
+	if (!BotaniItemThumbnail::GetSourceImage(Icon, Width, Height, IconImage))
 	{
-		UTexture2D* Texture2D = Cast<UTexture2D>(Texture);
-		UTexture* CpuCopyTexture = nullptr;
-		if (Texture2D)
+		return false;
+	}
+
+	OutImage.Init(Width, Height, ERawImageFormat::BGRA8, EGammaSpace::sRGB);
+	TArrayView64<FColor> OutPixels = OutImage.AsBGRA8();
+	const TArrayView64<FColor> IconPixels = IconImage.AsBGRA8();
+
+	if (!BotaniItemThumbnail::UsesTranslucentBlend(Icon))
+	{
+		for (int64 PixelIdx = 0; PixelIdx < OutPixels.Num(); PixelIdx++)
 		{
-			CpuCopyTexture = Texture2D->GetCPUCopyTexture();
+			OutPixels[PixelIdx] = IconPixels[PixelIdx];
+			OutPixels[PixelIdx].A = 255;
 		}
+		return true;
+	}
 
-		// behavior here should match FTextureEditorViewportClient as much as possible
+	// Background, either the rarity background tinted by the rarity color or a checkerboard
+	bool bHasBackground = false;
+	if (bRenderBackground && StyleAsset)
+	{
+		const FBotaniRarityStyleInfo StyleInfo = StyleAsset->GetRarityStyle(Item->Rarity);
+		const FLinearColor* BackgroundColor = StyleInfo.ColorParameters.Find("BackgroundColor");
+		const FLinearColor* Color = StyleInfo.ColorParameters.Find("Color");
 
-		if (CpuCopyTexture == nullptr)
+		FImage BackgroundImage;
+		if (BackgroundColor && BotaniItemThumbnail::GetSourceImage(StyleAsset->GetDefaultIcon(), Width, Height, BackgroundImage))
 		{
-			// Take the alpha channel into account for textures that have one.
-			// This provides a much better preview than just showing RGB,
-			// Because the RGB content in areas with an alpha of 0 is often garbage that will not be seen in normal conditions.
-			// Non-UI textures often have uncorrelated data in the alpha channel (like a skin mask, specular power, etc) so we only preview UI textures this way.
-			// @todo : this logic depending on LODGroup to decide whether alpha thumbnails should blend is very odd and unexpected for the user.  Consider changing.
-			const bool bUseTranslucentBlend = Texture2D && Texture2D->HasAlphaChannel() && ((Texture2D->LODGroup == TEXTUREGROUP_UI) || (Texture2D->LODGroup == TEXTUREGROUP_Pixels2D));
-
-			UTextureCube* TextureCube = Cast<UTextureCube>(Texture);
-			UTexture2DArray* Texture2DArray = Cast<UTexture2DArray>(Texture);
-			UTextureCubeArray* TextureCubeArray = Cast<UTextureCubeArray>(Texture);
-			UTextureRenderTargetCube* RTTextureCube = Cast<UTextureRenderTargetCube>(Texture);
-			UTextureLightProfile* TextureLightProfile = Cast<UTextureLightProfile>(Texture);
-			const bool bIsVirtualTexture = Texture->IsCurrentlyVirtualTextured();
-
-			TRefCountPtr<FBatchedElementParameters> BatchedElementParameters;
-			// BatchedElementParameters is released by the render thread when it was rendered
-
-			if(TextureCube || TextureCubeArray || RTTextureCube)
-			{
-				// show LongLat Unwrap
-				float MipLevel = -1.f;
-				float SliceIndex = -1.f;
-				bool bShowLongLatUnwrap = true;
-				BatchedElementParameters = new FMipLevelBatchedElementParameters(MipLevel, SliceIndex, TextureCubeArray != nullptr, FMatrix44f::Identity, bShowLongLatUnwrap, false, false);
-			
-				// If the thumbnail is square then make it 2:1 for cubes.
-				if(Width == Height)
-				{
-					Height = Width / 2;
-					Y += Height / 2;
-				}
-			}
-			else if (TextureLightProfile)
+			const FLinearColor Tint = Color ? *Color : *BackgroundColor;
+			const TArrayView64<FColor> BackgroundPixels = BackgroundImage.AsBGRA8();
+
+			for (int64 PixelIdx = 0; PixelIdx < OutPixels.Num(); PixelIdx++)
 			{
-				BatchedElementParameters = new FIESLightProfileBatchedElementParameters(TextureLightProfile->Brightness);
+				OutPixels[PixelIdx] = (FLinearColor(BackgroundPixels[PixelIdx]) * Tint).ToFColor(true);
+				OutPixels[PixelIdx].A = 255;
 			}
-			else if (Texture2D || Texture2DArray)
+
+			bHasBackground = true;
+		}
+	}
+
+	if (!bHasBackground)
+	{
+		for (int32 PixelY = 0; PixelY < Height; PixelY++)
+		{
+			const int32 CheckerY = PixelY * BotaniItemThumbnail::CheckerDensity / Height;
+			for (int32 PixelX = 0; PixelX < Width; PixelX++)
 			{
-				bool bIsNormalMap = Texture->IsNormalMap();
-				bool bIsSingleChannel = Texture->CompressionSettings == TC_Grayscale || Texture->CompressionSettings == TC_Alpha;
-				bool bSingleVTPhysicalSpace = Texture2D && Texture2D->IsVirtualTexturedWithSinglePhysicalSpace();
-				float MipLevel = -1.f;
-				float LayerIndex = 0;
-				float SliceIndex = -1.f;
-				bool bIsTextureArray = (Texture2DArray != nullptr);
-				bool bUsePointSampling = false;
-
-				// if you correctly tell FBatchedElementTexture2DPreviewParameters that the texture is a VT
-				//	then you only get a solid color thumbnail for the initial render
-				//	but if it is refreshes or the VT is examined, the thumbnail will become correct
-				//bool bSampleAsVirtualTexture = bIsVirtualTexture;
-
-				// if you just always lie and say you are not a VT, you get a good thumbnail :
-				bool bSampleAsVirtualTexture = false;
-
-				BatchedElementParameters = new FBatchedElementTexture2DPreviewParameters(MipLevel, LayerIndex, SliceIndex, bIsNormalMap, bIsSingleChannel, bSingleVTPhysicalSpace, bSampleAsVirtualTexture, bIsTextureArray, bUsePointSampling);
+				const int32 CheckerX = PixelX * BotaniItemThumbnail::CheckerDensity / Width;
+				OutPixels[static_cast<int64>(PixelY) * Width + PixelX] = ((CheckerX + CheckerY) & 1) ? FColor(128, 128, 128) : FColor(192, 192, 192);
 			}
-			else
-			{
-				// BatchedElementParameters is not set
-				// default Canvas will be used, which just shows the texture
-				// (what shader does this use??)
+		}
+	}
 
-				// some UTexture types can hit this
-				// UTextureRenderTarget
+	// Blend the icon over the background
+	for (int64 PixelIdx = 0; PixelIdx < OutPixels.Num(); PixelIdx++)
+	{
+		const FColor& Src = IconPixels[PixelIdx];
+		FColor& Dest = OutPixels[PixelIdx];
+
+		const uint32 Alpha = Src.A;
+		const uint32 InvAlpha = 255 - Alpha;
+		Dest.R = static_cast<uint8>((Src.R * Alpha + Dest.R * InvAlpha + 127) / 255);
+		Dest.G = static_cast<uint8>((Src.G * Alpha + Dest.G * InvAlpha + 127) / 255);
+		Dest.B = static_cast<uint8>((Src.B * Alpha + Dest.B * InvAlpha + 127) / 255);
+		Dest.A = 255;
+	}
 
-				// ?? maybe get rid of this and just always use the Texture2D branch above
-			}
+	return true;
+}
 
-			if (bUseTranslucentBlend)
-			{
-				if (StyleInfo.ColorParameters.Contains("BackgroundColor") && UBotaniEditorSettings::Get()->ShouldRenderRarityBackground())
-				{
-					FCanvasTileItem BGTile(FVector2d(X, Y), RarityTexture->GetResource(), FVector2D(Width, Height), *StyleInfo.ColorParameters.Find("Color"));
-					BGTile.Draw(Canvas);
-				}
-				else
-				{
-					// If using alpha, draw a checkerboard underneath first.
-					const int32 CheckerDensity = 8;
-					auto Checker = UThumbnailManager::Get().CheckerboardTexture;
-					Canvas->DrawTile(
-						0.0f, 0.0f, Width, Height,							// Dimensions
-						0.0f, 0.0f, CheckerDensity, CheckerDensity,			// UVs
-						FLinearColor::White, Checker->GetResource());			// Tint & Texture	
-				}
-			}
+const UBotaniRarityStyleAsset* UBotaniItemThumbnailRenderer::LoadRarityStyleAsset()
+{
+	const UBotaniGameData& GameData = UBotaniAssetManager::Get().GetGameData();
+	return GameData.BotaniRarityData.LoadSynchronous();
+}
 
-			// Use A canvas tile item to draw
-			FCanvasTileItem CanvasTile( FVector2D( X, Y ), Texture->GetResource(), FVector2D( Width,Height ), FLinearColor::White );
-			if ( BatchedElementParameters == nullptr )
-			{
-				// old style BatchedElementParameters == null wants you to use "Translucent" :
-				CanvasTile.BlendMode = bUseTranslucentBlend ? SE_BLEND_Translucent : SE_BLEND_Opaque;
-			}
-			else
-			{
-				// matches the behavior of FTextureEditorViewportClient::Draw and FTextureEditorToolkit::GetColourChannelBlendMode
-				// I think it may be a bug in BatchedElement that SE_BLEND_Translucent doesn't work here (failing to set up TextureComponentReplicate?)
-				CanvasTile.BlendMode = bUseTranslucentBlend ? (ESimpleElementBlendMode)(SE_BLEND_RGBA_MASK_START+0xF) : SE_BLEND_Opaque;
-			}
-			CanvasTile.BatchedElementParameters = BatchedElementParameters;
-			if (bIsVirtualTexture && Texture->Source.GetNumBlocks() > 1)
-			{
-				// Adjust UVs to display entire UDIM range, acounting for UE inverted V-axis
-				// We're not actually rendering a VT here, but the editor-only texture we're using is still using the UDIM tile layout
-				// So we use inverted Y-axis, but then normalize back to [0,1)
-				const FIntPoint BlockSize = Texture->Source.GetSizeInBlocks();
-				const float RcpBlockSizeY = 1.0f / (float)BlockSize.Y;
-				CanvasTile.UV0.Y = (1.0f - (float)BlockSize.Y) * RcpBlockSizeY;
-				CanvasTile.UV1.Y = RcpBlockSizeY;
-			}
-			CanvasTile.Draw( Canvas );
+UTexture2D* UBotaniItemThumbnailRenderer::FindOrCreateCompositeTexture(const UBotaniInventoryItemDefinition* Item, uint32 Width, uint32 Height)
+{
+	const UTexture2D* Icon = Item->DataList.GetThumbnailImage();
+	if (Icon == nullptr || !Icon->Source.IsValid())
+	{
+		return nullptr;
+	}
 
-			if (TextureLightProfile)
-			{
-				float Brightness = TextureLightProfile->Brightness;
-
-				// Brightness in Lumens
-				FText BrightnessText = FText::AsNumber( Brightness );
-				FCanvasTextItem TextItem( FVector2D( 5.0f, 5.0f ), BrightnessText, GEngine->GetLargeFont(), FLinearColor::White );
-				TextItem.EnableShadow(FLinearColor::Black);
-				TextItem.Scale = FVector2D(Width / 128.0f, Height / 128.0f);
-				TextItem.Draw(Canvas);
-			}
+	const UBotaniRarityStyleAsset* StyleAsset = GetRarityStyleAsset();
+	const UTexture2D* Background = StyleAsset ? StyleAsset->GetDefaultIcon() : nullptr;
+	const bool bRenderBackground = UBotaniEditorSettings::Get()->ShouldRenderRarityBackground();
 
-			if (bIsVirtualTexture)
-			{
-				auto VTChars = TEXT("VT");
-				int32 VTWidth = 0;
-				int32 VTHeight = 0;
-				StringSize(GEngine->GetLargeFont(), VTWidth, VTHeight, VTChars);
-				float PaddingX = Width / 128.0f;
-				float PaddingY = Height / 128.0f;
-				float ScaleX = Width / 64.0f; //Text is 1/64'th of the size of the thumbnails
-				float ScaleY = Height / 64.0f;
-				// VT overlay
-				FCanvasTextItem TextItem(FVector2D(Width - PaddingX - VTWidth * ScaleX, Height - PaddingY - VTHeight * ScaleY), FText::FromString(VTChars), GEngine->GetLargeFont(), FLinearColor::White);
-				TextItem.EnableShadow(FLinearColor::Black);
-				TextItem.Scale = FVector2D(ScaleX, ScaleY);
-				TextItem.Draw(Canvas);
-			}
-		}
-		else
+	const FGuid IconSourceId = Icon->Source.GetId();
+	const FGuid BackgroundSourceId = (Background && Background->Source.IsValid()) ? Background->Source.GetId() : FGuid();
+
+	if (const FCachedItemThumbnail* CachedThumbnail = CachedThumbnails.Find(FObjectKey(Item)))
+	{
+		if (CachedThumbnail->Texture
+			&& CachedThumbnail->IconSourceId == IconSourceId
+			&& CachedThumbnail->BackgroundSourceId == BackgroundSourceId
+			&& CachedThumbnail->Rarity == Item->Rarity
+			&& CachedThumbnail->Width == Width
+			&& CachedThumbnail->Height == Height
+			&& CachedThumbnail->bRenderBackground == bRenderBackground)
 		{
-			// Render a tile using a transient texture that holds the cpu copy.
-			Canvas->DrawTile(
-				0.0f, 0.0f, Width, Height,							// Dimensions
-				0.0f, 0.0f, 1.0f, 1.0f,								// UVs
-				FLinearColor::White, CpuCopyTexture->GetResource());			// Tint & Texture
-
-			const TCHAR* Chars = TEXT("CPU");
-			int32 TextWidth = 0;
-			int32 TextHeight = 0;
-			StringSize(GEngine->GetLargeFont(), TextWidth, TextHeight, Chars);
-			float PaddingX = Width / 128.0f;
-			float PaddingY = Height / 128.0f;
-			float ScaleX = Width / 64.0f; //Text is 1/64'th of the size of the thumbnails
-			float ScaleY = Height / 64.0f;
-			// overlay
-			FCanvasTextItem TextItem(FVector2D(Width - PaddingX - TextWidth * ScaleX, Height - PaddingY - TextHeight * ScaleY), FText::FromString(Chars), GEngine->GetLargeFont(), FLinearColor::White);
-			TextItem.EnableShadow(FLinearColor::Black);
-			TextItem.Scale = FVector2D(ScaleX, ScaleY);
-			TextItem.Draw(Canvas);
+			return CachedThumbnail->Texture;
 		}
 	}
+
+	FImage CompositeImage;
+	if (!CompositeItemThumbnail(Item, StyleAsset, Width, Height, bRenderBackground, CompositeImage))
+	{
+		CachedThumbnails.Remove(FObjectKey(Item));
+		return nullptr;
+	}
+
+	UTexture2D* CompositeTexture = UTexture2D::CreateTransient(Width, Height, PF_B8G8R8A8);
+	if (CompositeTexture == nullptr)
+	{
+		return nullptr;
+	}
+
+	FTexture2DMipMap& Mip = CompositeTexture->GetPlatformData()->Mips[0];
+	void* MipData = Mip.BulkData.Lock(LOCK_READ_WRITE);
+	FMemory::Memcpy(MipData, CompositeImage.RawData.GetData(), CompositeImage.RawData.Num());
+	Mip.BulkData.Unlock();
+	CompositeTexture->UpdateResource();
+
+	if (CachedThumbnails.Num() >= BotaniItemThumbnail::MaxCachedThumbnails && !CachedThumbnails.Contains(FObjectKey(Item)))
+	{
+		CachedThumbnails.Reset();
+	}
+
+	FCachedItemThumbnail& CachedThumbnail = CachedThumbnails.FindOrAdd(FObjectKey(Item));
+	CachedThumbnail.Texture = CompositeTexture;
+	CachedThumbnail.IconSourceId = IconSourceId;
+	CachedThumbnail.BackgroundSourceId = BackgroundSourceId;
+	CachedThumbnail.Rarity = Item->Rarity;
+	CachedThumbnail.Width = Width;
+	CachedThumbnail.Height = Height;
+	CachedThumbnail.bRenderBackground = bRenderBackground;
+
+	return CompositeTexture;
+}
+
+const UBotaniRarityStyleAsset* UBotaniItemThumbnailRenderer::GetRarityStyleAsset()
+{
+	if (!CachedRarityStyleAsset.IsValid())
+	{
+		CachedRarityStyleAsset = LoadRarityStyleAsset();
+	}
+
+	return CachedRarityStyleAsset.Get();
+}
+
+void UBotaniItemThumbnailRenderer::HandleObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& PropertyChangedEvent)
+{
+	if (Object == nullptr)
+	{
+		return;
+	}
+
+	if (Object->IsA<UBotaniRarityStyleAsset>() || Object->IsA<UBotaniGameData>())
+	{
+		CachedRarityStyleAsset.Reset();
+		CachedThumbnails.Reset();
+	}
+	else if (Object->IsA<UBotaniInventoryItemDefinition>())
+	{
+		CachedThumbnails.Remove(FObjectKey(Object));
+	}
 }
 
 void UBotaniItemThumbnailRenderer::ClearThumbnailCache(UObject* Object)
@@ -249,6 +311,8 @@ void UBotaniItemThumbnailRenderer::ClearThumbnailCache(UObject* Object)
 	const UBotaniInventoryItemDefinition* Item = Cast<UBotaniInventoryItemDefinition>(Object);
 	check(Item);
 
+	CachedThumbnails.Remove(FObjectKey(Item));
+
 	UPackage* Package = Item->GetOutermost();
 	ThumbnailTools::CacheEmptyThumbnail(Item->GetFullName(), Package);
 }
@@ -256,20 +320,7 @@ void UBotaniItemThumbnailRenderer::ClearThumbnailCache(UObject* Object)
 UTexture2D* UBotaniItemThumbnailRenderer::GetThumbnailTextureFromObject(UObject* Object) const
 {
 	const UBotaniInventoryItemDefinition* Item = Cast<UBotaniInventoryItemDefinition>(Object);
-	if (Item && Item->DataList.GetThumbnailImage())
-	{
-		UTexture2D* ThumbnailImage = Item->DataList.GetThumbnailImage();
-
-		if (!ThumbnailImage->GetPackage()->HasAnyPackageFlags(PKG_Cooked | PKG_FilterEditorOnly))
-		{
-			ThumbnailImage->FinishCachePlatformData();
-			ThumbnailImage->UpdateResource();
-		}
-
-		return ThumbnailImage;
-	}
-
-	return nullptr;
+	return Item ? Item->DataList.GetThumbnailImage() : nullptr;
 }
 
 
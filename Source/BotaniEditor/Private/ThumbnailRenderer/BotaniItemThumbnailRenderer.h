@@ -3,12 +3,21 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Inventory/Definitions/BotaniInventoryItemDefinition.h"
 #include "ThumbnailRendering/TextureThumbnailRenderer.h"
+#include "UObject/ObjectKey.h"
 
 #include "BotaniItemThumbnailRenderer.generated.h"
 
+class UBotaniRarityStyleAsset;
+struct FImage;
+
 /**
- * 
+ * UBotaniItemThumbnailRenderer
+ *
+ * Draws the thumbnail image of an item on top of its rarity background.
+ * The icon and the rarity background are composited on the cpu once per item and cached, so repainting the content
+ * browser only draws a single texture per item.
  */
 UCLASS()
 class BOTANIEDITOR_API UBotaniItemThumbnailRenderer : public UTextureThumbnailRenderer
@@ -16,13 +25,57 @@ class BOTANIEDITOR_API UBotaniItemThumbnailRenderer : public UTextureThumbnailRe
 	GENERATED_BODY()
 
 public:
+	//~ Begin UObject Interface
+	virtual void PostInitProperties() override;
+	virtual void BeginDestroy() override;
+	static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
+	//~ End UObject Interface
+
 	//~ Begin UThumbnailRenderer Interface
 	virtual bool CanVisualizeAsset(UObject* Object) override;
 	virtual void GetThumbnailSize(UObject* Object, float Zoom, uint32& OutWidth, uint32& OutHeight) const override;
 	virtual void Draw(UObject* Object, int32 X, int32 Y, uint32 Width, uint32 Height, FRenderTarget* Viewport, FCanvas* Canvas, bool bAdditionalViewFamily) override;
 	//~ End UThumbnailRenderer Interface
 
+	/**
+	 * Composites the thumbnail image of the item over its rarity background from the texture source data.
+	 * Does not need a renderer, so it can be used with -nullrhi.
+	 * @returns False if the item has no thumbnail image with source data.
+	 */
+	static bool CompositeItemThumbnail(const UBotaniInventoryItemDefinition* Item, const UBotaniRarityStyleAsset* StyleAsset, int32 Width, int32 Height, bool bRenderBackground, FImage& OutImage);
+
+	/** Returns the rarity style asset of the game data, loading it if needed. */
+	static const UBotaniRarityStyleAsset* LoadRarityStyleAsset();
+
 protected:
 	void ClearThumbnailCache(UObject* Object);
 	virtual UTexture2D* GetThumbnailTextureFromObject(UObject* Object) const;
+
+private:
+	struct FCachedItemThumbnail
+	{
+		TObjectPtr<UTexture2D> Texture;
+		FGuid IconSourceId;
+		FGuid BackgroundSourceId;
+		EBotaniItemRarity Rarity = EBotaniItemRarity::Unset;
+		uint32 Width = 0;
+		uint32 Height = 0;
+		bool bRenderBackground = false;
+	};
+
+	/** Returns the cached composite of the item, rebuilding it if the item, its icon or the rarity style changed. */
+	UTexture2D* FindOrCreateCompositeTexture(const UBotaniInventoryItemDefinition* Item, uint32 Width, uint32 Height);
+
+	const UBotaniRarityStyleAsset* GetRarityStyleAsset();
+
+	void HandleObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& PropertyChangedEvent);
+
+private:
+	/** Composited thumbnails per item */
+	TMap<FObjectKey, FCachedItemThumbnail> CachedThumbnails;
+
+	/** Rarity style asset of the game data, resolved once */
+	TWeakObjectPtr<const UBotaniRarityStyleAsset> CachedRarityStyleAsset;
+
+	FDelegateHandle ObjectPropertyChangedHandle;
 };
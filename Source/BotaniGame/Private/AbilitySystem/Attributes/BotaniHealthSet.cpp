@@ -5,6 +5,7 @@
 
 #include "GameplayEffectExtension.h"
 #include "AbilitySystem/BotaniAbilitySystemComponent.h"
+#include "Game/BotaniGameStateBase.h"
 #include "GameFramework/GameplayMessageSubsystem.h"
 #include "GameplayTags/BotaniGameplayTags.h"
 #include "Messaging/BotaniVerbMessage.h"
@@ -172,6 +173,12 @@ void UBotaniHealthSet::PostGameplayEffectExecute(const FGameplayEffectModCallbac
 
 			UGameplayMessageSubsystem& MessageSystem = UGameplayMessageSubsystem::Get(GetWorld());
 			MessageSystem.BroadcastMessage(VerbMessage.VerbTag, VerbMessage);
+
+			// Only the instigating and the damaged player receive it, see ABotaniGameStateBase::IsVerbMessageRelevantToInvolvedPlayers
+			if (ABotaniGameStateBase* GameState = GetWorld()->GetGameState<ABotaniGameStateBase>())
+			{
+				GameState->SendVerbMessageToClients(VerbMessage);
+			}
 		}
 		
 		if (!Data.EffectSpec.GetDynamicAssetTags().HasTagExact(BotaniGameplayTags::Gameplay::Damage::TAG_GameplayDamage_IgnoreShield) && GetShield() > 0.f)
@@ -3,10 +3,13 @@
 
 #include "Camera/BotaniCameraMode.h"
 
+#include "BotaniLogChannels.h"
 #include "Camera/BotaniCameraManager.h"
 #include "Components/CapsuleComponent.h"
 #include "Engine/Canvas.h"
 #include "GameFramework/Character.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
 
 //////////////////////////////////////////////////////////////////////////
 /// FBotaniCameraModeView
@@ -212,9 +215,67 @@ void UBotaniCameraMode::UpdateBlending(float DeltaTime)
 //////////////////////////////////////////////////////////////////////////
 /// UBotaniCameraModeStack
 
+#if !UE_BUILD_SHIPPING
+// Manual debugging tool, the captures of two runs are diffed by hand and nothing is asserted.
+namespace BotaniCameraDebug
+{
+	/** File the camera stack is currently being captured to */
+	static TUniquePtr<FArchive> CaptureWriter;
+	static FString CaptureFilename;
+	static int32 NumCapturedFrames = 0;
+
+	static void StopCapture()
+	{
+		if (!CaptureWriter.IsValid())
+		{
+			return;
+		}
+
+		CaptureWriter->Close();
+		CaptureWriter.Reset();
+
+		UE_LOG(LogBotani, Log, TEXT("Camera capture stopped, wrote %d frames to '%s'."), NumCapturedFrames, *CaptureFilename);
+	}
+
+	static void StartCapture(const TArray<FString>& Args)
+	{
+		StopCapture();
+
+		const FString Name = Args.Num() > 0 ? Args[0] : FString::Printf(TEXT("CameraCapture-%s"), *FDateTime::Now().ToString());
+		CaptureFilename = FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir() / TEXT("CameraCaptures") / FPaths::SetExtension(Name, TEXT("csv")));
+		NumCapturedFrames = 0;
+
+		CaptureWriter.Reset(IFileManager::Get().CreateFileWriter(*CaptureFilename));
+		if (!CaptureWriter.IsValid())
+		{
+			UE_LOG(LogBotani, Warning, TEXT("Camera capture failed to open '%s'."), *CaptureFilename);
+			return;
+		}
+
+		const FTCHARToUTF8 Header(TEXT("Frame,DeltaTime,Stack,Location,Rotation,FieldOfView,Modes\n"));
+		CaptureWriter->Serialize(const_cast<ANSICHAR*>(Header.Get()), Header.Length());
+
+		UE_LOG(LogBotani, Log, TEXT("Camera capture started, writing to '%s'."), *CaptureFilename);
+	}
+
+	static FAutoConsoleCommand CmdStartCapture(
+		TEXT("Botani.Camera.Capture.Start"),
+		TEXT("Records the contents of every camera mode stack each frame to Saved/CameraCaptures/<Name>.csv, so blending can be compared between runs. Usage: Botani.Camera.Capture.Start [Name]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(StartCapture));
+
+	static FAutoConsoleCommand CmdStopCapture(
+		TEXT("Botani.Camera.Capture.Stop"),
+		TEXT("Stops the camera capture started with Botani.Camera.Capture.Start."),
+		FConsoleCommandDelegate::CreateStatic(StopCapture));
+}
+#endif
+
 UBotaniCameraModeStack::UBotaniCameraModeStack()
 	: bIsActive(true)
+	, StackHead(0)
+	, StackSize(0)
 {
+	CameraModeRing.SetNumZeroed(MaxStackSize);
 }
 
 void UBotaniCameraModeStack::ActivateStack()
@@ -227,8 +288,9 @@ void UBotaniCameraModeStack::ActivateStack()
 	bIsActive = true;
 
 	// Notify the camera modes that they're being activated.
-	for (UBotaniCameraMode* CameraMode : CameraModeStack)
+	for (int32 StackIdx = 0; StackIdx < StackSize; ++StackIdx)
 	{
+		UBotaniCameraMode* CameraMode = GetStackEntry(StackIdx);
 		check(CameraMode);
 		CameraMode->OnActivated();
 	}
@@ -244,8 +306,9 @@ void UBotaniCameraModeStack::DeactivateStack()
 	bIsActive = false;
 
 	// Notify the camera modes that they're being deactivated.
-	for (UBotaniCameraMode* CameraMode : CameraModeStack)
+	for (int32 StackIdx = 0; StackIdx < StackSize; ++StackIdx)
 	{
+		UBotaniCameraMode* CameraMode = GetStackEntry(StackIdx);
 		check(CameraMode);
 		CameraMode->OnDeactivated();
 	}
@@ -261,9 +324,7 @@ void UBotaniCameraModeStack::PushCameraMode(TSubclassOf<UBotaniCameraMode> Camer
 	UBotaniCameraMode* CameraMode = GetCameraModeInstance(CameraModeClass);
 	check(CameraMode);
 
-	int32 StackSize = CameraModeStack.Num();
-
-	if ((StackSize > 0) && (CameraModeStack[0] == CameraMode))
+	if ((StackSize > 0) && (GetStackEntry(0) == CameraMode))
 	{
 		// The camera mode is already at the top of the stack.
 		return;
@@ -274,24 +335,41 @@ void UBotaniCameraModeStack::PushCameraMode(TSubclassOf<UBotaniCameraMode> Camer
 
 	for (int32 StackIdx = 0; StackIdx < StackSize; ++StackIdx)
 	{
-		if (CameraModeStack[StackIdx] == CameraMode)
+		const UBotaniCameraMode* StackMode = GetStackEntry(StackIdx);
+		if (StackMode == CameraMode)
 		{
 			ExistingStackIndex = StackIdx;
 			ExistingStackContribution *= CameraMode->GetBlendWeight();
 			break;
 		}
 
-		ExistingStackContribution *= (1.f - CameraModeStack[StackIdx]->GetBlendWeight());
+		ExistingStackContribution *= (1.f - StackMode->GetBlendWeight());
 	}
 
 	if (ExistingStackIndex != INDEX_NONE)
 	{
-		CameraModeStack.RemoveAt(ExistingStackIndex);
+		// Close the gap by moving the modes above it down one slot, the new top goes into the freed head slot.
+		for (int32 StackIdx = ExistingStackIndex; StackIdx > 0; --StackIdx)
+		{
+			CameraModeRing[GetRingIndex(StackIdx)] = CameraModeRing[GetRingIndex(StackIdx - 1)];
+		}
+
+		StackHead = GetRingIndex(1);
 		StackSize--;
 	}
 	else
 	{
 		ExistingStackContribution = 0.f;
+
+		if (StackSize == MaxStackSize)
+		{
+			// Out of slots, drop the bottom mode to make room.
+			UBotaniCameraMode* BottomCameraMode = GetStackEntry(StackSize - 1);
+			check(BottomCameraMode);
+
+			TrimStack(StackSize - 1);
+			BottomCameraMode->OnDeactivated();
+		}
 	}
 
 	// Decide what initial weight to start with.
@@ -300,10 +378,12 @@ void UBotaniCameraModeStack::PushCameraMode(TSubclassOf<UBotaniCameraMode> Camer
 	CameraMode->SetBlendWeight(BlendWeight);
 
 	// Add a new entry on top of the stack.
-	CameraModeStack.Insert(CameraMode, 0);
+	StackHead = (StackHead + MaxStackSize - 1) % MaxStackSize;
+	StackSize++;
+	CameraModeRing[StackHead] = CameraMode;
 
 	// Make sure the stack bottom is always weighted 100%
-	CameraModeStack.Last()->SetBlendWeight(1.f);
+	GetStackEntry(StackSize - 1)->SetBlendWeight(1.f);
 
 	// Let the camera mode know if its being added to the stack
 	if (ExistingStackIndex == INDEX_NONE)
@@ -319,8 +399,12 @@ bool UBotaniCameraModeStack::EvaluateStack(float DeltaTime, FBotaniCameraModeVie
 		return false;
 	}
 
-	UpdateStack(DeltaTime);
-	BlendStack(OutView);
+	UpdateStack(DeltaTime, OutView);
+
+#if !UE_BUILD_SHIPPING
+	CaptureStack(DeltaTime, OutView);
+#endif
+
 	return true;
 }
 
@@ -333,8 +417,9 @@ void UBotaniCameraModeStack::DrawDebug(UCanvas* Canvas) const
 	DisplayDebugManager.SetDrawColor(FColor::Green);
 	DisplayDebugManager.DrawString(FString(TEXT("   --- Camera Modes (Begin) ---")));
 
-	for (const UBotaniCameraMode* CameraMode : CameraModeStack)
+	for (int32 StackIdx = 0; StackIdx < StackSize; ++StackIdx)
 	{
+		const UBotaniCameraMode* CameraMode = GetStackEntry(StackIdx);
 		check(CameraMode);
 		CameraMode->DrawDebug(Canvas);
 	}
@@ -345,14 +430,14 @@ void UBotaniCameraModeStack::DrawDebug(UCanvas* Canvas) const
 
 void UBotaniCameraModeStack::GetBlendInfo(float& OutWeightOfTopLayer, FGameplayTag& OutTagOfTopLayer) const
 {
-	if (CameraModeStack.Num() == 0)
+	if (StackSize == 0)
 	{
 		OutWeightOfTopLayer = 1.0f;
 		OutTagOfTopLayer = FGameplayTag();
 		return;
 	}
 	
-	const UBotaniCameraMode* TopEntry = CameraModeStack.Last();
+	const UBotaniCameraMode* TopEntry = GetStackEntry(StackSize - 1);
 	check(TopEntry);
 	OutWeightOfTopLayer = TopEntry->GetBlendWeight();
 	OutTagOfTopLayer = TopEntry->GetCameraModeTag();
@@ -363,83 +448,110 @@ UBotaniCameraMode* UBotaniCameraModeStack::GetCameraModeInstance(TSubclassOf<UBo
 	check(CameraModeClass);
 
 	// First see if we already have an instance of this camera mode.
-	for (UBotaniCameraMode* CameraMode : CameraModeInstances)
+	TObjectPtr<UBotaniCameraMode>& CameraMode = CameraModeInstances.FindOrAdd(CameraModeClass);
+	if (CameraMode == nullptr)
 	{
-		if ((CameraMode != nullptr) && (CameraMode->GetClass() == CameraModeClass))
-		{
-			return CameraMode;
-		}
+		// Not found, create a new instance.
+		CameraMode = NewObject<UBotaniCameraMode>(GetOuter(), CameraModeClass, NAME_None, RF_NoFlags);
+		check(CameraMode);
 	}
 
-	// Not found, create a new instance.
-	UBotaniCameraMode* NewCameraMode = NewObject<UBotaniCameraMode>(GetOuter(), CameraModeClass, NAME_None, RF_NoFlags);
-	check(NewCameraMode);
-
-	CameraModeInstances.Add(NewCameraMode);
-	return NewCameraMode;
+	return CameraMode;
 }
 
-void UBotaniCameraModeStack::UpdateStack(float DeltaTime)
+void UBotaniCameraModeStack::UpdateStack(float DeltaTime, FBotaniCameraModeView& OutView)
 {
-	const int32 StackSize = CameraModeStack.Num();
 	if (StackSize <= 0)
 	{
 		return;
 	}
 
-	int32 RemoveCount = 0;
-	int32 RemoveIndex = INDEX_NONE;
+	// Update from the top down. A fully weighted mode replaces the view entirely,
+	// so the modes below the topmost one are neither updated nor blended and get trimmed afterwards.
+	int32 FullWeightIndex = INDEX_NONE;
 
-	for (int32 StackIndex = 0; StackIndex < StackSize; ++StackIndex)
+	for (int32 StackIdx = 0; StackIdx < StackSize; ++StackIdx)
 	{
-		UBotaniCameraMode* CameraMode = CameraModeStack[StackIndex];
+		UBotaniCameraMode* CameraMode = GetStackEntry(StackIdx);
 		check(CameraMode);
 
 		CameraMode->UpdateCameraMode(DeltaTime);
 
 		if (CameraMode->GetBlendWeight() >= 1.0f)
 		{
-			// Everything below this mode is now irrelevant and can be removed.
-			RemoveIndex = (StackIndex + 1);
-			RemoveCount = (StackSize - RemoveIndex);
+			FullWeightIndex = StackIdx;
 			break;
 		}
 	}
 
-	if (RemoveCount > 0)
+	// Blend up from the bottom of the visible modes, which always starts the view regardless of its weight.
+	const int32 BottomIdx = (FullWeightIndex != INDEX_NONE) ? FullWeightIndex : (StackSize - 1);
+	OutView = GetStackEntry(BottomIdx)->GetCameraModeView();
+
+	for (int32 StackIdx = (BottomIdx - 1); StackIdx >= 0; --StackIdx)
+	{
+		const UBotaniCameraMode* CameraMode = GetStackEntry(StackIdx);
+		OutView.Blend(CameraMode->GetCameraModeView(), CameraMode->GetBlendWeight());
+	}
+
+	const int32 NewStackSize = (FullWeightIndex + 1);
+	if ((FullWeightIndex != INDEX_NONE) && (NewStackSize < StackSize))
 	{
 		// Let the camera modes know they being removed from the stack.
-		for (int32 StackIndex = RemoveIndex; StackIndex < StackSize; ++StackIndex)
+		const int32 OldStackSize = StackSize;
+		TArray<UBotaniCameraMode*, TInlineAllocator<MaxStackSize>> RemovedModes;
+		for (int32 StackIdx = NewStackSize; StackIdx < OldStackSize; ++StackIdx)
 		{
-			UBotaniCameraMode* CameraMode = CameraModeStack[StackIndex];
-			check(CameraMode);
+			RemovedModes.Add(GetStackEntry(StackIdx));
+		}
 
-			CameraMode->OnDeactivated();
+		TrimStack(NewStackSize);
+
+		for (UBotaniCameraMode* RemovedMode : RemovedModes)
+		{
+			check(RemovedMode);
+			RemovedMode->OnDeactivated();
 		}
+	}
+}
 
-		CameraModeStack.RemoveAt(RemoveIndex, RemoveCount);
+void UBotaniCameraModeStack::TrimStack(int32 NewStackSize)
+{
+	check(NewStackSize >= 0 && NewStackSize <= StackSize);
+
+	for (int32 StackIdx = NewStackSize; StackIdx < StackSize; ++StackIdx)
+	{
+		CameraModeRing[GetRingIndex(StackIdx)] = nullptr;
 	}
+
+	StackSize = NewStackSize;
 }
 
-void UBotaniCameraModeStack::BlendStack(FBotaniCameraModeView& OutView) const
+#if !UE_BUILD_SHIPPING
+void UBotaniCameraModeStack::CaptureStack(float DeltaTime, const FBotaniCameraModeView& View) const
 {
-	const int32 StackSize = CameraModeStack.Num();
-	if (StackSize <= 0)
+	if (!BotaniCameraDebug::CaptureWriter.IsValid())
 	{
 		return;
 	}
 
-	// Start with the bottom of the stack.
-	const UBotaniCameraMode* BottomCameraMode = CameraModeStack[StackSize -1];
-	check(BottomCameraMode);
+	// Frame, delta time, owner, the blended view and then every mode from the top as Class:Tag:Weight.
+	TStringBuilder<512> Line;
+	Line.Appendf(TEXT("%llu,%.6f,%s,"), GFrameCounter, DeltaTime, *GetPathNameSafe(GetOuter()));
+	Line.Appendf(TEXT("%.3f %.3f %.3f,"), View.Location.X, View.Location.Y, View.Location.Z);
+	Line.Appendf(TEXT("%.3f %.3f %.3f,"), View.Rotation.Pitch, View.Rotation.Yaw, View.Rotation.Roll);
+	Line.Appendf(TEXT("%.3f,"), View.FieldOfView);
 
-	OutView = BottomCameraMode->GetCameraModeView();
-
-	for (int32 StackIdx = (StackSize - 2); StackIdx >= 0; --StackIdx)
+	for (int32 StackIdx = 0; StackIdx < StackSize; ++StackIdx)
 	{
-		BottomCameraMode = CameraModeStack[StackIdx];
-		check(BottomCameraMode);
-
-		OutView.Blend(BottomCameraMode->GetCameraModeView(), BottomCameraMode->GetBlendWeight());
+		const UBotaniCameraMode* CameraMode = GetStackEntry(StackIdx);
+		Line.Appendf(TEXT("%s%s:%s:%.4f"), (StackIdx > 0) ? TEXT(" ") : TEXT(""), *GetNameSafe(CameraMode->GetClass()), *CameraMode->GetCameraModeTag().ToString(), CameraMode->GetBlendWeight());
 	}
+
+	Line.Append(TEXT("\n"));
+
+	const FTCHARToUTF8 LineUTF8(Line.ToString(), Line.Len());
+	BotaniCameraDebug::CaptureWriter->Serialize(const_cast<ANSICHAR*>(LineUTF8.Get()), LineUTF8.Length());
+	BotaniCameraDebug::NumCapturedFrames++;
 }
+#endif
@@ -6,6 +6,7 @@
 #include "BotaniLogChannels.h"
 #include "AbilitySystem/BotaniAbilitySystemComponent.h"
 #include "AbilitySystem/Attributes/BotaniHealthSet.h"
+#include "Game/BotaniGameStateBase.h"
 #include "GameFramework/GameplayMessageSubsystem.h"
 #include "GameFramework/PlayerState.h"
 #include "GameplayTags/BotaniGameplayTags.h"
@@ -182,6 +183,12 @@ void UBotaniHealthComponent::HandleOutOfHealth(AActor* DamageInstigator, AActor*
 
 		UGameplayMessageSubsystem& MessageSub = UGameplayMessageSubsystem::Get(GetWorld());
 		MessageSub.BroadcastMessage(Message.VerbTag, Message);
+
+		// Let clients observe it too, e.g. for the elimination feed
+		if (ABotaniGameStateBase* GameState = GetWorld()->GetGameState<ABotaniGameStateBase>())
+		{
+			GameState->SendVerbMessageToClients(Message);
+		}
 	}
 #endif
 }
@@ -3,7 +3,6 @@
 
 #include "Feedback/NumberPops/Components/BotaniNumPopComponent_NiagaraText.h"
 
-#include "BotaniLogChannels.h"
 #include "NiagaraComponent.h"
 #include "NiagaraSystem.h"
 #include "NiagaraDataInterfaceArrayFunctionLibrary.h"
@@ -16,6 +15,9 @@
 UBotaniNumPopComponent_NiagaraText::UBotaniNumPopComponent_NiagaraText(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
+	// Only ticks while number pops are displayed, to flush new pops and clear expired ones.
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
 }
 
 UBotaniNumPopComponent_NiagaraText* UBotaniNumPopComponent_NiagaraText::FindNumPopComponent(const AActor* Actor)
@@ -30,30 +32,168 @@ UBotaniNumPopComponent_NiagaraText* UBotaniNumPopComponent_NiagaraText::FindNumP
 
 void UBotaniNumPopComponent_NiagaraText::AddNumberPop(const FBotaniNumPopRequest& NewRequest)
 {
-	int32 LocalDamage = NewRequest.NumberToDisplay;
+	if (!InitializeNiagaraComponent())
+	{
+		return;
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	int32 PopIdx = FindMergePop(NewRequest, Now);
+	if (PopIdx != INDEX_NONE)
+	{
+		// Refresh the merged pop so a target that keeps getting hit keeps its number
+		FNumberPop& Pop = NumberPops[PopIdx];
+		Pop.Number += NewRequest.NumberToDisplay;
+		Pop.SpawnTime = Now;
+	}
+	else
+	{
+		FNumberPop& Pop = NumberPops.AddDefaulted_GetRef();
+		Pop.Target = NewRequest.TargetActor;
+		Pop.Location = NewRequest.WorldLocation;
+		Pop.Number = NewRequest.NumberToDisplay;
+		Pop.SpawnTime = Now;
+
+		PopIdx = NumberPops.Num() - 1;
+		NumNewPopsThisFrame++;
+	}
+
+	LatestSpawnTime = Now;
+	DirtyPops.AddUnique(PopIdx);
+	SetComponentTickEnabled(true);
+}
+
+void UBotaniNumPopComponent_NiagaraText::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	FlushNumberPops(GetWorld()->GetTimeSeconds());
+
+	if (NumberPops.IsEmpty())
+	{
+		SetComponentTickEnabled(false);
+	}
+}
+
+bool UBotaniNumPopComponent_NiagaraText::InitializeNiagaraComponent()
+{
+	if (NiagaraComp)
+	{
+		return true;
+	}
+
+	if ((Style == nullptr) || (Style->TextNiagara == nullptr))
+	{
+		return false;
+	}
 
 	//Add a NiagaraComponent if we don't already have one
-	if (!NiagaraComp)
+	NiagaraComp = NewObject<UNiagaraComponent>(GetOwner());
+	NiagaraComp->SetAsset(Style->TextNiagara);
+	NiagaraComp->bAutoActivate = false;
+	NiagaraComp->SetupAttachment(nullptr);
+	NiagaraComp->RegisterComponent();
+
+	NumberPops.Reserve(FMath::Max(Style->MaxActivePops, 1));
+	DirtyPops.Reserve(FMath::Max(Style->MaxActivePops, 1));
+
+	return true;
+}
+
+int32 UBotaniNumPopComponent_NiagaraText::FindMergePop(const FBotaniNumPopRequest& Request, double Now) const
+{
+	const int32 NumPops = NumberPops.Num();
+	const bool bFull = (NumPops >= FMath::Max(Style->MaxActivePops, 1));
+	const bool bOverBudget = (NumNewPopsThisFrame >= Style->MaxNewPopsPerFrame);
+	const float MergeDistanceSq = FMath::Square(Style->MergeDistance);
+
+	int32 ClosestPop = INDEX_NONE;
+	double ClosestDistSq = UE_BIG_NUMBER;
+
+	// Merged pops are refreshed, so any entry can still be in the merge window. There are at most MaxActivePops of them.
+	for (int32 PopIdx = NumPops - 1; PopIdx >= 0; --PopIdx)
 	{
-		NiagaraComp = NewObject<UNiagaraComponent>(GetOwner());
-		if (Style != nullptr)
+		const FNumberPop& Pop = NumberPops[PopIdx];
+		const double DistSq = FVector::DistSquared(Pop.Location, Request.WorldLocation);
+
+		if ((Now - Pop.SpawnTime) <= Style->MergeWindow)
+		{
+			const bool bSameTarget = (Request.TargetActor != nullptr)
+				? (Pop.Target.Get() == Request.TargetActor)
+				: (!Pop.Target.IsValid() && DistSq <= MergeDistanceSq);
+
+			if (bSameTarget)
+			{
+				return PopIdx;
+			}
+		}
+
+		// Once the arrays are full every pop is a candidate, over the frame budget only the ones of this frame
+		const bool bThisFrame = (PopIdx >= NumPops - NumNewPopsThisFrame);
+		if ((bFull || (bOverBudget && bThisFrame)) && (DistSq < ClosestDistSq))
+		{
+			ClosestPop = PopIdx;
+			ClosestDistSq = DistSq;
+		}
+	}
+
+	return ClosestPop;
+}
+
+void UBotaniNumPopComponent_NiagaraText::FlushNumberPops(double Now)
+{
+	if (!NiagaraComp || (Style == nullptr))
+	{
+		return;
+	}
+
+	if (!DirtyPops.IsEmpty())
+	{
+		if (NumNewPopsThisFrame > 0)
 		{
-			NiagaraComp->SetAsset(Style->TextNiagara);
-			NiagaraComp->bAutoActivate = false;
-			
+			NiagaraComp->SetWorldLocation(NumberPops.Last().Location);
 		}
-		NiagaraComp->SetupAttachment(nullptr);
-		check(NiagaraComp);
-		NiagaraComp->RegisterComponent();
+
+		// New pops are appended in order, so the arrays grow one entry at a time
+		DirtyPops.Sort();
+		for (const int32 PopIdx : DirtyPops)
+		{
+			WritePop(PopIdx);
+		}
+
+		if (!NiagaraComp->IsActive())
+		{
+			NiagaraComp->Activate(true);
+		}
+
+		DirtyPops.Reset();
+		NumNewPopsThisFrame = 0;
 	}
+	else if (!NumberPops.IsEmpty() && ((Now - LatestSpawnTime) > Style->PopLifetime))
+	{
+		// Every pop is gone, start over with empty arrays instead of growing them forever
+		NumberPops.Reset();
+		NiagaraComp->Deactivate();
 
+		UNiagaraDataInterfaceArrayFunctionLibrary::SetNiagaraArrayVector4(NiagaraComp, Style->NiagaraArrayName, TArray<FVector4>());
 
-	NiagaraComp->Activate(false);
-	NiagaraComp->SetWorldLocation(NewRequest.WorldLocation);
+		if (!Style->NiagaraSpawnTimeArrayName.IsNone())
+		{
+			UNiagaraDataInterfaceArrayFunctionLibrary::SetNiagaraArrayFloat(NiagaraComp, Style->NiagaraSpawnTimeArrayName, TArray<float>());
+		}
+	}
+}
 
-	UE_LOG(LogBotani, Log, TEXT("DamageHit location : %s"), *(NewRequest.WorldLocation.ToString()));
-	//Add Damage information to the current Niagara list - Damage informations are packed inside a FVector4 where XYZ = Position, W = Damage
-	TArray<FVector4> DamageList = UNiagaraDataInterfaceArrayFunctionLibrary::GetNiagaraArrayVector4(NiagaraComp, Style->NiagaraArrayName);
-	DamageList.Add(FVector4(NewRequest.WorldLocation.X, NewRequest.WorldLocation.Y, NewRequest.WorldLocation.Z, LocalDamage));
-	UNiagaraDataInterfaceArrayFunctionLibrary::SetNiagaraArrayVector4(NiagaraComp, Style->NiagaraArrayName, DamageList);
+void UBotaniNumPopComponent_NiagaraText::WritePop(int32 PopIdx) const
+{
+	// Damage informations are packed inside a FVector4 where XYZ = Position, W = Damage
+	const FNumberPop& Pop = NumberPops[PopIdx];
+	const FVector4 PackedPop(Pop.Location.X, Pop.Location.Y, Pop.Location.Z, Pop.Number);
+	UNiagaraDataInterfaceArrayFunctionLibrary::SetNiagaraArrayVector4Value(NiagaraComp, Style->NiagaraArrayName, PopIdx, PackedPop, true);
+
+	if (!Style->NiagaraSpawnTimeArrayName.IsNone())
+	{
+		UNiagaraDataInterfaceArrayFunctionLibrary::SetNiagaraArrayFloatValue(NiagaraComp, Style->NiagaraSpawnTimeArrayName, PopIdx, static_cast<float>(Pop.SpawnTime), true);
+	}
 }
@@ -3,8 +3,33 @@
 
 #include "Game/BotaniExperienceManager.h"
 
+#include "BotaniLogChannels.h"
+#include "GameFeaturesSubsystem.h"
+#include "GameFeaturesSubsystemSettings.h"
+#include "Engine/Engine.h"
+#include "Game/Experience/BotaniExperienceDefinition.h"
+#include "GameFeatures/Data/BotaniExperienceActionSet.h"
+#include "System/BotaniAssetManager.h"
+
 #include UE_INLINE_GENERATED_CPP_BY_NAME(BotaniExperienceManager)
 
+namespace BotaniConsoleVariables
+{
+	static bool bEnableExperiencePrestaging = true;
+	static FAutoConsoleVariableRef CVarEnableExperiencePrestaging(
+		TEXT("botani.Experience.Prestage.Enabled"),
+		bEnableExperiencePrestaging,
+		TEXT("If true, the next experience can be pre-staged in the background while the current one is running"),
+		ECVF_Default);
+
+	static int32 ExperiencePrestageMemoryBudgetMB = 512;
+	static FAutoConsoleVariableRef CVarExperiencePrestageMemoryBudgetMB(
+		TEXT("botani.Experience.Prestage.MemoryBudgetMB"),
+		ExperiencePrestageMemoryBudgetMB,
+		TEXT("Amount of physical memory (in MB) pre-staging the next experience may use. Pre-staging is cancelled once it goes over this budget."),
+		ECVF_Default);
+}
+
 #if WITH_EDITOR
 void UBotaniExperienceManager::OnPlayInEditorBegun()
 {
@@ -18,7 +43,7 @@ void UBotaniExperienceManager::NotifyOfPluginActivation(const FString PluginURL)
 	{
 		return;
 	}
-	
+
 	UBotaniExperienceManager* ExperienceManagerSubsystem = GEngine->GetEngineSubsystem<UBotaniExperienceManager>();
 	check(ExperienceManagerSubsystem);
 
@@ -49,4 +74,351 @@ bool UBotaniExperienceManager::RequestToDeactivatePlugin(const FString PluginURL
 
 	return false;
 }
-#endif
\ No newline at end of file
+#endif
+
+bool UBotaniExperienceManager::PrestageExperience(FPrimaryAssetId ExperienceId, ENetMode NetMode)
+{
+	if (!BotaniConsoleVariables::bEnableExperiencePrestaging || !ExperienceId.IsValid())
+	{
+		return false;
+	}
+
+	if (ExperienceId == PrestagedExperienceId)
+	{
+		return true;
+	}
+
+	CancelPrestagedExperience();
+
+	const uint64 MemoryBudget = static_cast<uint64>(FMath::Max(BotaniConsoleVariables::ExperiencePrestageMemoryBudgetMB, 0)) * 1024 * 1024;
+	const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+	if (MemoryStats.AvailablePhysical < MemoryBudget)
+	{
+		UE_LOG(LogBotaniExperience, Warning, TEXT("EXPERIENCE: Not pre-staging %s, only %llu MB of physical memory available (budget is %d MB)"),
+			*ExperienceId.ToString(), MemoryStats.AvailablePhysical / (1024 * 1024), BotaniConsoleVariables::ExperiencePrestageMemoryBudgetMB);
+		return false;
+	}
+
+	UE_LOG(LogBotaniExperience, Log, TEXT("EXPERIENCE: PrestageExperience(%s)"), *ExperienceId.ToString());
+
+	UBotaniAssetManager& AssetManager = UBotaniAssetManager::Get();
+
+	PrestagedExperienceId = ExperienceId;
+	PrestageBaselineMemory = MemoryStats.UsedPhysical;
+	GetBundlesToLoad(NetMode, PrestagedBundles);
+
+	if (!AssetManager.GetPrimaryAssetHandle(ExperienceId).IsValid())
+	{
+		PrestagedAssetIds.Add(ExperienceId);
+	}
+
+	// Load the experience itself first, its action sets are only known once it's in memory
+	PrestageLoadHandle = AssetManager.ChangeBundleStateForPrimaryAssets({ ExperienceId }, PrestagedBundles, {}, false, FStreamableDelegate(), FStreamableManager::DefaultAsyncLoadPriority);
+	if (!PrestageLoadHandle.IsValid() || PrestageLoadHandle->HasLoadCompleted())
+	{
+		OnPrestageExperienceLoaded();
+	}
+	else
+	{
+		PrestageLoadHandle->BindCompleteDelegate(FStreamableDelegate::CreateUObject(this, &ThisClass::OnPrestageExperienceLoaded));
+		PrestageLoadHandle->BindUpdateDelegate(FStreamableUpdateDelegate::CreateUObject(this, &ThisClass::OnPrestageLoadUpdate));
+	}
+
+	return true;
+}
+
+void UBotaniExperienceManager::CancelPrestagedExperience()
+{
+	ReleasePrestagedExperience({}, /*bUnloadAssets=*/ true);
+}
+
+bool UBotaniExperienceManager::ShouldRetainPlugin(const FString& PluginURL)
+{
+	const UBotaniExperienceManager* ExperienceManagerSubsystem = GEngine ? GEngine->GetEngineSubsystem<UBotaniExperienceManager>() : nullptr;
+	return ExperienceManagerSubsystem && ExperienceManagerSubsystem->PrestagedPluginURLs.Contains(PluginURL);
+}
+
+void UBotaniExperienceManager::NotifyOfRetainedPlugin(const FString& PluginURL)
+{
+	UBotaniExperienceManager* ExperienceManagerSubsystem = GEngine->GetEngineSubsystem<UBotaniExperienceManager>();
+	check(ExperienceManagerSubsystem);
+
+	ExperienceManagerSubsystem->RetainedPluginURLs.AddUnique(PluginURL);
+}
+
+void UBotaniExperienceManager::ClaimPrestagedExperience(FPrimaryAssetId ExperienceId, const TArray<FString>& PluginURLs)
+{
+	UBotaniExperienceManager* ExperienceManagerSubsystem = GEngine->GetEngineSubsystem<UBotaniExperienceManager>();
+	check(ExperienceManagerSubsystem);
+
+	if (!ExperienceManagerSubsystem->PrestagedExperienceId.IsValid() && ExperienceManagerSubsystem->RetainedPluginURLs.IsEmpty())
+	{
+		return;
+	}
+
+	const bool bPrestageMatches = ExperienceManagerSubsystem->PrestagedExperienceId == ExperienceId;
+	UE_LOG(LogBotaniExperience, Log, TEXT("EXPERIENCE: ClaimPrestagedExperience(%s, pre-staged = %s, %d plugins retained)"),
+		*ExperienceId.ToString(),
+		*ExperienceManagerSubsystem->PrestagedExperienceId.ToString(),
+		ExperienceManagerSubsystem->RetainedPluginURLs.Num());
+
+	// Assets of a matching experience are now owned by the experience load, only drop them if we guessed wrong
+	ExperienceManagerSubsystem->ReleasePrestagedExperience(PluginURLs, /*bUnloadAssets=*/ !bPrestageMatches);
+}
+
+void UBotaniExperienceManager::GetBundlesToLoad(ENetMode NetMode, TArray<FName>& OutBundlesToLoad)
+{
+	OutBundlesToLoad.Reset();
+	OutBundlesToLoad.Add(FBotaniBundles::Equipped);
+
+	//@TODO: Centralize this client/server stuff into the BotaniAssetManager
+	const bool bLoadClient = GIsEditor || (NetMode != NM_DedicatedServer);
+	const bool bLoadServer = GIsEditor || (NetMode != NM_Client);
+	if (bLoadClient)
+	{
+		OutBundlesToLoad.Add(UGameFeaturesSubsystemSettings::LoadStateClient);
+	}
+	if (bLoadServer)
+	{
+		OutBundlesToLoad.Add(UGameFeaturesSubsystemSettings::LoadStateServer);
+	}
+}
+
+void UBotaniExperienceManager::GetBundleAssetList(const UBotaniExperienceDefinition* Experience, TSet<FPrimaryAssetId>& OutBundleAssetList)
+{
+	check(Experience);
+
+	OutBundleAssetList.Add(Experience->GetPrimaryAssetId());
+	for (const TObjectPtr<UBotaniExperienceActionSet>& ActionSet : Experience->FeatureActionSets)
+	{
+		if (ActionSet != nullptr)
+		{
+			OutBundleAssetList.Add(ActionSet->GetPrimaryAssetId());
+		}
+	}
+}
+
+void UBotaniExperienceManager::GetGameFeaturePluginURLs(const UBotaniExperienceDefinition* Experience, TArray<FString>& OutPluginURLs)
+{
+	check(Experience);
+
+	auto CollectGameFeaturePluginURLs = [&OutPluginURLs](const UPrimaryDataAsset* Context, const TArray<FString>& FeaturePluginList)
+	{
+		for (const FString& PluginName : FeaturePluginList)
+		{
+			FString PluginURL;
+			if (UGameFeaturesSubsystem::Get().GetPluginURLByName(PluginName, /*out*/ PluginURL))
+			{
+				OutPluginURLs.AddUnique(PluginURL);
+			}
+			else
+			{
+				ensureMsgf(false, TEXT("OnExperienceLoadComplete failed to find plugin URL from PluginName %s for experience %s - fix data, ignoring for this run"), *PluginName, *Context->GetPrimaryAssetId().ToString());
+			}
+		}
+	};
+
+	CollectGameFeaturePluginURLs(Experience, Experience->GameFeaturesToEnable);
+	for (const TObjectPtr<UBotaniExperienceActionSet>& ActionSet : Experience->FeatureActionSets)
+	{
+		if (ActionSet != nullptr)
+		{
+			CollectGameFeaturePluginURLs(ActionSet, ActionSet->GameFeaturesToEnable);
+		}
+	}
+}
+
+void UBotaniExperienceManager::GetDeferredGameFeaturePluginURLs(const UBotaniExperienceDefinition* Experience, TArray<FString>& OutPluginURLs)
+{
+	check(Experience);
+
+	auto CollectDeferredPluginURLs = [&OutPluginURLs](const TArray<FString>& DeferredPluginList)
+	{
+		for (const FString& PluginName : DeferredPluginList)
+		{
+			FString PluginURL;
+			if (UGameFeaturesSubsystem::Get().GetPluginURLByName(PluginName, /*out*/ PluginURL))
+			{
+				OutPluginURLs.AddUnique(PluginURL);
+			}
+		}
+	};
+
+	CollectDeferredPluginURLs(Experience->DeferredGameFeatures);
+	for (const TObjectPtr<UBotaniExperienceActionSet>& ActionSet : Experience->FeatureActionSets)
+	{
+		if (ActionSet != nullptr)
+		{
+			CollectDeferredPluginURLs(ActionSet->DeferredGameFeatures);
+		}
+	}
+}
+
+void UBotaniExperienceManager::OnPrestageExperienceLoaded()
+{
+	if (!PrestagedExperienceId.IsValid())
+	{
+		return;
+	}
+
+	UBotaniAssetManager& AssetManager = UBotaniAssetManager::Get();
+
+	const TSubclassOf<UBotaniExperienceDefinition> ExperienceClass = AssetManager.GetPrimaryAssetObjectClass<UBotaniExperienceDefinition>(PrestagedExperienceId);
+	if (ExperienceClass == nullptr)
+	{
+		UE_LOG(LogBotaniExperience, Warning, TEXT("EXPERIENCE: Failed to pre-stage %s, the experience could not be loaded"), *PrestagedExperienceId.ToString());
+		CancelPrestagedExperience();
+		return;
+	}
+
+	const UBotaniExperienceDefinition* Experience = GetDefault<UBotaniExperienceDefinition>(ExperienceClass);
+
+	TSet<FPrimaryAssetId> BundleAssetList;
+	GetBundleAssetList(Experience, BundleAssetList);
+	for (const FPrimaryAssetId& AssetId : BundleAssetList)
+	{
+		if (!AssetManager.GetPrimaryAssetHandle(AssetId).IsValid())
+		{
+			PrestagedAssetIds.AddUnique(AssetId);
+		}
+	}
+
+	GetGameFeaturePluginURLs(Experience, PrestagedPluginURLs);
+	for (const FString& PluginURL : PrestagedPluginURLs)
+	{
+		// Plugins that are already active are shared with the current experience, they will simply be retained
+		if (!UGameFeaturesSubsystem::Get().IsGameFeaturePluginActive(PluginURL))
+		{
+			PendingPrestagePluginURLs.Add(PluginURL);
+		}
+	}
+
+	PrestageLoadHandle = AssetManager.ChangeBundleStateForPrimaryAssets(BundleAssetList.Array(), PrestagedBundles, {}, false, FStreamableDelegate(), FStreamableManager::DefaultAsyncLoadPriority);
+	if (!PrestageLoadHandle.IsValid() || PrestageLoadHandle->HasLoadCompleted())
+	{
+		OnPrestageBundlesLoaded();
+	}
+	else
+	{
+		PrestageLoadHandle->BindCompleteDelegate(FStreamableDelegate::CreateUObject(this, &ThisClass::OnPrestageBundlesLoaded));
+		PrestageLoadHandle->BindUpdateDelegate(FStreamableUpdateDelegate::CreateUObject(this, &ThisClass::OnPrestageLoadUpdate));
+	}
+}
+
+void UBotaniExperienceManager::OnPrestageBundlesLoaded()
+{
+	if (!PrestagedExperienceId.IsValid())
+	{
+		return;
+	}
+
+	UE_LOG(LogBotaniExperience, Log, TEXT("EXPERIENCE: Pre-staged bundles of %s, loading %d of %d game feature plugins"),
+		*PrestagedExperienceId.ToString(), PendingPrestagePluginURLs.Num(), PrestagedPluginURLs.Num());
+
+	LoadNextPrestagedPlugin();
+}
+
+void UBotaniExperienceManager::LoadNextPrestagedPlugin()
+{
+	if (PendingPrestagePluginURLs.IsEmpty())
+	{
+		return;
+	}
+
+	if (IsPrestageOverBudget())
+	{
+		UE_LOG(LogBotaniExperience, Warning, TEXT("EXPERIENCE: Pre-staging %s went over the memory budget of %d MB, cancelling"),
+			*PrestagedExperienceId.ToString(), BotaniConsoleVariables::ExperiencePrestageMemoryBudgetMB);
+		CancelPrestagedExperience();
+		return;
+	}
+
+	// Plugins are loaded one after another, this is a background job and shouldn't compete with the running match
+	const FString PluginURL = PendingPrestagePluginURLs[0];
+	PendingPrestagePluginURLs.RemoveAt(0);
+	PrestageLoadedPluginURLs.AddUnique(PluginURL);
+
+	UGameFeaturesSubsystem::Get().LoadGameFeaturePlugin(PluginURL, FGameFeaturePluginLoadComplete::CreateUObject(this, &ThisClass::OnPrestagedPluginLoaded));
+}
+
+void UBotaniExperienceManager::OnPrestagedPluginLoaded(const UE::GameFeatures::FResult& Result)
+{
+	if (Result.HasError())
+	{
+		UE_LOG(LogBotaniExperience, Warning, TEXT("EXPERIENCE: Failed to pre-stage a game feature plugin for %s: %s"),
+			*PrestagedExperienceId.ToString(), *Result.GetError());
+	}
+
+	if (PrestagedExperienceId.IsValid())
+	{
+		LoadNextPrestagedPlugin();
+	}
+}
+
+void UBotaniExperienceManager::OnPrestageLoadUpdate(TSharedRef<FStreamableHandle> Handle)
+{
+	if (IsPrestageOverBudget())
+	{
+		UE_LOG(LogBotaniExperience, Warning, TEXT("EXPERIENCE: Pre-staging %s went over the memory budget of %d MB, cancelling"),
+			*PrestagedExperienceId.ToString(), BotaniConsoleVariables::ExperiencePrestageMemoryBudgetMB);
+		CancelPrestagedExperience();
+	}
+}
+
+bool UBotaniExperienceManager::IsPrestageOverBudget() const
+{
+	const uint64 MemoryBudget = static_cast<uint64>(FMath::Max(BotaniConsoleVariables::ExperiencePrestageMemoryBudgetMB, 0)) * 1024 * 1024;
+	const uint64 UsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+
+	return UsedPhysical > PrestageBaselineMemory && (UsedPhysical - PrestageBaselineMemory) > MemoryBudget;
+}
+
+void UBotaniExperienceManager::ReleasePrestagedExperience(const TArray<FString>& PluginURLsToKeep, bool bUnloadAssets)
+{
+	if (PrestageLoadHandle.IsValid())
+	{
+		PrestageLoadHandle->BindCompleteDelegate(FStreamableDelegate());
+		PrestageLoadHandle->BindUpdateDelegate(FStreamableUpdateDelegate());
+
+		if (bUnloadAssets)
+		{
+			PrestageLoadHandle->CancelHandle();
+		}
+		else
+		{
+			PrestageLoadHandle->ReleaseHandle();
+		}
+
+		PrestageLoadHandle.Reset();
+	}
+
+	if (bUnloadAssets && PrestagedAssetIds.Num() > 0)
+	{
+		UBotaniAssetManager::Get().UnloadPrimaryAssets(PrestagedAssetIds);
+	}
+
+	for (const FString& PluginURL : RetainedPluginURLs)
+	{
+		if (!PluginURLsToKeep.Contains(PluginURL))
+		{
+			UGameFeaturesSubsystem::Get().DeactivateGameFeaturePlugin(PluginURL);
+		}
+	}
+
+	for (const FString& PluginURL : PrestageLoadedPluginURLs)
+	{
+		if (!PluginURLsToKeep.Contains(PluginURL) && !UGameFeaturesSubsystem::Get().IsGameFeaturePluginActive(PluginURL, /*bCheckForActivating=*/ true))
+		{
+			UGameFeaturesSubsystem::Get().UnloadGameFeaturePlugin(PluginURL);
+		}
+	}
+
+	PrestagedExperienceId = FPrimaryAssetId();
+	PrestagedBundles.Reset();
+	PrestagedAssetIds.Reset();
+	PrestagedPluginURLs.Reset();
+	PendingPrestagePluginURLs.Reset();
+	PrestageLoadedPluginURLs.Reset();
+	RetainedPluginURLs.Reset();
+	PrestageBaselineMemory = 0;
+}
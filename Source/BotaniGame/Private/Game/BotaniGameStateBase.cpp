@@ -5,6 +5,7 @@
 
 #include "AbilitySystem/BotaniAbilitySystemComponent.h"
 #include "Game/Components/BotaniExperienceManagerComponent.h"
+#include "GameplayTags/BotaniGameplayTags.h"
 #include "Net/UnrealNetwork.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(BotaniGameStateBase)
@@ -25,6 +26,10 @@ ABotaniGameStateBase::ABotaniGameStateBase(const FObjectInitializer& ObjectIniti
 	ExperienceManagerComponent = ObjectInitializer.CreateDefaultSubobject<UBotaniExperienceManagerComponent>(this, TEXT("ExperienceManagerComponent"));
 	
 	ServerFPS = 0.0f;
+
+	// Damage messages only matter to the players dealing or taking the damage
+	VerbMessages.SetOwner(this);
+	VerbMessages.SetVerbRelevancy(BotaniGameplayTags::Ability::Message::TAG_Damage_Message, FBotaniVerbMessageRelevancy::CreateStatic(&ThisClass::IsVerbMessageRelevantToInvolvedPlayers));
 }
 
 void ABotaniGameStateBase::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
@@ -32,6 +37,7 @@ void ABotaniGameStateBase::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>&
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
 	DOREPLIFETIME(ThisClass, ServerFPS);
+	DOREPLIFETIME(ThisClass, VerbMessages);
 }
 
 void ABotaniGameStateBase::PostInitializeComponents()
@@ -49,6 +55,7 @@ void ABotaniGameStateBase::Tick(float DeltaSeconds)
 	if (GetLocalRole() == ROLE_Authority)
 	{
 		ServerFPS = GAverageFPS;
+		VerbMessages.ExpireMessages();
 	}
 }
 
@@ -56,3 +63,29 @@ UAbilitySystemComponent* ABotaniGameStateBase::GetAbilitySystemComponent() const
 {
 	return AbilitySystemComponent;
 }
+
+void ABotaniGameStateBase::SendVerbMessageToClients(const FBotaniVerbMessage& Message)
+{
+	if (GetNetMode() == NM_Client)
+	{
+		return;
+	}
+
+	VerbMessages.AddMessage(Message);
+}
+
+void ABotaniGameStateBase::SetVerbMessageRelevancy(FGameplayTag VerbTag, const FBotaniVerbMessageRelevancy& Relevancy)
+{
+	VerbMessages.SetVerbRelevancy(VerbTag, Relevancy);
+}
+
+bool ABotaniGameStateBase::IsVerbMessageRelevantToInvolvedPlayers(const FBotaniVerbMessage& Message, const UNetConnection* Connection)
+{
+	auto IsOwnedByConnection = [Connection](const UObject* Object)
+	{
+		const AActor* Actor = Cast<AActor>(Object);
+		return Actor && (Actor->GetNetConnection() == Connection);
+	};
+
+	return IsOwnedByConnection(Message.Instigator.Get()) || IsOwnedByConnection(Message.Target.Get());
+}
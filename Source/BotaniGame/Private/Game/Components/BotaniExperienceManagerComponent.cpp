@@ -13,6 +13,8 @@
 #include "BotaniLogChannels.h"
 #include "Game/BotaniExperienceManager.h"
 #include "GameFeatures/Data/BotaniExperienceActionSet.h"
+#include "Interfaces/IPluginManager.h"
+#include "Algo/AllOf.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(BotaniExperienceManagerComponent)
 
@@ -41,6 +43,13 @@ namespace BotaniConsoleVariables
 		TEXT("A random amount of time between 0 and this value (in seconds) will be added as a delay of load completion of the experience (along with the fixed value Botani.chaos.ExperienceDelayLoad.MinSecs)"),
 		ECVF_Default);
 
+	static int32 MaxConcurrentPluginActivations = 4;
+	static FAutoConsoleVariableRef CVarMaxConcurrentPluginActivations(
+		TEXT("botani.Experience.MaxConcurrentPluginActivations"),
+		MaxConcurrentPluginActivations,
+		TEXT("Maximum number of game feature plugins an experience loads and activates at the same time (0 = unlimited)"),
+		ECVF_Default);
+
 	float GetExperienceLoadDelayDuration()
 	{
 		return FMath::Max(0.0f, ExperienceLoadRandomDelayMin + FMath::FRand() * ExperienceLoadRandomDelayRange);
@@ -67,6 +76,15 @@ void UBotaniExperienceManagerComponent::SetCurrentExperience(FPrimaryAssetId Exp
 	StartExperienceLoad();
 }
 
+void UBotaniExperienceManagerComponent::PrestageNextExperience(FPrimaryAssetId ExperienceId)
+{
+	UBotaniExperienceManager* ExperienceManagerSubsystem = GEngine->GetEngineSubsystem<UBotaniExperienceManager>();
+	check(ExperienceManagerSubsystem);
+
+	// Replaying the same experience is fine too, nothing needs to be loaded then and all plugins are retained
+	ExperienceManagerSubsystem->PrestageExperience(ExperienceId, GetOwner()->GetNetMode());
+}
+
 void UBotaniExperienceManagerComponent::CallOrRegister_OnExperienceLoaded_HighPriority(FOnBotaniExperienceLoaded::FDelegate&& Delegate)
 {
 	if (IsExperienceLoaded())
@@ -136,32 +154,12 @@ void UBotaniExperienceManagerComponent::StartExperienceLoad()
 	TSet<FPrimaryAssetId> BundleAssetList;
 	TSet<FSoftObjectPath> RawAssetList;
 
-	BundleAssetList.Add(CurrentExperience->GetPrimaryAssetId());
-	for (const TObjectPtr<UBotaniExperienceActionSet>& ActionSet : CurrentExperience->FeatureActionSets)
-	{
-		if (ActionSet != nullptr)
-		{
-			BundleAssetList.Add(ActionSet->GetPrimaryAssetId());
-		}
-	}
+	UBotaniExperienceManager::GetBundleAssetList(CurrentExperience, BundleAssetList);
 
 	// Load assets associated with the experience
 
 	TArray<FName> BundlesToLoad;
-	BundlesToLoad.Add(FBotaniBundles::Equipped);
-
-	//@TODO: Centralize this client/server stuff into the BotaniAssetManager
-	const ENetMode OwnerNetMode = GetOwner()->GetNetMode();
-	const bool bLoadClient = GIsEditor || (OwnerNetMode != NM_DedicatedServer);
-	const bool bLoadServer = GIsEditor || (OwnerNetMode != NM_Client);
-	if (bLoadClient)
-	{
-		BundlesToLoad.Add(UGameFeaturesSubsystemSettings::LoadStateClient);
-	}
-	if (bLoadServer)
-	{
-		BundlesToLoad.Add(UGameFeaturesSubsystemSettings::LoadStateServer);
-	}
+	UBotaniExperienceManager::GetBundlesToLoad(GetOwner()->GetNetMode(), BundlesToLoad);
 
 	TSharedPtr<FStreamableHandle> BundleLoadHandle = nullptr;
 	if (BundleAssetList.Num() > 0)
@@ -222,68 +220,237 @@ void UBotaniExperienceManagerComponent::OnExperienceLoadComplete()
 
 	// find the URLs for our GameFeaturePlugins - filtering out dupes and ones that don't have a valid mapping
 	GameFeaturePluginURLs.Reset();
+	UBotaniExperienceManager::GetGameFeaturePluginURLs(CurrentExperience, GameFeaturePluginURLs);
+
+	// Take over anything that was pre-staged for us, plugins shared with the previous experience are still active
+	UBotaniExperienceManager::ClaimPrestagedExperience(CurrentExperience->GetPrimaryAssetId(), GameFeaturePluginURLs);
+
+	int32 NumWarmPlugins = 0;
+	for (const FString& PluginURL : GameFeaturePluginURLs)
+	{
+		if (UGameFeaturesSubsystem::Get().IsGameFeaturePluginActive(PluginURL))
+		{
+			++NumWarmPlugins;
+		}
+	}
+
+	if (NumWarmPlugins > 0)
+	{
+		UE_LOG(LogBotaniExperience, Log, TEXT("EXPERIENCE: %d of %d game feature plugins are already active (%s)"),
+			NumWarmPlugins, GameFeaturePluginURLs.Num(), *GetClientServerContextString(this));
+	}
+
+	// Load and activate the features
+	for (const FString& PluginURL : GameFeaturePluginURLs)
+	{
+		UBotaniExperienceManager::NotifyOfPluginActivation(PluginURL);
+	}
+
+	InitializePluginActivations();
 
-	auto CollectGameFeaturePluginURLs = [This=this](const UPrimaryDataAsset* Context, const TArray<FString>& FeaturePluginList)
+	if (NumGameFeaturePluginsLoading > 0)
+	{
+		LoadingState = EBotaniExperienceLoadingState::LoadingGameFeatures;
+		PumpPluginActivations();
+	}
+	else
+	{
+		OnExperienceFullLoadCompleted();
+	}
+}
+
+void UBotaniExperienceManagerComponent::InitializePluginActivations()
+{
+	PluginActivations.Reset();
+	NumPluginActivationsInFlight = 0;
+	bDeferredPluginActivationsReleased = false;
+
+	TArray<FString> DeferredPluginURLs;
+	UBotaniExperienceManager::GetDeferredGameFeaturePluginURLs(CurrentExperience, DeferredPluginURLs);
+
+	TMap<FString, int32> ActivationIndexByName;
+	for (const FString& PluginURL : GameFeaturePluginURLs)
+	{
+		FBotaniGameFeaturePluginActivation& Activation = PluginActivations.AddDefaulted_GetRef();
+		Activation.PluginURL = PluginURL;
+		Activation.PluginName = FPaths::GetBaseFilename(PluginURL);
+		Activation.bDeferred = DeferredPluginURLs.Contains(PluginURL);
+
+		ActivationIndexByName.Add(Activation.PluginName, PluginActivations.Num() - 1);
+	}
+
+	// Only dependencies on plugins that are part of this experience need to be respected, the rest is handled by the plugin state machine
+	for (FBotaniGameFeaturePluginActivation& Activation : PluginActivations)
 	{
-		for (const FString& PluginName : FeaturePluginList)
+		const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(Activation.PluginName);
+		if (!Plugin.IsValid())
+		{
+			continue;
+		}
+
+		for (const FPluginReferenceDescriptor& PluginReference : Plugin->GetDescriptor().Plugins)
 		{
-			FString PluginURL;
-			if (UGameFeaturesSubsystem::Get().GetPluginURLByName(PluginName, /*out*/ PluginURL))
+			if (const int32* DependencyIndex = ActivationIndexByName.Find(PluginReference.Name))
 			{
-				This->GameFeaturePluginURLs.AddUnique(PluginURL);
+				Activation.Dependencies.AddUnique(*DependencyIndex);
 			}
-			else
+		}
+	}
+
+	// A gameplay-critical plugin can't wait on a deferred one, so promote whatever critical plugins depend on
+	bool bPromotedAny = true;
+	while (bPromotedAny)
+	{
+		bPromotedAny = false;
+		for (const FBotaniGameFeaturePluginActivation& Activation : PluginActivations)
+		{
+			if (Activation.bDeferred)
 			{
-				ensureMsgf(false, TEXT("OnExperienceLoadComplete failed to find plugin URL from PluginName %s for experience %s - fix data, ignoring for this run"), *PluginName, *Context->GetPrimaryAssetId().ToString());
+				continue;
 			}
-		}
 
-		// 		// Add in our extra plugin
-		// 		if (!CurrentPlaylistData->GameFeaturePluginToActivateUntilDownloadedContentIsPresent.IsEmpty())
-		// 		{
-		// 			FString PluginURL;
-		// 			if (UGameFeaturesSubsystem::Get().GetPluginURLByName(CurrentPlaylistData->GameFeaturePluginToActivateUntilDownloadedContentIsPresent, PluginURL))
-		// 			{
-		// 				GameFeaturePluginURLs.AddUnique(PluginURL);
-		// 			}
-		// 		}
-	};
+			for (const int32 DependencyIndex : Activation.Dependencies)
+			{
+				FBotaniGameFeaturePluginActivation& Dependency = PluginActivations[DependencyIndex];
+				if (Dependency.bDeferred)
+				{
+					UE_LOG(LogBotaniExperience, Warning, TEXT("EXPERIENCE: Deferred plugin %s is required by %s and won't be deferred"), *Dependency.PluginName, *Activation.PluginName);
+					Dependency.bDeferred = false;
+					bPromotedAny = true;
+				}
+			}
+		}
+	}
 
-	CollectGameFeaturePluginURLs(CurrentExperience, CurrentExperience->GameFeaturesToEnable);
-	for (const TObjectPtr<UBotaniExperienceActionSet>& ActionSet : CurrentExperience->FeatureActionSets)
+	NumGameFeaturePluginsLoading = 0;
+	for (const FBotaniGameFeaturePluginActivation& Activation : PluginActivations)
 	{
-		if (ActionSet != nullptr)
+		if (!Activation.bDeferred)
 		{
-			CollectGameFeaturePluginURLs(ActionSet, ActionSet->GameFeaturesToEnable);
+			++NumGameFeaturePluginsLoading;
 		}
 	}
+}
 
-	// Load and activate the features	
-	NumGameFeaturePluginsLoading = GameFeaturePluginURLs.Num();
-	if (NumGameFeaturePluginsLoading > 0)
+void UBotaniExperienceManagerComponent::PumpPluginActivations()
+{
+	if (bIsPumpingPluginActivations)
 	{
-		LoadingState = EBotaniExperienceLoadingState::LoadingGameFeatures;
-		for (const FString& PluginURL : GameFeaturePluginURLs)
+		// Something completed synchronously while we were starting plugins, run another pass once we're done
+		bPluginActivationPumpRequested = true;
+		return;
+	}
+
+	TGuardValue<bool> PumpGuard(bIsPumpingPluginActivations, true);
+
+	const int32 MaxInFlight = BotaniConsoleVariables::MaxConcurrentPluginActivations;
+
+	do
+	{
+		bPluginActivationPumpRequested = false;
+
+		for (int32 ActivationIndex = 0; ActivationIndex < PluginActivations.Num(); ++ActivationIndex)
 		{
-			UBotaniExperienceManager::NotifyOfPluginActivation(PluginURL);
-			UGameFeaturesSubsystem::Get().LoadAndActivateGameFeaturePlugin(PluginURL, FGameFeaturePluginLoadComplete::CreateUObject(this, &ThisClass::OnGameFeaturePluginLoadComplete));
+			if (MaxInFlight > 0 && NumPluginActivationsInFlight >= MaxInFlight)
+			{
+				break;
+			}
+
+			FBotaniGameFeaturePluginActivation& Activation = PluginActivations[ActivationIndex];
+			if (Activation.State != FBotaniGameFeaturePluginActivation::EState::Pending)
+			{
+				continue;
+			}
+
+			if (Activation.bDeferred && !bDeferredPluginActivationsReleased)
+			{
+				continue;
+			}
+
+			const bool bDependenciesReady = Algo::AllOf(Activation.Dependencies, [this](int32 DependencyIndex)
+			{
+				return PluginActivations[DependencyIndex].State == FBotaniGameFeaturePluginActivation::EState::Done;
+			});
+
+			if (!bDependenciesReady)
+			{
+				continue;
+			}
+
+			++NumPluginActivationsInFlight;
+			Activation.StartTime = FPlatformTime::Seconds();
+
+			// Plugins retained from the previous experience are still active, loading them on their own would deactivate them again
+			if (UGameFeaturesSubsystem::Get().IsGameFeaturePluginActive(Activation.PluginURL))
+			{
+				Activation.State = FBotaniGameFeaturePluginActivation::EState::Activating;
+				Activation.LoadedTime = Activation.StartTime;
+				UGameFeaturesSubsystem::Get().LoadAndActivateGameFeaturePlugin(Activation.PluginURL, FGameFeaturePluginLoadComplete::CreateUObject(this, &ThisClass::OnGameFeaturePluginActivated, ActivationIndex));
+			}
+			else
+			{
+				Activation.State = FBotaniGameFeaturePluginActivation::EState::Loading;
+				UGameFeaturesSubsystem::Get().LoadGameFeaturePlugin(Activation.PluginURL, FGameFeaturePluginLoadComplete::CreateUObject(this, &ThisClass::OnGameFeaturePluginLoaded, ActivationIndex));
+			}
 		}
 	}
-	else
+	while (bPluginActivationPumpRequested);
+}
+
+void UBotaniExperienceManagerComponent::OnGameFeaturePluginLoaded(const UE::GameFeatures::FResult& Result, int32 ActivationIndex)
+{
+	if (!PluginActivations.IsValidIndex(ActivationIndex))
 	{
-		OnExperienceFullLoadCompleted();
+		return;
 	}
+
+	FBotaniGameFeaturePluginActivation& Activation = PluginActivations[ActivationIndex];
+	Activation.LoadedTime = FPlatformTime::Seconds();
+
+	if (Result.HasError())
+	{
+		UE_LOG(LogBotaniExperience, Error, TEXT("EXPERIENCE: Failed to load game feature plugin %s: %s"), *Activation.PluginName, *Result.GetError());
+		OnGameFeaturePluginActivated(Result, ActivationIndex);
+		return;
+	}
+
+	Activation.State = FBotaniGameFeaturePluginActivation::EState::Activating;
+	UGameFeaturesSubsystem::Get().ChangeGameFeatureTargetState(Activation.PluginURL, EGameFeatureTargetState::Active, FGameFeaturePluginChangeStateComplete::CreateUObject(this, &ThisClass::OnGameFeaturePluginActivated, ActivationIndex));
 }
 
-void UBotaniExperienceManagerComponent::OnGameFeaturePluginLoadComplete(const UE::GameFeatures::FResult& Result)
+void UBotaniExperienceManagerComponent::OnGameFeaturePluginActivated(const UE::GameFeatures::FResult& Result, int32 ActivationIndex)
 {
-	// decrement the number of plugins that are loading
-	NumGameFeaturePluginsLoading--;
+	if (!PluginActivations.IsValidIndex(ActivationIndex))
+	{
+		return;
+	}
+
+	FBotaniGameFeaturePluginActivation& Activation = PluginActivations[ActivationIndex];
+	check(Activation.State != FBotaniGameFeaturePluginActivation::EState::Done);
 
-	if (NumGameFeaturePluginsLoading == 0)
+	Activation.State = FBotaniGameFeaturePluginActivation::EState::Done;
+	Activation.ActivatedTime = FPlatformTime::Seconds();
+	--NumPluginActivationsInFlight;
+
+	UE_LOG(LogBotaniExperience, Log, TEXT("EXPERIENCE: Game feature plugin %s%s loaded in %.2f ms, activated in %.2f ms (%s)"),
+		*Activation.PluginName,
+		Activation.bDeferred ? TEXT(" (deferred)") : TEXT(""),
+		(Activation.LoadedTime - Activation.StartTime) * 1000.0,
+		(Activation.ActivatedTime - Activation.LoadedTime) * 1000.0,
+		*GetClientServerContextString(this));
+
+	if (!Activation.bDeferred)
 	{
-		OnExperienceFullLoadCompleted();
+		// decrement the number of plugins that are loading
+		NumGameFeaturePluginsLoading--;
+
+		if (NumGameFeaturePluginsLoading == 0 && LoadingState == EBotaniExperienceLoadingState::LoadingGameFeatures)
+		{
+			OnExperienceFullLoadCompleted();
+		}
 	}
+
+	PumpPluginActivations();
 }
 
 void UBotaniExperienceManagerComponent::OnExperienceFullLoadCompleted()
@@ -343,6 +510,7 @@ void UBotaniExperienceManagerComponent::OnExperienceFullLoadCompleted()
 	}
 
 	LoadingState = EBotaniExperienceLoadingState::Loaded;
+	ILoadingProcessInterface::NotifyLoadingStateChanged(this);
 
 	OnExperienceLoaded_HighPriority.Broadcast(CurrentExperience);
 	OnExperienceLoaded_HighPriority.Clear();
@@ -353,6 +521,10 @@ void UBotaniExperienceManagerComponent::OnExperienceFullLoadCompleted()
 	OnExperienceLoaded_LowPriority.Broadcast(CurrentExperience);
 	OnExperienceLoaded_LowPriority.Clear();
 
+	// Now that gameplay is ready, the plugins that aren't needed for it can follow
+	bDeferredPluginActivationsReleased = true;
+	PumpPluginActivations();
+
 	/*// Apply any necessary scalability settings
 #if !UE_SERVER
 	UBotaniSettingsLocal::Get()->OnExperienceLoaded();
@@ -392,15 +564,27 @@ void UBotaniExperienceManagerComponent::EndPlay(const EEndPlayReason::Type EndPl
 	Super::EndPlay(EndPlayReason);
 
 	// deactivate any features this experience loaded
+	// plugins the pre-staged experience shares with us stay active, so the next experience doesn't have to reactivate them
 	//@TODO: This should be handled FILO as well
 	for (const FString& PluginURL : GameFeaturePluginURLs)
 	{
 		if (UBotaniExperienceManager::RequestToDeactivatePlugin(PluginURL))
 		{
-			UGameFeaturesSubsystem::Get().DeactivateGameFeaturePlugin(PluginURL);
+			if (UBotaniExperienceManager::ShouldRetainPlugin(PluginURL))
+			{
+				UBotaniExperienceManager::NotifyOfRetainedPlugin(PluginURL);
+			}
+			else
+			{
+				UGameFeaturesSubsystem::Get().DeactivateGameFeaturePlugin(PluginURL);
+			}
 		}
 	}
 
+	// Drop the activation pipeline, so plugins still completing in the background are ignored
+	PluginActivations.Reset();
+	NumPluginActivationsInFlight = 0;
+
 	//@TODO: Ensure proper handling of a partially-loaded state too
 	if (LoadingState == EBotaniExperienceLoadingState::Loaded)
 	{
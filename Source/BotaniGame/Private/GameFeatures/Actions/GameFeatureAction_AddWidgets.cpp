@@ -161,11 +161,20 @@ void UGameFeatureAction_AddWidgets::AddWidgets(AActor* Actor, FPerContextData& A
 			}
 		}
 
-		UUIExtensionSubsystem* ExtensionSubsystem = HUD->GetWorld()->GetSubsystem<UUIExtensionSubsystem>();
+		// Register all widgets in one batch, so every extension point widget rebuilds once
+		TArray<FUIExtensionRequest> ExtensionRequests;
+		ExtensionRequests.Reserve(WidgetExtensions.Num());
 		for (const FBotaniHUDElementEntry& Entry : WidgetExtensions)
 		{
-			ActorData.ExtensionHandles.Add(ExtensionSubsystem->RegisterExtensionAsWidgetForContext(Entry.SlotID, LocalPlayer, Entry.WidgetClass.LoadSynchronous(), -1));
+			FUIExtensionRequest& Request = ExtensionRequests.AddDefaulted_GetRef();
+			Request.ExtensionPointTag = Entry.SlotID;
+			Request.ContextObject = LocalPlayer;
+			Request.Data = Entry.WidgetClass.LoadSynchronous();
+			Request.Priority = -1;
 		}
+
+		UUIExtensionSubsystem* ExtensionSubsystem = HUD->GetWorld()->GetSubsystem<UUIExtensionSubsystem>();
+		ActorData.ExtensionHandles.Append(ExtensionSubsystem->RegisterExtensionsAsData(ExtensionRequests));
 	}
 	else
 	{
@@ -190,9 +199,9 @@ void UGameFeatureAction_AddWidgets::RemoveWidgets(AActor* Actor, FPerContextData
 			}
 		}
 
-		for (FUIExtensionHandle& Handle : ActorData->ExtensionHandles)
+		if (UUIExtensionSubsystem* ExtensionSubsystem = HUD->GetWorld()->GetSubsystem<UUIExtensionSubsystem>())
 		{
-			Handle.Unregister();
+			ExtensionSubsystem->UnregisterExtensions(ActorData->ExtensionHandles);
 		}
 		ActiveData.ActorData.Remove(HUD);
 	}
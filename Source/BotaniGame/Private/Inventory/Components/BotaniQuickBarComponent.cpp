@@ -3,6 +3,7 @@
 
 #include "Inventory/Components/BotaniQuickBarComponent.h"
 
+#include "BotaniLogChannels.h"
 #include "GameFramework/GameplayMessageSubsystem.h"
 #include "GameplayTags/BotaniGameplayTags.h"
 #include "Inventory/BotaniInventoryStatics.h"
@@ -16,8 +17,34 @@
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(BotaniQuickBarComponent)
 
+void FBotaniQuickBarSlotList::PreReplicatedRemove(const TArrayView<int32> RemovedIndices, int32 FinalSize)
+{
+	for (const int32 Index : RemovedIndices)
+	{
+		QuickBar->HandleSlotChanged(Slots[Index].SlotIndex, nullptr);
+	}
+}
+
+void FBotaniQuickBarSlotList::PostReplicatedAdd(const TArrayView<int32> AddedIndices, int32 FinalSize)
+{
+	for (const int32 Index : AddedIndices)
+	{
+		QuickBar->HandleSlotChanged(Slots[Index].SlotIndex, Slots[Index].ItemInstance);
+	}
+}
+
+void FBotaniQuickBarSlotList::PostReplicatedChange(const TArrayView<int32> ChangedIndices, int32 FinalSize)
+{
+	for (const int32 Index : ChangedIndices)
+	{
+		QuickBar->HandleSlotChanged(Slots[Index].SlotIndex, Slots[Index].ItemInstance);
+	}
+}
+
+
 UBotaniQuickBarComponent::UBotaniQuickBarComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
+	, SlotList(this)
 {
 	SetIsReplicatedByDefault(true);
 }
@@ -30,7 +57,7 @@ void UBotaniQuickBarComponent::GetLifetimeReplicatedProps(TArray< FLifetimePrope
 	Params.bIsPushBased = true;
 	Params.Condition = COND_ReplayOrOwner;
 
-	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, Slots, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, SlotList, Params);
 	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, ActiveSlotIndex, Params);
 }
 
@@ -38,58 +65,103 @@ void UBotaniQuickBarComponent::BeginPlay()
 {
 	if (Slots.Num() < NumSlots)
 	{
+		FreeSlots.Add(true, NumSlots - Slots.Num());
 		Slots.AddDefaulted(NumSlots - Slots.Num());
 	}
 
-	MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, Slots, this);
+	// Slots replicate as individual items, clients receive them through the slot list callbacks
+	if (GetOwner()->HasAuthority() && (SlotList.Slots.Num() < NumSlots))
+	{
+		for (int32 SlotIndex = SlotList.Slots.Num(); SlotIndex < NumSlots; ++SlotIndex)
+		{
+			FBotaniQuickBarSlot& Slot = SlotList.Slots.AddDefaulted_GetRef();
+			Slot.SlotIndex = SlotIndex;
+			SlotList.MarkItemDirty(Slot);
+		}
+
+		MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, SlotList, this);
+	}
 	
 	Super::BeginPlay();
 }
 
 void UBotaniQuickBarComponent::CycleActiveSlotForward()
+{
+	CycleActiveSlot(1);
+}
+
+void UBotaniQuickBarComponent::CycleActiveSlotBackward()
+{
+	CycleActiveSlot(-1);
+}
+
+void UBotaniQuickBarComponent::CycleActiveSlot(int32 Direction)
 {
 	if (Slots.Num() < 2)
 	{
 		return;
 	}
 
-	const int32 OldIdx = (ActiveSlotIndex < 0 ? Slots.Num() - 1 : ActiveSlotIndex);
-	int32 NewIdx = ActiveSlotIndex;
+	// Continue from the slot requested last, rapid input would otherwise keep requesting the same slot until the server replied
+	const int32 CurrentIdx = GetPredictedActiveSlotIndex();
+	const int32 OldIdx = (CurrentIdx < 0 ? Slots.Num() - 1 : CurrentIdx);
+	int32 NewIdx = CurrentIdx;
 
 	do
 	{
-		NewIdx = (NewIdx + 1) % Slots.Num();
+		NewIdx = (NewIdx + Direction + Slots.Num()) % Slots.Num();
 
 		if (Slots[NewIdx] != nullptr)
 		{
-			SetActiveSlotIndex(NewIdx);
+			RequestActiveSlotIndex(NewIdx);
 			return;
 		}
 	}
 	while (NewIdx != OldIdx);
 }
 
-void UBotaniQuickBarComponent::CycleActiveSlotBackward()
+void UBotaniQuickBarComponent::RequestActiveSlotIndex(int32 NewIndex)
 {
-	if (Slots.Num() < 2)
+	if (NewIndex == GetPredictedActiveSlotIndex())
 	{
 		return;
 	}
 
-	const int32 OldIdx = (ActiveSlotIndex < 0 ? Slots.Num() - 1 : ActiveSlotIndex);
-	int32 NewIdx = ActiveSlotIndex;
-
-	do
+	if (GetOwner() && GetOwner()->HasAuthority())
 	{
-		NewIdx = (NewIdx - 1 + Slots.Num()) % Slots.Num();
+		SetActiveSlotIndex(NewIndex);
+		return;
+	}
 
-		if (Slots[NewIdx] != nullptr)
+	// Only the last slot requested within a frame is sent, the server would otherwise equip every slot in between
+	PendingActiveSlotIndex = NewIndex;
+
+	if (!bActiveSlotRequestScheduled)
+	{
+		if (UWorld* World = GetWorld())
 		{
-			SetActiveSlotIndex(NewIdx);
-			return;
+			bActiveSlotRequestScheduled = true;
+			World->GetTimerManager().SetTimerForNextTick(FTimerDelegate::CreateUObject(this, &ThisClass::SendActiveSlotIndexRequest));
 		}
 	}
-	while (NewIdx != OldIdx);
+}
+
+void UBotaniQuickBarComponent::SendActiveSlotIndexRequest()
+{
+	bActiveSlotRequestScheduled = false;
+
+	if (PendingActiveSlotIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	SetActiveSlotIndex(PendingActiveSlotIndex);
+
+	// Cycled back to the confirmed slot, the server will not replicate a change that would clear the request
+	if (PendingActiveSlotIndex == ActiveSlotIndex)
+	{
+		PendingActiveSlotIndex = INDEX_NONE;
+	}
 }
 
 void UBotaniQuickBarComponent::SetActiveSlotIndex_Implementation(int32 NewIndex)
@@ -124,7 +196,14 @@ UBotaniEquipmentManager* UBotaniQuickBarComponent::FindEquipmentManager() const
 		return nullptr;
 	}
 
-	return Cast<UBotaniEquipmentManager>(UInventorySystemBlueprintLibrary::FindEquipmentManager(Pawn));
+	// The equipment manager lives on the pawn, resolve it again once the controller possesses another pawn
+	if ((CachedEquipmentPawn != Pawn) || !CachedEquipmentManager.IsValid())
+	{
+		CachedEquipmentPawn = Pawn;
+		CachedEquipmentManager = Cast<UBotaniEquipmentManager>(UInventorySystemBlueprintLibrary::FindEquipmentManager(Pawn));
+	}
+
+	return CachedEquipmentManager.Get();
 }
 
 UBotaniInventoryManager* UBotaniQuickBarComponent::FindInventoryManager() const
@@ -135,7 +214,12 @@ UBotaniInventoryManager* UBotaniQuickBarComponent::FindInventoryManager() const
 		return nullptr;
 	}
 
-	return Cast<UBotaniInventoryManager>(UInventorySystemBlueprintLibrary::FindInventoryManager(OwnerController));
+	if (!CachedInventoryManager.IsValid())
+	{
+		CachedInventoryManager = Cast<UBotaniInventoryManager>(UInventorySystemBlueprintLibrary::FindInventoryManager(OwnerController));
+	}
+
+	return CachedInventoryManager.Get();
 }
 
 AController* UBotaniQuickBarComponent::GetOwnerController() const
@@ -148,12 +232,14 @@ AController* UBotaniQuickBarComponent::GetOwnerController() const
 	return nullptr;
 }
 
-void UBotaniQuickBarComponent::BroadcastQuickBarMessage(const FGameplayTag& MessageTag)
+void UBotaniQuickBarComponent::BroadcastQuickBarMessage(const FGameplayTag& MessageTag, int32 SlotIndex)
 {
 	FBotaniQuickBarChangeMessage Message;
 	Message.Owner = GetOwnerController();
 	Message.QuickBar = this;
 	Message.Slots = Slots;
+	Message.SlotIndex = SlotIndex;
+	Message.SlotItem = Slots.IsValidIndex(SlotIndex) ? Slots[SlotIndex] : nullptr;
 	Message.ActiveSlotIndex = ActiveSlotIndex;
 	Message.EquippedItemHandle = EquippedItemHandle;
 
@@ -163,19 +249,13 @@ void UBotaniQuickBarComponent::BroadcastQuickBarMessage(const FGameplayTag& Mess
 
 int32 UBotaniQuickBarComponent::GetNextFreeItemSlot() const
 {
-	int32 SlotIdx = 0;
-
-	for (TObjectPtr<UBotaniItemInstance> SlotItem : Slots)
-	{
-		if (SlotItem == nullptr)
-		{
-			return SlotIdx;
-		}
-
-		SlotIdx++;
-	}
+	return FreeSlots.Find(true);
+}
 
-	return INDEX_NONE;
+int32 UBotaniQuickBarComponent::FindSlotIndexByHandle(const FGameplayInventoryItemSpecHandle& ItemHandle) const
+{
+	const int32* SlotIndex = SlotIndexByHandle.Find(ItemHandle);
+	return SlotIndex ? *SlotIndex : INDEX_NONE;
 }
 
 void UBotaniQuickBarComponent::AddItemToSlot(const int32 SlotIndex, const FGameplayInventoryItemSpecHandle& ItemHandle)
@@ -205,10 +285,7 @@ void UBotaniQuickBarComponent::AddItemToSlot(const int32 SlotIndex, const FGamep
 
 	UBotaniItemInstance* ItemInstance = CastChecked<UBotaniItemInstance>(MutableInstance);
 
-	Slots[SlotIndex] = ItemInstance;
-	MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, Slots, this);
-	
-	OnRep_Slots();
+	SetSlotItem(SlotIndex, ItemInstance);
 }
 
 UBotaniItemInstance* UBotaniQuickBarComponent::RemoveItemFromSlot(const int32 SlotIndex)
@@ -230,10 +307,7 @@ UBotaniItemInstance* UBotaniQuickBarComponent::RemoveItemFromSlot(const int32 Sl
 
 		if (Result != nullptr)
 		{
-			Slots[SlotIndex] = nullptr;
-			MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, Slots, this);
-			
-			OnRep_Slots();
+			SetSlotItem(SlotIndex, nullptr);
 		}
 	}
 	
@@ -253,30 +327,72 @@ UBotaniItemInstance* UBotaniQuickBarComponent::RemoveItemByHandle(const FGamepla
 		MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, ActiveSlotIndex, this);
 	}
 
-	// Try to find the item in the slots
-	for (int32 SlotIndex = 0; SlotIndex < Slots.Num(); SlotIndex++)
+	const int32 SlotIndex = FindSlotIndexByHandle(ItemHandle);
+	if (Slots.IsValidIndex(SlotIndex))
 	{
-		if (Slots[SlotIndex] != nullptr && Slots[SlotIndex]->GetItemSpecHandle() == ItemHandle)
-		{
-			Result = Slots[SlotIndex];
-			Slots[SlotIndex] = nullptr;
-			MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, Slots, this);
-			
-			OnRep_Slots();
-			break;
-		}
+		Result = Slots[SlotIndex];
+		SetSlotItem(SlotIndex, nullptr);
 	}
 
 	return Result;
 }
 
-void UBotaniQuickBarComponent::OnRep_Slots()
+void UBotaniQuickBarComponent::SetSlotItem(int32 SlotIndex, UBotaniItemInstance* ItemInstance)
 {
-	BroadcastQuickBarMessage(BotaniGameplayTags::Inventory::Message::TAG_InventoryMessage_QuickBar_SlotsChanged);
+	check(SlotList.Slots.IsValidIndex(SlotIndex));
+
+	FBotaniQuickBarSlot& Slot = SlotList.Slots[SlotIndex];
+	Slot.ItemInstance = ItemInstance;
+	SlotList.MarkItemDirty(Slot);
+	MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, SlotList, this);
+
+	HandleSlotChanged(SlotIndex, ItemInstance);
+}
+
+void UBotaniQuickBarComponent::HandleSlotChanged(int32 SlotIndex, UBotaniItemInstance* ItemInstance)
+{
+	if (SlotIndex < 0)
+	{
+		return;
+	}
+
+	// Slots may replicate before BeginPlay ran on clients
+	if (SlotIndex >= Slots.Num())
+	{
+		FreeSlots.Add(true, SlotIndex + 1 - Slots.Num());
+		Slots.SetNum(SlotIndex + 1);
+	}
+
+	if (const UBotaniItemInstance* OldItemInstance = Slots[SlotIndex])
+	{
+		SlotIndexByHandle.Remove(OldItemInstance->GetItemSpecHandle());
+	}
+
+	Slots[SlotIndex] = ItemInstance;
+	FreeSlots[SlotIndex] = (ItemInstance == nullptr);
+
+	if (ItemInstance && ItemInstance->GetItemSpecHandle().IsValid())
+	{
+		SlotIndexByHandle.Add(ItemInstance->GetItemSpecHandle(), SlotIndex);
+	}
+
+	// A requested slot that got emptied will not be confirmed anymore
+	if ((ItemInstance == nullptr) && (PendingActiveSlotIndex == SlotIndex))
+	{
+		PendingActiveSlotIndex = INDEX_NONE;
+	}
+
+	OnSlotChanged.Broadcast(this, SlotIndex, ItemInstance);
+	BroadcastQuickBarMessage(BotaniGameplayTags::Inventory::Message::TAG_InventoryMessage_QuickBar_SlotsChanged, SlotIndex);
 }
 
 void UBotaniQuickBarComponent::OnRep_ActiveSlotIndex()
 {
+	if (ActiveSlotIndex == PendingActiveSlotIndex)
+	{
+		PendingActiveSlotIndex = INDEX_NONE;
+	}
+
 	BroadcastQuickBarMessage(BotaniGameplayTags::Inventory::Message::TAG_InventoryMessage_QuickBar_ActiveIndexChanged);
 }
 
@@ -305,7 +421,13 @@ void UBotaniQuickBarComponent::EquipItemInSlot()
 		return;
 	}
 
-	const UBotaniEquipmentDefinition* EquipmentDefinition = CastChecked<UBotaniEquipmentDefinition>(SlotItem->GetItemDefinition()->EquipmentDefinition);
+	const UGameplayInventoryItemDefinition* ItemDefinition = SlotItem->GetItemDefinition();
+	if (ItemDefinition == nullptr)
+	{
+		return;
+	}
+
+	const UBotaniEquipmentDefinition* EquipmentDefinition = Cast<UBotaniEquipmentDefinition>(ItemDefinition->EquipmentDefinition);
 	if (EquipmentDefinition == nullptr)
 	{
 		return;
@@ -318,4 +440,3 @@ void UBotaniQuickBarComponent::EquipItemInSlot()
 		EquipmentManager->EquipItemByHandle(EquippedItemHandle, SlotItem->GetItemContext());
 	}
 }
-
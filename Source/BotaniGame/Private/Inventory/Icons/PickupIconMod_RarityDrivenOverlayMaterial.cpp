@@ -7,39 +7,33 @@
 #include "Inventory/Definitions/BotaniInventoryItemDefinition.h"
 #include "System/BotaniAssetManager.h"
 
-void UPickupIconMod_RarityDrivenOverlayMaterial::ApplyModifier(UPickupItemIcon* Outer, USceneComponent* SpawnedIcon,
-                                                               APickupProxyActor* PickupProxy, const UGameplayInventoryItemDefinition* InItemDef)
+void UPickupIconMod_RarityDrivenOverlayMaterial::GatherMaterialParameters(const APickupProxyActor* PickupProxy, const UGameplayInventoryItemDefinition* InItemDef,
+	TMap<FName, float>& OutScalarParameters, TMap<FName, FLinearColor>& OutVectorParameters, TMap<FName, UTexture*>& OutTextureParameters) const
 {
-	Super::ApplyModifier(Outer, SpawnedIcon, PickupProxy, InItemDef);
+	Super::GatherMaterialParameters(PickupProxy, InItemDef, OutScalarParameters, OutVectorParameters, OutTextureParameters);
 
-	const UMeshComponent* MeshComp = Cast<UMeshComponent>(SpawnedIcon);
-	UMaterialInstanceDynamic* DynMat = CastChecked<UMaterialInstanceDynamic>(MeshComp->GetOverlayMaterial());
+	const UBotaniInventoryItemDefinition* ItemDef = Cast<UBotaniInventoryItemDefinition>(InItemDef);
+	if (ItemDef == nullptr)
+	{
+		return;
+	}
+	
+	const EBotaniItemRarity Rarity = ItemDef->Rarity;
+	const UBotaniGameData& GameDate =  UBotaniAssetManager::Get().GetGameData();
+	const FBotaniRarityStyleInfo Info = GameDate.BotaniRarityData.LoadSynchronous()->GetRarityStyle(Rarity);
+
+	for (const auto& KVP : Info.ColorParameters)
+	{
+		OutVectorParameters.Add(KVP.Key, KVP.Value);
+	}
+
+	for (const auto& KVP : Info.ScalarParameters)
+	{
+		OutScalarParameters.Add(KVP.Key, KVP.Value);
+	}
 
-	if (ensure(DynMat))
+	for (const auto& KVP : Info.TextureParameters)
 	{
-		const UBotaniInventoryItemDefinition* ItemDef = Cast<UBotaniInventoryItemDefinition>(InItemDef);
-		if (ItemDef == nullptr)
-		{
-			return;
-		}
-		
-		const EBotaniItemRarity Rarity = ItemDef->Rarity;
-		const UBotaniGameData& GameDate =  UBotaniAssetManager::Get().GetGameData();
-		const FBotaniRarityStyleInfo Info = GameDate.BotaniRarityData.LoadSynchronous()->GetRarityStyle(Rarity);
-
-		for (const auto& KVP : Info.ColorParameters)
-		{
-			DynMat->SetVectorParameterValue(KVP.Key, KVP.Value);
-		}
-
-		for (const auto& KVP : Info.ScalarParameters)
-		{
-			DynMat->SetScalarParameterValue(KVP.Key, KVP.Value);
-		}
-
-		for (const auto& KVP : Info.TextureParameters)
-		{
-			DynMat->SetTextureParameterValue(KVP.Key, KVP.Value);
-		}
+		OutTextureParameters.Add(KVP.Key, KVP.Value);
 	}
 }
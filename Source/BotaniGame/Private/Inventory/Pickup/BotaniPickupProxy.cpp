@@ -14,6 +14,7 @@
 #include "Inventory/BotaniInventoryStatics.h"
 #include "Inventory/Components/BotaniQuickBarComponent.h"
 #include "Instance/GameplayInventoryItemInstance.h"
+#include "Pickup/PickupProxySubsystem.h"
 #include "Weapons/Components/BotaniProjectileMovementComponent.h"
 
 
@@ -24,6 +25,7 @@ ABotaniPickupProxy::ABotaniPickupProxy(const FObjectInitializer& ObjectInitializ
 {
 	InitialMovement = EBotaniInitialItemMovement::Gravity;
 	InitialInteractionDelay = .5f;
+	GravityRestHeight = 0.f;
 	
 	PickupMovement = ObjectInitializer.CreateDefaultSubobject<UBotaniProjectileMovementComponent>(this, TEXT("PickupMovement"));
 	ensure(PickupMovement);
@@ -46,7 +48,8 @@ ABotaniPickupProxy::ABotaniPickupProxy(const FObjectInitializer& ObjectInitializ
 
 void ABotaniPickupProxy::BeginPlay()
 {
-	if (InitialMovement == EBotaniInitialItemMovement::None)
+	// Pickups promoted from an instance already came to rest before they were instanced
+	if (InitialMovement == EBotaniInitialItemMovement::None || WasPromotedFromInstance())
 	{
 		DisablePickupMovement();
 	}
@@ -54,21 +57,26 @@ void ABotaniPickupProxy::BeginPlay()
 	{
 		EnablePickupMovement_Gravity();
 	}
+	else
+	{
+		// Stop ticking the movement once the toss came to rest
+		PickupMovement->OnProjectileStop.AddDynamic(this, &ThisClass::OnPickupMovementStopped);
+	}
 
-	CollisionComponent->SetCollisionResponseToChannel(ECC_Pawn, ECR_Ignore);
+	SetPickupInteractionEnabled(false);
 	
 	Super::BeginPlay();
 
-	auto EnablePickupCollision = [this]()
+	// Delayed through the pickup subsystem, so many dropped pickups don't each need a timer
+	UPickupProxySubsystem* PickupSubsystem = UPickupProxySubsystem::Get(this);
+	if (PickupSubsystem && !WasPromotedFromInstance())
 	{
-		CollisionComponent->SetCollisionResponseToChannel(ECC_Pawn, ECR_Overlap);
-
-		// Update the overlap events
-		CollisionComponent->UpdateOverlaps();
-	};
-
-	FTimerHandle TimerHandle;
-	GetWorld()->GetTimerManager().SetTimer(TimerHandle, FTimerDelegate::CreateLambda(EnablePickupCollision), InitialInteractionDelay, false);
+		PickupSubsystem->ScheduleEnableInteraction(this, InitialInteractionDelay);
+	}
+	else
+	{
+		SetPickupInteractionEnabled(true);
+	}
 }
 
 void ABotaniPickupProxy::OnDropped(AActor* InInstigator, UGameplayInventoryItemDefinition* InItemDefinition, const FInventoryItemPickupData& InPickupData)
@@ -124,6 +132,28 @@ void ABotaniPickupProxy::OnDropped(AActor* InInstigator, UGameplayInventoryItemD
 	Super::OnDropped(InInstigator, InItemDefinition, InPickupData);
 }
 
+void ABotaniPickupProxy::SetPickupCosmeticsActive(bool bActive)
+{
+	Super::SetPickupCosmeticsActive(bActive);
+
+	PickupLight->SetVisibility(bActive);
+
+	if (bActive)
+	{
+		PickupGlowSystem->Activate();
+	}
+	else
+	{
+		PickupGlowSystem->Deactivate();
+	}
+}
+
+bool ABotaniPickupProxy::CanBeInstanced() const
+{
+	// Tossed pickups are moved by their movement component until they come to rest
+	return Super::CanBeInstanced() && !PickupMovement->IsActive();
+}
+
 #if WITH_EDITOR
 void ABotaniPickupProxy::OnConstruction(const FTransform& Transform)
 {
@@ -262,6 +292,20 @@ void ABotaniPickupProxy::EnablePickupMovement_Gravity()
 {
 	check(PickupMovement);
 
-	PickupMovement->InitialSpeed = 0.f;
-	PickupMovement->Velocity = FVector(0.f, 0.f, -1.f);
+	// Falling is simulated by the pickup subsystem together with all other pickups, instead of a ticking movement component
+	UPickupProxySubsystem* PickupSubsystem = UPickupProxySubsystem::Get(this);
+	if (PickupSubsystem == nullptr)
+	{
+		PickupMovement->InitialSpeed = 0.f;
+		PickupMovement->Velocity = FVector(0.f, 0.f, -1.f);
+		return;
+	}
+
+	DisablePickupMovement();
+	PickupSubsystem->StartFalling(this, FVector::ZeroVector, GravityRestHeight);
+}
+
+void ABotaniPickupProxy::OnPickupMovementStopped(const FHitResult& ImpactResult)
+{
+	PickupMovement->Deactivate();
 }
\ No newline at end of file
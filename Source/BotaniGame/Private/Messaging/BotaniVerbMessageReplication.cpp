@@ -3,8 +3,29 @@
 
 #include "Messaging/BotaniVerbMessageReplication.h"
 
+#include "Engine/PackageMapClient.h"
 #include "GameFramework/GameplayMessageSubsystem.h"
 
+namespace BotaniVerbMessageCVars
+{
+	static int32 MaxReplicatedMessages = 32;
+	static FAutoConsoleVariableRef CVarMaxReplicatedMessages(
+		TEXT("Botani.VerbMessages.MaxReplicated"),
+		MaxReplicatedMessages,
+		TEXT("Default number of verb messages kept for replication, the oldest message is replaced once full."),
+		ECVF_Default);
+
+	static float MessageLifetime = 10.f;
+	static FAutoConsoleVariableRef CVarMessageLifetime(
+		TEXT("Botani.VerbMessages.Lifetime"),
+		MessageLifetime,
+		TEXT("Default number of seconds a verb message is kept for replication. 0 keeps messages until they are replaced."),
+		ECVF_Default);
+
+	/** Number of ids behind the highest broadcast id clients still remember, older ids are considered stale */
+	static constexpr int32 BroadcastIdWindow = 256;
+}
+
 //////////////////////////////////////////////////////////////////////////
 /// FBotaniVerbMessageReplicationEntry
 //////////////////////////////////////////////////////////////////////////
@@ -18,32 +39,193 @@ FString FBotaniVerMessageReplicationEntry::GetDebugString() const
 /// FBotaniVerbMessageReplication
 //////////////////////////////////////////////////////////////////////////
 
+void FBotaniVerbMessageReplication::SetLimits(int32 InMaxMessages, float InMessageLifetime)
+{
+	MaxMessages = FMath::Max(InMaxMessages, 0);
+	MessageLifetime = FMath::Max(InMessageLifetime, 0.f);
+}
+
 void FBotaniVerbMessageReplication::AddMessage(const FBotaniVerbMessage& Message)
 {
-	FBotaniVerMessageReplicationEntry& NewStack = CurrentMessages.Emplace_GetRef(Message);
-	MarkItemDirty(NewStack);
+	AddMessage_Internal(Message, GetServerTime());
+}
+
+void FBotaniVerbMessageReplication::ExpireMessages()
+{
+	ExpireMessages_Internal(GetServerTime());
+}
+
+void FBotaniVerbMessageReplication::SetVerbRelevancy(FGameplayTag VerbTag, const FBotaniVerbMessageRelevancy& Relevancy)
+{
+	if (Relevancy.IsBound())
+	{
+		VerbRelevancyFilters.Add(VerbTag, Relevancy);
+	}
+	else
+	{
+		VerbRelevancyFilters.Remove(VerbTag);
+	}
+}
+
+void FBotaniVerbMessageReplication::AddMessage_Internal(const FBotaniVerbMessage& Message, double Now)
+{
+	ExpireMessages_Internal(Now);
+
+	FBotaniVerMessageReplicationEntry* Entry = nullptr;
+	if (CurrentMessages.Num() < GetMaxMessages())
+	{
+		Entry = &CurrentMessages.Emplace_GetRef(Message);
+	}
+	else
+	{
+		// Full, reuse the slot of the oldest message. Clients see a changed entry with a new id and broadcast it.
+		Entry = &CurrentMessages[0];
+		for (FBotaniVerMessageReplicationEntry& Existing : CurrentMessages)
+		{
+			if (Existing.MessageId < Entry->MessageId)
+			{
+				Entry = &Existing;
+			}
+		}
+
+		Entry->Message = Message;
+	}
+
+	Entry->MessageId = NextMessageId++;
+	Entry->ServerTime = Now;
+	MarkItemDirty(*Entry);
+}
+
+void FBotaniVerbMessageReplication::ExpireMessages_Internal(double Now)
+{
+	const float Lifetime = GetMessageLifetime();
+	if (Lifetime <= 0.f)
+	{
+		return;
+	}
+
+	const int32 NumRemoved = CurrentMessages.RemoveAllSwap([ExpireTime = Now - Lifetime](const FBotaniVerMessageReplicationEntry& Entry)
+	{
+		return Entry.ServerTime <= ExpireTime;
+	}, EAllowShrinking::No);
+
+	if (NumRemoved > 0)
+	{
+		MarkArrayDirty();
+	}
+}
+
+int32 FBotaniVerbMessageReplication::GetMaxMessages() const
+{
+	return FMath::Max((MaxMessages > 0) ? MaxMessages : BotaniVerbMessageCVars::MaxReplicatedMessages, 1);
+}
+
+float FBotaniVerbMessageReplication::GetMessageLifetime() const
+{
+	return (MessageLifetime > 0.f) ? MessageLifetime : BotaniVerbMessageCVars::MessageLifetime;
+}
+
+double FBotaniVerbMessageReplication::GetServerTime() const
+{
+	const UWorld* World = Owner ? Owner->GetWorld() : nullptr;
+	return World ? World->GetTimeSeconds() : FPlatformTime::Seconds();
+}
+
+bool FBotaniVerbMessageReplication::IsRelevantForConnection(const FBotaniVerbMessage& Message, const UNetConnection* Connection) const
+{
+	if (Connection == nullptr)
+	{
+		return true;
+	}
+
+	const FBotaniVerbMessageRelevancy* Relevancy = VerbRelevancyFilters.Find(Message.VerbTag);
+	return (Relevancy == nullptr) || Relevancy->Execute(Message, Connection);
+}
+
+bool FBotaniVerbMessageReplication::NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+{
+	// Remember the connection being written for, so the relevancy filters can be applied per entry.
+	// Only the legacy replication path asks ShouldWriteFastArrayItem, with Iris every connection receives every message.
+	const UPackageMapClient* PackageMap = (DeltaParms.Writer && VerbRelevancyFilters.Num() > 0) ? Cast<UPackageMapClient>(DeltaParms.Map) : nullptr;
+	SerializingConnection = PackageMap ? PackageMap->GetConnection() : nullptr;
+
+	const bool bResult = FFastArraySerializer::FastArrayDeltaSerialize<FBotaniVerMessageReplicationEntry, FBotaniVerbMessageReplication>(CurrentMessages, DeltaParms, *this);
+
+	SerializingConnection = nullptr;
+	return bResult;
 }
 
 void FBotaniVerbMessageReplication::PreReplicatedRemove(const TArrayView<int32> RemovedIndices, int32 FinalSize)
 {
+	// Removed messages have expired on the server and were already broadcast when they were added.
 }
 
 void FBotaniVerbMessageReplication::PostReplicatedAdd(const TArrayView<int32> AddedIndices, int32 FinalSize)
 {
-	for (const int32 Index : AddedIndices)
+	BroadcastNewMessages(AddedIndices);
+}
+
+void FBotaniVerbMessageReplication::PostReplicatedChange(const TArrayView<int32> ChangedIndices, int32 FinalSize)
+{
+	BroadcastNewMessages(ChangedIndices);
+}
+
+void FBotaniVerbMessageReplication::BroadcastNewMessages(const TArrayView<int32> Indices)
+{
+	TArray<const FBotaniVerMessageReplicationEntry*, TInlineAllocator<16>> Entries;
+	for (const int32 Index : Indices)
+	{
+		Entries.Add(&CurrentMessages[Index]);
+	}
+
+	Entries.Sort([](const FBotaniVerMessageReplicationEntry& A, const FBotaniVerMessageReplicationEntry& B)
+	{
+		return A.MessageId < B.MessageId;
+	});
+
+	for (const FBotaniVerMessageReplicationEntry* Entry : Entries)
 	{
-		const FBotaniVerMessageReplicationEntry& Entry = CurrentMessages[Index];
-		BroadcastMessage(Entry.Message);
+		if (MarkMessageBroadcast(Entry->MessageId))
+		{
+			BroadcastMessage(Entry->Message);
+		}
 	}
 }
 
-void FBotaniVerbMessageReplication::PostReplicatedChange(const TArrayView<int32> ChangedIndices, int32 FinalSize)
+bool FBotaniVerbMessageReplication::MarkMessageBroadcast(int32 MessageId)
 {
-	for (const int32 Index : ChangedIndices)
+	const int32 OldestRememberedId = HighestBroadcastMessageId - BotaniVerbMessageCVars::BroadcastIdWindow;
+	if (MessageId <= OldestRememberedId)
 	{
-		const FBotaniVerMessageReplicationEntry& Entry = CurrentMessages[Index];
-		BroadcastMessage(Entry.Message);
+		return false;
 	}
+
+	bool bAlreadyBroadcast = false;
+	BroadcastMessageIds.Add(MessageId, &bAlreadyBroadcast);
+	if (bAlreadyBroadcast)
+	{
+		return false;
+	}
+
+	if (MessageId > HighestBroadcastMessageId)
+	{
+		HighestBroadcastMessageId = MessageId;
+
+		// Forget the ids that fell out of the window, keeps the set bounded.
+		if (BroadcastMessageIds.Num() > BotaniVerbMessageCVars::BroadcastIdWindow)
+		{
+			const int32 NewOldestRememberedId = HighestBroadcastMessageId - BotaniVerbMessageCVars::BroadcastIdWindow;
+			for (auto It = BroadcastMessageIds.CreateIterator(); It; ++It)
+			{
+				if (*It <= NewOldestRememberedId)
+				{
+					It.RemoveCurrent();
+				}
+			}
+		}
+	}
+
+	return true;
 }
 
 void FBotaniVerbMessageReplication::BroadcastMessage(const FBotaniVerbMessage& Message) const
@@ -4,6 +4,8 @@
 #include "System/BotaniAssetManager.h"
 #include "BotaniLogChannels.h"
 #include "AbilitySystem/BotaniGameplayCueManager.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Misc/FileHelper.h"
 
 #define LOCTEXT_NAMESPACE "BotaniAssetManager"
 
@@ -19,7 +21,7 @@ static FAutoConsoleCommand CVarDumpLoadedAssets(
 
 //////////////////////////////////////////////////////////////////////////
 
-#define STARTUP_JOB_WEIGHTED(JobFunc, JobWeight) StartupJobs.Add(FBotaniAssetManagerStartupJob(#JobFunc, [this](const FBotaniAssetManagerStartupJob& StartupJob, TSharedPtr<FStreamableHandle>& LoadHandle){JobFunc;}, JobWeight))
+#define STARTUP_JOB_WEIGHTED(JobFunc, JobWeight) StartupJobs.Add_GetRef(FBotaniAssetManagerStartupJob(#JobFunc, [this](const FBotaniAssetManagerStartupJob& StartupJob, TSharedPtr<FStreamableHandle>& LoadHandle){JobFunc;}, JobWeight))
 #define STARTUP_JOB(JobFunc) STARTUP_JOB_WEIGHTED(JobFunc, 1.f)
 
 //////////////////////////////////////////////////////////////////////////
@@ -154,11 +156,14 @@ void UBotaniAssetManager::StartInitialLoading()
 	
 	Super::StartInitialLoading();
 
-	// Load cue manager
+	// Start streaming in the base game data asset first, the cue manager loads synchronously and would block it otherwise
+	const FString PreloadGameDataJob = STARTUP_JOB_WEIGHTED(PreloadGameData(LoadHandle), 20.f).JobName;
+
+	// Load cue manager while the game data streams in
 	STARTUP_JOB(InitializeGameplayCueManager());
 
 	// Load base game data asset
-	STARTUP_JOB_WEIGHTED(GetGameData(), 25.f);
+	STARTUP_JOB_WEIGHTED(GetGameData(), 5.f).DependsOn(PreloadGameDataJob);
 
 	// Run all the queued startup jobs
 	DoAllStartupJobs();
@@ -169,52 +174,263 @@ void UBotaniAssetManager::DoAllStartupJobs()
 	SCOPED_BOOT_TIMING("UBotaniAssetManager::DoAllStartupJobs");
 	const double AllStartupJobsStartTime = FPlatformTime::Seconds();
 
-	if (IsRunningDedicatedServer())
+	const bool bReportProgress = !IsRunningDedicatedServer();
+	const int32 NumJobs = StartupJobs.Num();
+
+	if (NumJobs == 0)
 	{
-		for (const FBotaniAssetManagerStartupJob& StartupJob : StartupJobs)
+		if (bReportProgress)
 		{
-			StartupJob.DoJob();
+			UpdateInitialGameContentLoadPercent(1.f);
 		}
+
+		return;
 	}
-	else
+
+	enum class EJobState : uint8
+	{
+		Pending,
+		Running,
+		Completed
+	};
+
+	TArray<EJobState> JobStates;
+	JobStates.Init(EJobState::Pending, NumJobs);
+
+	TArray<TSharedPtr<FStreamableHandle>> JobHandles;
+	JobHandles.SetNum(NumJobs);
+
+	TArray<FGraphEventRef> JobTasks;
+	JobTasks.SetNum(NumJobs);
+
+	TArray<float> JobProgress;
+	JobProgress.SetNumZeroed(NumJobs);
+
+	float TotalJobValue = 0.f;
+	for (const FBotaniAssetManagerStartupJob& StartupJob : StartupJobs)
+	{
+		TotalJobValue += StartupJob.JobWeight;
+	}
+
+	auto ReportOverallProgress = [this, &JobProgress, TotalJobValue, bReportProgress]()
+	{
+		if (!bReportProgress || TotalJobValue <= 0.f)
+		{
+			return;
+		}
+
+		float AccumulatedJobValue = 0.f;
+		for (const float Progress : JobProgress)
+		{
+			AccumulatedJobValue += Progress;
+		}
+
+		UpdateInitialGameContentLoadPercent(AccumulatedJobValue / TotalJobValue);
+	};
+
+	// Resolve the dependency names to job indices
+	TMap<FString, int32> JobIndexByName;
+	for (int32 JobIdx = 0; JobIdx < NumJobs; ++JobIdx)
 	{
-		if (StartupJobs.Num() > 0)
+		JobIndexByName.Add(StartupJobs[JobIdx].JobName, JobIdx);
+	}
+
+	TArray<TArray<int32>> JobDependencies;
+	JobDependencies.SetNum(NumJobs);
+	for (int32 JobIdx = 0; JobIdx < NumJobs; ++JobIdx)
+	{
+		for (const FString& DependencyName : StartupJobs[JobIdx].Dependencies)
 		{
-			float TotalJobValue = 0.f;
-			for (const FBotaniAssetManagerStartupJob& StartupJob : StartupJobs)
+			if (const int32* DependencyIdx = JobIndexByName.Find(DependencyName))
+			{
+				JobDependencies[JobIdx].Add(*DependencyIdx);
+			}
+			else
 			{
-				TotalJobValue += StartupJob.JobWeight;
+				BOTANI_LOG(Warning, TEXT("Startup job \"%s\" depends on unknown job \"%s\", ignoring the dependency."), *StartupJobs[JobIdx].JobName, *DependencyName);
 			}
+		}
+	}
 
-			float AccumulatedJobValue = 0.f;
-			for (FBotaniAssetManagerStartupJob& StartupJob : StartupJobs)
+	auto CanStartJob = [&JobStates, &JobDependencies](int32 JobIdx)
+	{
+		for (const int32 DependencyIdx : JobDependencies[JobIdx])
+		{
+			if (JobStates[DependencyIdx] != EJobState::Completed)
 			{
-				const float JobValue = StartupJob.JobWeight;
-				StartupJob.SubstepProgressDelegate.BindLambda([This = this, AccumulatedJobValue, JobValue, TotalJobValue] (float NewProgress)
-				{
-					const float SubstepAmount = FMath::Clamp(NewProgress, 0.0f, 1.0f) * JobValue;
-					const float OverallPercentWithSubstep = (AccumulatedJobValue + SubstepAmount) / TotalJobValue;
+				return false;
+			}
+		}
+
+		return true;
+	};
 
-					This->UpdateInitialGameContentLoadPercent(OverallPercentWithSubstep);
-				});
+	auto StartJob = [&](int32 JobIdx)
+	{
+		FBotaniAssetManagerStartupJob& StartupJob = StartupJobs[JobIdx];
+		JobStates[JobIdx] = EJobState::Running;
 
-				StartupJob.DoJob();
-				StartupJob.SubstepProgressDelegate.Unbind();
+		if (StartupJob.ThreadAffinity == EBotaniStartupJobThread::AnyThread)
+		{
+			JobTasks[JobIdx] = FFunctionGraphTask::CreateAndDispatchWhenReady([&StartupJob]()
+			{
+				const TSharedPtr<FStreamableHandle> Handle = StartupJob.StartJob();
+				ensureMsgf(!Handle.IsValid(), TEXT("Startup job \"%s\" runs on any thread and must not return a streamable handle"), *StartupJob.JobName);
+				StartupJob.FinishJob(Handle);
+			}, TStatId(), nullptr, ENamedThreads::AnyBackgroundThreadNormalTask);
 
-				AccumulatedJobValue += JobValue;
-				UpdateInitialGameContentLoadPercent(AccumulatedJobValue / TotalJobValue);
+			return;
+		}
+
+		if (bReportProgress)
+		{
+			const float JobValue = StartupJob.JobWeight;
+			StartupJob.SubstepProgressDelegate.BindLambda([&JobProgress, &ReportOverallProgress, JobIdx, JobValue] (float NewProgress)
+			{
+				JobProgress[JobIdx] = FMath::Clamp(NewProgress, 0.0f, 1.0f) * JobValue;
+				ReportOverallProgress();
+			});
+		}
+
+		JobHandles[JobIdx] = StartupJob.StartJob();
+	};
+
+	auto CompleteJob = [&](int32 JobIdx)
+	{
+		FBotaniAssetManagerStartupJob& StartupJob = StartupJobs[JobIdx];
+		JobStates[JobIdx] = EJobState::Completed;
+
+		if (StartupJob.ThreadAffinity == EBotaniStartupJobThread::GameThread)
+		{
+			StartupJob.FinishJob(JobHandles[JobIdx]);
+			StartupJob.SubstepProgressDelegate.Unbind();
+		}
+
+		JobProgress[JobIdx] = StartupJob.JobWeight;
+		ReportOverallProgress();
+	};
+
+	int32 NumCompletedJobs = 0;
+	while (NumCompletedJobs < NumJobs)
+	{
+		// Start everything whose dependencies are satisfied, so async loads and worker tasks overlap
+		bool bMadeProgress = false;
+		for (int32 JobIdx = 0; JobIdx < NumJobs; ++JobIdx)
+		{
+			if (JobStates[JobIdx] == EJobState::Pending && CanStartJob(JobIdx))
+			{
+				StartJob(JobIdx);
+				bMadeProgress = true;
 			}
 		}
-		else
+
+		// Gather finished jobs
+		int32 BlockingJobIdx = INDEX_NONE;
+		for (int32 JobIdx = 0; JobIdx < NumJobs; ++JobIdx)
 		{
-			UpdateInitialGameContentLoadPercent(1.f);
+			if (JobStates[JobIdx] != EJobState::Running)
+			{
+				continue;
+			}
+
+			bool bFinished;
+			if (StartupJobs[JobIdx].ThreadAffinity == EBotaniStartupJobThread::AnyThread)
+			{
+				bFinished = JobTasks[JobIdx]->IsComplete();
+			}
+			else
+			{
+				const TSharedPtr<FStreamableHandle>& Handle = JobHandles[JobIdx];
+				bFinished = !Handle.IsValid() || Handle->HasLoadCompleted() || Handle->WasCanceled();
+			}
+
+			if (bFinished)
+			{
+				CompleteJob(JobIdx);
+				++NumCompletedJobs;
+				bMadeProgress = true;
+			}
+			else if (BlockingJobIdx == INDEX_NONE)
+			{
+				BlockingJobIdx = JobIdx;
+			}
+		}
+
+		if (bMadeProgress)
+		{
+			continue;
+		}
+
+		if (BlockingJobIdx != INDEX_NONE)
+		{
+			// Nothing new can start, wait for the oldest running job. Other loads and tasks keep going meanwhile.
+			if (StartupJobs[BlockingJobIdx].ThreadAffinity == EBotaniStartupJobThread::AnyThread)
+			{
+				FTaskGraphInterface::Get().WaitUntilTaskCompletes(JobTasks[BlockingJobIdx], ENamedThreads::GameThread);
+			}
+			else
+			{
+				JobHandles[BlockingJobIdx]->WaitUntilComplete(0.0f, false);
+			}
+
+			continue;
+		}
+
+		// Nothing is running and nothing can start, so the remaining jobs have cyclic dependencies
+		for (int32 JobIdx = 0; JobIdx < NumJobs; ++JobIdx)
+		{
+			if (JobStates[JobIdx] == EJobState::Pending)
+			{
+				BOTANI_LOG(Error, TEXT("Startup job \"%s\" has cyclic dependencies, forcing it to start."), *StartupJobs[JobIdx].JobName);
+				StartJob(JobIdx);
+				break;
+			}
 		}
 	}
 
+#if !UE_BUILD_SHIPPING
+	if (bWriteStartupJobTimings)
+	{
+		WriteStartupJobTimings(AllStartupJobsStartTime);
+	}
+#endif
+
 	StartupJobs.Empty();
 	BOTANI_LOG(Display, TEXT("All startup jobs took %.2f seconds to complete"), FPlatformTime::Seconds() - AllStartupJobsStartTime);
 }
 
+#if !UE_BUILD_SHIPPING
+void UBotaniAssetManager::WriteStartupJobTimings(double AllStartupJobsStartTime) const
+{
+	FString Csv = TEXT("Job,Thread,Weight,Dependencies,StartOffsetSeconds,DurationSeconds\n");
+
+	for (const FBotaniAssetManagerStartupJob& StartupJob : StartupJobs)
+	{
+		Csv += FString::Printf(TEXT("\"%s\",%s,%.2f,\"%s\",%.4f,%.4f\n"),
+			*StartupJob.JobName,
+			StartupJob.ThreadAffinity == EBotaniStartupJobThread::GameThread ? TEXT("GameThread") : TEXT("AnyThread"),
+			StartupJob.JobWeight,
+			*FString::Join(StartupJob.Dependencies, TEXT(";")),
+			StartupJob.StartTime - AllStartupJobsStartTime,
+			StartupJob.GetDuration());
+	}
+
+	const FString FileName = FString::Printf(TEXT("StartupJobs_%s_%s.csv"),
+		IsRunningDedicatedServer() ? TEXT("Server") : TEXT("Client"),
+		*FDateTime::Now().ToString());
+	const FString FilePath = FPaths::ProfilingDir() / TEXT("BootTiming") / FileName;
+
+	if (FFileHelper::SaveStringToFile(Csv, *FilePath))
+	{
+		BOTANI_LOG(Log, TEXT("Wrote startup job timings to %s"), *FilePath);
+	}
+	else
+	{
+		BOTANI_LOG(Warning, TEXT("Failed to write startup job timings to %s"), *FilePath);
+	}
+}
+#endif
+
 void UBotaniAssetManager::InitializeGameplayCueManager()
 {
 	SCOPED_BOOT_TIMING("UBotaniAssetManager::InitializeGameplayCueManager");
@@ -225,6 +441,17 @@ void UBotaniAssetManager::InitializeGameplayCueManager()
 	GCM->LoadAlwaysLoadedCues();
 }
 
+void UBotaniAssetManager::PreloadGameData(TSharedPtr<FStreamableHandle>& LoadHandle)
+{
+	// The editor loads game data synchronously anyway, see LoadGameDataOfClass
+	if (GIsEditor || BotaniGameDataPath.IsNull())
+	{
+		return;
+	}
+
+	LoadHandle = LoadPrimaryAssetsWithType(UBotaniGameData::StaticClass()->GetFName());
+}
+
 void UBotaniAssetManager::UpdateInitialGameContentLoadPercent(float GameContentPercent)
 {
 }
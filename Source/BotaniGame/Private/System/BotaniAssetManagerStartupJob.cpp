@@ -7,20 +7,42 @@
 
 TSharedPtr<FStreamableHandle> FBotaniAssetManagerStartupJob::DoJob() const
 {
-	const double JobStartTime = FPlatformTime::Seconds();
+	TSharedPtr<FStreamableHandle> Handle = StartJob();
+
+	if (Handle.IsValid())
+	{
+		Handle->WaitUntilComplete(0.0f, false);
+	}
+
+	FinishJob(Handle);
+
+	return Handle;
+}
+
+TSharedPtr<FStreamableHandle> FBotaniAssetManagerStartupJob::StartJob() const
+{
+	StartTime = FPlatformTime::Seconds();
 
 	TSharedPtr<FStreamableHandle> Handle;
 	UE_LOG(LogBotani, Display, TEXT("Startup job \"%s\" starting"), *JobName);
 	JobFunc(*this, Handle);
 
-	if (Handle.IsValid())
+	if (Handle.IsValid() && !Handle->HasLoadCompleted())
 	{
+		ensureMsgf(IsInGameThread(), TEXT("Startup job \"%s\" created a streamable handle off the game thread"), *JobName);
 		Handle->BindUpdateDelegate(FStreamableUpdateDelegate::CreateRaw(this, &FBotaniAssetManagerStartupJob::UpdateSubstepProgressFromStreamable));
-		Handle->WaitUntilComplete(0.0f, false);
-		Handle->BindUpdateDelegate(FStreamableUpdateDelegate());
 	}
 
-	UE_LOG(LogBotani, Display, TEXT("Startup job \"%s\" took %.2f seconds to complete"), *JobName, FPlatformTime::Seconds() - JobStartTime);
-
 	return Handle;
 }
+
+void FBotaniAssetManagerStartupJob::FinishJob(const TSharedPtr<FStreamableHandle>& Handle) const
+{
+	if (Handle.IsValid())
+	{
+		Handle->BindUpdateDelegate(FStreamableUpdateDelegate());
+	}
+
+	EndTime = FPlatformTime::Seconds();
+	UE_LOG(LogBotani, Display, TEXT("Startup job \"%s\" took %.2f seconds to complete"), *JobName, GetDuration());
+}
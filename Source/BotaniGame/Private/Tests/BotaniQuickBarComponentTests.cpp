@@ -0,0 +1,101 @@
+// Copyright © 2024 Botanibots Team. All rights reserved.
+
+#include "Inventory/Components/BotaniQuickBarComponent.h"
+
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "Inventory/Instances/BotaniItemInstance.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/ScopeExit.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBotaniQuickBarCyclingTest, "Botani.Inventory.QuickBar.RapidCycling", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FBotaniQuickBarCyclingTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumInputs = 1000;
+
+	// The quick bar broadcasts its messages through the game instance of its world
+	UGameInstance* GameInstance = NewObject<UGameInstance>(GEngine);
+	GameInstance->InitializeStandalone();
+	UWorld* World = GameInstance->GetWorld();
+	ON_SCOPE_EXIT
+	{
+		GameInstance->Shutdown();
+		World->DestroyWorld(false);
+	};
+
+	for (const int32 InputsPerFrame : { 1, 3, 8 })
+	{
+		// A quick bar without owner behaves like a client's, with every other slot occupied so cycling has to skip empty slots
+		UBotaniQuickBarComponent* QuickBar = NewObject<UBotaniQuickBarComponent>(World, NAME_None, RF_Transient);
+		QuickBar->NumSlots = 8;
+
+		TArray<int32> OccupiedSlots;
+		for (int32 SlotIndex = 0; SlotIndex < QuickBar->NumSlots; SlotIndex += 2)
+		{
+			QuickBar->HandleSlotChanged(SlotIndex, NewObject<UBotaniItemInstance>(QuickBar));
+			OccupiedSlots.Add(SlotIndex);
+		}
+
+		TestEqual(TEXT("Next free slot"), QuickBar->GetNextFreeItemSlot(), 1);
+
+		// Every frame the pending request is sent and confirmed right away, as a server without latency would
+		int32 NumRequests = 0;
+		auto EndFrame = [QuickBar, &NumRequests]()
+		{
+			if (QuickBar->PendingActiveSlotIndex != INDEX_NONE)
+			{
+				QuickBar->SendActiveSlotIndexRequest();
+				NumRequests++;
+			}
+		};
+
+		for (int32 Index = 0; Index < NumInputs; ++Index)
+		{
+			QuickBar->CycleActiveSlotForward();
+			if (((Index + 1) % InputsPerFrame) == 0)
+			{
+				EndFrame();
+			}
+		}
+		EndFrame();
+
+		// Starting without an active slot the first input activates the first occupied slot
+		const int32 ExpectedForwardSlot = OccupiedSlots[(NumInputs - 1) % OccupiedSlots.Num()];
+		if (QuickBar->GetActiveSlotIndex() != ExpectedForwardSlot)
+		{
+			AddError(FString::Printf(TEXT("%d inputs per frame: Expected slot %d to be active after cycling forward, got %d."), InputsPerFrame, ExpectedForwardSlot, QuickBar->GetActiveSlotIndex()));
+		}
+
+		for (int32 Index = 0; Index < NumInputs; ++Index)
+		{
+			QuickBar->CycleActiveSlotBackward();
+			if (((Index + 1) % InputsPerFrame) == 0)
+			{
+				EndFrame();
+			}
+		}
+		EndFrame();
+
+		const int32 ExpectedBackwardSlot = OccupiedSlots[(((NumInputs - 1) - NumInputs) % OccupiedSlots.Num() + OccupiedSlots.Num()) % OccupiedSlots.Num()];
+		if (QuickBar->GetActiveSlotIndex() != ExpectedBackwardSlot)
+		{
+			AddError(FString::Printf(TEXT("%d inputs per frame: Expected slot %d to be active after cycling backward, got %d."), InputsPerFrame, ExpectedBackwardSlot, QuickBar->GetActiveSlotIndex()));
+		}
+
+		const int32 MaxRequests = 2 * FMath::DivideAndRoundUp(NumInputs, InputsPerFrame);
+		if (NumRequests > MaxRequests)
+		{
+			AddError(FString::Printf(TEXT("%d inputs per frame: Expected at most one slot request per frame (%d), got %d."), InputsPerFrame, MaxRequests, NumRequests));
+		}
+
+		TestEqual(TEXT("Pending slot request after the last frame"), QuickBar->PendingActiveSlotIndex, static_cast<int32>(INDEX_NONE));
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
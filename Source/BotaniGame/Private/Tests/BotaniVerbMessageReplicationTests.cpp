@@ -0,0 +1,132 @@
+// Copyright © 2024 Botanibots Team. All rights reserved.
+
+#include "Messaging/BotaniVerbMessageReplication.h"
+
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "GameFramework/GameplayMessageSubsystem.h"
+#include "GameplayTags/BotaniGameplayTags.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/ScopeExit.h"
+#include "Tests/FastArrayTestReplicator.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBotaniVerbMessageSoakTest, "Botani.Messaging.VerbMessages.Soak", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FBotaniVerbMessageSoakTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 SimulatedSeconds = 60 * 60;
+	constexpr int32 IntervalSeconds = 5 * 60;
+	constexpr int32 MaxMessages = 32;
+	constexpr float MessageLifetime = 10.f;
+
+	// Clients remember a window of 256 broadcast ids, see BotaniVerbMessageCVars::BroadcastIdWindow
+	constexpr int32 MaxRememberedIds = 256 + 1;
+
+	// Bytes per interval only grow with the digits of the message ids, not with the length of the match
+	constexpr double MaxIntervalBytesGrowth = 1.25;
+
+	// Clients broadcast the received messages through the message subsystem of their game instance
+	UGameInstance* GameInstance = NewObject<UGameInstance>(GEngine);
+	GameInstance->InitializeStandalone();
+	UWorld* World = GameInstance->GetWorld();
+	ON_SCOPE_EXIT
+	{
+		GameInstance->Shutdown();
+		World->DestroyWorld(false);
+	};
+
+	UGameplayMessageSubsystem& MessageSubsystem = UGameplayMessageSubsystem::Get(World);
+
+	FBotaniVerbMessage Message;
+	Message.VerbTag = BotaniGameplayTags::Gameplay::Verb::TAG_GameplayVerb_Elimination;
+
+	for (const int32 MessagesPerMinute : { 30, 600 })
+	{
+		FBotaniVerbMessageReplication Server;
+		Server.SetOwner(World);
+		Server.SetLimits(MaxMessages, MessageLifetime);
+
+		FBotaniVerbMessageReplication Client;
+		Client.SetOwner(World);
+
+		FastArrayTests::TFastArrayTestReplicator<FBotaniVerbMessageReplication> Replicator;
+
+		int32 NumReceived = 0;
+		FGameplayMessageListenerHandle ListenerHandle = MessageSubsystem.RegisterListener<FBotaniVerbMessage>(Message.VerbTag, [&NumReceived](FGameplayTag, const FBotaniVerbMessage&)
+		{
+			NumReceived++;
+		});
+
+		ON_SCOPE_EXIT
+		{
+			ListenerHandle.Unregister();
+		};
+
+		// Simulate in steps of one second, every step is a replication update of the server container to the client
+		int32 NumSent = 0;
+		int32 PendingMessages = 0;
+		int64 IntervalBits = 0;
+		int64 FirstIntervalBytes = INDEX_NONE;
+
+		for (int32 Step = 1; Step <= SimulatedSeconds; ++Step)
+		{
+			const double Now = Step;
+
+			PendingMessages += MessagesPerMinute;
+			for (; PendingMessages >= 60; PendingMessages -= 60)
+			{
+				Server.AddMessage_Internal(Message, Now);
+				NumSent++;
+			}
+
+			Server.ExpireMessages_Internal(Now);
+
+			if (!Replicator.Replicate(Server, Client) && Replicator.HasReadError())
+			{
+				AddError(FString::Printf(TEXT("%d per minute: Delta serialization failed after %d seconds."), MessagesPerMinute, Step));
+				return false;
+			}
+
+			IntervalBits += Replicator.GetLastNumBits();
+
+			if ((Server.GetNumMessages() > MaxMessages) || (Client.GetNumMessages() != Server.GetNumMessages()))
+			{
+				AddError(FString::Printf(TEXT("%d per minute: Expected at most %d entries on both ends after %d seconds, got %d on the server and %d on the client."),
+					MessagesPerMinute, MaxMessages, Step, Server.GetNumMessages(), Client.GetNumMessages()));
+				return false;
+			}
+
+			if (Client.BroadcastMessageIds.Num() > MaxRememberedIds)
+			{
+				AddError(FString::Printf(TEXT("%d per minute: Client remembers %d message ids after %d seconds."), MessagesPerMinute, Client.BroadcastMessageIds.Num(), Step));
+				return false;
+			}
+
+			if ((Step % IntervalSeconds) == 0)
+			{
+				const int64 IntervalBytes = (IntervalBits + 7) / 8;
+				IntervalBits = 0;
+
+				if (FirstIntervalBytes == INDEX_NONE)
+				{
+					FirstIntervalBytes = IntervalBytes;
+				}
+				else if (IntervalBytes > FirstIntervalBytes * MaxIntervalBytesGrowth)
+				{
+					AddError(FString::Printf(TEXT("%d per minute: %lld bytes were sent in the interval ending at minute %d, the first interval sent %lld."),
+						MessagesPerMinute, IntervalBytes, Step / 60, FirstIntervalBytes));
+				}
+			}
+		}
+
+		TestTrue(FString::Printf(TEXT("%d per minute: Bytes were sent"), MessagesPerMinute), FirstIntervalBytes > 0);
+		TestEqual(FString::Printf(TEXT("%d per minute: Messages broadcast on the client"), MessagesPerMinute), NumReceived, NumSent);
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -146,6 +146,8 @@ protected:
  * UBotaniCameraModeStack
  *
  * Stack used for blending camera modes.
+ * The stack is a fixed size ring of persistent per class camera mode instances, so pushing a mode or trimming
+ * blended out modes only moves the ring's head and size instead of shifting an array every frame.
  */
 UCLASS()
 class UBotaniCameraModeStack : public UObject
@@ -155,6 +157,9 @@ class UBotaniCameraModeStack : public UObject
 public:
 	UBotaniCameraModeStack();
 
+	/** Maximum number of camera modes on the stack, pushing more drops the bottom mode. */
+	static constexpr int32 MaxStackSize = 8;
+
 	void ActivateStack();
 	void DeactivateStack();
 
@@ -167,18 +172,43 @@ public:
 	/** Gets the tag associated with the top camera mode on the stack. */
 	void GetBlendInfo(float& OutWeightOfTopLayer, FGameplayTag& OutTagOfTopLayer) const;
 
+	/** Returns the number of camera modes on the stack. */
+	int32 GetStackSize() const { return StackSize; }
+
+	/** Returns the camera mode at the given stack index, where 0 is the top of the stack. */
+	UBotaniCameraMode* GetStackEntry(int32 StackIndex) const
+	{
+		check(StackIndex >= 0 && StackIndex < StackSize);
+		return CameraModeRing[GetRingIndex(StackIndex)];
+	}
+
 protected:
 	UBotaniCameraMode* GetCameraModeInstance(TSubclassOf<UBotaniCameraMode> CameraModeClass);
 
-	void UpdateStack(float DeltaTime);
-	void BlendStack(FBotaniCameraModeView& OutView) const;
+	/** Updates the camera modes down to the topmost fully blended in one, blends them into the view from the bottom up and trims the modes below it. */
+	void UpdateStack(float DeltaTime, FBotaniCameraModeView& OutView);
+
+	int32 GetRingIndex(int32 StackIndex) const { return (StackHead + StackIndex) % MaxStackSize; }
+
+	/** Removes the camera modes from the given stack index down to the bottom, without notifying them. */
+	void TrimStack(int32 NewStackSize);
+
+#if !UE_BUILD_SHIPPING
+	/** Appends the current stack contents to the camera debug capture, if one is running. */
+	void CaptureStack(float DeltaTime, const FBotaniCameraModeView& View) const;
+#endif
 
 protected:
 	bool bIsActive;
 
+	/** Camera mode instances by class, kept for the lifetime of the stack. */
 	UPROPERTY()
-	TArray<TObjectPtr<UBotaniCameraMode>> CameraModeInstances;
+	TMap<TSubclassOf<UBotaniCameraMode>, TObjectPtr<UBotaniCameraMode>> CameraModeInstances;
 
+	/** Ring of MaxStackSize slots, the stack starts at StackHead and spans StackSize slots. */
 	UPROPERTY()
-	TArray<TObjectPtr<UBotaniCameraMode>> CameraModeStack;
-};
\ No newline at end of file
+	TArray<TObjectPtr<UBotaniCameraMode>> CameraModeRing;
+
+	int32 StackHead;
+	int32 StackSize;
+};
@@ -12,6 +12,13 @@ class UNiagaraComponent;
  * UBotaniNumPopComponent_NiagaraText
  *
  * A component that can be added to a controller to allow for the display of number pops using Niagara text.
+ *
+ * The Niagara system reads the style's arrays:
+ *	- NiagaraArrayName, Vector4 with XYZ = location, W = number. One entry per number pop, appended in order while the system is active.
+ *	  The index of an entry never changes. A hit merged into an entry rewrites it in place with the accumulated number.
+ *	- NiagaraSpawnTimeArrayName (optional), float with the world time of the latest hit of the entry at the same index.
+ * Entries are never zeroed. Once every entry is older than PopLifetime both arrays are emptied and the system is deactivated,
+ * the next number pop activates it again with a reset.
  */
 UCLASS(Blueprintable)
 class BOTANIGAME_API UBotaniNumPopComponent_NiagaraText : public UBotaniNumberPopComponent
@@ -27,10 +34,44 @@ public:
 	//~ Begin UBotaniNumberPopComponent interface
 	virtual void AddNumberPop(const FBotaniNumPopRequest& NewRequest) override;
 	//~ End of UBotaniNumberPopComponent interface
+
+	//~ Begin UActorComponent interface
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	//~ End of UActorComponent interface
 	
 protected:
-	/** List of cached number pop requests */
-	TArray<int32> NumberArray;
+	/** A single entry of the Niagara arrays */
+	struct FNumberPop
+	{
+		TWeakObjectPtr<const AActor> Target;
+		FVector Location = FVector::ZeroVector;
+		int32 Number = 0;
+		double SpawnTime = 0.0;
+	};
+
+	/** Creates the Niagara component, returns false if there is no usable style */
+	bool InitializeNiagaraComponent();
+
+	/** Returns the number pop the request should be merged into, INDEX_NONE if it needs an entry of its own */
+	int32 FindMergePop(const FBotaniNumPopRequest& Request, double Now) const;
+
+	/** Writes every changed number pop to Niagara, clears the arrays once all of them outlived the pop lifetime */
+	void FlushNumberPops(double Now);
+
+	/** Writes a single number pop to the Niagara arrays, appending it if it is new */
+	void WritePop(int32 PopIdx) const;
+
+	/** Number pops mirroring the Niagara arrays, entries are only appended until they are cleared as a whole */
+	TArray<FNumberPop> NumberPops;
+
+	/** Number pops that changed since the last flush */
+	TArray<int32> DirtyPops;
+
+	/** Number of number pops added since the last flush */
+	int32 NumNewPopsThisFrame = 0;
+
+	/** World time of the latest hit, the arrays are cleared once it is older than the pop lifetime */
+	double LatestSpawnTime = 0.0;
 
 	/** Style asset to apply to the incoming number pops */
 	UPROPERTY(EditDefaultsOnly, Category = "Number Pop|Style")
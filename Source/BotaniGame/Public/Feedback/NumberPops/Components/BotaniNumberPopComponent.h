@@ -38,6 +38,10 @@ public:
 	/** The literal number to display */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Number Pop")
 	int32 NumberToDisplay = 0;
+
+	/** Optional actor the number pop belongs to, pops for the same target can be merged into one */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Number Pop")
+	TObjectPtr<AActor> TargetActor = nullptr;
 };
 
 /**
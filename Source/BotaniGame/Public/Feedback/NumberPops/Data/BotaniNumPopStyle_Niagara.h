@@ -21,7 +21,31 @@ public:
 	UPROPERTY(EditDefaultsOnly, Category = "NumberPop")
 	FName NiagaraArrayName;
 
+	/** Optional name of a Niagara float array that receives the world time of the latest hit of each Number Pop */
+	UPROPERTY(EditDefaultsOnly, Category = "NumberPop")
+	FName NiagaraSpawnTimeArrayName;
+
 	/** Niagara System used to display the Number Pop */
 	UPROPERTY(EditDefaultsOnly, Category = "NumberPop")
 	TObjectPtr<class UNiagaraSystem> TextNiagara;
+
+	/** Maximum size of the Niagara arrays, further Number Pops are merged into the closest one until the displayed ones expired */
+	UPROPERTY(EditDefaultsOnly, Category = "NumberPop|Budget", meta = (ClampMin = 1, UIMin = 1))
+	int32 MaxActivePops = 64;
+
+	/** Seconds after the latest hit until the Niagara arrays are emptied, should cover the lifetime of the effect's particles */
+	UPROPERTY(EditDefaultsOnly, Category = "NumberPop|Budget", meta = (ClampMin = 0, UIMin = 0, Units = s))
+	float PopLifetime = 1.5f;
+
+	/** Number Pops for the same target within this many seconds are merged into one accumulated number */
+	UPROPERTY(EditDefaultsOnly, Category = "NumberPop|Budget", meta = (ClampMin = 0, UIMin = 0, Units = s))
+	float MergeWindow = 0.15f;
+
+	/** Number Pops without a target are merged if they are closer than this */
+	UPROPERTY(EditDefaultsOnly, Category = "NumberPop|Budget", meta = (ClampMin = 0, UIMin = 0, Units = cm))
+	float MergeDistance = 50.f;
+
+	/** Number of new Number Pops per frame, further pops are merged into the closest pop of this frame */
+	UPROPERTY(EditDefaultsOnly, Category = "NumberPop|Budget", meta = (ClampMin = 1, UIMin = 1))
+	int32 MaxNewPopsPerFrame = 8;
 };
@@ -6,8 +6,13 @@
 #include "Subsystems/EngineSubsystem.h"
 #include "BotaniExperienceManager.generated.h"
 
+namespace UE::GameFeatures { struct FResult; }
+class UBotaniExperienceDefinition;
+struct FStreamableHandle;
+
 /**
  * Manager for experiences – primarily for arbitration between multiple PIE sessions
+ * Also owns the pre-staged experience, since it has to outlive the game state of the current match.
  */
 UCLASS(MinimalAPI)
 class UBotaniExperienceManager : public UEngineSubsystem
@@ -25,10 +30,89 @@ public:
 	static bool RequestToDeactivatePlugin(const FString PluginURL) { return true; }
 #endif
 
+	/**
+	 * Starts loading the bundles and game feature plugins of the given experience in the background,
+	 * so a following experience load only has to activate them.
+	 * Replaces any previously pre-staged experience.
+	 *
+	 * @return False if pre-staging is disabled or there is not enough memory left for it.
+	 */
+	BOTANIGAME_API bool PrestageExperience(FPrimaryAssetId ExperienceId, ENetMode NetMode);
+
+	/** Stops pre-staging and releases everything that was only loaded for the pre-staged experience */
+	BOTANIGAME_API void CancelPrestagedExperience();
+
+	/** Returns the experience that is currently pre-staged, if any */
+	FPrimaryAssetId GetPrestagedExperienceId() const { return PrestagedExperienceId; }
+
+	/** Returns true if the pre-staged experience wants the given plugin, so it should stay active across the switch */
+	static bool ShouldRetainPlugin(const FString& PluginURL);
+
+	/** Called by the outgoing experience for plugins it left active because the pre-staged experience wants them */
+	static void NotifyOfRetainedPlugin(const FString& PluginURL);
+
+	/**
+	 * Hands the pre-staged state over to the experience that is now loading.
+	 * Anything that was pre-staged or retained but isn't part of the given plugin list is released.
+	 */
+	static void ClaimPrestagedExperience(FPrimaryAssetId ExperienceId, const TArray<FString>& PluginURLs);
+
+	/** Returns the asset bundles an experience needs for the given net mode */
+	static void GetBundlesToLoad(ENetMode NetMode, TArray<FName>& OutBundlesToLoad);
+
+	/** Returns the primary assets whose bundles need to be loaded for the given experience */
+	static void GetBundleAssetList(const UBotaniExperienceDefinition* Experience, TSet<FPrimaryAssetId>& OutBundleAssetList);
+
+	/** Returns the URLs of all game feature plugins the given experience wants active, filtering out dupes and unknown plugins */
+	static void GetGameFeaturePluginURLs(const UBotaniExperienceDefinition* Experience, TArray<FString>& OutPluginURLs);
+
+	/** Returns the URLs of the game feature plugins the given experience allows to be activated after it has loaded */
+	static void GetDeferredGameFeaturePluginURLs(const UBotaniExperienceDefinition* Experience, TArray<FString>& OutPluginURLs);
+
+private:
+	void OnPrestageExperienceLoaded();
+	void OnPrestageBundlesLoaded();
+	void LoadNextPrestagedPlugin();
+	void OnPrestagedPluginLoaded(const UE::GameFeatures::FResult& Result);
+	void OnPrestageLoadUpdate(TSharedRef<FStreamableHandle> Handle);
+
+	/** Returns true if pre-staging used more memory than the configured budget */
+	bool IsPrestageOverBudget() const;
+
+	/** Releases the pre-staged state. Plugins in PluginURLsToKeep are left untouched. */
+	void ReleasePrestagedExperience(const TArray<FString>& PluginURLsToKeep, bool bUnloadAssets);
+
 private:
 	/**
 	 * The map of requests to active count for a given game feature plugin
 	 * (to allow first in, last out activation management during PIE)
 	 */
 	TMap<FString, int32> GameFeaturePluginRequestCountMap;
+
+	/** The experience currently being pre-staged */
+	FPrimaryAssetId PrestagedExperienceId;
+
+	/** Bundles requested for the pre-staged experience */
+	TArray<FName> PrestagedBundles;
+
+	/** Primary assets that weren't loaded before pre-staging started, and can be unloaded if it gets cancelled */
+	TArray<FPrimaryAssetId> PrestagedAssetIds;
+
+	/** Handle of the in-flight bundle load */
+	TSharedPtr<FStreamableHandle> PrestageLoadHandle;
+
+	/** All game feature plugins the pre-staged experience wants */
+	TArray<FString> PrestagedPluginURLs;
+
+	/** Plugins that still need to be loaded in the background */
+	TArray<FString> PendingPrestagePluginURLs;
+
+	/** Plugins that were loaded (but not activated) for the pre-staged experience */
+	TArray<FString> PrestageLoadedPluginURLs;
+
+	/** Plugins the previous experience left active for the pre-staged one */
+	TArray<FString> RetainedPluginURLs;
+
+	/** Used physical memory when pre-staging started */
+	uint64 PrestageBaselineMemory = 0;
 };
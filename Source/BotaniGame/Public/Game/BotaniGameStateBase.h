@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "AbilitySystemInterface.h"
 #include "ModularGameState.h"
+#include "Messaging/BotaniVerbMessageReplication.h"
 #include "BotaniGameStateBase.generated.h"
 
 class UBotaniAbilitySystemComponent;
@@ -33,6 +34,18 @@ public:
 	/** Gets the server*s FPS, replicated to clients */
 	float GetServerFPS() const { return ServerFPS; }
 
+	/**
+	 * Sends a verb message to the clients it is relevant for, server only.
+	 * Clients broadcast it through their gameplay message subsystem, the server already broadcast it itself.
+	 */
+	void SendVerbMessageToClients(const FBotaniVerbMessage& Message);
+
+	/** Limits which connections receive verb messages with exactly the given verb, all connections receive them by default. */
+	void SetVerbMessageRelevancy(FGameplayTag VerbTag, const FBotaniVerbMessageRelevancy& Relevancy);
+
+	/** Relevancy for verb messages only the players involved in care about, the connections owning the instigator or the target. */
+	static bool IsVerbMessageRelevantToInvolvedPlayers(const FBotaniVerbMessage& Message, const UNetConnection* Connection);
+
 protected:
 	UPROPERTY(Replicated)
 	float ServerFPS;
@@ -44,4 +57,8 @@ private:
 
 	UPROPERTY(VisibleAnywhere, Category = "Components")
 	TObjectPtr<UBotaniAbilitySystemComponent> AbilitySystemComponent;
+
+	/** Verb messages sent to clients, expired on tick */
+	UPROPERTY(Replicated)
+	FBotaniVerbMessageReplication VerbMessages;
 };
@@ -25,6 +25,34 @@ enum class EBotaniExperienceLoadingState
 	Deactivating
 };
 
+/** Tracks a single game feature plugin through the experience's activation pipeline */
+struct FBotaniGameFeaturePluginActivation
+{
+	enum class EState : uint8
+	{
+		Pending,
+		Loading,
+		Activating,
+		Done
+	};
+
+	FString PluginURL;
+	FString PluginName;
+
+	/** Indices of the plugins in the same pipeline that need to be active before this one may start */
+	TArray<int32> Dependencies;
+
+	/** If true, this plugin isn't needed for gameplay and is only started once the experience has loaded */
+	bool bDeferred = false;
+
+	EState State = EState::Pending;
+
+	/** Timings of this plugin, relative to FPlatformTime::Seconds() */
+	double StartTime = 0.0;
+	double LoadedTime = 0.0;
+	double ActivatedTime = 0.0;
+};
+
 /**
  * UBotaniExperienceManagerComponent
  *
@@ -44,11 +72,19 @@ public:
 	
 	//~ Begin ILoadingProcessInterface Interface
 	virtual bool ShouldShowLoadingScreen(FString& OutReason) const override;
+	virtual bool IsLoadingStateEventDriven() const override { return true; }
 	//~ End ILoadingProcessInterface Interface
 
 	/** Tries to set the current experience. Can be a UI or gameplay one. */
 	void SetCurrentExperience(FPrimaryAssetId ExperienceId);
 
+	/**
+	 * Starts loading the next experience in the background while the current one is running.
+	 * Game feature plugins it shares with the current experience stay active across the switch.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Botani|Experience")
+	void PrestageNextExperience(FPrimaryAssetId ExperienceId);
+
 	/** Returns the current experience if it is fully loaded, asserting otherwise. */
 	const UBotaniExperienceDefinition* GetCurrentExperienceChecked() const;
 
@@ -79,7 +115,14 @@ private:
 
 	void StartExperienceLoad();
 	void OnExperienceLoadComplete();
-	void OnGameFeaturePluginLoadComplete(const UE::GameFeatures::FResult& Result);
+
+	/** Builds the activation pipeline for all plugins in GameFeaturePluginURLs */
+	void InitializePluginActivations();
+
+	/** Starts every pending plugin whose dependencies are active, as long as the concurrency limit allows it */
+	void PumpPluginActivations();
+	void OnGameFeaturePluginLoaded(const UE::GameFeatures::FResult& Result, int32 ActivationIndex);
+	void OnGameFeaturePluginActivated(const UE::GameFeatures::FResult& Result, int32 ActivationIndex);
 	void OnExperienceFullLoadCompleted();
 
 	void OnActionDeactivationCompleted();
@@ -98,6 +141,19 @@ private:
 	int32 NumGameFeaturePluginsLoading = 0;
 	TArray<FString> GameFeaturePluginURLs;
 
+	/** The activation pipeline for the plugins in GameFeaturePluginURLs */
+	TArray<FBotaniGameFeaturePluginActivation> PluginActivations;
+
+	/** Number of plugins currently being loaded or activated */
+	int32 NumPluginActivationsInFlight = 0;
+
+	/** True once deferred plugins may be started */
+	bool bDeferredPluginActivationsReleased = false;
+
+	/** Guards PumpPluginActivations against re-entry from synchronously completing plugins */
+	bool bIsPumpingPluginActivations = false;
+	bool bPluginActivationPumpRequested = false;
+
 	/**
 	 * Delegate called when the experience has finished loading just before others.
 	 * (e.g., subsystems that need the experience to be loaded first)
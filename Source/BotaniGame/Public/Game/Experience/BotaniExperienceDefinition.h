@@ -40,6 +40,13 @@ public:
 	UPROPERTY(EditDefaultsOnly, Category = "Gameplay")
 	TArray<FString> GameFeaturesToEnable;
 
+	/**
+	 * Plugins from GameFeaturesToEnable that aren't needed for gameplay (e.g., cosmetic or frontend only ones).
+	 * These are activated after the experience has finished loading, so the gameplay-critical plugins are ready sooner.
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = "Gameplay")
+	TArray<FString> DeferredGameFeatures;
+
 	/** Default pawn data to use for player-controlled pawns. */
 	UPROPERTY(EditDefaultsOnly, Category = "Gameplay")
 	TObjectPtr<const UBotaniPawnData> DefaultPawnData;
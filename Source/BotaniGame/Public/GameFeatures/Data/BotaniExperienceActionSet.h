@@ -36,6 +36,13 @@ public:
 	/** List of Game Feature Plugin URL's this experience wants to have active. Should be relative to the project's directory. */
 	UPROPERTY(EditDefaultsOnly, Category = "Gameplay")
 	TArray<FString> GameFeaturesToEnable;
+
+	/**
+	 * Plugins from GameFeaturesToEnable that aren't needed for gameplay (e.g., cosmetic or frontend only ones).
+	 * These are activated after the experience has finished loading, so the gameplay-critical plugins are ready sooner.
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = "Gameplay")
+	TArray<FString> DeferredGameFeatures;
 	
 	/** List of additional actions to perform as this experience is loaded/activated/deactivated/unloaded. */
 	UPROPERTY(EditDefaultsOnly, Category = "Actions")
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Components/ControllerComponent.h"
+#include "Net/Serialization/FastArraySerializer.h"
 #include "Spec/GameplayInventoryItemSpecHandle.h"
 #include "BotaniQuickBarComponent.generated.h"
 
@@ -11,6 +12,88 @@ class UBotaniInventoryManager;
 class UBotaniEquipmentManager;
 class UBotaniEquipmentInstance;
 class UBotaniItemInstance;
+class UBotaniQuickBarComponent;
+
+/** Called when the item in a single quick bar slot changes, on the server and on the owning client. */
+DECLARE_MULTICAST_DELEGATE_ThreeParams(FOnBotaniQuickBarSlotChanged, UBotaniQuickBarComponent* /*QuickBar*/, int32 /*SlotIndex*/, UBotaniItemInstance* /*ItemInstance*/);
+
+/**
+ * FBotaniQuickBarSlot
+ *
+ * A single slot in the quick bar.
+ */
+USTRUCT()
+struct FBotaniQuickBarSlot : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	FBotaniQuickBarSlot()
+	{
+	}
+
+private:
+	friend struct FBotaniQuickBarSlotList;
+	friend class UBotaniQuickBarComponent;
+
+	/** The item in this slot, null if the slot is empty. */
+	UPROPERTY()
+	TObjectPtr<UBotaniItemInstance> ItemInstance = nullptr;
+
+	/** The index of this slot, the order of the replicated slots is not guaranteed. */
+	UPROPERTY()
+	int32 SlotIndex = INDEX_NONE;
+};
+
+/**
+ * FBotaniQuickBarSlotList
+ *
+ * The replicated slots of a quick bar, only changed slots are sent.
+ */
+USTRUCT()
+struct FBotaniQuickBarSlotList : public FFastArraySerializer
+{
+	GENERATED_BODY()
+	friend class UBotaniQuickBarComponent;
+
+	FBotaniQuickBarSlotList()
+	{
+	}
+
+	FBotaniQuickBarSlotList(UBotaniQuickBarComponent* InQuickBar)
+		: QuickBar(InQuickBar)
+	{
+	}
+
+public:
+	//~ Begin FFastArraySerializer Interface
+	void PreReplicatedRemove(const TArrayView<int32> RemovedIndices, int32 FinalSize);
+	void PostReplicatedAdd(const TArrayView<int32> AddedIndices, int32 FinalSize);
+	void PostReplicatedChange(const TArrayView<int32> ChangedIndices, int32 FinalSize);
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParams)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FBotaniQuickBarSlot, FBotaniQuickBarSlotList>(Slots, DeltaParams, *this);
+	}
+	//~ End FFastArraySerializer Interface
+
+private:
+	/** The slots of the quick bar, in slot order on the server. */
+	UPROPERTY()
+	TArray<FBotaniQuickBarSlot> Slots;
+
+	/** The quick bar that owns this list. */
+	UPROPERTY(NotReplicated)
+	TObjectPtr<UBotaniQuickBarComponent> QuickBar = nullptr;
+};
+
+template<>
+struct TStructOpsTypeTraits<FBotaniQuickBarSlotList> : public TStructOpsTypeTraitsBase2<FBotaniQuickBarSlotList>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
 
 /**
  * UBotaniQuickBarComponent
@@ -21,6 +104,10 @@ UCLASS(Blueprintable, meta = (BlueprintSpawnableComponent))
 class BOTANIGAME_API UBotaniQuickBarComponent : public UControllerComponent
 {
 	GENERATED_UCLASS_BODY()
+	friend struct FBotaniQuickBarSlotList;
+#if WITH_DEV_AUTOMATION_TESTS
+	friend class FBotaniQuickBarCyclingTest;
+#endif
 
 public:
 	//~ Begin UActorComponent Interface
@@ -47,6 +134,10 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Botani|Quick Bar")
 	int32 GetActiveSlotIndex() const { return ActiveSlotIndex; }
 
+	/** Returns the active slot index including a change this client requested that the server has not confirmed yet */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Botani|Quick Bar")
+	int32 GetPredictedActiveSlotIndex() const { return (PendingActiveSlotIndex != INDEX_NONE) ? PendingActiveSlotIndex : ActiveSlotIndex; }
+
 	/** Returns the item handle in the active slot */
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Botani|Quick Bar")
 	FGameplayInventoryItemSpecHandle GetActiveSlotItemHandle() const { return EquippedItemHandle; }
@@ -59,6 +150,10 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Botani|Quick Bar")
 	int32 GetNextFreeItemSlot() const;
 
+	/** Returns the slot index of the item with the given handle, INDEX_NONE if it is not in the quick bar */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Botani|Quick Bar")
+	int32 FindSlotIndexByHandle(const FGameplayInventoryItemSpecHandle& ItemHandle) const;
+
 	/** Adds an item by Handle to the specified slot */
 	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Botani|Quick Bar")
 	void AddItemToSlot(const int32 SlotIndex, const FGameplayInventoryItemSpecHandle& ItemHandle);
@@ -70,40 +165,72 @@ public:
 	/** Removes the item via Handle */
 	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Botani|Quick Bar")
 	UBotaniItemInstance* RemoveItemByHandle(const FGameplayInventoryItemSpecHandle& ItemHandle);
-	
+
+	/** Called when the item in a single slot changes */
+	FOnBotaniQuickBarSlotChanged OnSlotChanged;
 	
 protected:
 	/** The number of slots in the quick bar */
 	UPROPERTY(EditDefaultsOnly, Category = "Quick Bar", meta = (ClampMin = 0, UIMin = 1))
 	int32 NumSlots = 3;
 
-	UFUNCTION()
-	void OnRep_Slots();
-
 	UFUNCTION()
 	void OnRep_ActiveSlotIndex();
 
+	/** Updates the local slot state and notifies listeners, called on the server and for replicated slot changes. */
+	void HandleSlotChanged(int32 SlotIndex, UBotaniItemInstance* ItemInstance);
+
 private:
 	void UnequipItemInSlot();
 	void EquipItemInSlot();
 
+	/** Sets the item in the given slot and marks the slot for replication */
+	void SetSlotItem(int32 SlotIndex, UBotaniItemInstance* ItemInstance);
+
+	void CycleActiveSlot(int32 Direction);
+
+	/** Requests the given slot to become active, requests of a client are sent once per frame */
+	void RequestActiveSlotIndex(int32 NewIndex);
+	void SendActiveSlotIndexRequest();
+
 	UBotaniInventoryManager* FindInventoryManager() const;
 	UBotaniEquipmentManager* FindEquipmentManager() const;
 	AController* GetOwnerController() const;
 
-	void BroadcastQuickBarMessage(const struct FGameplayTag& MessageTag);
+	void BroadcastQuickBarMessage(const struct FGameplayTag& MessageTag, int32 SlotIndex = INDEX_NONE);
 	
 private:
 	/** Replicated list of slots in the quick bar */
-	UPROPERTY(ReplicatedUsing = OnRep_Slots)
+	UPROPERTY(Replicated)
+	FBotaniQuickBarSlotList SlotList;
+
+	/** The item in each slot, mirrors the replicated slots */
+	UPROPERTY(Transient)
 	TArray<TObjectPtr<UBotaniItemInstance>> Slots;
 
+	/** Slot index of every item in the quick bar */
+	TMap<FGameplayInventoryItemSpecHandle, int32> SlotIndexByHandle;
+
+	/** Whether each slot is free */
+	TBitArray<> FreeSlots;
+
 	/** The index of the active slot */
 	UPROPERTY(ReplicatedUsing = OnRep_ActiveSlotIndex)
 	int32 ActiveSlotIndex = -1;
 
 	UPROPERTY()
 	FGameplayInventoryItemSpecHandle EquippedItemHandle;
+
+	/** Slot index this client requested that the server has not confirmed yet */
+	int32 PendingActiveSlotIndex = INDEX_NONE;
+
+	/** Whether a request for PendingActiveSlotIndex is scheduled for the next frame */
+	bool bActiveSlotRequestScheduled = false;
+
+	/** Managers resolved for the current pawn, resolved again once the pawn changes */
+	mutable TWeakObjectPtr<UBotaniInventoryManager> CachedInventoryManager;
+	mutable TWeakObjectPtr<UBotaniEquipmentManager> CachedEquipmentManager;
+	mutable TWeakObjectPtr<const APawn> CachedEquipmentPawn;
 };
 
 /**
@@ -129,6 +256,14 @@ public:
 	UPROPERTY(BlueprintReadOnly, Category = "Botani|Quick Bar")
 	TArray<TObjectPtr<UBotaniItemInstance>> Slots;
 
+	/** The slot that changed, INDEX_NONE if the message is not about a single slot */
+	UPROPERTY(BlueprintReadOnly, Category = "Botani|Quick Bar")
+	int32 SlotIndex = INDEX_NONE;
+
+	/** The item now in the changed slot, null if the slot was emptied */
+	UPROPERTY(BlueprintReadOnly, Category = "Botani|Quick Bar")
+	TObjectPtr<UBotaniItemInstance> SlotItem = nullptr;
+
 	/** The active slot index */
 	UPROPERTY(BlueprintReadOnly, Category = "Botani|Quick Bar")
 	int32 ActiveSlotIndex = -1;
@@ -7,7 +7,9 @@
 #include "PickupIconMod_RarityDrivenOverlayMaterial.generated.h"
 
 /**
- * 
+ * UPickupIconMod_RarityDrivenOverlayMaterial
+ *
+ * Overlay material modifier that adds the rarity style parameters of the item on top of its own.
  */
 UCLASS(meta = (DisplayName = "Overlay Material (Rarity Driven)"))
 class UPickupIconMod_RarityDrivenOverlayMaterial : public UPickupIconMod_OverlayMaterial
@@ -15,7 +17,8 @@ class UPickupIconMod_RarityDrivenOverlayMaterial : public UPickupIconMod_Overlay
 	GENERATED_BODY()
 
 protected:
-	//~ Begin UPickupIconModifier Interface
-	virtual void ApplyModifier(UPickupItemIcon* Outer, USceneComponent* SpawnedIcon, APickupProxyActor* PickupProxy, const UGameplayInventoryItemDefinition* InItemDef) override;
-	//~ End UPickupIconModifier Interface
+	//~ Begin UPickupIconMod_OverlayMaterial Interface
+	virtual void GatherMaterialParameters(const APickupProxyActor* PickupProxy, const UGameplayInventoryItemDefinition* InItemDef,
+		TMap<FName, float>& OutScalarParameters, TMap<FName, FLinearColor>& OutVectorParameters, TMap<FName, UTexture*>& OutTextureParameters) const override;
+	//~ End UPickupIconMod_OverlayMaterial Interface
 };
@@ -44,6 +44,8 @@ public:
 
 	//~ Begin APickupProxyActor Interface
 	virtual void OnDropped(AActor* InInstigator, UGameplayInventoryItemDefinition* InItemDefinition, const FInventoryItemPickupData& InPickupData) override;
+	virtual void SetPickupCosmeticsActive(bool bActive) override;
+	virtual bool CanBeInstanced() const override;
 	//~ End APickupProxyActor Interface
 
 #if WITH_EDITOR
@@ -83,8 +85,15 @@ protected:
 	 */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Pickup")
 	float InitialInteractionDelay;
+
+	/** Height above the ground the pickup comes to rest at, when falling on spawn. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Pickup", meta = (EditCondition = "InitialMovement == EBotaniInitialItemMovement::Gravity", ForceUnits = "cm"))
+	float GravityRestHeight;
 	
 private:
 	void DisablePickupMovement();
 	void EnablePickupMovement_Gravity();
+
+	UFUNCTION()
+	void OnPickupMovementStopped(const FHitResult& ImpactResult);
 };
@@ -7,8 +7,12 @@
 
 #include "BotaniVerbMessageReplication.generated.h"
 
+class UNetConnection;
 struct FBotaniVerbMessageReplication;
 
+/** Returns whether a verb message should be replicated to the given connection. */
+DECLARE_DELEGATE_RetVal_TwoParams(bool, FBotaniVerbMessageRelevancy, const FBotaniVerbMessage& /*Message*/, const UNetConnection* /*Connection*/);
+
 /**
  * FBotaniVerbMessageReplicationEntry
  *
@@ -36,12 +40,22 @@ private:
 	
 	UPROPERTY()
 	FBotaniVerbMessage Message;
+
+	/** Unique id of the message, clients only broadcast each id once */
+	UPROPERTY()
+	int32 MessageId = INDEX_NONE;
+
+	/** Server time the message was added at, not replicated */
+	double ServerTime = 0.0;
 };
 
 /**
  * FBotaniVerbMessageReplication
  *
- * Container of verb messages to replicate
+ * Container of verb messages to replicate.
+ * The server keeps a bounded number of messages, reusing the slot of the oldest message once full and removing
+ * messages that have outlived their lifetime. Clients broadcast every message id only once, so reused or
+ * re-sent entries are not broadcast again.
  */
 USTRUCT(BlueprintType)
 struct FBotaniVerbMessageReplication : public FFastArraySerializer
@@ -57,21 +71,64 @@ public:
 	/** Sets the owner of this replication */
 	void SetOwner(UObject* InOwner) { Owner = InOwner; }
 
+	/**
+	 * Bounds the messages kept for replication.
+	 * @param InMaxMessages			Number of messages kept, the oldest one is replaced once full. 0 uses Botani.VerbMessages.MaxReplicated.
+	 * @param InMessageLifetime		Seconds a message is kept for. 0 uses Botani.VerbMessages.Lifetime.
+	 */
+	void SetLimits(int32 InMaxMessages, float InMessageLifetime);
+
 	/** Broadcasts a message from the server to clients */
 	void AddMessage(const FBotaniVerbMessage& Message);
 
+	/** Removes every message that has outlived its lifetime, the owner calls this regularly and it is also done whenever a message is added. */
+	void ExpireMessages();
+
+	/** Sets a filter deciding which connections receive messages with exactly the given verb, all connections receive them by default. */
+	void SetVerbRelevancy(FGameplayTag VerbTag, const FBotaniVerbMessageRelevancy& Relevancy);
+
+	/** Returns the number of messages currently kept for replication */
+	int32 GetNumMessages() const { return CurrentMessages.Num(); }
+
 	//~ Begin FFastArraySerializer contract
 	void PreReplicatedRemove(const TArrayView<int32> RemovedIndices, int32 FinalSize);
 	void PostReplicatedAdd(const TArrayView<int32> AddedIndices, int32 FinalSize);
 	void PostReplicatedChange(const TArrayView<int32> ChangedIndices, int32 FinalSize);
-	//~ End of FFastArraySerializer contract
 
-	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	template<typename Type, typename SerializerType>
+	bool ShouldWriteFastArrayItem(const Type& Item, const bool bIsWritingOnClient) const
 	{
-		return FFastArraySerializer::FastArrayDeltaSerialize<FBotaniVerMessageReplicationEntry, FBotaniVerbMessageReplication>(CurrentMessages, DeltaParms, *this);
+		if (bIsWritingOnClient)
+		{
+			return Item.ReplicationID != INDEX_NONE;
+		}
+
+		return IsRelevantForConnection(Item.Message, SerializingConnection);
 	}
+	//~ End of FFastArraySerializer contract
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms);
 
 private:
+#if WITH_DEV_AUTOMATION_TESTS
+	friend class FBotaniVerbMessageSoakTest;
+#endif
+
+	void AddMessage_Internal(const FBotaniVerbMessage& Message, double Now);
+	void ExpireMessages_Internal(double Now);
+
+	int32 GetMaxMessages() const;
+	float GetMessageLifetime() const;
+	double GetServerTime() const;
+
+	bool IsRelevantForConnection(const FBotaniVerbMessage& Message, const UNetConnection* Connection) const;
+
+	/** Broadcasts the added or changed entries in order of their id, skipping ids that were broadcast before */
+	void BroadcastNewMessages(const TArrayView<int32> Indices);
+
+	/** Remembers the message id as broadcast, returns false if it was broadcast before */
+	bool MarkMessageBroadcast(int32 MessageId);
+
 	/** Rebroadcasts a message */
 	void BroadcastMessage(const FBotaniVerbMessage& Message) const;
 
@@ -83,6 +140,23 @@ private:
 	/** Owner of this replication (for a route to a world) */
 	UPROPERTY()
 	TObjectPtr<UObject> Owner = nullptr;
+
+	/** Server: limits of the kept messages, 0 uses the cvar defaults */
+	int32 MaxMessages = 0;
+	float MessageLifetime = 0.f;
+
+	/** Server: id of the next added message */
+	int32 NextMessageId = 0;
+
+	/** Server: relevancy filters by verb */
+	TMap<FGameplayTag, FBotaniVerbMessageRelevancy> VerbRelevancyFilters;
+
+	/** Server: connection that is currently being serialized for */
+	const UNetConnection* SerializingConnection = nullptr;
+
+	/** Client: recently broadcast message ids, ids too far behind the highest one are considered stale */
+	TSet<int32> BroadcastMessageIds;
+	int32 HighestBroadcastMessageId = INDEX_NONE;
 };
 
 template<>
@@ -80,6 +80,10 @@ protected:
 	UPROPERTY(Config)
 	TSoftObjectPtr<UBotaniPawnData> DefaultPawnData;
 
+	/** If true, the wall time of every startup job is written to a boot timing CSV in the profiling directory. Ignored in shipping builds. */
+	UPROPERTY(Config)
+	bool bWriteStartupJobTimings = false;
+
 private:
 	// Assets loaded and tracked by the asset manager.
 	UPROPERTY()
@@ -88,12 +92,23 @@ private:
 	// Used for a scope lock when modifying the list of load assets.
 	FCriticalSection LoadedAssetsCritical;
 
-	/** Flushes the StartupJobs array. Processes all startup work. */
+	/**
+	 * Flushes the StartupJobs array. Processes all startup work.
+	 * Jobs without pending dependencies are started right away, so their async loads and worker tasks overlap.
+	 */
 	void DoAllStartupJobs();
 
+#if !UE_BUILD_SHIPPING
+	/** Writes the timings of all startup jobs to a CSV file in the profiling directory. */
+	void WriteStartupJobTimings(double AllStartupJobsStartTime) const;
+#endif
+
 	/** Sets up the ability system. */
 	void InitializeGameplayCueManager();
 
+	/** Starts streaming in the game data asset without blocking, so it can load alongside other startup jobs. */
+	void PreloadGameData(TSharedPtr<FStreamableHandle>& LoadHandle);
+
 	/* Called periodically during loads, could be used to feed the status to a loading screen */
 	void UpdateInitialGameContentLoadPercent(float GameContentPercent);
 
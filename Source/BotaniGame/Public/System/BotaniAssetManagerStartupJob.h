@@ -6,6 +6,16 @@
 
 DECLARE_DELEGATE_OneParam(FBotaniAssetManagerStartupJobSubstepProgress, float /*NewProgress*/);
 
+/** Which thread a startup job is allowed to run on */
+enum class EBotaniStartupJobThread : uint8
+{
+	/** Runs on the game thread. Required for anything touching UObjects or the streamable manager. */
+	GameThread,
+
+	/** Runs as a task graph task on any worker thread. Must not create streamable handles. */
+	AnyThread
+};
+
 /** Handles reporting progress from streamable handles */
 struct FBotaniAssetManagerStartupJob
 {
@@ -15,6 +25,16 @@ struct FBotaniAssetManagerStartupJob
 	float JobWeight;
 	mutable double LastUpdate = 0;
 
+	/** Names of the jobs that need to be completed before this one may start */
+	TArray<FString> Dependencies;
+
+	/** Thread this job is allowed to run on */
+	EBotaniStartupJobThread ThreadAffinity = EBotaniStartupJobThread::GameThread;
+
+	/** Wall clock times of this job, relative to FPlatformTime::Seconds() */
+	mutable double StartTime = 0.0;
+	mutable double EndTime = 0.0;
+
 	/** Simple job that is all synchronous */
 	FBotaniAssetManagerStartupJob(const FString& InJobName, const TFunction<void(const FBotaniAssetManagerStartupJob&, TSharedPtr<FStreamableHandle>&)>& InJobFunc, float InJobWeight)
 		: JobFunc(InJobFunc)
@@ -23,9 +43,32 @@ struct FBotaniAssetManagerStartupJob
 	{
 	}
 
+	/** Declares that this job may only start once the given job has completed */
+	FBotaniAssetManagerStartupJob& DependsOn(const FString& OtherJobName)
+	{
+		Dependencies.AddUnique(OtherJobName);
+		return *this;
+	}
+
+	/** Sets the thread this job is allowed to run on */
+	FBotaniAssetManagerStartupJob& RunOn(EBotaniStartupJobThread InThreadAffinity)
+	{
+		ThreadAffinity = InThreadAffinity;
+		return *this;
+	}
+
 	/** Perform actual loading, will return a handle if it created one */
 	TSharedPtr<FStreamableHandle> DoJob() const;
 
+	/** Starts the job without waiting for its streamable handle. Returns the handle if one is still loading. */
+	TSharedPtr<FStreamableHandle> StartJob() const;
+
+	/** Marks the job as finished and releases the progress binding of the given handle */
+	void FinishJob(const TSharedPtr<FStreamableHandle>& Handle) const;
+
+	/** Returns the wall time this job took, in seconds */
+	double GetDuration() const { return EndTime - StartTime; }
+
 	void UpdateSubsystemProgress(float NewProgress) const
 	{
 		SubstepProgressDelegate.ExecuteIfBound(NewProgress);
@@ -37,7 +80,7 @@ struct FBotaniAssetManagerStartupJob
 		{
 			// StreamableHandle::GetProgress traverses() a large graph and is quite expensive
 			double Now = FPlatformTime::Seconds();
-			if (LastUpdate - Now > 1.0 / 60)
+			if (Now - LastUpdate > 1.0 / 60)
 			{
 				SubstepProgressDelegate.Execute(StreamableHandle->GetProgress());
 				LastUpdate = Now;
@@ -45,4 +88,3 @@ struct FBotaniAssetManagerStartupJob
 		}
 	}
 };
-
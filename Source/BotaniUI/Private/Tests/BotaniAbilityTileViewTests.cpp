@@ -0,0 +1,132 @@
+// Copyright © 2024 Botanibots Team. All rights reserved.
+
+#include "Widgets/AbilityList/BotaniAbilityTileView.h"
+
+#include "GameplayTagsManager.h"
+#include "Abilities/GameplayAbility.h"
+#include "AbilitySystem/BotaniAbilitySystemComponent.h"
+#include "Engine/World.h"
+#include "GameplayTags/BotaniGameplayTags.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/ScopeExit.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBotaniAbilityTileViewReplicationTest, "Botani.UI.AbilityTileView.Replication", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FBotaniAbilityTileViewReplicationTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumAbilities = 128;
+
+	// Every synthetic ability displays one of the input tags, like abilities bound to the action bar do
+	FGameplayTagContainer InputTagContainer = UGameplayTagsManager::Get().RequestGameplayTagChildren(BotaniGameplayTags::Input::TAG_InputTag);
+	InputTagContainer.AddTag(BotaniGameplayTags::Input::TAG_InputTag);
+	const TArray<FGameplayTag> InputTags = InputTagContainer.GetGameplayTagArray();
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("AbilityTileViewTestWorld"));
+	ON_SCOPE_EXIT
+	{
+		World->DestroyWorld(false);
+	};
+
+	AActor* Owner = World->SpawnActor<AActor>();
+	if (!TestNotNull(TEXT("Ability system owner"), Owner))
+	{
+		return false;
+	}
+
+	UBotaniAbilitySystemComponent* ASC = NewObject<UBotaniAbilitySystemComponent>(Owner);
+	ASC->RegisterComponent();
+	ASC->InitAbilityActorInfo(Owner, Owner);
+
+	for (int32 Index = 0; Index < NumAbilities; ++Index)
+	{
+		FGameplayAbilitySpec AbilitySpec(UGameplayAbility::StaticClass(), 1, INDEX_NONE, Owner);
+		AbilitySpec.DynamicAbilityTags.AddTag(InputTags[Index % InputTags.Num()]);
+		ASC->GiveAbility(AbilitySpec);
+	}
+
+	UBotaniAbilityTileView* TileView = NewObject<UBotaniAbilityTileView>(GetTransientPackage());
+	auto VerifyNumEntries = [this, TileView](int32 ExpectedEntries, const TCHAR* Step)
+	{
+		if ((TileView->GetNumItems() != ExpectedEntries) || (TileView->EntriesByHandle.Num() != ExpectedEntries))
+		{
+			AddError(FString::Printf(TEXT("%s: Expected %d entries, got %d items and %d indexed entries."),
+				Step, ExpectedEntries, TileView->GetNumItems(), TileView->EntriesByHandle.Num()));
+			return false;
+		}
+
+		return true;
+	};
+
+	TileView->InitializeWithAbilitySystem(ASC);
+	if (!VerifyNumEntries(NumAbilities, TEXT("Initialize")))
+	{
+		return false;
+	}
+
+	// Replicate a quarter of the abilities away and as many new ones in
+	TArray<FGameplayAbilitySpec> ReplicatedAbilities;
+	TArray<FGameplayAbilitySpecHandle> RemovedHandles;
+	for (int32 Index = 0; Index < ASC->GetActivatableAbilities().Num(); ++Index)
+	{
+		const FGameplayAbilitySpec& AbilitySpec = ASC->GetActivatableAbilities()[Index];
+		if ((Index % 4) != 0)
+		{
+			ReplicatedAbilities.Add(AbilitySpec);
+		}
+		else
+		{
+			RemovedHandles.Add(AbilitySpec.Handle);
+		}
+	}
+
+	for (int32 Index = 0; Index < RemovedHandles.Num(); ++Index)
+	{
+		FGameplayAbilitySpec& AbilitySpec = ReplicatedAbilities.Emplace_GetRef(UGameplayAbility::StaticClass(), 1, INDEX_NONE, Owner);
+		AbilitySpec.DynamicAbilityTags.AddTag(InputTags[Index % InputTags.Num()]);
+	}
+
+	TileView->OnAbilitiesReplicated(ReplicatedAbilities);
+	if (!VerifyNumEntries(NumAbilities, TEXT("Replicated diff")))
+	{
+		return false;
+	}
+
+	// Kept entries must point at the replicated specs, not the ones they were created from
+	for (const FGameplayAbilitySpec& AbilitySpec : ReplicatedAbilities)
+	{
+		const UBotaniAbilityTileEntryData* EntryData = TileView->FindEntryDataByHandle(AbilitySpec.Handle);
+		if ((EntryData == nullptr) || (EntryData->AbilitySpec != &AbilitySpec))
+		{
+			AddError(FString::Printf(TEXT("Replicated diff: Entry of ability %s is missing or stale."), *AbilitySpec.Handle.ToString()));
+		}
+	}
+
+	for (const FGameplayAbilitySpecHandle& Handle : RemovedHandles)
+	{
+		if (TileView->FindEntryDataByHandle(Handle) != nullptr)
+		{
+			AddError(FString::Printf(TEXT("Replicated diff: Entry of removed ability %s was kept."), *Handle.ToString()));
+		}
+	}
+
+	// Every entry must be subscribed to exactly the input tag it displays
+	int32 NumSubscriptions = 0;
+	for (const FGameplayTag& Tag : InputTags)
+	{
+		const TArray<FGameplayAbilitySpecHandle>* Subscribers = TileView->TagSubscribers.Find(Tag);
+		NumSubscriptions += Subscribers ? Subscribers->Num() : 0;
+	}
+
+	TestEqual(TEXT("Input tag subscriptions"), NumSubscriptions, NumAbilities);
+
+	TileView->UninitializeAbilitySystem();
+	VerifyNumEntries(0, TEXT("Uninitialize"));
+	TestEqual(TEXT("Tag subscriptions after uninitialize"), TileView->TagSubscribers.Num(), 0);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
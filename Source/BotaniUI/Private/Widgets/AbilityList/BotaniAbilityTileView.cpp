@@ -33,6 +33,15 @@ void UBotaniAbilityTileEntryData::Initialize(const FGameplayAbilitySpec& Spec)
 
 		InputTags.AddTag(Tag);
 	}
+
+	DisplayedTags = InputTags;
+	if (Spec.Ability)
+	{
+		if (const FGameplayTagContainer* CooldownTags = Spec.Ability->GetCooldownTags())
+		{
+			DisplayedTags.AppendTags(*CooldownTags);
+		}
+	}
 }
 
 
@@ -54,6 +63,8 @@ void UBotaniAbilityTileView::InitializeWithAbilitySystem(UAbilitySystemComponent
 		return;
 	}
 
+	UninitializeAbilitySystem();
+
 	AbilitySystemComponent = InAbilitySystemComponent;
 	RegisterAbilitySystemEvents();
 	AddInitialEntries();
@@ -68,9 +79,35 @@ void UBotaniAbilityTileView::UninitializeAbilitySystem()
 
 	UnregisterAbilitySystemEvents();
 
+	// The entries point into the ability specs of this ability system
+	ClearListItems();
+	EntriesByHandle.Reset();
+	TagSubscribers.Reset();
+
 	AbilitySystemComponent = nullptr;
 }
 
+void UBotaniAbilityTileView::RefreshDisplayedTags(UBotaniAbilityTileViewEntry& Entry, const UBotaniAbilityTileEntryData& EntryData) const
+{
+	if (AbilitySystemComponent == nullptr)
+	{
+		return;
+	}
+
+	for (const FGameplayTag& Tag : EntryData.DisplayedTags)
+	{
+		Entry.OnGameplayTagChanged(Tag, AbilitySystemComponent->GetTagCount(Tag));
+	}
+
+	for (const FGameplayTag& Tag : DisplayedTags)
+	{
+		if (!EntryData.DisplayedTags.HasTagExact(Tag))
+		{
+			Entry.OnGameplayTagChanged(Tag, AbilitySystemComponent->GetTagCount(Tag));
+		}
+	}
+}
+
 void UBotaniAbilityTileView::AddInitialEntries()
 {
 	check(AbilitySystemComponent);
@@ -99,6 +136,9 @@ void UBotaniAbilityTileView::AddAbilitySpec(const FGameplayAbilitySpec& AbilityS
 	UBotaniAbilityTileEntryData* EntryData = NewObject<UBotaniAbilityTileEntryData>(this);
 	EntryData->Initialize(AbilitySpec);
 
+	EntriesByHandle.Add(AbilitySpec.Handle, EntryData);
+	SubscribeEntry(EntryData);
+
 	AddItem(EntryData);
 }
 
@@ -135,18 +175,27 @@ void UBotaniAbilityTileView::UnregisterAbilitySystemEvents()
 
 void UBotaniAbilityTileView::OnGameplayTagChanged(const FGameplayTag GameplayTag, int32 Count)
 {
-	for (UObject* ListItem : GetListItems())
+	const TArray<FGameplayAbilitySpecHandle>* Subscribers = TagSubscribers.Find(GameplayTag);
+	if (Subscribers == nullptr)
+	{
+		return;
+	}
+
+	// Copy, the entry widgets may grant or remove abilities in response
+	const TArray<FGameplayAbilitySpecHandle, TInlineAllocator<8>> Handles(*Subscribers);
+	for (const FGameplayAbilitySpecHandle& Handle : Handles)
 	{
-		if (ListItem == nullptr)
+		const UBotaniAbilityTileEntryData* EntryData = FindEntryDataByHandle(Handle);
+		if (EntryData == nullptr)
 		{
 			continue;
 		}
 
-		const UBotaniAbilityTileEntryData* EntryData = Cast<UBotaniAbilityTileEntryData>(ListItem);
+		// Entries without a widget are scrolled out of view, they catch up once a widget gets bound to them
 		UBotaniAbilityTileViewEntry* Entry = GetEntryWidgetFromItem<UBotaniAbilityTileViewEntry>(EntryData);
 		if (Entry == nullptr)
 		{
-			return;
+			continue;
 		}
 
 		Entry->OnGameplayTagChanged(GameplayTag, Count);
@@ -193,57 +242,96 @@ void UBotaniAbilityTileView::OnAbilityEnded(UGameplayAbility* Ability)
 
 void UBotaniAbilityTileView::OnAbilitiesReplicated(const TArray<FGameplayAbilitySpec>& Abilities)
 {
-	UAbilitySystemComponent* ASC = AbilitySystemComponent.Get();
-	
+	TSet<FGameplayAbilitySpecHandle> ReplicatedHandles;
+	ReplicatedHandles.Reserve(Abilities.Num());
+	for (const FGameplayAbilitySpec& AbilitySpec : Abilities)
+	{
+		ReplicatedHandles.Add(AbilitySpec.Handle);
+	}
+
 	// Remove existing entries for any abilities that got removed.
-	for (auto It = GetListItems().CreateConstIterator(); It; ++It)
+	TArray<UBotaniAbilityTileEntryData*> RemovedEntries;
+	for (const auto& Pair : EntriesByHandle)
 	{
-		auto* EntryData = Cast<UBotaniAbilityTileEntryData>(*It);
-		if (EntryData == nullptr)
+		if (!ReplicatedHandles.Contains(Pair.Key))
 		{
-			continue;
-		}
-
-		bool bFound = false;
-		for (const auto& AbilitySpec : Abilities)
-		{
-			if ((AbilitySpec.Handle == EntryData->Handle) &&
-				(EntryData->AbilitySpec != nullptr) &&
-				(ASC->FindAbilitySpecFromHandle(EntryData->Handle) != nullptr))
-			{
-				bFound = true;
-				break;
-			}
+			RemovedEntries.Add(Pair.Value);
 		}
+	}
 
-		if (!bFound)
-		{
-			RemoveItem(EntryData);
-		}
-		else
-		{
-			BOTANI_UI_LOG(Display, TEXT("Ability %s was not removed"), *EntryData->Handle.ToString());
-		}
+	for (UBotaniAbilityTileEntryData* EntryData : RemovedEntries)
+	{
+		RemoveEntry(EntryData);
 	}
-	
-	
+
 	// Add new entries for any abilities that were replicated.
 	for (const FGameplayAbilitySpec& AbilitySpec : Abilities)
 	{
+		if (UBotaniAbilityTileEntryData* EntryData = FindEntryDataByHandle(AbilitySpec.Handle))
+		{
+			// The replicated array may have been reallocated
+			EntryData->AbilitySpec = &AbilitySpec;
+			continue;
+		}
+
 		AddAbilitySpec(AbilitySpec);
 	}
 }
 
 UBotaniAbilityTileEntryData* UBotaniAbilityTileView::FindEntryDataByHandle(const FGameplayAbilitySpecHandle Handle) const
 {
-	for (auto& Entry : GetListItems())
+	const TObjectPtr<UBotaniAbilityTileEntryData>* EntryData = EntriesByHandle.Find(Handle);
+	return EntryData ? EntryData->Get() : nullptr;
+}
+
+void UBotaniAbilityTileView::RemoveEntry(UBotaniAbilityTileEntryData* EntryData)
+{
+	check(EntryData);
+
+	UnsubscribeEntry(EntryData);
+	EntriesByHandle.Remove(EntryData->Handle);
+
+	RemoveItem(EntryData);
+}
+
+void UBotaniAbilityTileView::SubscribeEntry(const UBotaniAbilityTileEntryData* EntryData)
+{
+	check(EntryData);
+
+	for (const FGameplayTag& Tag : EntryData->DisplayedTags)
+	{
+		TagSubscribers.FindOrAdd(Tag).AddUnique(EntryData->Handle);
+	}
+
+	for (const FGameplayTag& Tag : DisplayedTags)
 	{
-		auto* EntryData = Cast<UBotaniAbilityTileEntryData>(Entry);
-		if (EntryData && EntryData->Handle == Handle)
+		TagSubscribers.FindOrAdd(Tag).AddUnique(EntryData->Handle);
+	}
+}
+
+void UBotaniAbilityTileView::UnsubscribeEntry(const UBotaniAbilityTileEntryData* EntryData)
+{
+	check(EntryData);
+
+	auto Unsubscribe = [this, EntryData](const FGameplayTag& Tag)
+	{
+		if (TArray<FGameplayAbilitySpecHandle>* Subscribers = TagSubscribers.Find(Tag))
 		{
-			return EntryData;
+			Subscribers->RemoveSingleSwap(EntryData->Handle);
+			if (Subscribers->Num() == 0)
+			{
+				TagSubscribers.Remove(Tag);
+			}
 		}
+	};
+
+	for (const FGameplayTag& Tag : EntryData->DisplayedTags)
+	{
+		Unsubscribe(Tag);
 	}
 
-	return nullptr;
+	for (const FGameplayTag& Tag : DisplayedTags)
+	{
+		Unsubscribe(Tag);
+	}
 }
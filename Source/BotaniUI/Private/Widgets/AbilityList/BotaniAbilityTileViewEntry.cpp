@@ -3,6 +3,8 @@
 
 #include "Widgets/AbilityList/BotaniAbilityTileViewEntry.h"
 
+#include "Widgets/AbilityList/BotaniAbilityTileView.h"
+
 void UBotaniAbilityTileViewEntry::OnGameplayTagChanged_Implementation(const FGameplayTag GameplayTag, int32 Count)
 {
 }
@@ -14,3 +16,20 @@ void UBotaniAbilityTileViewEntry::OnAbilityActivated_Implementation(UGameplayAbi
 void UBotaniAbilityTileViewEntry::OnAbilityEnded_Implementation(UGameplayAbility* Ability)
 {
 }
+
+void UBotaniAbilityTileViewEntry::NativeOnListItemObjectSet(UObject* ListItemObject)
+{
+	IUserObjectListEntry::NativeOnListItemObjectSet(ListItemObject);
+
+	// Entry widgets are recycled and only notified about tag changes while bound, catch up on the current counts
+	const UBotaniAbilityTileEntryData* EntryData = Cast<UBotaniAbilityTileEntryData>(ListItemObject);
+	if (EntryData == nullptr)
+	{
+		return;
+	}
+
+	if (const UBotaniAbilityTileView* TileView = EntryData->GetTypedOuter<UBotaniAbilityTileView>())
+	{
+		TileView->RefreshDisplayedTags(*this, *EntryData);
+	}
+}
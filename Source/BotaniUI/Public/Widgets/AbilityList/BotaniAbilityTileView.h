@@ -7,6 +7,8 @@
 #include "GameplayAbilitySpec.h"
 #include "BotaniAbilityTileView.generated.h"
 
+class UBotaniAbilityTileViewEntry;
+
 UCLASS(NotBlueprintable, BlueprintType)
 class UBotaniAbilityTileEntryData : public UObject
 {
@@ -22,6 +24,10 @@ public:
 	UPROPERTY(BlueprintReadOnly, Category = "Ability")
 	FGameplayTagContainer InputTags;
 
+	/** The tags this entry displays, the entry widget is only notified about changes of these tags. */
+	UPROPERTY(BlueprintReadOnly, Category = "Ability")
+	FGameplayTagContainer DisplayedTags;
+
 protected:
 	const FGameplayAbilitySpec* AbilitySpec;
 	FGameplayAbilitySpecHandle Handle;
@@ -36,6 +42,9 @@ UCLASS()
 class BOTANIUI_API UBotaniAbilityTileView : public UCommonTileView
 {
 	GENERATED_UCLASS_BODY()
+#if WITH_DEV_AUTOMATION_TESTS
+	friend class FBotaniAbilityTileViewReplicationTest;
+#endif
 
 public:
 	/** Initializes the tile view with the given ability system component. */
@@ -46,6 +55,9 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Ability")
 	void UninitializeAbilitySystem();
 
+	/** Pushes the current count of every tag the entry data displays to the entry widget, called whenever a widget gets (re)bound to an entry. */
+	void RefreshDisplayedTags(UBotaniAbilityTileViewEntry& Entry, const UBotaniAbilityTileEntryData& EntryData) const;
+
 protected:
 	virtual void AddInitialEntries();
 	virtual void AddAbilitySpec(const FGameplayAbilitySpec& AbilitySpec);
@@ -58,9 +70,24 @@ protected:
 	virtual void OnAbilityEnded(UGameplayAbility* Ability);
 	virtual void OnAbilitiesReplicated(const TArray<FGameplayAbilitySpec>& Abilities);
 
+	/** Tags every entry displays in addition to the tags of its own ability, e.g. states that block all abilities. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ability")
+	FGameplayTagContainer DisplayedTags;
+
 private:
 	UBotaniAbilityTileEntryData* FindEntryDataByHandle(const FGameplayAbilitySpecHandle Handle) const;
+
+	void RemoveEntry(UBotaniAbilityTileEntryData* EntryData);
+	void SubscribeEntry(const UBotaniAbilityTileEntryData* EntryData);
+	void UnsubscribeEntry(const UBotaniAbilityTileEntryData* EntryData);
 	
 	UPROPERTY()
 	TObjectPtr<UAbilitySystemComponent> AbilitySystemComponent;
+
+	/** Every entry, by the handle of its ability */
+	UPROPERTY(Transient)
+	TMap<FGameplayAbilitySpecHandle, TObjectPtr<UBotaniAbilityTileEntryData>> EntriesByHandle;
+
+	/** The handles of the entries displaying each tag */
+	TMap<FGameplayTag, TArray<FGameplayAbilitySpecHandle>> TagSubscribers;
 };
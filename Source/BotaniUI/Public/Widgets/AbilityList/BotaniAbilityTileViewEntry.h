@@ -29,4 +29,9 @@ public:
 	/** Called when an ability ends. */
 	UFUNCTION(BlueprintNativeEvent, Category = "Ability")
 	void OnAbilityEnded(UGameplayAbility* Ability);
+
+protected:
+	//~Begin IUserObjectListEntry interface
+	virtual void NativeOnListItemObjectSet(UObject* ListItemObject) override;
+	//~End IUserObjectListEntry interface
 };
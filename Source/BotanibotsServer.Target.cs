@@ -0,0 +1,21 @@
+// Copyright © 2024 Botanibots Team. All rights reserved.
+
+using UnrealBuildTool;
+using System.Collections.Generic;
+
+public class BotanibotsServerTarget : TargetRules
+{
+	public BotanibotsServerTarget(TargetInfo Target) : base(Target)
+	{
+		Type = TargetType.Server;
+
+		ExtraModuleNames.AddRange( new[]
+		{
+			"BotaniGame",
+			"BotaniAI",
+			"BotaniCheats",
+		});
+
+		BotanibotsGameTarget.ApplySharedBotaniTargetSettings(this);
+	}
+}